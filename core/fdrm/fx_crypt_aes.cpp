@@ -8,6 +8,7 @@
 
 #include <string.h>
 
+#include "core/fdrm/fx_crypt_hw.h"
 #include "core/fxcrt/fx_system.h"
 #include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
@@ -648,6 +649,8 @@ void CRYPT_AESDecrypt(CRYPT_aes_context* context,
                       uint8_t* dest,
                       const uint8_t* src,
                       uint32_t size) {
+  if (CRYPT_AESDecryptWithInstructions(context, dest, src, size))
+    return;
   aes_decrypt_cbc(dest, src, size, context);
 }
 
@@ -655,5 +658,7 @@ void CRYPT_AESEncrypt(CRYPT_aes_context* context,
                       uint8_t* dest,
                       const uint8_t* src,
                       uint32_t size) {
+  if (CRYPT_AESEncryptWithInstructions(context, dest, src, size))
+    return;
   aes_encrypt_cbc(dest, src, size, context);
 }
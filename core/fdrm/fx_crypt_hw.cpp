@@ -0,0 +1,368 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fdrm/fx_crypt_hw.h"
+
+#include "build/build_config.h"
+#include "core/fdrm/fx_crypt.h"
+#include "third_party/base/check_op.h"
+
+#if defined(ARCH_CPU_X86_FAMILY) && (defined(__GNUC__) || defined(__clang__))
+#define CRYPT_X86_INSTRUCTIONS
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(ARCH_CPU_ARM64) && defined(ARCH_CPU_LITTLE_ENDIAN) && \
+    (defined(__GNUC__) || defined(__clang__)) &&                     \
+    (BUILDFLAG(IS_ANDROID) || BUILDFLAG(IS_LINUX) ||                 \
+     BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_APPLE))
+#define CRYPT_ARM_INSTRUCTIONS
+#include <arm_neon.h>
+#if !BUILDFLAG(IS_APPLE)
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace {
+
+bool g_instructions_disabled_for_testing = false;
+
+#if defined(CRYPT_X86_INSTRUCTIONS) || defined(CRYPT_ARM_INSTRUCTIONS)
+
+constexpr uint32_t kSHA256RoundConstants[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1,
+    0x923F82A4, 0xAB1C5ED5, 0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+    0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174, 0xE49B69C1, 0xEFBE4786,
+    0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147,
+    0x06CA6351, 0x14292967, 0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+    0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85, 0xA2BFE8A1, 0xA81A664B,
+    0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A,
+    0x5B9CCA4F, 0x682E6FF3, 0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+    0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+
+struct CPUFeatures {
+  bool aes = false;
+  bool sha256 = false;
+};
+
+CPUFeatures DetectCPUFeatures() {
+  CPUFeatures features;
+#if defined(CRYPT_X86_INSTRUCTIONS)
+  unsigned int eax;
+  unsigned int ebx;
+  unsigned int ecx;
+  unsigned int edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    return features;
+
+  const bool has_ssse3 = ecx & (1u << 9);
+  const bool has_sse41 = ecx & (1u << 19);
+  features.aes = has_ssse3 && (ecx & (1u << 25));
+  if (has_ssse3 && has_sse41 && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+    features.sha256 = ebx & (1u << 29);
+#elif BUILDFLAG(IS_APPLE)
+  // Every arm64 Apple device implements the cryptography extension.
+  features.aes = true;
+  features.sha256 = true;
+#else
+  // Values of HWCAP_AES and HWCAP_SHA2 from the arm64 <asm/hwcap.h>.
+  constexpr unsigned long kHWCapAES = 1 << 3;
+  constexpr unsigned long kHWCapSHA2 = 1 << 6;
+  const unsigned long hwcap = getauxval(AT_HWCAP);
+  features.aes = hwcap & kHWCapAES;
+  features.sha256 = hwcap & kHWCapSHA2;
+#endif
+  return features;
+}
+
+const CPUFeatures& GetCPUFeatures() {
+  static const CPUFeatures features = DetectCPUFeatures();
+  return features;
+}
+
+bool CanUseAESInstructions(const CRYPT_aes_context* context) {
+  return !g_instructions_disabled_for_testing && GetCPUFeatures().aes &&
+         context->Nb == 4;
+}
+
+bool CanUseSHA256Instructions() {
+  return !g_instructions_disabled_for_testing && GetCPUFeatures().sha256;
+}
+
+#endif  // defined(CRYPT_X86_INSTRUCTIONS) || defined(CRYPT_ARM_INSTRUCTIONS)
+
+#if defined(CRYPT_X86_INSTRUCTIONS)
+
+#define CRYPT_TARGET_AES __attribute__((target("aes,ssse3")))
+#define CRYPT_TARGET_SHA __attribute__((target("sha,sse4.1")))
+
+// The portable code keeps round keys and IVs as 32-bit words holding the
+// bytes in big-endian order, so they need a byte swap per word.
+CRYPT_TARGET_AES __m128i LoadWords(const unsigned int* words) {
+  const __m128i kByteSwap =
+      _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+  return _mm_shuffle_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(words)), kByteSwap);
+}
+
+CRYPT_TARGET_AES void StoreWords(unsigned int* words, __m128i value) {
+  const __m128i kByteSwap =
+      _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(words),
+                   _mm_shuffle_epi8(value, kByteSwap));
+}
+
+CRYPT_TARGET_AES void AESEncryptCBC(CRYPT_aes_context* context,
+                                    uint8_t* dest,
+                                    const uint8_t* src,
+                                    uint32_t size) {
+  const int rounds = context->Nr;
+  __m128i keys[CRYPT_aes_context::kMaxNr + 1];
+  for (int i = 0; i <= rounds; ++i)
+    keys[i] = LoadWords(context->keysched + 4 * i);
+
+  __m128i iv = LoadWords(context->iv);
+  for (uint32_t offset = 0; offset < size; offset += 16) {
+    __m128i block = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(src + offset));
+    block = _mm_xor_si128(_mm_xor_si128(block, iv), keys[0]);
+    for (int i = 1; i < rounds; ++i)
+      block = _mm_aesenc_si128(block, keys[i]);
+    iv = _mm_aesenclast_si128(block, keys[rounds]);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + offset), iv);
+  }
+  StoreWords(context->iv, iv);
+}
+
+// `invkeysched` already holds the round keys for the equivalent inverse
+// cipher, which is the form AESDEC expects.
+CRYPT_TARGET_AES void AESDecryptCBC(CRYPT_aes_context* context,
+                                    uint8_t* dest,
+                                    const uint8_t* src,
+                                    uint32_t size) {
+  const int rounds = context->Nr;
+  __m128i keys[CRYPT_aes_context::kMaxNr + 1];
+  for (int i = 0; i <= rounds; ++i)
+    keys[i] = LoadWords(context->invkeysched + 4 * i);
+
+  __m128i iv = LoadWords(context->iv);
+  for (uint32_t offset = 0; offset < size; offset += 16) {
+    const __m128i ciphertext = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(src + offset));
+    __m128i block = _mm_xor_si128(ciphertext, keys[0]);
+    for (int i = 1; i < rounds; ++i)
+      block = _mm_aesdec_si128(block, keys[i]);
+    block = _mm_aesdeclast_si128(block, keys[rounds]);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + offset),
+                     _mm_xor_si128(block, iv));
+    iv = ciphertext;
+  }
+  StoreWords(context->iv, iv);
+}
+
+CRYPT_TARGET_SHA void SHA256Process(uint32_t state[8],
+                                    const uint8_t* data,
+                                    size_t nblocks) {
+  const __m128i kByteSwap =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  // SHA256RNDS2 wants the state split as ABEF and CDGH.
+  __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+  __m128i state1 =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4));
+  tmp = _mm_shuffle_epi32(tmp, 0xB1);
+  state1 = _mm_shuffle_epi32(state1, 0x1B);
+  __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+  for (size_t block = 0; block < nblocks; ++block, data += 64) {
+    const __m128i saved0 = state0;
+    const __m128i saved1 = state1;
+    __m128i msg[4];
+    for (int i = 0; i < 4; ++i) {
+      msg[i] = _mm_shuffle_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)),
+          kByteSwap);
+    }
+    for (int i = 0; i < 16; ++i) {
+      if (i >= 4) {
+        // Message schedule for words 4i to 4i + 3.
+        __m128i next = _mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]);
+        next = _mm_add_epi32(
+            next, _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+        msg[i & 3] = _mm_sha256msg2_epu32(next, msg[(i + 3) & 3]);
+      }
+      const __m128i wk = _mm_add_epi32(
+          msg[i & 3], _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                          kSHA256RoundConstants + 4 * i)));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+      state0 =
+          _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(wk, 0x0E));
+    }
+    state0 = _mm_add_epi32(state0, saved0);
+    state1 = _mm_add_epi32(state1, saved1);
+  }
+
+  tmp = _mm_shuffle_epi32(state0, 0x1B);
+  state1 = _mm_shuffle_epi32(state1, 0xB1);
+  state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+  state1 = _mm_alignr_epi8(state1, tmp, 8);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state), state0);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), state1);
+}
+
+#elif defined(CRYPT_ARM_INSTRUCTIONS)
+
+#if defined(__clang__)
+#define CRYPT_TARGET_AES __attribute__((target("aes")))
+#define CRYPT_TARGET_SHA __attribute__((target("sha2")))
+#else
+#define CRYPT_TARGET_AES __attribute__((target("+crypto")))
+#define CRYPT_TARGET_SHA __attribute__((target("+crypto")))
+#endif
+
+// The portable code keeps round keys and IVs as 32-bit words holding the
+// bytes in big-endian order, so they need a byte swap per word.
+uint8x16_t LoadWords(const unsigned int* words) {
+  return vrev32q_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(words)));
+}
+
+void StoreWords(unsigned int* words, uint8x16_t value) {
+  vst1q_u8(reinterpret_cast<uint8_t*>(words), vrev32q_u8(value));
+}
+
+CRYPT_TARGET_AES void AESEncryptCBC(CRYPT_aes_context* context,
+                                    uint8_t* dest,
+                                    const uint8_t* src,
+                                    uint32_t size) {
+  const int rounds = context->Nr;
+  uint8x16_t keys[CRYPT_aes_context::kMaxNr + 1];
+  for (int i = 0; i <= rounds; ++i)
+    keys[i] = LoadWords(context->keysched + 4 * i);
+
+  uint8x16_t iv = LoadWords(context->iv);
+  for (uint32_t offset = 0; offset < size; offset += 16) {
+    // AESE folds the round key in before SubBytes and ShiftRows, so the last
+    // round key is applied separately.
+    uint8x16_t block = veorq_u8(vld1q_u8(src + offset), iv);
+    for (int i = 0; i < rounds - 1; ++i)
+      block = vaesmcq_u8(vaeseq_u8(block, keys[i]));
+    block = vaeseq_u8(block, keys[rounds - 1]);
+    iv = veorq_u8(block, keys[rounds]);
+    vst1q_u8(dest + offset, iv);
+  }
+  StoreWords(context->iv, iv);
+}
+
+// `invkeysched` already holds the round keys for the equivalent inverse
+// cipher, which is the form AESD expects.
+CRYPT_TARGET_AES void AESDecryptCBC(CRYPT_aes_context* context,
+                                    uint8_t* dest,
+                                    const uint8_t* src,
+                                    uint32_t size) {
+  const int rounds = context->Nr;
+  uint8x16_t keys[CRYPT_aes_context::kMaxNr + 1];
+  for (int i = 0; i <= rounds; ++i)
+    keys[i] = LoadWords(context->invkeysched + 4 * i);
+
+  uint8x16_t iv = LoadWords(context->iv);
+  for (uint32_t offset = 0; offset < size; offset += 16) {
+    const uint8x16_t ciphertext = vld1q_u8(src + offset);
+    uint8x16_t block = ciphertext;
+    for (int i = 0; i < rounds - 1; ++i)
+      block = vaesimcq_u8(vaesdq_u8(block, keys[i]));
+    block = vaesdq_u8(block, keys[rounds - 1]);
+    block = veorq_u8(block, keys[rounds]);
+    vst1q_u8(dest + offset, veorq_u8(block, iv));
+    iv = ciphertext;
+  }
+  StoreWords(context->iv, iv);
+}
+
+CRYPT_TARGET_SHA void SHA256Process(uint32_t state[8],
+                                    const uint8_t* data,
+                                    size_t nblocks) {
+  uint32x4_t abcd = vld1q_u32(state);
+  uint32x4_t efgh = vld1q_u32(state + 4);
+  for (size_t block = 0; block < nblocks; ++block, data += 64) {
+    const uint32x4_t saved_abcd = abcd;
+    const uint32x4_t saved_efgh = efgh;
+    uint32x4_t msg[4];
+    for (int i = 0; i < 4; ++i)
+      msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+    for (int i = 0; i < 16; ++i) {
+      if (i >= 4) {
+        // Message schedule for words 4i to 4i + 3.
+        msg[i & 3] =
+            vsha256su1q_u32(vsha256su0q_u32(msg[i & 3], msg[(i + 1) & 3]),
+                            msg[(i + 2) & 3], msg[(i + 3) & 3]);
+      }
+      const uint32x4_t wk =
+          vaddq_u32(msg[i & 3], vld1q_u32(kSHA256RoundConstants + 4 * i));
+      const uint32x4_t prev_abcd = abcd;
+      abcd = vsha256hq_u32(abcd, efgh, wk);
+      efgh = vsha256h2q_u32(efgh, prev_abcd, wk);
+    }
+    abcd = vaddq_u32(abcd, saved_abcd);
+    efgh = vaddq_u32(efgh, saved_efgh);
+  }
+  vst1q_u32(state, abcd);
+  vst1q_u32(state + 4, efgh);
+}
+
+#endif
+
+}  // namespace
+
+bool CRYPT_AESEncryptWithInstructions(CRYPT_aes_context* context,
+                                      uint8_t* dest,
+                                      const uint8_t* src,
+                                      uint32_t size) {
+#if defined(CRYPT_X86_INSTRUCTIONS) || defined(CRYPT_ARM_INSTRUCTIONS)
+  if (CanUseAESInstructions(context)) {
+    DCHECK_EQ(size % 16, 0u);
+    AESEncryptCBC(context, dest, src, size);
+    return true;
+  }
+#endif
+  return false;
+}
+
+bool CRYPT_AESDecryptWithInstructions(CRYPT_aes_context* context,
+                                      uint8_t* dest,
+                                      const uint8_t* src,
+                                      uint32_t size) {
+#if defined(CRYPT_X86_INSTRUCTIONS) || defined(CRYPT_ARM_INSTRUCTIONS)
+  if (CanUseAESInstructions(context)) {
+    DCHECK_EQ(size % 16, 0u);
+    AESDecryptCBC(context, dest, src, size);
+    return true;
+  }
+#endif
+  return false;
+}
+
+bool CRYPT_SHA256ProcessWithInstructions(CRYPT_sha2_context* context,
+                                         const uint8_t* data,
+                                         size_t nblocks) {
+#if defined(CRYPT_X86_INSTRUCTIONS) || defined(CRYPT_ARM_INSTRUCTIONS)
+  if (CanUseSHA256Instructions()) {
+    // SHA-256 only uses the low 32 bits of each state word.
+    uint32_t state[8];
+    for (int i = 0; i < 8; ++i)
+      state[i] = static_cast<uint32_t>(context->state[i]);
+    SHA256Process(state, data, nblocks);
+    for (int i = 0; i < 8; ++i)
+      context->state[i] = state[i];
+    return true;
+  }
+#endif
+  return false;
+}
+
+void CRYPT_SetCPUInstructionsEnabledForTesting(bool enabled) {
+  g_instructions_disabled_for_testing = !enabled;
+}
@@ -0,0 +1,40 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FDRM_FX_CRYPT_HW_H_
+#define CORE_FDRM_FX_CRYPT_HW_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct CRYPT_aes_context;
+struct CRYPT_sha2_context;
+
+// AES and SHA-256 implementations that use the CPU's cryptography
+// instructions (AES-NI and SHA-NI on x86, the ARMv8 cryptography extension on
+// arm64). The CPU is probed once at runtime. Each function returns false
+// without touching its arguments when the instructions are unavailable, in
+// which case the caller falls back to the portable implementation.
+
+// CBC-mode equivalents of the portable routines in fx_crypt_aes.cpp. Like
+// them, these update the IV in `context` and require `size` to be a multiple
+// of 16.
+bool CRYPT_AESEncryptWithInstructions(CRYPT_aes_context* context,
+                                      uint8_t* dest,
+                                      const uint8_t* src,
+                                      uint32_t size);
+bool CRYPT_AESDecryptWithInstructions(CRYPT_aes_context* context,
+                                      uint8_t* dest,
+                                      const uint8_t* src,
+                                      uint32_t size);
+
+// Compresses `nblocks` consecutive 64-byte blocks into `context->state`.
+bool CRYPT_SHA256ProcessWithInstructions(CRYPT_sha2_context* context,
+                                         const uint8_t* data,
+                                         size_t nblocks);
+
+// Lets tests compare the accelerated paths against the portable ones.
+void CRYPT_SetCPUInstructionsEnabledForTesting(bool enabled);
+
+#endif  // CORE_FDRM_FX_CRYPT_HW_H_
@@ -8,6 +8,8 @@
 
 #include <string.h>
 
+#include "core/fdrm/fx_crypt_hw.h"
+
 #define SHA_GET_UINT32(n, b, i)                                         \
   {                                                                     \
     (n) = ((uint32_t)(b)[(i)] << 24) | ((uint32_t)(b)[(i) + 1] << 16) | \
@@ -244,6 +246,15 @@ void sha256_process(CRYPT_sha2_context* ctx, const uint8_t data[64]) {
   ctx->state[7] += H;
 }
 
+void sha256_process_blocks(CRYPT_sha2_context* ctx,
+                           const uint8_t* data,
+                           size_t nblocks) {
+  if (CRYPT_SHA256ProcessWithInstructions(ctx, data, nblocks))
+    return;
+  for (size_t i = 0; i < nblocks; ++i)
+    sha256_process(ctx, data + 64 * i);
+}
+
 const uint8_t sha256_padding[64] = {
     0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
     0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -451,15 +462,15 @@ void CRYPT_SHA256Update(CRYPT_sha2_context* context,
   context->total_bytes += size;
   if (left && size >= fill) {
     memcpy(context->buffer + left, data, fill);
-    sha256_process(context, context->buffer);
+    sha256_process_blocks(context, context->buffer, 1);
     size -= fill;
     data += fill;
     left = 0;
   }
-  while (size >= 64) {
-    sha256_process(context, data);
-    size -= 64;
-    data += 64;
+  if (size >= 64) {
+    sha256_process_blocks(context, data, size / 64);
+    data += size & ~0x3Fu;
+    size &= 0x3F;
   }
   if (size)
     memcpy(context->buffer + left, data, size);
@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+#include "core/fdrm/fx_crypt_hw.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/utils/hash.h"
 
@@ -277,6 +278,149 @@ TEST(FXCRYPT, Sha256TestB2) {
     EXPECT_EQ(kExpected[i], actual[i]) << " at byte " << i;
 }
 
+TEST(FXCRYPT, AES128CBC) {
+  // Examples F.2.1 and F.2.2 from NIST SP 800-38A.
+  static const uint8_t kKey[16] = {
+      0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15,
+      0x88, 0x09, 0xcf, 0x4f, 0x3c};
+  static const uint8_t kIV[16] = {
+      0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a,
+      0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+  static const uint8_t kPlaintext[64] = {
+      0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e,
+      0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03,
+      0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51, 0x30,
+      0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19,
+      0x1a, 0x0a, 0x52, 0xef, 0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b,
+      0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10};
+  static const uint8_t kCiphertext[64] = {
+      0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e,
+      0x9b, 0x12, 0xe9, 0x19, 0x7d, 0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72,
+      0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2, 0x73,
+      0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b, 0x71, 0x16, 0xe6, 0x9e,
+      0x22, 0x22, 0x95, 0x16, 0x3f, 0xf1, 0xca, 0xa1, 0x68, 0x1f, 0xac,
+      0x09, 0x12, 0x0e, 0xca, 0x30, 0x75, 0x86, 0xe1, 0xa7};
+
+  for (bool use_instructions : {true, false}) {
+    SCOPED_TRACE(use_instructions);
+    CRYPT_SetCPUInstructionsEnabledForTesting(use_instructions);
+    CRYPT_aes_context context;
+    uint8_t actual[64];
+    CRYPT_AESSetKey(&context, kKey, sizeof(kKey));
+    CRYPT_AESSetIV(&context, kIV);
+    CRYPT_AESEncrypt(&context, actual, kPlaintext, sizeof(kPlaintext));
+    EXPECT_TRUE(std::equal(std::begin(actual), std::end(actual),
+                           std::begin(kCiphertext)));
+
+    // Decrypt in two calls to check that the IV carries over.
+    CRYPT_AESSetIV(&context, kIV);
+    CRYPT_AESDecrypt(&context, actual, kCiphertext, 16);
+    CRYPT_AESDecrypt(&context, actual + 16, kCiphertext + 16, 48);
+    EXPECT_TRUE(std::equal(std::begin(actual), std::end(actual),
+                           std::begin(kPlaintext)));
+  }
+  CRYPT_SetCPUInstructionsEnabledForTesting(true);
+}
+
+TEST(FXCRYPT, AES256CBC) {
+  // Examples F.2.5 and F.2.6 from NIST SP 800-38A.
+  static const uint8_t kKey[32] = {
+      0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae,
+      0xf0, 0x85, 0x7d, 0x77, 0x81, 0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61,
+      0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4};
+  static const uint8_t kIV[16] = {
+      0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a,
+      0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+  static const uint8_t kPlaintext[64] = {
+      0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e,
+      0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03,
+      0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51, 0x30,
+      0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19,
+      0x1a, 0x0a, 0x52, 0xef, 0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b,
+      0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10};
+  static const uint8_t kCiphertext[64] = {
+      0xf5, 0x8c, 0x4c, 0x04, 0xd6, 0xe5, 0xf1, 0xba, 0x77, 0x9e, 0xab,
+      0xfb, 0x5f, 0x7b, 0xfb, 0xd6, 0x9c, 0xfc, 0x4e, 0x96, 0x7e, 0xdb,
+      0x80, 0x8d, 0x67, 0x9f, 0x77, 0x7b, 0xc6, 0x70, 0x2c, 0x7d, 0x39,
+      0xf2, 0x33, 0x69, 0xa9, 0xd9, 0xba, 0xcf, 0xa5, 0x30, 0xe2, 0x63,
+      0x04, 0x23, 0x14, 0x61, 0xb2, 0xeb, 0x05, 0xe2, 0xc3, 0x9b, 0xe9,
+      0xfc, 0xda, 0x6c, 0x19, 0x07, 0x8c, 0x6a, 0x9d, 0x1b};
+
+  for (bool use_instructions : {true, false}) {
+    SCOPED_TRACE(use_instructions);
+    CRYPT_SetCPUInstructionsEnabledForTesting(use_instructions);
+    CRYPT_aes_context context;
+    uint8_t actual[64];
+    CRYPT_AESSetKey(&context, kKey, sizeof(kKey));
+    CRYPT_AESSetIV(&context, kIV);
+    CRYPT_AESEncrypt(&context, actual, kPlaintext, sizeof(kPlaintext));
+    EXPECT_TRUE(std::equal(std::begin(actual), std::end(actual),
+                           std::begin(kCiphertext)));
+
+    // Decrypt in two calls to check that the IV carries over.
+    CRYPT_AESSetIV(&context, kIV);
+    CRYPT_AESDecrypt(&context, actual, kCiphertext, 16);
+    CRYPT_AESDecrypt(&context, actual + 16, kCiphertext + 16, 48);
+    EXPECT_TRUE(std::equal(std::begin(actual), std::end(actual),
+                           std::begin(kPlaintext)));
+  }
+  CRYPT_SetCPUInstructionsEnabledForTesting(true);
+}
+
+TEST(FXCRYPT, AESInstructionsMatchPortable) {
+  std::vector<uint8_t> data(256);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<uint8_t>(i * 37 + 11);
+
+  for (uint32_t keylen : {16u, 24u, 32u}) {
+    SCOPED_TRACE(keylen);
+    std::vector<uint8_t> results[2];
+    for (bool use_instructions : {true, false}) {
+      CRYPT_SetCPUInstructionsEnabledForTesting(use_instructions);
+      CRYPT_aes_context context;
+      CRYPT_AESSetKey(&context, data.data() + 100, keylen);
+      CRYPT_AESSetIV(&context, data.data() + 200);
+      std::vector<uint8_t> result(data.size());
+      CRYPT_AESEncrypt(&context, result.data(), data.data(), 128);
+      CRYPT_AESEncrypt(&context, result.data() + 128, data.data() + 128, 128);
+
+      // Decrypting in place must round-trip.
+      std::vector<uint8_t> decrypted = result;
+      CRYPT_AESSetIV(&context, data.data() + 200);
+      CRYPT_AESDecrypt(&context, decrypted.data(), decrypted.data(),
+                       decrypted.size());
+      EXPECT_EQ(data, decrypted);
+      results[use_instructions] = std::move(result);
+    }
+    EXPECT_EQ(results[0], results[1]);
+  }
+  CRYPT_SetCPUInstructionsEnabledForTesting(true);
+}
+
+TEST(FXCRYPT, Sha256InstructionsMatchPortable) {
+  std::vector<uint8_t> data(300);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<uint8_t>(i * 131 + 7);
+
+  for (uint32_t size = 0; size <= data.size(); ++size) {
+    SCOPED_TRACE(size);
+    uint8_t expected[32];
+    CRYPT_SetCPUInstructionsEnabledForTesting(false);
+    CRYPT_SHA256Generate(data.data(), size, expected);
+
+    // Feed the data in two parts to mix buffered and direct blocks.
+    uint8_t actual[32];
+    CRYPT_SetCPUInstructionsEnabledForTesting(true);
+    CRYPT_sha2_context context;
+    CRYPT_SHA256Start(&context);
+    CRYPT_SHA256Update(&context, data.data(), size / 3);
+    CRYPT_SHA256Update(&context, data.data() + size / 3, size - size / 3);
+    CRYPT_SHA256Finish(&context, actual);
+    EXPECT_TRUE(std::equal(std::begin(actual), std::end(actual),
+                           std::begin(expected)));
+  }
+}
+
 TEST(FXCRYPT, CRYPT_ArcFourSetup) {
   {
     static const uint8_t
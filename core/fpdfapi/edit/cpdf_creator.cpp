@@ -24,6 +24,7 @@
 #include "core/fpdfapi/parser/cpdf_string.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fpdfapi/parser/object_tree_traversal_util.h"
+#include "core/fxcrt/cfx_tracelog.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_random.h"
@@ -606,6 +607,7 @@ void CPDF_Creator::InitID() {
 }
 
 bool CPDF_Creator::Continue() {
+  FX_TRACE_EVENT("pdfium.edit", "CPDF_Creator::Continue");
   if (m_iStage < Stage::kInit0)
     return false;
 
@@ -8,6 +8,7 @@
 
 #include <math.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <algorithm>
 #include <limits>
@@ -253,6 +254,66 @@ class CPDF_ICCBasedCS final : public CPDF_BasedCS {
   std::vector<float> m_pRanges;
 };
 
+// Remembers the tint transform outputs for recently seen inputs, so colors
+// that repeat skip evaluating the function. Inputs must match exactly, so the
+// cache never changes the results.
+class TintTransformCache {
+ public:
+  static constexpr size_t kMaxValues = 4;
+
+  TintTransformCache();
+  ~TintTransformCache();
+
+  // Returns true and fills in `outputs` if `inputs` were seen recently.
+  bool Lookup(pdfium::span<const float> inputs,
+              pdfium::span<float> outputs) const;
+  void Store(pdfium::span<const float> inputs,
+             pdfium::span<const float> outputs);
+
+ private:
+  struct Entry {
+    bool valid = false;
+    float inputs[kMaxValues];
+    float outputs[kMaxValues];
+  };
+
+  static size_t GetIndex(pdfium::span<const float> inputs);
+
+  std::vector<Entry> m_Entries;
+};
+
+// Samples a tint transform on a regular grid, and approximates it in between
+// with simplex interpolation, which is tetrahedral interpolation for three
+// inputs. Only worthwhile for images with many more pixels than grid points.
+class TintTransformGrid {
+ public:
+  static constexpr uint32_t kMaxInputs = 4;
+  static constexpr uint32_t kMaxOutputs = 4;
+
+  // Returns the number of grid points for `nInputs` inputs.
+  static uint32_t GetPointCount(uint32_t nInputs);
+
+  TintTransformGrid();
+  ~TintTransformGrid();
+
+  // Returns false if `func` fails at any grid point.
+  bool Build(const CPDF_Function& func, uint32_t nInputs, uint32_t nOutputs);
+
+  // Converts 8-bit `nInputs` component pixels to 8-bit `nOutputs` component
+  // pixels.
+  void TranslatePixels(pdfium::span<uint8_t> dest_span,
+                       pdfium::span<const uint8_t> src_span,
+                       int pixels) const;
+
+ private:
+  uint32_t m_nInputs = 0;
+  uint32_t m_nOutputs = 0;
+  uint32_t m_Strides[kMaxInputs] = {};
+  uint8_t m_Cells[256] = {};
+  float m_Fractions[256] = {};
+  std::vector<float> m_Points;  // `m_nOutputs` values, scaled to 0-255.
+};
+
 class CPDF_SeparationCS final : public CPDF_BasedCS {
  public:
   CONSTRUCT_VIA_MAKE_RETAIN;
@@ -276,6 +337,7 @@ class CPDF_SeparationCS final : public CPDF_BasedCS {
 
   bool m_IsNoneType = false;
   std::unique_ptr<const CPDF_Function> m_pFunc;
+  mutable TintTransformCache m_TintCache;
 };
 
 class CPDF_DeviceNCS final : public CPDF_BasedCS {
@@ -295,11 +357,23 @@ class CPDF_DeviceNCS final : public CPDF_BasedCS {
   uint32_t v_Load(CPDF_Document* pDoc,
                   const CPDF_Array* pArray,
                   std::set<const CPDF_Object*>* pVisited) override;
+  void TranslateImageLine(pdfium::span<uint8_t> dest_span,
+                          pdfium::span<const uint8_t> src_span,
+                          int pixels,
+                          int image_width,
+                          int image_height,
+                          bool bTransMask) const override;
 
  private:
   CPDF_DeviceNCS();
 
+  // Returns true if large enough images should go through `m_pImageGrid`.
+  bool ShouldUseImageGrid(int image_width, int image_height) const;
+
   std::unique_ptr<const CPDF_Function> m_pFunc;
+  mutable TintTransformCache m_TintCache;
+  mutable std::unique_ptr<TintTransformGrid> m_pImageGrid;
+  mutable bool m_bImageGridFailed = false;
 };
 
 class Vector_3by1 {
@@ -424,6 +498,35 @@ void XYZ_to_sRGB_WhitePoint(float X,
   *B = RGB_Conversion(RGB.c);
 }
 
+// Evaluates `func` for `inputs` and converts the result with `base_cs`.
+bool GetTintTransformRGB(const CPDF_Function& func,
+                         const CPDF_ColorSpace& base_cs,
+                         pdfium::span<const float> inputs,
+                         TintTransformCache* cache,
+                         float* R,
+                         float* G,
+                         float* B) {
+  // Using at least 16 elements due to the call base_cs.GetRGB() below.
+  float stack_results[16] = {};
+  std::vector<float> heap_results;
+  pdfium::span<float> results(stack_results);
+  if (func.CountOutputs() > std::size(stack_results)) {
+    heap_results.resize(func.CountOutputs());
+    results = heap_results;
+  }
+
+  const uint32_t nComponents = base_cs.CountComponents();
+  if (cache->Lookup(inputs, results.first(nComponents)))
+    return base_cs.GetRGB(results, R, G, B);
+
+  uint32_t nresults = func.Call(inputs, results).value_or(0);
+  if (nresults == 0)
+    return false;
+
+  cache->Store(inputs, results.first(nComponents));
+  return base_cs.GetRGB(results, R, G, B);
+}
+
 }  // namespace
 
 PatternValue::PatternValue() = default;
@@ -1089,6 +1192,149 @@ std::vector<float> CPDF_ICCBasedCS::GetRanges(const CPDF_Dictionary* pDict,
   return ranges;
 }
 
+TintTransformCache::TintTransformCache() = default;
+
+TintTransformCache::~TintTransformCache() = default;
+
+bool TintTransformCache::Lookup(pdfium::span<const float> inputs,
+                                pdfium::span<float> outputs) const {
+  if (m_Entries.empty() || inputs.size() > kMaxValues ||
+      outputs.size() > kMaxValues) {
+    return false;
+  }
+
+  const Entry& entry = m_Entries[GetIndex(inputs)];
+  if (!entry.valid ||
+      memcmp(entry.inputs, inputs.data(), inputs.size_bytes()) != 0) {
+    return false;
+  }
+
+  fxcrt::spancpy(outputs, pdfium::make_span(entry.outputs, outputs.size()));
+  return true;
+}
+
+void TintTransformCache::Store(pdfium::span<const float> inputs,
+                               pdfium::span<const float> outputs) {
+  if (inputs.size() > kMaxValues || outputs.size() > kMaxValues)
+    return;
+
+  if (m_Entries.empty())
+    m_Entries.resize(256);
+
+  Entry& entry = m_Entries[GetIndex(inputs)];
+  entry.valid = true;
+  fxcrt::spancpy(pdfium::make_span(entry.inputs), inputs);
+  fxcrt::spancpy(pdfium::make_span(entry.outputs), outputs);
+}
+
+// static
+size_t TintTransformCache::GetIndex(pdfium::span<const float> inputs) {
+  uint32_t hash = 0;
+  for (float input : inputs) {
+    uint32_t bits;
+    memcpy(&bits, &input, sizeof(bits));
+    hash = (hash ^ bits) * 0x9e3779b1;
+  }
+  return hash >> 24;
+}
+
+// static
+uint32_t TintTransformGrid::GetPointCount(uint32_t nInputs) {
+  DCHECK_GE(nInputs, 1u);
+  DCHECK_LE(nInputs, kMaxInputs);
+  const uint32_t side = nInputs < 4 ? 17 : 9;
+  uint32_t count = 1;
+  for (uint32_t i = 0; i < nInputs; ++i)
+    count *= side;
+  return count;
+}
+
+TintTransformGrid::TintTransformGrid() = default;
+
+TintTransformGrid::~TintTransformGrid() = default;
+
+bool TintTransformGrid::Build(const CPDF_Function& func,
+                              uint32_t nInputs,
+                              uint32_t nOutputs) {
+  DCHECK_LE(nOutputs, kMaxOutputs);
+  DCHECK_LE(nOutputs, func.CountOutputs());
+  m_nInputs = nInputs;
+  m_nOutputs = nOutputs;
+
+  // Grid points sit every `step` 8-bit values, plus one at 255.
+  const uint32_t point_count = GetPointCount(nInputs);
+  const int side = nInputs < 4 ? 17 : 9;
+  const int step = 256 / (side - 1);
+  for (int value = 0; value < 256; ++value) {
+    const int cell = std::min(value / step, side - 2);
+    const int cell_start = cell * step;
+    const int cell_end = std::min(cell_start + step, 255);
+    m_Cells[value] = cell;
+    m_Fractions[value] =
+        static_cast<float>(value - cell_start) / (cell_end - cell_start);
+  }
+  uint32_t stride = 1;
+  for (uint32_t i = nInputs; i > 0; --i) {
+    m_Strides[i - 1] = stride;
+    stride *= side;
+  }
+
+  std::vector<float> results(std::max(func.CountOutputs(), 16u));
+  float inputs[kMaxInputs];
+  m_Points.resize(point_count * nOutputs);
+  for (uint32_t point = 0; point < point_count; ++point) {
+    for (uint32_t i = 0; i < nInputs; ++i) {
+      const int index = point / m_Strides[i] % side;
+      inputs[i] = std::min(index * step, 255) / 255.0f;
+    }
+    if (!func.Call(pdfium::make_span(inputs, nInputs), results).has_value())
+      return false;
+    for (uint32_t i = 0; i < nOutputs; ++i)
+      m_Points[point * nOutputs + i] = results[i] * 255;
+  }
+  return true;
+}
+
+void TintTransformGrid::TranslatePixels(pdfium::span<uint8_t> dest_span,
+                                        pdfium::span<const uint8_t> src_span,
+                                        int pixels) const {
+  uint8_t* dest = dest_span.data();
+  const uint8_t* src = src_span.data();
+  for (int i = 0; i < pixels; ++i) {
+    // Find the enclosing cell, and visit the dimensions from the largest
+    // fraction to the smallest.
+    uint32_t base = 0;
+    float fractions[kMaxInputs];
+    uint32_t order[kMaxInputs];
+    for (uint32_t j = 0; j < m_nInputs; ++j) {
+      const uint8_t value = src[j];
+      base += m_Cells[value] * m_Strides[j];
+      fractions[j] = m_Fractions[value];
+      uint32_t k = j;
+      for (; k > 0 && fractions[order[k - 1]] < fractions[j]; --k)
+        order[k] = order[k - 1];
+      order[k] = j;
+    }
+    src += m_nInputs;
+
+    const float* point = &m_Points[base * m_nOutputs];
+    float weight = 1.0f - fractions[order[0]];
+    float values[kMaxOutputs];
+    for (uint32_t k = 0; k < m_nOutputs; ++k)
+      values[k] = weight * point[k];
+    for (uint32_t j = 0; j < m_nInputs; ++j) {
+      point += m_Strides[order[j]] * m_nOutputs;
+      weight = fractions[order[j]] -
+               (j + 1 < m_nInputs ? fractions[order[j + 1]] : 0.0f);
+      for (uint32_t k = 0; k < m_nOutputs; ++k)
+        values[k] += weight * point[k];
+    }
+    for (uint32_t k = 0; k < m_nOutputs; ++k)
+      *dest++ = static_cast<uint8_t>(pdfium::clamp(values[k], 0.0f, 255.0f) +
+                                     0.5f);
+  }
+}
+
 CPDF_SeparationCS::CPDF_SeparationCS() : CPDF_BasedCS(Family::kSeparation) {}
 
 CPDF_SeparationCS::~CPDF_SeparationCS() = default;
@@ -1147,15 +1393,17 @@ bool CPDF_SeparationCS::GetRGB(pdfium::span<const float> pBuf,
     return m_pBaseCS->GetRGB(results, R, G, B);
   }
 
+  if (m_pBaseCS) {
+    return GetTintTransformRGB(*m_pFunc, *m_pBaseCS, pBuf.first(1),
+                               &m_TintCache, R, G, B);
+  }
+
   // Using at least 16 elements due to the call m_pAltCS->GetRGB() below.
   std::vector<float> results(std::max(m_pFunc->CountOutputs(), 16u));
   uint32_t nresults = m_pFunc->Call(pBuf.first(1), results).value_or(0);
   if (nresults == 0)
     return false;
 
-  if (m_pBaseCS)
-    return m_pBaseCS->GetRGB(results, R, G, B);
-
   *R = 0.0f;
   *G = 0.0f;
   *B = 0.0f;
@@ -1207,14 +1455,60 @@ bool CPDF_DeviceNCS::GetRGB(pdfium::span<const float> pBuf,
   if (!m_pFunc)
     return false;
 
-  // Using at least 16 elements due to the call m_pAltCS->GetRGB() below.
-  std::vector<float> results(std::max(m_pFunc->CountOutputs(), 16u));
-  uint32_t nresults =
-      m_pFunc->Call(pBuf.first(CountComponents()), pdfium::make_span(results))
-          .value_or(0);
+  return GetTintTransformRGB(*m_pFunc, *m_pBaseCS,
+                             pBuf.first(CountComponents()), &m_TintCache, R,
+                             G, B);
+}
 
-  if (nresults == 0)
+void CPDF_DeviceNCS::TranslateImageLine(pdfium::span<uint8_t> dest_span,
+                                        pdfium::span<const uint8_t> src_span,
+                                        int pixels,
+                                        int image_width,
+                                        int image_height,
+                                        bool bTransMask) const {
+  if (!ShouldUseImageGrid(image_width, image_height)) {
+    CPDF_ColorSpace::TranslateImageLine(dest_span, src_span, pixels,
+                                        image_width, image_height, bTransMask);
+    return;
+  }
+
+  // Interpolate into the alternate color space, and let it do the rest.
+  DataVector<uint8_t> alt_pixels(
+      Fx2DSizeOrDie(pixels, m_pBaseCS->CountComponents()));
+  m_pImageGrid->TranslatePixels(alt_pixels, src_span, pixels);
+  m_pBaseCS->TranslateImageLine(dest_span, alt_pixels, pixels, image_width,
+                                image_height, /*bTransMask=*/false);
+}
+
+bool CPDF_DeviceNCS::ShouldUseImageGrid(int image_width,
+                                        int image_height) const {
+  if (m_bImageGridFailed || !m_pFunc)
+    return false;
+
+  const uint32_t nInputs = CountComponents();
+  const uint32_t nOutputs = m_pBaseCS->CountComponents();
+  if (nInputs < 2 || nInputs > TintTransformGrid::kMaxInputs ||
+      nOutputs > TintTransformGrid::kMaxOutputs) {
+    return false;
+  }
+
+  // The grid only pays off when it is much smaller than the image.
+  FX_SAFE_UINT32 min_pixels = TintTransformGrid::GetPointCount(nInputs);
+  min_pixels *= 16;
+  FX_SAFE_UINT32 image_pixels = image_width;
+  image_pixels *= image_height;
+  if (!image_pixels.IsValid() ||
+      image_pixels.ValueOrDie() < min_pixels.ValueOrDie()) {
     return false;
+  }
 
-  return m_pBaseCS->GetRGB(results, R, G, B);
+  if (!m_pImageGrid) {
+    auto pGrid = std::make_unique<TintTransformGrid>();
+    if (!pGrid->Build(*m_pFunc, nInputs, nOutputs)) {
+      m_bImageGridFailed = true;
+      return false;
+    }
+    m_pImageGrid = std::move(pGrid);
+  }
+  return true;
 }
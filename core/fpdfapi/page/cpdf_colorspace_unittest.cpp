@@ -5,11 +5,61 @@
 #include "core/fpdfapi/page/cpdf_colorspace.h"
 
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include <iterator>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "core/fpdfapi/page/test_with_page_module.h"
+#include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+namespace {
+
+// Returns a DeviceN color space with inputs (a, b) and RGB color (a, b, ab).
+RetainPtr<CPDF_ColorSpace> LoadDeviceNCS() {
+  static constexpr char kProgram[] = "{ 2 copy mul }";
+  auto func_dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  func_dict->SetNewFor<CPDF_Number>("FunctionType", 4);
+  auto domain = func_dict->SetNewFor<CPDF_Array>("Domain");
+  auto range = func_dict->SetNewFor<CPDF_Array>("Range");
+  for (int i = 0; i < 3; ++i) {
+    if (i < 2) {
+      domain->AppendNew<CPDF_Number>(0);
+      domain->AppendNew<CPDF_Number>(1);
+    }
+    range->AppendNew<CPDF_Number>(0);
+    range->AppendNew<CPDF_Number>(1);
+  }
+  auto func = pdfium::MakeRetain<CPDF_Stream>(
+      DataVector<uint8_t>(std::begin(kProgram), std::end(kProgram) - 1),
+      std::move(func_dict));
+
+  auto array = pdfium::MakeRetain<CPDF_Array>();
+  array->AppendNew<CPDF_Name>("DeviceN");
+  auto names = array->AppendNew<CPDF_Array>();
+  names->AppendNew<CPDF_Name>("Spot1");
+  names->AppendNew<CPDF_Name>("Spot2");
+  array->AppendNew<CPDF_Name>("DeviceRGB");
+  array->Append(std::move(func));
+
+  std::set<const CPDF_Object*> visited;
+  return CPDF_ColorSpace::Load(nullptr, array.Get(), &visited);
+}
+
+}  // namespace
+
+using CPDF_DeviceNCSTest = TestWithPageModule;
+
 TEST(CPDF_CalGray, TranslateImageLine) {
   const uint8_t kSrc[12] = {255, 0, 0, 0, 255, 0, 0, 0, 255, 128, 128, 128};
   const uint8_t kExpect[12] = {255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0, 0};
@@ -50,3 +100,57 @@ TEST(CPDF_CalRGB, TranslateImageLine) {
   for (size_t i = 0; i < 12; ++i)
     EXPECT_EQ(dst[i], kExpectNomask[i]) << " at " << i;
 }
+
+TEST_F(CPDF_DeviceNCSTest, GetRGB) {
+  RetainPtr<CPDF_ColorSpace> pCS = LoadDeviceNCS();
+  ASSERT_TRUE(pCS);
+  ASSERT_EQ(2u, pCS->CountComponents());
+
+  // Repeated colors come from the cache, and must not change.
+  for (int i = 0; i < 2; ++i) {
+    const float kColors[][2] = {{0.5f, 0.25f}, {1, 0}, {0.5f, 0.25f}};
+    for (const auto& color : kColors) {
+      float R = -1;
+      float G = -1;
+      float B = -1;
+      ASSERT_TRUE(pCS->GetRGB(color, &R, &G, &B));
+      EXPECT_FLOAT_EQ(color[0], R);
+      EXPECT_FLOAT_EQ(color[1], G);
+      EXPECT_FLOAT_EQ(color[0] * color[1], B);
+    }
+  }
+}
+
+TEST_F(CPDF_DeviceNCSTest, TranslateImageLine) {
+  RetainPtr<CPDF_ColorSpace> pCS = LoadDeviceNCS();
+  ASSERT_TRUE(pCS);
+
+  std::vector<uint8_t> src;
+  for (int a = 0; a < 256; a += 5) {
+    for (int b = 0; b < 256; b += 7) {
+      src.push_back(a);
+      src.push_back(b);
+    }
+  }
+  const int pixels = src.size() / 2;
+
+  // Small images are converted exactly.
+  std::vector<uint8_t> exact(pixels * 3);
+  pCS->TranslateImageLine(exact, src, pixels, pixels, 1, false);
+  for (int i = 0; i < pixels; ++i) {
+    float R;
+    float G;
+    float B;
+    const float color[2] = {src[i * 2] / 255.0f, src[i * 2 + 1] / 255.0f};
+    ASSERT_TRUE(pCS->GetRGB(color, &R, &G, &B));
+    EXPECT_EQ(static_cast<int>(B * 255), exact[i * 3]);
+    EXPECT_EQ(static_cast<int>(G * 255), exact[i * 3 + 1]);
+    EXPECT_EQ(static_cast<int>(R * 255), exact[i * 3 + 2]);
+  }
+
+  // Large images go through an interpolated grid, which stays close.
+  std::vector<uint8_t> approximate(pixels * 3);
+  pCS->TranslateImageLine(approximate, src, pixels, 1000, 1000, false);
+  for (size_t i = 0; i < exact.size(); ++i)
+    EXPECT_LE(abs(exact[i] - approximate[i]), 2) << " at " << i;
+}
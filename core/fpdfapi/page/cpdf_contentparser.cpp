@@ -16,8 +16,10 @@
 #include "core/fpdfapi/page/cpdf_path.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_stream_acc.h"
+#include "core/fxcrt/cfx_tracelog.h"
 #include "core/fxcrt/fixed_try_alloc_zeroed_data_vector.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/pauseindicator_iface.h"
@@ -26,6 +28,7 @@
 #include "core/fxge/cfx_fillrenderoptions.h"
 #include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
+#include "third_party/base/numerics/safe_conversions.h"
 
 CPDF_ContentParser::CPDF_ContentParser(CPDF_Page* pPage)
     : m_CurrentStage(Stage::kGetContent), m_pPageObjectHolder(pPage) {
@@ -109,8 +112,15 @@ CPDF_ContentParser::CPDF_ContentParser(RetainPtr<const CPDF_Stream> pStream,
     pState->SetFillAlpha(1.0f);
     pState->SetSoftMask(nullptr);
   }
-  m_pSingleStream = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(pStream));
-  m_pSingleStream->LoadAllDataFiltered();
+  // Forms are frequently shared between pages, so reuse the document's
+  // decoded copy when there is one.
+  CPDF_Document* pDocument = m_pPageObjectHolder->GetDocument();
+  if (pDocument) {
+    m_pSingleStream = pDocument->GetDecodedStreamAcc(std::move(pStream));
+  } else {
+    m_pSingleStream = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(pStream));
+    m_pSingleStream->LoadAllDataFiltered();
+  }
   m_Data = m_pSingleStream->GetSpan();
 }
 
@@ -143,6 +153,7 @@ bool CPDF_ContentParser::Continue(PauseIndicatorIface* pPause) {
 }
 
 CPDF_ContentParser::Stage CPDF_ContentParser::GetContent() {
+  FX_TRACE_EVENT("pdfium.page", "CPDF_ContentParser::GetContent");
   DCHECK_EQ(m_CurrentStage, Stage::kGetContent);
   DCHECK(m_pPageObjectHolder->IsPage());
   RetainPtr<const CPDF_Array> pContent =
@@ -152,7 +163,8 @@ CPDF_ContentParser::Stage CPDF_ContentParser::GetContent() {
       pContent ? pContent->GetDirectObjectAt(m_CurrentOffset) : nullptr);
   m_StreamArray[m_CurrentOffset] =
       pdfium::MakeRetain<CPDF_StreamAcc>(std::move(pStreamObj));
-  m_StreamArray[m_CurrentOffset]->LoadAllDataFiltered();
+  m_StreamArray[m_CurrentOffset]->LoadAllDataFilteredWithMaxSize(
+      GetMaxContentStreamSize());
   m_CurrentOffset++;
 
   return m_CurrentOffset == m_nStreams ? Stage::kPrepareContent
@@ -160,6 +172,7 @@ CPDF_ContentParser::Stage CPDF_ContentParser::GetContent() {
 }
 
 CPDF_ContentParser::Stage CPDF_ContentParser::PrepareContent() {
+  FX_TRACE_EVENT("pdfium.page", "CPDF_ContentParser::PrepareContent");
   m_CurrentOffset = 0;
 
   if (m_StreamArray.empty()) {
@@ -196,6 +209,7 @@ CPDF_ContentParser::Stage CPDF_ContentParser::PrepareContent() {
 }
 
 CPDF_ContentParser::Stage CPDF_ContentParser::Parse() {
+  FX_TRACE_EVENT("pdfium.page", "CPDF_ContentParser::Parse");
   if (!m_pParser) {
     m_ParsedSet.clear();
     m_pParser = std::make_unique<CPDF_StreamContentParser>(
@@ -208,6 +222,11 @@ CPDF_ContentParser::Stage CPDF_ContentParser::Parse() {
   if (m_CurrentOffset >= GetData().size())
     return Stage::kCheckClip;
 
+  // Stop creating page objects once the document is over its memory limit.
+  // Whatever has been parsed so far is kept and can still be rendered.
+  if (m_pPageObjectHolder->IsOverMemoryLimit())
+    return Stage::kCheckClip;
+
   if (m_StreamSegmentOffsets.empty())
     m_StreamSegmentOffsets.push_back(0);
 
@@ -218,6 +237,7 @@ CPDF_ContentParser::Stage CPDF_ContentParser::Parse() {
 }
 
 CPDF_ContentParser::Stage CPDF_ContentParser::CheckClip() {
+  FX_TRACE_EVENT("pdfium.page", "CPDF_ContentParser::CheckClip");
   if (m_pType3Char) {
     m_pType3Char->InitializeFromStreamData(m_pParser->IsColored(),
                                            m_pParser->GetType3Data());
@@ -247,10 +267,15 @@ CPDF_ContentParser::Stage CPDF_ContentParser::CheckClip() {
 void CPDF_ContentParser::HandlePageContentStream(const CPDF_Stream* pStream) {
   m_pSingleStream =
       pdfium::MakeRetain<CPDF_StreamAcc>(pdfium::WrapRetain(pStream));
-  m_pSingleStream->LoadAllDataFiltered();
+  m_pSingleStream->LoadAllDataFilteredWithMaxSize(GetMaxContentStreamSize());
   m_CurrentStage = Stage::kPrepareContent;
 }
 
+uint32_t CPDF_ContentParser::GetMaxContentStreamSize() const {
+  return pdfium::base::saturated_cast<uint32_t>(
+      m_pPageObjectHolder->GetAvailableMemory());
+}
+
 bool CPDF_ContentParser::HandlePageContentArray(const CPDF_Array* pArray) {
   m_nStreams = fxcrt::CollectionSize<uint32_t>(*pArray);
   if (m_nStreams == 0)
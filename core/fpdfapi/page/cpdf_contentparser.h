@@ -62,6 +62,9 @@ class CPDF_ContentParser {
   void HandlePageContentStream(const CPDF_Stream* pStream);
   bool HandlePageContentArray(const CPDF_Array* pArray);
   void HandlePageContentFailure();
+  // Page content streams that would not fit within the document's memory
+  // limit are left undecoded.
+  uint32_t GetMaxContentStreamSize() const;
 
   bool is_owned() const {
     return absl::holds_alternative<FixedTryAllocZeroedDataVector<uint8_t>>(
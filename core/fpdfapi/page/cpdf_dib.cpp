@@ -31,7 +31,9 @@
 #include "core/fxcodec/jbig2/jbig2_decoder.h"
 #include "core/fxcodec/jpeg/jpegmodule.h"
 #include "core/fxcodec/jpx/cjpx_decoder.h"
+#include "core/fxcodec/prefetchingscanlinedecoder.h"
 #include "core/fxcodec/scanlinedecoder.h"
+#include "core/fxcrt/cfx_renderprofile.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/span_util.h"
@@ -317,6 +319,7 @@ CPDF_DIB::LoadState CPDF_DIB::StartLoadDIBBase(
 }
 
 CPDF_DIB::LoadState CPDF_DIB::ContinueLoadDIBBase(PauseIndicatorIface* pPause) {
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kImageDecode);
   if (m_Status == LoadState::kContinue)
     return ContinueLoadMaskDIB(pPause);
 
@@ -505,6 +508,7 @@ bool CPDF_DIB::GetDecodeAndMaskArray() {
 }
 
 CPDF_DIB::LoadState CPDF_DIB::CreateDecoder(uint8_t resolution_levels_to_skip) {
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kImageDecode);
   ByteString decoder = m_pStreamAcc->GetImageDecoder();
   if (decoder.IsEmpty())
     return LoadState::kSuccess;
@@ -556,6 +560,17 @@ CPDF_DIB::LoadState CPDF_DIB::CreateDecoder(uint8_t resolution_levels_to_skip) {
     return LoadState::kFail;
   if (provided_pitch.value() < requested_pitch.value())
     return LoadState::kFail;
+
+  // Huge images are never realized, so buffering them all would only double
+  // their memory use.
+  if (m_pPrefetchPool) {
+    FX_SAFE_SIZE_T decoded_size = provided_pitch.value();
+    decoded_size *= m_pDecoder->GetHeight();
+    if (decoded_size.IsValid() && decoded_size.ValueOrDie() < kHugeImageSize) {
+      m_pDecoder = PrefetchingScanlineDecoder::Create(std::move(m_pDecoder),
+                                                      m_pPrefetchPool);
+    }
+  }
   return LoadState::kSuccess;
 }
 
@@ -793,6 +808,8 @@ bool CPDF_DIB::LoadInternal(const CPDF_Dictionary* pFormResources,
   if (!m_pStream)
     return false;
 
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kResourceLoad);
+
   m_pDict = m_pStream->GetDict();
   if (!m_pDict)
     return false;
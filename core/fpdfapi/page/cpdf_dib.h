@@ -19,6 +19,7 @@
 #include "core/fxge/dib/cfx_dibbase.h"
 #include "third_party/base/span.h"
 
+class CFX_ThreadPool;
 class CPDF_Dictionary;
 class CPDF_Document;
 class CPDF_Stream;
@@ -54,6 +55,10 @@ class CPDF_DIB final : public CFX_DIBBase {
   uint32_t GetMatteColor() const { return m_MatteColor; }
   bool IsJBigImage() const;
 
+  // Makes loading start decoding all scanlines on `pPool` right away, rather
+  // than as they are requested. Must be called before loading.
+  void SetPrefetchPool(CFX_ThreadPool* pPool) { m_pPrefetchPool = pPool; }
+
   bool Load();
   LoadState StartLoadDIBBase(bool bHasMask,
                              const CPDF_Dictionary* pFormResources,
@@ -106,6 +111,7 @@ class CPDF_DIB final : public CFX_DIBBase {
   uint32_t Get1BitResetValue() const;
 
   UnownedPtr<CPDF_Document> const m_pDocument;
+  UnownedPtr<CFX_ThreadPool> m_pPrefetchPool;
   RetainPtr<const CPDF_Stream> const m_pStream;
   RetainPtr<const CPDF_Dictionary> m_pDict;
   RetainPtr<CPDF_StreamAcc> m_pStreamAcc;
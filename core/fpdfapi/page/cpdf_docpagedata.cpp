@@ -401,9 +401,7 @@ RetainPtr<CPDF_IccProfile> CPDF_DocPageData::GetIccProfile(
   if (it != m_IccProfileMap.end() && it->second)
     return pdfium::WrapRetain(it->second.Get());
 
-  auto pAccessor = pdfium::MakeRetain<CPDF_StreamAcc>(pProfileStream);
-  pAccessor->LoadAllDataFiltered();
-
+  RetainPtr<CPDF_StreamAcc> pAccessor = GetDecodedStreamAcc(pProfileStream);
   ByteString bsDigest = pAccessor->ComputeDigest();
   auto hash_it = m_HashProfileMap.find(bsDigest);
   if (hash_it != m_HashProfileMap.end()) {
@@ -412,7 +410,8 @@ RetainPtr<CPDF_IccProfile> CPDF_DocPageData::GetIccProfile(
       return pdfium::WrapRetain(it_copied_stream->second.Get());
   }
   auto pProfile =
-      pdfium::MakeRetain<CPDF_IccProfile>(pProfileStream, pAccessor->GetSpan());
+      pdfium::MakeRetain<CPDF_IccProfile>(pProfileStream, pAccessor->GetSpan(),
+                                          bsDigest);
   m_IccProfileMap[pProfileStream].Reset(pProfile.Get());
   m_HashProfileMap[bsDigest] = std::move(pProfileStream);
   return pProfile;
@@ -458,6 +457,16 @@ void CPDF_DocPageData::MaybePurgeFontFileStreamAcc(
     m_FontFileMap.erase(it);
 }
 
+RetainPtr<CPDF_StreamAcc> CPDF_DocPageData::GetDecodedStreamAcc(
+    RetainPtr<const CPDF_Stream> pStream) {
+  // The document is not known yet when `m_DecodedStreamCache` is constructed.
+  if (!m_DecodedStreamCache.GetMemoryAccount()) {
+    m_DecodedStreamCache.SetMemoryAccount(
+        pdfium::WrapRetain(GetDocument()->GetMemoryAccount()));
+  }
+  return m_DecodedStreamCache.GetStreamAcc(std::move(pStream));
+}
+
 std::unique_ptr<CPDF_Font::FormIface> CPDF_DocPageData::CreateForm(
     CPDF_Document* pDocument,
     RetainPtr<CPDF_Dictionary> pPageResources,
@@ -13,6 +13,7 @@
 
 #include "core/fpdfapi/font/cpdf_font.h"
 #include "core/fpdfapi/page/cpdf_colorspace.h"
+#include "core/fpdfapi/parser/cpdf_decodedstreamcache.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/fx_codepage_forward.h"
@@ -45,6 +46,8 @@ class CPDF_DocPageData final : public CPDF_Document::PageDataIface,
   void MaybePurgeFontFileStreamAcc(
       RetainPtr<CPDF_StreamAcc>&& pStreamAcc) override;
   void MaybePurgeImage(uint32_t dwStreamObjNum) override;
+  RetainPtr<CPDF_StreamAcc> GetDecodedStreamAcc(
+      RetainPtr<const CPDF_Stream> pStream) override;
 
   // CPDF_Font::FormFactoryIFace:
   std::unique_ptr<CPDF_Font::FormIface> CreateForm(
@@ -53,6 +56,9 @@ class CPDF_DocPageData final : public CPDF_Document::PageDataIface,
       RetainPtr<CPDF_Stream> pFormStream) override;
 
   bool IsForceClear() const { return m_bForceClear; }
+  CPDF_DecodedStreamCache* GetDecodedStreamCache() {
+    return &m_DecodedStreamCache;
+  }
 
   RetainPtr<CPDF_Font> AddFont(std::unique_ptr<CFX_Font> pFont,
                                FX_Charset charset);
@@ -107,6 +113,7 @@ class CPDF_DocPageData final : public CPDF_Document::PageDataIface,
       std::function<void(wchar_t, wchar_t, CPDF_Array*)> Insert);
 
   bool m_bForceClear = false;
+  CPDF_DecodedStreamCache m_DecodedStreamCache;
 
   // Specific destruction order may be required between maps.
   std::map<ByteString, RetainPtr<const CPDF_Stream>> m_HashProfileMap;
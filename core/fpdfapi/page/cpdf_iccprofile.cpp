@@ -8,6 +8,7 @@
 
 #include <utility>
 
+#include "core/fpdfapi/page/cpdf_pagemodule.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fxcodec/icc/icc_transform.h"
 
@@ -21,14 +22,17 @@ bool DetectSRGB(pdfium::span<const uint8_t> span) {
 }  // namespace
 
 CPDF_IccProfile::CPDF_IccProfile(RetainPtr<const CPDF_Stream> pStream,
-                                 pdfium::span<const uint8_t> span)
+                                 pdfium::span<const uint8_t> span,
+                                 const ByteString& digest)
     : m_bsRGB(DetectSRGB(span)), m_pStream(std::move(pStream)) {
   if (m_bsRGB) {
     m_nSrcComponents = 3;
     return;
   }
 
-  m_Transform = fxcodec::IccTransform::CreateTransformSRGB(span);
+  m_Transform =
+      CPDF_PageModule::GetInstance()->GetIccTransformCache()->GetTransformSRGB(
+          digest, span);
   if (m_Transform)
     m_nSrcComponents = m_Transform->components();
 }
@@ -9,8 +9,7 @@
 
 #include <stdint.h>
 
-#include <memory>
-
+#include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "third_party/base/span.h"
@@ -38,15 +37,18 @@ class CPDF_IccProfile final : public Retainable, public Observable {
                          int pixels);
 
  private:
-  // Keeps stream alive for the duration of the CPDF_IccProfile.
+  // Keeps stream alive for the duration of the CPDF_IccProfile. `digest`
+  // identifies the contents of `span`, so that the transform can be shared
+  // with other documents that embed the same profile.
   CPDF_IccProfile(RetainPtr<const CPDF_Stream> pStream,
-                  pdfium::span<const uint8_t> span);
+                  pdfium::span<const uint8_t> span,
+                  const ByteString& digest);
   ~CPDF_IccProfile() override;
 
   const bool m_bsRGB;
   uint32_t m_nSrcComponents = 0;
-  RetainPtr<const CPDF_Stream> const m_pStream;  // Used by `m_Transform`.
-  std::unique_ptr<fxcodec::IccTransform> m_Transform;
+  RetainPtr<const CPDF_Stream> const m_pStream;
+  RetainPtr<fxcodec::IccTransform> m_Transform;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_ICCPROFILE_H_
@@ -13,6 +13,7 @@
 #include "core/fpdfapi/page/cpdf_imageobject.h"
 #include "core/fpdfapi/page/cpdf_pageimagecache.h"
 #include "core/fpdfapi/page/cpdf_transferfunc.h"
+#include "core/fxcrt/cfx_renderprofile.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "third_party/base/check.h"
 
@@ -28,6 +29,9 @@ bool CPDF_ImageLoader::Start(const CPDF_ImageObject* pImage,
                              CPDF_ColorSpace::Family eFamily,
                              bool bLoadMask,
                              const CFX_Size& max_size_required) {
+  // Loading decodes the image, and realizes it for the page image cache, so
+  // time decoding here rather than per scanline.
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kImageDecode);
   m_pCache = pPageImageCache;
   m_pImageObject = pImage;
   bool ret;
@@ -46,6 +50,7 @@ bool CPDF_ImageLoader::Start(const CPDF_ImageObject* pImage,
 }
 
 bool CPDF_ImageLoader::Continue(PauseIndicatorIface* pPause) {
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kImageDecode);
   bool ret = m_pCache ? m_pCache->Continue(pPause)
                       : m_pImageObject->GetImage()->Continue(pPause);
   if (!ret)
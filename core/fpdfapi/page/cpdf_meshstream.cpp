@@ -6,6 +6,7 @@
 
 #include "core/fpdfapi/page/cpdf_meshstream.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "core/fpdfapi/page/cpdf_colorspace.h"
@@ -89,6 +90,16 @@ bool IsValidBitsPerFlag(uint32_t x) {
   }
 }
 
+constexpr size_t kColorCacheSize = 1024;
+
+size_t ColorCacheIndex(const uint32_t* components, uint32_t count) {
+  uint32_t hash = 0;
+  for (uint32_t i = 0; i < count; ++i)
+    hash = hash * 31 + components[i];
+  hash ^= hash >> 10;
+  return hash % kColorCacheSize;
+}
+
 }  // namespace
 
 CPDF_MeshVertex::CPDF_MeshVertex() = default;
@@ -105,13 +116,26 @@ CPDF_MeshStream::CPDF_MeshStream(
     : m_type(type),
       m_funcs(funcs),
       m_pShadingStream(std::move(pShadingStream)),
+      m_pCS(std::move(pCS)) {}
+
+CPDF_MeshStream::CPDF_MeshStream(
+    ShadingType type,
+    const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
+    RetainPtr<CPDF_StreamAcc> pShadingAcc,
+    RetainPtr<CPDF_ColorSpace> pCS)
+    : m_type(type),
+      m_funcs(funcs),
+      m_pShadingStream(pShadingAcc->GetStream()),
       m_pCS(std::move(pCS)),
-      m_pStream(pdfium::MakeRetain<CPDF_StreamAcc>(m_pShadingStream)) {}
+      m_pStream(std::move(pShadingAcc)) {}
 
 CPDF_MeshStream::~CPDF_MeshStream() = default;
 
 bool CPDF_MeshStream::Load() {
-  m_pStream->LoadAllDataFiltered();
+  if (!m_pStream) {
+    m_pStream = pdfium::MakeRetain<CPDF_StreamAcc>(m_pShadingStream);
+    m_pStream->LoadAllDataFiltered();
+  }
   m_BitStream = std::make_unique<CFX_BitStream>(m_pStream->GetSpan());
 
   RetainPtr<const CPDF_Dictionary> pDict = m_pShadingStream->GetDict();
@@ -150,6 +174,12 @@ bool CPDF_MeshStream::Load() {
     m_CoordMax = m_nCoordBits == 32 ? -1 : (1 << m_nCoordBits) - 1;
     m_ComponentMax = (1 << m_nComponentBits) - 1;
   }
+
+  const CPDF_ColorSpace::Family family = m_pCS->GetFamily();
+  if (!m_funcs.empty() || (family != CPDF_ColorSpace::Family::kDeviceGray &&
+                           family != CPDF_ColorSpace::Family::kDeviceRGB)) {
+    m_ColorCache.resize(kColorCacheSize);
+  }
   return true;
 }
 
@@ -203,9 +233,22 @@ CFX_PointF CPDF_MeshStream::ReadCoords() {
 std::tuple<float, float, float> CPDF_MeshStream::ReadColor() {
   DCHECK(ShouldCheckBPC(m_type));
 
+  uint32_t components[kMaxComponents];
+  for (uint32_t i = 0; i < m_nComponents; ++i)
+    components[i] = m_BitStream->GetBits(m_nComponentBits);
+
+  ColorCacheEntry* pEntry = nullptr;
+  if (!m_ColorCache.empty()) {
+    pEntry = &m_ColorCache[ColorCacheIndex(components, m_nComponents)];
+    if (pEntry->valid && std::equal(components, components + m_nComponents,
+                                    pEntry->components)) {
+      return pEntry->rgb;
+    }
+  }
+
   float color_value[kMaxComponents];
   for (uint32_t i = 0; i < m_nComponents; ++i) {
-    color_value[i] = m_ColorMin[i] + m_BitStream->GetBits(m_nComponentBits) *
+    color_value[i] = m_ColorMin[i] + components[i] *
                                          (m_ColorMax[i] - m_ColorMin[i]) /
                                          m_ComponentMax;
   }
@@ -215,17 +258,22 @@ std::tuple<float, float, float> CPDF_MeshStream::ReadColor() {
   float b = 0.0;
   if (m_funcs.empty()) {
     m_pCS->GetRGB(color_value, &r, &g, &b);
-    return std::tuple<float, float, float>(r, g, b);
+  } else {
+    float result[kMaxComponents] = {};
+    for (const auto& func : m_funcs) {
+      if (func && func->CountOutputs() <= kMaxComponents)
+        func->Call(pdfium::make_span(color_value, 1), result);
+    }
+    m_pCS->GetRGB(result, &r, &g, &b);
   }
 
-  float result[kMaxComponents] = {};
-  for (const auto& func : m_funcs) {
-    if (func && func->CountOutputs() <= kMaxComponents)
-      func->Call(pdfium::make_span(color_value, 1), result);
+  std::tuple<float, float, float> rgb(r, g, b);
+  if (pEntry) {
+    pEntry->valid = true;
+    std::copy(components, components + m_nComponents, pEntry->components);
+    pEntry->rgb = rgb;
   }
-
-  m_pCS->GetRGB(result, &r, &g, &b);
-  return std::tuple<float, float, float>(r, g, b);
+  return rgb;
 }
 
 bool CPDF_MeshStream::ReadVertex(const CFX_Matrix& pObject2Bitmap,
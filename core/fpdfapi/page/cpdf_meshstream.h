@@ -42,6 +42,12 @@ class CPDF_MeshStream {
                   const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
                   RetainPtr<const CPDF_Stream> pShadingStream,
                   RetainPtr<CPDF_ColorSpace> pCS);
+  // Reads from `pShadingAcc`, which must already have its data loaded, instead
+  // of decoding the shading stream again.
+  CPDF_MeshStream(ShadingType type,
+                  const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
+                  RetainPtr<CPDF_StreamAcc> pShadingAcc,
+                  RetainPtr<CPDF_ColorSpace> pCS);
   ~CPDF_MeshStream();
 
   bool Load();
@@ -87,6 +93,16 @@ class CPDF_MeshStream {
   std::unique_ptr<CFX_BitStream> m_BitStream;
   float m_ColorMin[kMaxComponents] = {};
   float m_ColorMax[kMaxComponents] = {};
+
+  // Meshes repeat the colors of shared vertices, so remember the RGB values
+  // of recently read component values instead of calling `m_funcs` and
+  // converting from `m_pCS` again. Empty when the conversion is cheap.
+  struct ColorCacheEntry {
+    bool valid = false;
+    uint32_t components[kMaxComponents] = {};
+    std::tuple<float, float, float> rgb;
+  };
+  std::vector<ColorCacheEntry> m_ColorCache;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_MESHSTREAM_H_
@@ -27,6 +27,7 @@ class CPDF_OCContext final : public Retainable {
 
   bool CheckOCGDictVisible(const CPDF_Dictionary* pOCGDict) const;
   bool CheckPageObjectVisible(const CPDF_PageObject* pObj) const;
+  UsageType GetUsageType() const { return m_eUsageType; }
 
  private:
   CPDF_OCContext(CPDF_Document* pDoc, UsageType eUsageType);
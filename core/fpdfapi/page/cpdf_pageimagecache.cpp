@@ -12,12 +12,17 @@
 
 #include "core/fpdfapi/page/cpdf_dib.h"
 #include "core/fpdfapi/page/cpdf_image.h"
+#include "core/fpdfapi/page/cpdf_imageobject.h"
 #include "core/fpdfapi/page/cpdf_page.h"
+#include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxcrt/cfx_threadpool.h"
+#include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/stl_util.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
+#include "third_party/base/containers/contains.h"
 
 namespace {
 
@@ -31,13 +36,41 @@ struct CacheInfo {
   bool operator<(const CacheInfo& other) const { return time < other.time; }
 };
 
+// Decoders that produce a whole bitmap up front, rather than scanlines, cannot
+// be prefetched.
+bool HasScanlineDecoder(const CPDF_Dictionary* pDict) {
+  RetainPtr<const CPDF_Object> pFilter = pDict->GetDirectObjectFor("Filter");
+  if (!pFilter)
+    return true;
+
+  ByteString decoder;
+  if (const CPDF_Array* pArray = pFilter->AsArray()) {
+    if (!pArray->IsEmpty())
+      decoder = pArray->GetByteStringAt(pArray->size() - 1);
+  } else {
+    decoder = pFilter->GetString();
+  }
+  return decoder != "JPXDecode" && decoder != "JBIG2Decode";
+}
+
 }  // namespace
 
-CPDF_PageImageCache::CPDF_PageImageCache(CPDF_Page* pPage) : m_pPage(pPage) {}
+CPDF_PageImageCache::CPDF_PageImageCache(CPDF_Page* pPage)
+    : m_pPage(pPage),
+      m_pMemoryAccount(
+          pdfium::WrapRetain(pPage->GetDocument()->GetMemoryAccount())) {}
 
-CPDF_PageImageCache::~CPDF_PageImageCache() = default;
+CPDF_PageImageCache::~CPDF_PageImageCache() {
+  m_pMemoryAccount->Refund(CFX_MemoryAccount::Category::kImageCaches,
+                            m_nAccountedSize);
+}
 
 void CPDF_PageImageCache::CacheOptimization(int32_t dwLimitCacheSize) {
+  // When the document is over its memory limit, cached bitmaps are the first
+  // thing to go.
+  if (m_pMemoryAccount->IsOverLimit())
+    dwLimitCacheSize = 0;
+
   if (m_nCacheSize <= (uint32_t)dwLimitCacheSize)
     return;
 
@@ -65,6 +98,8 @@ void CPDF_PageImageCache::CacheOptimization(int32_t dwLimitCacheSize) {
 
   while (i < nCount && m_nCacheSize > (uint32_t)dwLimitCacheSize)
     ClearImageCacheEntry(cache_info[i++].pStream);
+
+  UpdateMemoryAccount();
 }
 
 void CPDF_PageImageCache::ClearImageCacheEntry(const CPDF_Stream* pStream) {
@@ -116,6 +151,7 @@ bool CPDF_PageImageCache::StartGetCachedBitmap(
   if (ret == CPDF_DIB::LoadState::kFail)
     m_nCacheSize += m_pCurImageCacheEntry->EstimateSize();
 
+  UpdateMemoryAccount();
   return false;
 }
 
@@ -130,6 +166,7 @@ bool CPDF_PageImageCache::Continue(PauseIndicatorIface* pPause) {
         m_pCurImageCacheEntry.Release();
   }
   m_nCacheSize += m_pCurImageCacheEntry->EstimateSize();
+  UpdateMemoryAccount();
   return false;
 }
 
@@ -143,6 +180,40 @@ void CPDF_PageImageCache::ResetBitmapForImage(RetainPtr<CPDF_Image> pImage) {
   m_nCacheSize -= pEntry->EstimateSize();
   pEntry->Reset();
   m_nCacheSize += pEntry->EstimateSize();
+  UpdateMemoryAccount();
+}
+
+void CPDF_PageImageCache::PrefetchImages(CFX_ThreadPool* pPool,
+                                         const CFX_Size& max_size_required) {
+  if (!pPool)
+    return;
+
+  // Each prefetch allocates its decoded copy up front, so starting more than
+  // the pool can decode at the same time only holds memory for queued work.
+  size_t prefetches_left = std::max<size_t>(pPool->GetMaxConcurrency(), 1);
+  RetainPtr<const CPDF_Dictionary> pPageResources = m_pPage->GetPageResources();
+  for (const auto& pPageObj : *m_pPage) {
+    if (prefetches_left == 0)
+      break;
+
+    const CPDF_ImageObject* pImageObj = pPageObj->AsImage();
+    if (!pImageObj)
+      continue;
+
+    RetainPtr<CPDF_Image> pImage = pImageObj->GetImage();
+    RetainPtr<const CPDF_Stream> pStream = pImage->GetStream();
+    if (!pStream || pImage->GetDocument() != m_pPage->GetDocument() ||
+        pdfium::Contains(m_ImageCache, pStream)) {
+      continue;
+    }
+
+    auto pEntry = std::make_unique<Entry>(std::move(pImage));
+    if (pEntry->Prefetch(this, pPageResources.Get(), pPool,
+                         max_size_required)) {
+      m_ImageCache[std::move(pStream)] = std::move(pEntry);
+      --prefetches_left;
+    }
+  }
 }
 
 uint32_t CPDF_PageImageCache::GetCurMatteColor() const {
@@ -157,10 +228,27 @@ RetainPtr<CFX_DIBBase> CPDF_PageImageCache::DetachCurMask() {
   return m_pCurImageCacheEntry->DetachMask();
 }
 
+void CPDF_PageImageCache::UpdateMemoryAccount() {
+  if (m_nCacheSize > m_nAccountedSize) {
+    m_pMemoryAccount->Charge(CFX_MemoryAccount::Category::kImageCaches,
+                             m_nCacheSize - m_nAccountedSize);
+  } else {
+    m_pMemoryAccount->Refund(CFX_MemoryAccount::Category::kImageCaches,
+                              m_nAccountedSize - m_nCacheSize);
+  }
+  m_nAccountedSize = m_nCacheSize;
+}
+
+bool CPDF_PageImageCache::CanCacheBytes(size_t bytes) const {
+  return m_pMemoryAccount->CanCharge(bytes);
+}
+
 CPDF_PageImageCache::Entry::Entry(RetainPtr<CPDF_Image> pImage)
     : m_pImage(std::move(pImage)) {}
 
-CPDF_PageImageCache::Entry::~Entry() = default;
+CPDF_PageImageCache::Entry::~Entry() {
+  TakePrefetchedBitmap();
+}
 
 void CPDF_PageImageCache::Entry::Reset() {
   m_pCachedBitmap.Reset();
@@ -189,6 +277,19 @@ CPDF_DIB::LoadState CPDF_PageImageCache::Entry::StartGetCachedBitmap(
     return CPDF_DIB::LoadState::kSuccess;
   }
 
+  // Use the prefetched bitmap only if it was loaded with the same options.
+  // Otherwise, dropping it stops its decoding without waiting for it.
+  RetainPtr<CFX_DIBBase> pPrefetched = TakePrefetchedBitmap();
+  if (pPrefetched && !pFormResources && !bStdCS &&
+      eFamily == CPDF_ColorSpace::Family::kUnknown && !bLoadMask &&
+      max_size_required == m_PrefetchedMaxSizeRequired) {
+    m_pCurBitmap = std::move(pPrefetched);
+    m_bCachedSetMaxSizeRequired =
+        (max_size_required.width != 0 && max_size_required.height != 0);
+    ContinueGetCachedBitmap(pPageImageCache);
+    return CPDF_DIB::LoadState::kFail;
+  }
+
   m_pCurBitmap = m_pImage->CreateNewDIB();
   CPDF_DIB::LoadState ret = m_pCurBitmap.AsRaw<CPDF_DIB>()->StartLoadDIBBase(
       true, pFormResources, pPageResources, bStdCS, eFamily, bLoadMask,
@@ -205,6 +306,46 @@ CPDF_DIB::LoadState CPDF_PageImageCache::Entry::StartGetCachedBitmap(
   return CPDF_DIB::LoadState::kFail;
 }
 
+bool CPDF_PageImageCache::Entry::Prefetch(
+    CPDF_PageImageCache* pPageImageCache,
+    const CPDF_Dictionary* pPageResources,
+    CFX_ThreadPool* pPool,
+    const CFX_Size& max_size_required) {
+  if (!HasScanlineDecoder(m_pImage->GetDict().Get()))
+    return false;
+
+  // The decoded copy is charged until the renderer takes it, at which point
+  // the bitmap it gets realized into is charged instead. The estimate leaves
+  // room for that bitmap.
+  FX_SAFE_SIZE_T estimated_size = m_pImage->GetPixelWidth();
+  estimated_size *= m_pImage->GetPixelHeight();
+  estimated_size *= 4;
+  if (!estimated_size.IsValid() ||
+      !pPageImageCache->m_pMemoryAccount->TryCharge(
+          CFX_MemoryAccount::Category::kImageCaches,
+          estimated_size.ValueOrDie())) {
+    return false;
+  }
+  m_pPrefetchAccount = pPageImageCache->m_pMemoryAccount;
+  m_PrefetchCharge = estimated_size.ValueOrDie();
+
+  RetainPtr<CPDF_DIB> pDIB = m_pImage->CreateNewDIB();
+  pDIB->SetPrefetchPool(pPool);
+  // Matches the options CPDF_ImageRenderer uses for page-level images.
+  CPDF_DIB::LoadState ret = pDIB->StartLoadDIBBase(
+      true, nullptr, pPageResources, false, CPDF_ColorSpace::Family::kUnknown,
+      false, max_size_required);
+  if (ret != CPDF_DIB::LoadState::kSuccess) {
+    TakePrefetchedBitmap();
+    return false;
+  }
+
+  m_pPrefetchedBitmap = std::move(pDIB);
+  m_PrefetchedMaxSizeRequired = max_size_required;
+  m_dwTimeCount = pPageImageCache->GetTimeCount();
+  return true;
+}
+
 bool CPDF_PageImageCache::Entry::Continue(
     PauseIndicatorIface* pPause,
     CPDF_PageImageCache* pPageImageCache) {
@@ -220,12 +361,27 @@ bool CPDF_PageImageCache::Entry::Continue(
   return false;
 }
 
+RetainPtr<CFX_DIBBase> CPDF_PageImageCache::Entry::TakePrefetchedBitmap() {
+  if (m_pPrefetchAccount) {
+    m_pPrefetchAccount->Refund(CFX_MemoryAccount::Category::kImageCaches,
+                               m_PrefetchCharge);
+    m_pPrefetchAccount.Reset();
+    m_PrefetchCharge = 0;
+  }
+  return std::move(m_pPrefetchedBitmap);
+}
+
 void CPDF_PageImageCache::Entry::ContinueGetCachedBitmap(
     CPDF_PageImageCache* pPageImageCache) {
   m_MatteColor = m_pCurBitmap.AsRaw<CPDF_DIB>()->GetMatteColor();
   m_pCurMask = m_pCurBitmap.AsRaw<CPDF_DIB>()->DetachMask();
   m_dwTimeCount = pPageImageCache->GetTimeCount();
-  if (m_pCurBitmap->GetPitch() * m_pCurBitmap->GetHeight() < kHugeImageSize) {
+  // Keep decoding lazily, as for huge images, when a realized copy would not
+  // fit within the document's memory limit.
+  const size_t realized_size =
+      m_pCurBitmap->GetPitch() * m_pCurBitmap->GetHeight();
+  if (realized_size < kHugeImageSize &&
+      pPageImageCache->CanCacheBytes(realized_size)) {
     m_pCachedBitmap = m_pCurBitmap->Realize();
     m_pCurBitmap.Reset();
   } else {
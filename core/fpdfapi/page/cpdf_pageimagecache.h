@@ -7,6 +7,7 @@
 #ifndef CORE_FPDFAPI_PAGE_CPDF_PAGEIMAGECACHE_H_
 #define CORE_FPDFAPI_PAGE_CPDF_PAGEIMAGECACHE_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <functional>
@@ -14,10 +15,12 @@
 #include <memory>
 
 #include "core/fpdfapi/page/cpdf_dib.h"
+#include "core/fxcrt/cfx_memoryaccount.h"
 #include "core/fxcrt/maybe_owned.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
 
+class CFX_ThreadPool;
 class CPDF_Dictionary;
 class CPDF_Image;
 class CPDF_Page;
@@ -30,6 +33,15 @@ class CPDF_PageImageCache {
   ~CPDF_PageImageCache();
 
   void ResetBitmapForImage(RetainPtr<CPDF_Image> pImage);
+
+  // Starts decoding the images drawn directly by the page's content on
+  // `pPool`, so they are ready by the time rendering reaches them. The page
+  // must be parsed. `max_size_required` is what the renderer will pass to
+  // StartGetCachedBitmap(); a request for any other size does not use the
+  // prefetched image. At most GetMaxConcurrency() images are prefetched, in
+  // page order; the rest are decoded when drawn.
+  void PrefetchImages(CFX_ThreadPool* pPool,
+                      const CFX_Size& max_size_required);
   void CacheOptimization(int32_t dwLimitCacheSize);
   uint32_t GetTimeCount() const { return m_nTimeCount; }
   CPDF_Page* GetPage() const { return m_pPage; }
@@ -77,7 +89,17 @@ class CPDF_PageImageCache {
     RetainPtr<CFX_DIBBase> DetachBitmap();
     RetainPtr<CFX_DIBBase> DetachMask();
 
+    // Loads the image the way top-level page content loads it, decoding on
+    // `pPool`. Returns false if the image is not suitable for prefetching, or
+    // its decoded copy does not fit within the document's memory limit.
+    bool Prefetch(CPDF_PageImageCache* pPageImageCache,
+                  const CPDF_Dictionary* pPageResources,
+                  CFX_ThreadPool* pPool,
+                  const CFX_Size& max_size_required);
+
    private:
+    // Takes `m_pPrefetchedBitmap` and refunds what was charged for it.
+    RetainPtr<CFX_DIBBase> TakePrefetchedBitmap();
     void ContinueGetCachedBitmap(CPDF_PageImageCache* pPageImageCache);
     void CalcSize();
     bool IsCacheValid(const CFX_Size& max_size_required) const;
@@ -90,18 +112,30 @@ class CPDF_PageImageCache {
     RetainPtr<CFX_DIBBase> m_pCurMask;
     RetainPtr<CFX_DIBBase> m_pCachedBitmap;
     RetainPtr<CFX_DIBBase> m_pCachedMask;
+    // Loaded by Prefetch(), still being decoded.
+    RetainPtr<CFX_DIBBase> m_pPrefetchedBitmap;
+    CFX_Size m_PrefetchedMaxSizeRequired;
+    // Charged to the document for `m_pPrefetchedBitmap`'s decoded copy.
+    RetainPtr<CFX_MemoryAccount> m_pPrefetchAccount;
+    size_t m_PrefetchCharge = 0;
     bool m_bCachedSetMaxSizeRequired = false;
   };
 
   void ClearImageCacheEntry(const CPDF_Stream* pStream);
 
+  // Brings the document's memory account in line with `m_nCacheSize`.
+  void UpdateMemoryAccount();
+  bool CanCacheBytes(size_t bytes) const;
+
   UnownedPtr<CPDF_Page> const m_pPage;
   std::map<RetainPtr<const CPDF_Stream>, std::unique_ptr<Entry>, std::less<>>
       m_ImageCache;
   MaybeOwned<Entry> m_pCurImageCacheEntry;
   uint32_t m_nTimeCount = 0;
   uint32_t m_nCacheSize = 0;
+  uint32_t m_nAccountedSize = 0;
   bool m_bCurFindCache = false;
+  RetainPtr<CFX_MemoryAccount> const m_pMemoryAccount;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_PAGEIMAGECACHE_H_
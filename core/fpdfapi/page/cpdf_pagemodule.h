@@ -8,6 +8,7 @@
 #define CORE_FPDFAPI_PAGE_CPDF_PAGEMODULE_H_
 
 #include "core/fpdfapi/page/cpdf_colorspace.h"
+#include "core/fxcodec/icc/icc_transform_cache.h"
 #include "core/fxcrt/retain_ptr.h"
 
 class CPDF_Document;
@@ -23,6 +24,9 @@ class CPDF_PageModule {
 
   RetainPtr<CPDF_ColorSpace> GetStockCS(CPDF_ColorSpace::Family family);
   void ClearStockFont(CPDF_Document* pDoc);
+  fxcodec::IccTransformCache* GetIccTransformCache() {
+    return &m_IccTransformCache;
+  }
 
  private:
   CPDF_PageModule();
@@ -32,6 +36,7 @@ class CPDF_PageModule {
   RetainPtr<CPDF_DeviceCS> m_StockRGBCS;
   RetainPtr<CPDF_DeviceCS> m_StockCMYKCS;
   RetainPtr<CPDF_PatternCS> m_StockPatternCS;
+  fxcodec::IccTransformCache m_IccTransformCache;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_PAGEMODULE_H_
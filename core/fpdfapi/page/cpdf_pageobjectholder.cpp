@@ -13,13 +13,33 @@
 #include "core/fpdfapi/page/cpdf_allstates.h"
 #include "core/fpdfapi/page/cpdf_contentparser.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/page/cpdf_pathobject.h"
+#include "core/fpdfapi/page/cpdf_textobject.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fxcrt/cfx_renderprofile.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/stl_util.h"
 #include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
 
+namespace {
+
+// Rough size of a page object and the state it does not share with others.
+constexpr size_t kPageObjectOverhead = 256;
+
+size_t EstimatePageObjectSize(const CPDF_PageObject* pPageObj) {
+  size_t size = kPageObjectOverhead;
+  if (const CPDF_PathObject* pPath = pPageObj->AsPath()) {
+    size += pPath->path().GetPoints().size() * sizeof(CFX_Path::Point);
+  } else if (const CPDF_TextObject* pText = pPageObj->AsText()) {
+    size += pText->GetCharCodes().size() * (sizeof(uint32_t) + sizeof(float));
+  }
+  return size;
+}
+
+}  // namespace
+
 bool GraphicsData::operator<(const GraphicsData& other) const {
   if (!FXSYS_SafeEQ(fillAlpha, other.fillAlpha))
     return FXSYS_SafeLT(fillAlpha, other.fillAlpha);
@@ -42,11 +62,15 @@ CPDF_PageObjectHolder::CPDF_PageObjectHolder(
     : m_pPageResources(std::move(pPageResources)),
       m_pResources(std::move(pResources)),
       m_pDict(std::move(pDict)),
-      m_pDocument(pDoc) {
+      m_pDocument(pDoc),
+      m_pMemoryAccount(pDoc ? pdfium::WrapRetain(pDoc->GetMemoryAccount())
+                            : nullptr) {
   DCHECK(m_pDict);
 }
 
-CPDF_PageObjectHolder::~CPDF_PageObjectHolder() = default;
+CPDF_PageObjectHolder::~CPDF_PageObjectHolder() {
+  ReleasePageObjectBytes(m_nChargedBytes);
+}
 
 bool CPDF_PageObjectHolder::IsPage() const {
   return false;
@@ -64,6 +88,7 @@ void CPDF_PageObjectHolder::ContinueParse(PauseIndicatorIface* pPause) {
     return;
 
   DCHECK_EQ(m_ParseState, ParseState::kParsing);
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kParse);
   if (m_pParser->Continue(pPause))
     return;
 
@@ -136,9 +161,22 @@ CPDF_PageObject* CPDF_PageObjectHolder::GetPageObjectByIndex(
 
 void CPDF_PageObjectHolder::AppendPageObject(
     std::unique_ptr<CPDF_PageObject> pPageObj) {
+  if (m_pMemoryAccount) {
+    size_t size = EstimatePageObjectSize(pPageObj.get());
+    m_pMemoryAccount->Charge(CFX_MemoryAccount::Category::kPageObjects, size);
+    m_nChargedBytes += size;
+  }
   m_PageObjectList.push_back(std::move(pPageObj));
 }
 
+bool CPDF_PageObjectHolder::IsOverMemoryLimit() const {
+  return m_pMemoryAccount && m_pMemoryAccount->IsOverLimit();
+}
+
+size_t CPDF_PageObjectHolder::GetAvailableMemory() const {
+  return m_pMemoryAccount ? m_pMemoryAccount->GetAvailable() : SIZE_MAX;
+}
+
 std::unique_ptr<CPDF_PageObject> CPDF_PageObjectHolder::RemovePageObject(
     CPDF_PageObject* pPageObj) {
   auto it = std::find(std::begin(m_PageObjectList), std::end(m_PageObjectList),
@@ -148,6 +186,7 @@ std::unique_ptr<CPDF_PageObject> CPDF_PageObjectHolder::RemovePageObject(
 
   std::unique_ptr<CPDF_PageObject> result = std::move(*it);
   m_PageObjectList.erase(it);
+  ReleasePageObjectBytes(EstimatePageObjectSize(pPageObj));
 
   int32_t content_stream = pPageObj->GetContentStream();
   if (content_stream >= 0)
@@ -160,6 +199,17 @@ bool CPDF_PageObjectHolder::ErasePageObjectAtIndex(size_t index) {
   if (index >= m_PageObjectList.size())
     return false;
 
+  ReleasePageObjectBytes(
+      EstimatePageObjectSize(m_PageObjectList[index].get()));
   m_PageObjectList.erase(m_PageObjectList.begin() + index);
   return true;
 }
+
+void CPDF_PageObjectHolder::ReleasePageObjectBytes(size_t size) {
+  // Objects may have grown since they were charged, so never release more
+  // than what is outstanding.
+  size = std::min(size, m_nChargedBytes);
+  m_nChargedBytes -= size;
+  if (m_pMemoryAccount)
+    m_pMemoryAccount->Refund(CFX_MemoryAccount::Category::kPageObjects, size);
+}
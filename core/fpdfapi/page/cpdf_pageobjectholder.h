@@ -19,6 +19,7 @@
 
 #include "core/fpdfapi/page/cpdf_transparency.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fxcrt/cfx_memoryaccount.h"
 #include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
@@ -84,7 +85,12 @@ class CPDF_PageObjectHolder {
   }
   size_t GetPageObjectCount() const { return m_PageObjectList.size(); }
   CPDF_PageObject* GetPageObjectByIndex(size_t index) const;
+  // Charges `pPageObj` to the document's memory account, even when this takes
+  // the account past its limit. Use IsOverMemoryLimit() to stop creating more.
   void AppendPageObject(std::unique_ptr<CPDF_PageObject> pPageObj);
+  bool IsOverMemoryLimit() const;
+  // Returns SIZE_MAX when there is no memory limit.
+  size_t GetAvailableMemory() const;
 
   // Remove `pPageObj` if present, and transfer ownership to the caller.
   std::unique_ptr<CPDF_PageObject> RemovePageObject(CPDF_PageObject* pPageObj);
@@ -130,6 +136,8 @@ class CPDF_PageObjectHolder {
   CPDF_Transparency m_Transparency;
 
  private:
+  void ReleasePageObjectBytes(size_t size);
+
   bool m_bBackgroundAlphaNeeded = false;
   ParseState m_ParseState = ParseState::kNotParsed;
   RetainPtr<CPDF_Dictionary> const m_pDict;
@@ -137,6 +145,10 @@ class CPDF_PageObjectHolder {
   std::vector<CFX_FloatRect> m_MaskBoundingBoxes;
   std::unique_ptr<CPDF_ContentParser> m_pParser;
   std::deque<std::unique_ptr<CPDF_PageObject>> m_PageObjectList;
+  // Null for holders without a document. `m_nChargedBytes` is what this
+  // holder has charged to it for its page objects.
+  RetainPtr<CFX_MemoryAccount> const m_pMemoryAccount;
+  size_t m_nChargedBytes = 0;
   CFX_Matrix m_LastCTM;
 
   // The indexes of Content streams that are dirty and need to be regenerated.
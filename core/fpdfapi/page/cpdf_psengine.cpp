@@ -17,6 +17,7 @@
 #include "core/fxcrt/fx_string.h"
 #include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
+#include "third_party/base/numerics/safe_conversions.h"
 #include "third_party/base/notreached.h"
 
 namespace {
@@ -82,6 +83,157 @@ float RoundHalfUp(float f) {
   return floor(f + 0.5f);
 }
 
+bool IsUnaryOperator(PDF_PSOP op) {
+  switch (op) {
+    case PSOP_NEG:
+    case PSOP_ABS:
+    case PSOP_CEILING:
+    case PSOP_FLOOR:
+    case PSOP_ROUND:
+    case PSOP_TRUNCATE:
+    case PSOP_SQRT:
+    case PSOP_SIN:
+    case PSOP_COS:
+    case PSOP_LN:
+    case PSOP_LOG:
+    case PSOP_CVI:
+    case PSOP_NOT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsBinaryOperator(PDF_PSOP op) {
+  switch (op) {
+    case PSOP_ADD:
+    case PSOP_SUB:
+    case PSOP_MUL:
+    case PSOP_DIV:
+    case PSOP_IDIV:
+    case PSOP_MOD:
+    case PSOP_ATAN:
+    case PSOP_EXP:
+    case PSOP_EQ:
+    case PSOP_NE:
+    case PSOP_GT:
+    case PSOP_GE:
+    case PSOP_LT:
+    case PSOP_LE:
+    case PSOP_AND:
+    case PSOP_OR:
+    case PSOP_XOR:
+    case PSOP_BITSHIFT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+float DoUnaryOperator(PDF_PSOP op, float d1) {
+  switch (op) {
+    case PSOP_NEG:
+      return -d1;
+    case PSOP_ABS:
+      return fabs(d1);
+    case PSOP_CEILING:
+      return ceil(d1);
+    case PSOP_FLOOR:
+      return floor(d1);
+    case PSOP_ROUND:
+      return RoundHalfUp(d1);
+    case PSOP_TRUNCATE:
+    case PSOP_CVI:
+      return static_cast<int>(d1);
+    case PSOP_SQRT:
+      return sqrt(d1);
+    case PSOP_SIN:
+      return sin(d1 * FXSYS_PI / 180.0f);
+    case PSOP_COS:
+      return cos(d1 * FXSYS_PI / 180.0f);
+    case PSOP_LN:
+      return log(d1);
+    case PSOP_LOG:
+      return log10(d1);
+    case PSOP_NOT:
+      return !static_cast<int>(d1);
+    default:
+      NOTREACHED_NORETURN();
+  }
+}
+
+// `d2` is the operand that was on top of the stack.
+float DoBinaryOperator(PDF_PSOP op, float d1, float d2) {
+  switch (op) {
+    case PSOP_ADD:
+      return d1 + d2;
+    case PSOP_SUB:
+      return d1 - d2;
+    case PSOP_MUL:
+      return d1 * d2;
+    case PSOP_DIV:
+      return d2 ? d1 / d2 : 0;
+    case PSOP_ATAN:
+      d1 = atan2(d1, d2) * 180.0 / FXSYS_PI;
+      if (d1 < 0) {
+        d1 += 360;
+      }
+      return d1;
+    case PSOP_EXP:
+      return powf(d1, d2);
+    case PSOP_EQ:
+      return d1 == d2;
+    case PSOP_NE:
+      return d1 != d2;
+    case PSOP_GT:
+      return d1 > d2;
+    case PSOP_GE:
+      return d1 >= d2;
+    case PSOP_LT:
+      return d1 < d2;
+    case PSOP_LE:
+      return d1 <= d2;
+    default:
+      break;
+  }
+
+  const int i1 = static_cast<int>(d1);
+  const int i2 = static_cast<int>(d2);
+  FX_SAFE_INT32 result;
+  switch (op) {
+    case PSOP_IDIV:
+      if (!i2)
+        return 0;
+      result = i1;
+      result /= i2;
+      return result.ValueOrDefault(0);
+    case PSOP_MOD:
+      if (!i2)
+        return 0;
+      result = i1;
+      result %= i2;
+      return result.ValueOrDefault(0);
+    case PSOP_AND:
+      return i1 & i2;
+    case PSOP_OR:
+      return i1 | i2;
+    case PSOP_XOR:
+      return i1 ^ i2;
+    case PSOP_BITSHIFT:
+      result = i1;
+      if (i2 > 0) {
+        result <<= i2;
+      } else {
+        // Avoids unsafe negation of INT_MIN.
+        FX_SAFE_INT32 safe_shift = i2;
+        result >>= (-safe_shift).ValueOrDefault(0);
+      }
+      return result.ValueOrDefault(0);
+    default:
+      NOTREACHED_NORETURN();
+  }
+}
+
 }  // namespace
 
 CPDF_PSOP::CPDF_PSOP()
@@ -106,6 +258,11 @@ void CPDF_PSOP::Execute(CPDF_PSEngine* pEngine) {
   m_proc->Execute(pEngine);
 }
 
+void CPDF_PSOP::Compile(CPDF_PSProgram* pProgram) const {
+  CHECK_EQ(m_op, PSOP_PROC);
+  m_proc->Compile(pProgram, /*bMain=*/false);
+}
+
 float CPDF_PSOP::GetFloatValue() const {
   if (m_op == PSOP_CONST)
     return m_value;
@@ -114,6 +271,72 @@ float CPDF_PSOP::GetFloatValue() const {
 }
 
 bool CPDF_PSEngine::Execute() {
+  using Opcode = CPDF_PSProgram::Opcode;
+  const std::vector<CPDF_PSProgram::Instruction>& instructions =
+      m_Program.instructions();
+  size_t pc = 0;
+  while (pc < instructions.size()) {
+    const CPDF_PSProgram::Instruction& instruction = instructions[pc++];
+    switch (instruction.opcode) {
+      case Opcode::kPush:
+        Push(instruction.value);
+        break;
+      case Opcode::kOperator:
+        DoOperator(instruction.op);
+        break;
+      case Opcode::kUnaryOperator: {
+        float d1 = Pop();
+        Push(DoUnaryOperator(instruction.op, d1));
+        break;
+      }
+      case Opcode::kBinaryOperator: {
+        float d2 = Pop();
+        float d1 = Pop();
+        Push(DoBinaryOperator(instruction.op, d1, d2));
+        break;
+      }
+      case Opcode::kConstOperator:
+        if (m_StackCount < kPSEngineStackSize) {
+          float d1 = Pop();
+          Push(DoBinaryOperator(instruction.op, d1, instruction.value));
+        } else {
+          // The constant would not have fit on the stack.
+          DoOperator(instruction.op);
+        }
+        break;
+      case Opcode::kConstExchOperator:
+        if (m_StackCount < kPSEngineStackSize) {
+          float d2 = Pop();
+          Push(DoBinaryOperator(instruction.op, instruction.value, d2));
+        } else {
+          DoOperator(PSOP_EXCH);
+          DoOperator(instruction.op);
+        }
+        break;
+      case Opcode::kFoldedConst:
+        if (m_StackCount + instruction.operand_count <= kPSEngineStackSize) {
+          Push(instruction.value);
+        } else {
+          for (uint8_t i = 0; i < instruction.operand_count; ++i)
+            Push(instruction.operands[i]);
+          DoOperator(instruction.op);
+        }
+        break;
+      case Opcode::kJump:
+        pc = instruction.target;
+        break;
+      case Opcode::kJumpIfZero:
+        if (!PopInt())
+          pc = instruction.target;
+        break;
+      case Opcode::kFail:
+        return false;
+    }
+  }
+  return true;
+}
+
+bool CPDF_PSEngine::ExecuteProcForTesting() {
   return m_MainProc.Execute(this);
 }
 
@@ -175,6 +398,48 @@ bool CPDF_PSProc::Execute(CPDF_PSEngine* pEngine) {
   return true;
 }
 
+void CPDF_PSProc::Compile(CPDF_PSProgram* pProgram, bool bMain) const {
+  for (size_t i = 0; i < m_Operators.size(); ++i) {
+    const PDF_PSOP op = m_Operators[i]->GetOp();
+    if (op == PSOP_PROC)
+      continue;
+
+    if (op == PSOP_CONST) {
+      pProgram->EmitConst(m_Operators[i]->GetFloatValue());
+      continue;
+    }
+
+    if (op == PSOP_IF) {
+      if (i == 0 || m_Operators[i - 1]->GetOp() != PSOP_PROC) {
+        // Leaving out the rest of a nested procedure skips it.
+        if (bMain)
+          pProgram->EmitFail();
+        return;
+      }
+
+      size_t skip = pProgram->EmitJumpIfZero();
+      m_Operators[i - 1]->Compile(pProgram);
+      pProgram->SetJumpTarget(skip);
+    } else if (op == PSOP_IFELSE) {
+      if (i < 2 || m_Operators[i - 1]->GetOp() != PSOP_PROC ||
+          m_Operators[i - 2]->GetOp() != PSOP_PROC) {
+        if (bMain)
+          pProgram->EmitFail();
+        return;
+      }
+
+      size_t to_else = pProgram->EmitJumpIfZero();
+      m_Operators[i - 2]->Compile(pProgram);
+      size_t to_end = pProgram->EmitJump();
+      pProgram->SetJumpTarget(to_else);
+      m_Operators[i - 1]->Compile(pProgram);
+      pProgram->SetJumpTarget(to_end);
+    } else {
+      pProgram->EmitOperator(op);
+    }
+  }
+}
+
 void CPDF_PSProc::AddOperatorForTesting(ByteStringView word) {
   AddOperator(word);
 }
@@ -191,6 +456,118 @@ void CPDF_PSProc::AddOperator(ByteStringView word) {
     m_Operators.push_back(std::make_unique<CPDF_PSOP>(StringToFloat(word)));
 }
 
+CPDF_PSProgram::CPDF_PSProgram() = default;
+
+CPDF_PSProgram::~CPDF_PSProgram() = default;
+
+void CPDF_PSProgram::EmitConst(float value) {
+  size_t index = EmitInstruction(Opcode::kPush);
+  m_Instructions[index].value = value;
+}
+
+void CPDF_PSProgram::EmitOperator(PDF_PSOP op) {
+  switch (op) {
+    case PSOP_CVR:
+      return;
+    case PSOP_TRUE:
+      EmitConst(1);
+      return;
+    case PSOP_FALSE:
+      EmitConst(0);
+      return;
+    default:
+      break;
+  }
+
+  Instruction* last = GetFusableInstruction(1);
+  if (IsUnaryOperator(op) && last && last->opcode == Opcode::kPush) {
+    const float operand = last->value;
+    last->opcode = Opcode::kFoldedConst;
+    last->op = op;
+    last->operand_count = 1;
+    last->value = DoUnaryOperator(op, operand);
+    last->operands[0] = operand;
+    return;
+  }
+
+  if (IsUnaryOperator(op)) {
+    size_t index = EmitInstruction(Opcode::kUnaryOperator);
+    m_Instructions[index].op = op;
+    return;
+  }
+
+  if (!IsBinaryOperator(op)) {
+    size_t index = EmitInstruction(Opcode::kOperator);
+    m_Instructions[index].op = op;
+    return;
+  }
+
+  Instruction* second_last = GetFusableInstruction(2);
+  if (last && last->opcode == Opcode::kPush) {
+    if (second_last && second_last->opcode == Opcode::kPush) {
+      const float d1 = second_last->value;
+      const float d2 = last->value;
+      m_Instructions.pop_back();
+      second_last->opcode = Opcode::kFoldedConst;
+      second_last->op = op;
+      second_last->operand_count = 2;
+      second_last->value = DoBinaryOperator(op, d1, d2);
+      second_last->operands[0] = d1;
+      second_last->operands[1] = d2;
+      return;
+    }
+    last->opcode = Opcode::kConstOperator;
+    last->op = op;
+    return;
+  }
+
+  // Catches idioms like "1 exch sub".
+  if (last && last->opcode == Opcode::kOperator && last->op == PSOP_EXCH &&
+      second_last && second_last->opcode == Opcode::kPush) {
+    m_Instructions.pop_back();
+    second_last->opcode = Opcode::kConstExchOperator;
+    second_last->op = op;
+    return;
+  }
+
+  size_t index = EmitInstruction(Opcode::kBinaryOperator);
+  m_Instructions[index].op = op;
+}
+
+void CPDF_PSProgram::EmitFail() {
+  EmitInstruction(Opcode::kFail);
+}
+
+size_t CPDF_PSProgram::EmitJump() {
+  return EmitInstruction(Opcode::kJump);
+}
+
+size_t CPDF_PSProgram::EmitJumpIfZero() {
+  return EmitInstruction(Opcode::kJumpIfZero);
+}
+
+void CPDF_PSProgram::SetJumpTarget(size_t index) {
+  DCHECK(m_Instructions[index].opcode == Opcode::kJump ||
+         m_Instructions[index].opcode == Opcode::kJumpIfZero);
+  m_LastJumpTarget = m_Instructions.size();
+  m_Instructions[index].target = pdfium::base::checked_cast<uint32_t>(
+      m_LastJumpTarget);
+}
+
+CPDF_PSProgram::Instruction* CPDF_PSProgram::GetFusableInstruction(
+    size_t back) {
+  if (m_Instructions.size() < m_LastJumpTarget + back)
+    return nullptr;
+  return &m_Instructions[m_Instructions.size() - back];
+}
+
+size_t CPDF_PSProgram::EmitInstruction(Opcode opcode) {
+  Instruction instruction = {};
+  instruction.opcode = opcode;
+  m_Instructions.push_back(instruction);
+  return m_Instructions.size() - 1;
+}
+
 CPDF_PSEngine::CPDF_PSEngine() = default;
 
 CPDF_PSEngine::~CPDF_PSEngine() = default;
@@ -210,184 +587,30 @@ int CPDF_PSEngine::PopInt() {
 
 bool CPDF_PSEngine::Parse(pdfium::span<const uint8_t> input) {
   CPDF_SimpleParser parser(input);
-  return parser.GetWord() == "{" && m_MainProc.Parse(&parser, 0);
+  if (parser.GetWord() != "{" || !m_MainProc.Parse(&parser, 0))
+    return false;
+
+  m_Program = CPDF_PSProgram();
+  m_MainProc.Compile(&m_Program, /*bMain=*/true);
+  return true;
 }
 
 bool CPDF_PSEngine::DoOperator(PDF_PSOP op) {
-  int i1;
-  int i2;
+  if (IsUnaryOperator(op)) {
+    float d1 = Pop();
+    Push(DoUnaryOperator(op, d1));
+    return true;
+  }
+  if (IsBinaryOperator(op)) {
+    float d2 = Pop();
+    float d1 = Pop();
+    Push(DoBinaryOperator(op, d1, d2));
+    return true;
+  }
+
   float d1;
   float d2;
-  FX_SAFE_INT32 result;
   switch (op) {
-    case PSOP_ADD:
-      d1 = Pop();
-      d2 = Pop();
-      Push(d1 + d2);
-      break;
-    case PSOP_SUB:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d1 - d2);
-      break;
-    case PSOP_MUL:
-      d1 = Pop();
-      d2 = Pop();
-      Push(d1 * d2);
-      break;
-    case PSOP_DIV:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d2 ? d1 / d2 : 0);
-      break;
-    case PSOP_IDIV:
-      i2 = PopInt();
-      i1 = PopInt();
-      if (i2) {
-        result = i1;
-        result /= i2;
-        Push(result.ValueOrDefault(0));
-      } else {
-        Push(0);
-      }
-      break;
-    case PSOP_MOD:
-      i2 = PopInt();
-      i1 = PopInt();
-      if (i2) {
-        result = i1;
-        result %= i2;
-        Push(result.ValueOrDefault(0));
-      } else {
-        Push(0);
-      }
-      break;
-    case PSOP_NEG:
-      d1 = Pop();
-      Push(-d1);
-      break;
-    case PSOP_ABS:
-      d1 = Pop();
-      Push(fabs(d1));
-      break;
-    case PSOP_CEILING:
-      d1 = Pop();
-      Push(ceil(d1));
-      break;
-    case PSOP_FLOOR:
-      d1 = Pop();
-      Push(floor(d1));
-      break;
-    case PSOP_ROUND:
-      d1 = Pop();
-      Push(RoundHalfUp(d1));
-      break;
-    case PSOP_TRUNCATE:
-      i1 = PopInt();
-      Push(i1);
-      break;
-    case PSOP_SQRT:
-      d1 = Pop();
-      Push(sqrt(d1));
-      break;
-    case PSOP_SIN:
-      d1 = Pop();
-      Push(sin(d1 * FXSYS_PI / 180.0f));
-      break;
-    case PSOP_COS:
-      d1 = Pop();
-      Push(cos(d1 * FXSYS_PI / 180.0f));
-      break;
-    case PSOP_ATAN:
-      d2 = Pop();
-      d1 = Pop();
-      d1 = atan2(d1, d2) * 180.0 / FXSYS_PI;
-      if (d1 < 0) {
-        d1 += 360;
-      }
-      Push(d1);
-      break;
-    case PSOP_EXP:
-      d2 = Pop();
-      d1 = Pop();
-      Push(powf(d1, d2));
-      break;
-    case PSOP_LN:
-      d1 = Pop();
-      Push(log(d1));
-      break;
-    case PSOP_LOG:
-      d1 = Pop();
-      Push(log10(d1));
-      break;
-    case PSOP_CVI:
-      i1 = PopInt();
-      Push(i1);
-      break;
-    case PSOP_CVR:
-      break;
-    case PSOP_EQ:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d1 == d2);
-      break;
-    case PSOP_NE:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d1 != d2);
-      break;
-    case PSOP_GT:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d1 > d2);
-      break;
-    case PSOP_GE:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d1 >= d2);
-      break;
-    case PSOP_LT:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d1 < d2);
-      break;
-    case PSOP_LE:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d1 <= d2);
-      break;
-    case PSOP_AND:
-      i1 = PopInt();
-      i2 = PopInt();
-      Push(i1 & i2);
-      break;
-    case PSOP_OR:
-      i1 = PopInt();
-      i2 = PopInt();
-      Push(i1 | i2);
-      break;
-    case PSOP_XOR:
-      i1 = PopInt();
-      i2 = PopInt();
-      Push(i1 ^ i2);
-      break;
-    case PSOP_NOT:
-      i1 = PopInt();
-      Push(!i1);
-      break;
-    case PSOP_BITSHIFT: {
-      int shift = PopInt();
-      result = PopInt();
-      if (shift > 0) {
-        result <<= shift;
-      } else {
-        // Avoids unsafe negation of INT_MIN.
-        FX_SAFE_INT32 safe_shift = shift;
-        result >>= (-safe_shift).ValueOrDefault(0);
-      }
-      Push(result.ValueOrDefault(0));
-      break;
-    }
     case PSOP_TRUE:
       Push(1);
       break;
@@ -18,6 +18,7 @@
 
 class CPDF_PSEngine;
 class CPDF_PSProc;
+class CPDF_PSProgram;
 class CPDF_SimpleParser;
 
 enum PDF_PSOP : uint8_t {
@@ -76,6 +77,7 @@ class CPDF_PSOP {
 
   bool Parse(CPDF_SimpleParser* parser, int depth);
   void Execute(CPDF_PSEngine* pEngine);
+  void Compile(CPDF_PSProgram* pProgram) const;
   float GetFloatValue() const;
   PDF_PSOP GetOp() const { return m_op; }
 
@@ -93,6 +95,11 @@ class CPDF_PSProc {
   bool Parse(CPDF_SimpleParser* parser, int depth);
   bool Execute(CPDF_PSEngine* pEngine);
 
+  // Appends code to `pProgram` that behaves like Execute(). A misplaced "if"
+  // or "ifelse" stops the whole program if `bMain` is set, and only skips the
+  // rest of this procedure otherwise, as it does for Execute().
+  void Compile(CPDF_PSProgram* pProgram, bool bMain) const;
+
   // These methods are exposed for testing.
   void AddOperatorForTesting(ByteStringView word);
   size_t num_operators() const { return m_Operators.size(); }
@@ -108,6 +115,63 @@ class CPDF_PSProc {
   std::vector<std::unique_ptr<CPDF_PSOP>> m_Operators;
 };
 
+// Flat form of a CPDF_PSProc tree, which is what CPDF_PSEngine::Execute()
+// runs. Procedures are inlined at the "if" or "ifelse" that uses them, and
+// constant operands are folded into the operators that consume them. Every
+// folded instruction falls back to the original sequence when the operand
+// stack is too full for it, so results always match CPDF_PSProc::Execute().
+class CPDF_PSProgram {
+ public:
+  enum class Opcode : uint8_t {
+    kPush,               // Push `value`.
+    kOperator,           // Run `op`.
+    kUnaryOperator,      // Run `op`, known to take one operand.
+    kBinaryOperator,     // Run `op`, known to take two operands.
+    kConstOperator,      // `value` `op`, for binary operators.
+    kConstExchOperator,  // `value` exch `op`, for binary operators.
+    kFoldedConst,        // Push `value`, the result of `operands` `op`.
+    kJump,               // Continue at `target`.
+    kJumpIfZero,         // Pop an integer, and continue at `target` if 0.
+    kFail,               // Stop, as for a misplaced "if" or "ifelse".
+  };
+
+  struct Instruction {
+    Opcode opcode;
+    PDF_PSOP op;
+    uint8_t operand_count;
+    float value;
+    float operands[2];
+    uint32_t target;
+  };
+
+  CPDF_PSProgram();
+  ~CPDF_PSProgram();
+
+  void EmitConst(float value);
+  void EmitOperator(PDF_PSOP op);
+  void EmitFail();
+
+  // Return the index of the new jump, to be passed to SetJumpTarget().
+  size_t EmitJump();
+  size_t EmitJumpIfZero();
+
+  // Makes the jump at `index` continue at the next emitted instruction.
+  void SetJumpTarget(size_t index);
+
+  const std::vector<Instruction>& instructions() const {
+    return m_Instructions;
+  }
+
+ private:
+  // Returns the instruction `back` places before the end, if no jump lands
+  // after it, and nullptr otherwise.
+  Instruction* GetFusableInstruction(size_t back);
+  size_t EmitInstruction(Opcode opcode);
+
+  std::vector<Instruction> m_Instructions;
+  size_t m_LastJumpTarget = 0;
+};
+
 class CPDF_PSEngine {
  public:
   CPDF_PSEngine();
@@ -116,6 +180,13 @@ class CPDF_PSEngine {
   bool Parse(pdfium::span<const uint8_t> input);
   bool Execute();
   bool DoOperator(PDF_PSOP op);
+
+  // Runs the parsed procedure without the compiled program.
+  bool ExecuteProcForTesting();
+  size_t GetProgramSizeForTesting() const {
+    return m_Program.instructions().size();
+  }
+
   void Reset() { m_StackCount = 0; }
   void Push(float value);
   float Pop();
@@ -127,6 +198,7 @@ class CPDF_PSEngine {
 
   uint32_t m_StackCount = 0;
   CPDF_PSProc m_MainProc;
+  CPDF_PSProgram m_Program;
   float m_Stack[kPSEngineStackSize] = {};
 };
 
@@ -6,6 +6,9 @@
 
 #include <iterator>
 #include <limits>
+#include <vector>
+
+#include "core/fxcrt/bytestring.h"
 
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -38,6 +41,35 @@ float DoOperator2(CPDF_PSEngine* engine, float v1, float v2, PDF_PSOP op) {
   return ret;
 }
 
+std::vector<float> PopAll(CPDF_PSEngine* engine) {
+  std::vector<float> values;
+  while (engine->GetStackSize())
+    values.push_back(engine->Pop());
+  return values;
+}
+
+// Runs `program` both compiled and interpreted, and checks that the results
+// match exactly.
+void ExpectCompiledMatchesInterpreted(const char* program,
+                                     const std::vector<float>& inputs) {
+  SCOPED_TRACE(program);
+  CPDF_PSEngine engine;
+  ASSERT_TRUE(engine.Parse(ByteStringView(program).raw_span()));
+
+  for (float input : inputs)
+    engine.Push(input);
+  bool compiled_result = engine.Execute();
+  std::vector<float> compiled = PopAll(&engine);
+
+  for (float input : inputs)
+    engine.Push(input);
+  bool interpreted_result = engine.ExecuteProcForTesting();
+  std::vector<float> interpreted = PopAll(&engine);
+
+  EXPECT_EQ(interpreted_result, compiled_result);
+  EXPECT_EQ(interpreted, compiled);
+}
+
 }  // namespace
 
 TEST(CPDF_PSProc, AddOperator) {
@@ -281,3 +313,53 @@ TEST(CPDF_PSEngine, MathFunctions) {
   EXPECT_FLOAT_EQ(3.0f, DoOperator1(&engine, 1000.0f, PSOP_LOG));
   EXPECT_FLOAT_EQ(2.302585f, DoOperator1(&engine, 10.0f, PSOP_LN));
 }
+
+TEST(CPDF_PSEngine, CompiledProgram) {
+  CPDF_PSEngine engine;
+  const char kProgram[] = "{ 2 3 add 1 exch sub }";
+  ASSERT_TRUE(engine.Parse(ByteStringView(kProgram).raw_span()));
+  EXPECT_EQ(2u, engine.GetProgramSizeForTesting());
+  engine.Push(4);
+  EXPECT_TRUE(engine.Execute());
+  ASSERT_EQ(2u, engine.GetStackSize());
+  EXPECT_FLOAT_EQ(-4.0f, engine.Pop());
+  EXPECT_FLOAT_EQ(4.0f, engine.Pop());
+
+  const char* const kPrograms[] = {
+      "{ 2 3 add 1 exch sub }",
+      "{ dup 0.5 gt { 2 mul } { 1 exch sub } ifelse }",
+      "{ 1 { 2 } if add 3 cvr mul }",
+      "{ 0.25 sub abs 4 neg mul 10 3 idiv exch 7 atan true { cvi } if }",
+      "{ dup dup 0.3 mul exch 0.59 mul add exch 0.11 mul add 5 4 3 roll }",
+      "{ 1 if 2 }",
+      "{ { 1 } if 2 }",
+      "{ 1 { 3 if 4 } { 5 } ifelse 6 }",
+      "{ 1 { 3 } { 4 } { 5 } ifelse ifelse }",
+      "{ { 1 { 2 { 3 exch sub } if } if } if 8 2 bitshift }",
+  };
+  const std::vector<float> kInputs[] = {{}, {0}, {1}, {0.75f}, {-2.5f, 1}};
+  for (const char* program : kPrograms) {
+    for (const std::vector<float>& inputs : kInputs)
+      ExpectCompiledMatchesInterpreted(program, inputs);
+  }
+}
+
+TEST(CPDF_PSEngine, CompiledProgramFullStack) {
+  // Folded constants must behave like the original operators when they do
+  // not fit on the stack.
+  const char* const kEndings[] = {
+      "1 2 add", "5 sub", "1 exch sub", "4 neg", "{ 2 } if 3 mul",
+  };
+  for (const char* ending : kEndings) {
+    for (int count = 96; count <= 100; ++count) {
+      ByteString program = "{";
+      for (int i = 0; i < count; ++i)
+        program += ByteString::Format(" %d", i);
+      program += " ";
+      program += ending;
+      program += " }";
+      ExpectCompiledMatchesInterpreted(program.c_str(), {});
+      ExpectCompiledMatchesInterpreted(program.c_str(), {7});
+    }
+  }
+}
@@ -24,6 +24,7 @@
 #include "core/fpdfapi/parser/cpdf_string.h"
 #include "core/fpdfapi/parser/fpdf_parser_decode.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
+#include "core/fxcodec/flate/flatemodule.h"
 #include "core/fxcodec/jpeg/jpegmodule.h"
 #include "core/fxcodec/scanlinedecoder.h"
 #include "core/fxcrt/data_vector.h"
@@ -90,10 +91,12 @@ uint32_t DecodeInlineStream(pdfium::span<const uint8_t> src_span,
   uint32_t ignored_size;
   if (decoder == "FlateDecode") {
     return FlateOrLZWDecode(false, src_span, pParam.Get(), orig_size,
-                            &ignored_result, &ignored_size);
+                            FlateModule::kNoMaxSize, &ignored_result,
+                            &ignored_size);
   }
   if (decoder == "LZWDecode") {
-    return FlateOrLZWDecode(true, src_span, pParam.Get(), 0, &ignored_result,
+    return FlateOrLZWDecode(true, src_span, pParam.Get(), 0,
+                            FlateModule::kNoMaxSize, &ignored_result,
                             &ignored_size);
   }
   if (decoder == "DCTDecode") {
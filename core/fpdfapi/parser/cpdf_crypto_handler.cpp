@@ -156,6 +156,17 @@ bool CPDF_CryptoHandler::DecryptStream(void* context,
   uint32_t src_off = 0;
   uint32_t src_left = source.size();
   while (true) {
+    if (!pContext->m_bIV && pContext->m_BlockOffset == 0 && src_left > 16) {
+      // Decrypt whole blocks in place in `dest_buf`, leaving the final block
+      // buffered as its padding can only be removed in DecryptFinish().
+      uint32_t bulk_size = (src_left - 1) / 16 * 16;
+      size_t old_size = dest_buf.GetSize();
+      dest_buf.AppendSpan(source.subspan(src_off, bulk_size));
+      uint8_t* bulk = dest_buf.GetMutableSpan().subspan(old_size).data();
+      CRYPT_AESDecrypt(&pContext->m_Context, bulk, bulk, bulk_size);
+      src_off += bulk_size;
+      src_left -= bulk_size;
+    }
     uint32_t copy_size = 16 - pContext->m_BlockOffset;
     if (copy_size > src_left) {
       copy_size = src_left;
@@ -0,0 +1,106 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_decodedstreamcache.h"
+
+#include <sstream>
+#include <utility>
+
+#include "constants/stream_dict_common.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_stream_acc.h"
+#include "core/fpdfapi/parser/fpdf_parser_utility.h"
+#include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/fx_string_wrappers.h"
+#include "third_party/base/check.h"
+#include "third_party/base/numerics/safe_conversions.h"
+
+namespace {
+
+ByteString GetFilters(const CPDF_Stream* pStream) {
+  RetainPtr<const CPDF_Dictionary> pDict = pStream->GetDict();
+  if (!pDict)
+    return ByteString();
+
+  fxcrt::ostringstream buf;
+  buf << pDict->GetDirectObjectFor(pdfium::stream::kFilter).Get()
+      << pDict->GetDirectObjectFor(pdfium::stream::kDecodeParms).Get();
+  return ByteString(buf);
+}
+
+}  // namespace
+
+CPDF_DecodedStreamCache::Entry::Entry(RetainPtr<CPDF_StreamAcc> pAcc,
+                                      uint32_t generation,
+                                      ByteString filters)
+    : pAcc(std::move(pAcc)),
+      generation(generation),
+      filters(std::move(filters)) {}
+
+CPDF_DecodedStreamCache::Entry::Entry(Entry&&) noexcept = default;
+
+CPDF_DecodedStreamCache::Entry& CPDF_DecodedStreamCache::Entry::operator=(
+    Entry&&) noexcept = default;
+
+CPDF_DecodedStreamCache::Entry::~Entry() = default;
+
+CPDF_DecodedStreamCache::CPDF_DecodedStreamCache()
+    : m_Cache(CFX_MemoryAccount::Category::kDecodedStreams,
+              kDefaultByteBudget) {}
+
+CPDF_DecodedStreamCache::~CPDF_DecodedStreamCache() = default;
+
+RetainPtr<CPDF_StreamAcc> CPDF_DecodedStreamCache::GetStreamAcc(
+    RetainPtr<const CPDF_Stream> pStream) {
+  DCHECK(pStream);
+  ByteString filters = GetFilters(pStream.Get());
+  Entry* pEntry = m_Cache.Find(pStream);
+  if (pEntry) {
+    if (pEntry->generation == pStream->GetGeneration() &&
+        pEntry->filters == filters) {
+      return pEntry->pAcc;
+    }
+    m_Cache.Remove(pStream);
+  }
+
+  auto pAcc = pdfium::MakeRetain<CPDF_StreamAcc>(pStream);
+  if (CFX_MemoryAccount* pAccount = m_Cache.GetMemoryAccount()) {
+    // Evicting everything cached here is the most that can be made room for.
+    FX_SAFE_SIZE_T headroom = pAccount->GetAvailable();
+    headroom += m_Cache.GetCachedBytes();
+    pAcc->LoadAllDataFilteredWithMaxSize(
+        pdfium::base::saturated_cast<uint32_t>(
+            headroom.ValueOrDefault(SIZE_MAX)));
+  } else {
+    pAcc->LoadAllDataFiltered();
+  }
+
+  // Unfiltered in-memory streams are accessed in place, so there is nothing
+  // to save by caching them. Streams that did not fit may fit later, once
+  // memory has been freed.
+  if ((pStream->IsMemoryBased() && !pStream->HasFilter()) ||
+      pAcc->IsOverMaxSize()) {
+    return pAcc;
+  }
+
+  const size_t cost = pAcc->GetSize();
+  const uint32_t generation = pStream->GetGeneration();
+  m_Cache.Add(std::move(pStream),
+              Entry(pAcc, generation, std::move(filters)), cost);
+  return pAcc;
+}
+
+void CPDF_DecodedStreamCache::SetByteBudget(size_t budget) {
+  m_Cache.SetByteBudget(budget);
+}
+
+void CPDF_DecodedStreamCache::Clear() {
+  m_Cache.Clear();
+}
+
+void CPDF_DecodedStreamCache::SetMemoryAccount(
+    RetainPtr<CFX_MemoryAccount> pAccount) {
+  m_Cache.SetMemoryAccount(std::move(pAccount));
+}
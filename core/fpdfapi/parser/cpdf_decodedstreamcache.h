@@ -0,0 +1,79 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_CPDF_DECODEDSTREAMCACHE_H_
+#define CORE_FPDFAPI_PARSER_CPDF_DECODEDSTREAMCACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/cfx_memoryaccount.h"
+#include "core/fxcrt/lru_byte_cache.h"
+#include "core/fxcrt/retain_ptr.h"
+
+class CPDF_Stream;
+class CPDF_StreamAcc;
+
+// Document-wide cache of filtered stream data for resources that are shared
+// between pages, e.g. form XObjects, soft masks, ICC profiles and mesh
+// shadings. Once the decoded size exceeds the byte budget, the least recently
+// used entries are dropped. Dropping an entry only releases the cache's
+// reference, so callers still holding the CPDF_StreamAcc are unaffected.
+// Unfiltered in-memory streams are read in place, so they are never cached.
+//
+// When a memory account is set, cached bytes are charged to it, and entries
+// that would push the account past its limit are not cached.
+class CPDF_DecodedStreamCache {
+ public:
+  static constexpr size_t kDefaultByteBudget = 64 * 1024 * 1024;
+
+  CPDF_DecodedStreamCache();
+  ~CPDF_DecodedStreamCache();
+
+  // Returns a CPDF_StreamAcc for `pStream` with LoadAllDataFiltered() already
+  // called on it. The returned accessor is shared, so callers must not call
+  // DetachData() on it. With a memory account set, streams that would not fit
+  // within its limit are left undecoded.
+  RetainPtr<CPDF_StreamAcc> GetStreamAcc(RetainPtr<const CPDF_Stream> pStream);
+
+  // Sets the budget and immediately evicts entries that no longer fit.
+  void SetByteBudget(size_t budget);
+  size_t GetByteBudget() const { return m_Cache.GetByteBudget(); }
+
+  // Total decoded bytes currently owned by cached entries.
+  size_t GetCachedBytes() const { return m_Cache.GetCachedBytes(); }
+  size_t GetEntryCount() const { return m_Cache.GetEntryCount(); }
+
+  void Clear();
+
+  void SetMemoryAccount(RetainPtr<CFX_MemoryAccount> pAccount);
+  CFX_MemoryAccount* GetMemoryAccount() const {
+    return m_Cache.GetMemoryAccount();
+  }
+
+ private:
+  struct Entry {
+    Entry(RetainPtr<CPDF_StreamAcc> pAcc,
+          uint32_t generation,
+          ByteString filters);
+    Entry(Entry&&) noexcept;
+    Entry& operator=(Entry&&) noexcept;
+    ~Entry();
+
+    RetainPtr<CPDF_StreamAcc> pAcc;
+    // CPDF_Stream::GetGeneration() when the stream was decoded.
+    uint32_t generation;
+    // The stream's /Filter and /DecodeParms when it was decoded. These are
+    // edited in place on the dictionary, which does not change the
+    // generation.
+    ByteString filters;
+  };
+
+  LruByteCache<RetainPtr<const CPDF_Stream>, Entry, std::less<>> m_Cache;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_CPDF_DECODEDSTREAMCACHE_H_
@@ -0,0 +1,189 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_decodedstreamcache.h"
+
+#include <utility>
+
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_stream_acc.h"
+#include "core/fxcrt/data_vector.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Returns a stream whose ASCIIHex-encoded data decodes to 4 bytes.
+RetainPtr<CPDF_Stream> MakeHexStream() {
+  static constexpr char kHex[] = "41424344>";
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Name>("Filter", "ASCIIHexDecode");
+  return pdfium::MakeRetain<CPDF_Stream>(
+      DataVector<uint8_t>(std::begin(kHex), std::end(kHex) - 1),
+      std::move(dict));
+}
+
+}  // namespace
+
+TEST(CPDFDecodedStreamCacheTest, ReusesDecodedData) {
+  CPDF_DecodedStreamCache cache;
+  RetainPtr<CPDF_Stream> stream = MakeHexStream();
+
+  RetainPtr<CPDF_StreamAcc> acc1 = cache.GetStreamAcc(stream);
+  ASSERT_TRUE(acc1);
+  EXPECT_EQ(4u, acc1->GetSize());
+  EXPECT_EQ(1u, cache.GetEntryCount());
+  EXPECT_EQ(4u, cache.GetCachedBytes());
+
+  RetainPtr<CPDF_StreamAcc> acc2 = cache.GetStreamAcc(stream);
+  EXPECT_EQ(acc1, acc2);
+  EXPECT_EQ(1u, cache.GetEntryCount());
+  EXPECT_EQ(4u, cache.GetCachedBytes());
+}
+
+TEST(CPDFDecodedStreamCacheTest, UnfilteredStreamsAreNotCached) {
+  static constexpr uint8_t kData[] = {'a', 'b', 'c'};
+  auto stream = pdfium::MakeRetain<CPDF_Stream>();
+  stream->SetData(kData);
+
+  CPDF_DecodedStreamCache cache;
+  RetainPtr<CPDF_StreamAcc> acc = cache.GetStreamAcc(stream);
+  EXPECT_EQ(pdfium::make_span(kData), acc->GetSpan());
+  EXPECT_EQ(0u, cache.GetEntryCount());
+  EXPECT_EQ(0u, cache.GetCachedBytes());
+}
+
+TEST(CPDFDecodedStreamCacheTest, EvictsLeastRecentlyUsed) {
+  CPDF_DecodedStreamCache cache;
+  cache.SetByteBudget(8);
+
+  RetainPtr<CPDF_Stream> stream1 = MakeHexStream();
+  RetainPtr<CPDF_Stream> stream2 = MakeHexStream();
+  RetainPtr<CPDF_Stream> stream3 = MakeHexStream();
+  RetainPtr<CPDF_StreamAcc> acc1 = cache.GetStreamAcc(stream1);
+  cache.GetStreamAcc(stream2);
+  EXPECT_EQ(8u, cache.GetCachedBytes());
+
+  // Touch `stream1` so `stream2` becomes the eviction candidate.
+  EXPECT_EQ(acc1, cache.GetStreamAcc(stream1));
+  cache.GetStreamAcc(stream3);
+  EXPECT_EQ(2u, cache.GetEntryCount());
+  EXPECT_EQ(8u, cache.GetCachedBytes());
+  EXPECT_EQ(acc1, cache.GetStreamAcc(stream1));
+
+  cache.SetByteBudget(0);
+  EXPECT_EQ(0u, cache.GetEntryCount());
+  EXPECT_EQ(0u, cache.GetCachedBytes());
+
+  // Evicted accessors remain usable by their holders.
+  EXPECT_EQ(4u, acc1->GetSize());
+}
+
+TEST(CPDFDecodedStreamCacheTest, OversizedStreamsAreNotCached) {
+  CPDF_DecodedStreamCache cache;
+  cache.SetByteBudget(3);
+
+  RetainPtr<CPDF_StreamAcc> acc = cache.GetStreamAcc(MakeHexStream());
+  EXPECT_EQ(4u, acc->GetSize());
+  EXPECT_EQ(0u, cache.GetEntryCount());
+  EXPECT_EQ(0u, cache.GetCachedBytes());
+}
+
+TEST(CPDFDecodedStreamCacheTest, ModifiedStreamIsDecodedAgain) {
+  CPDF_DecodedStreamCache cache;
+  RetainPtr<CPDF_Stream> stream = MakeHexStream();
+  RetainPtr<CPDF_StreamAcc> acc1 = cache.GetStreamAcc(stream);
+  EXPECT_EQ(4u, cache.GetCachedBytes());
+
+  static constexpr uint8_t kNewData[] = {'x', 'y'};
+  stream->SetDataAndRemoveFilter(kNewData);
+  RetainPtr<CPDF_StreamAcc> acc2 = cache.GetStreamAcc(stream);
+  EXPECT_NE(acc1, acc2);
+  EXPECT_EQ(pdfium::make_span(kNewData), acc2->GetSpan());
+  EXPECT_EQ(0u, cache.GetEntryCount());
+  EXPECT_EQ(0u, cache.GetCachedBytes());
+}
+
+TEST(CPDFDecodedStreamCacheTest, SameSizeReplacementIsDecodedAgain) {
+  CPDF_DecodedStreamCache cache;
+  RetainPtr<CPDF_Stream> stream = MakeHexStream();
+  RetainPtr<CPDF_StreamAcc> acc1 = cache.GetStreamAcc(stream);
+  EXPECT_EQ('A', acc1->GetSpan()[0]);
+
+  // The new data has the same size, and may reuse the old allocation.
+  static constexpr char kNewHex[] = "45464748>";
+  stream->SetData(pdfium::as_bytes(pdfium::make_span(kNewHex, 9)));
+  RetainPtr<CPDF_StreamAcc> acc2 = cache.GetStreamAcc(stream);
+  EXPECT_NE(acc1, acc2);
+  EXPECT_EQ('E', acc2->GetSpan()[0]);
+  EXPECT_EQ(1u, cache.GetEntryCount());
+  EXPECT_EQ(4u, cache.GetCachedBytes());
+}
+
+TEST(CPDFDecodedStreamCacheTest, FilterEditIsDecodedAgain) {
+  CPDF_DecodedStreamCache cache;
+  RetainPtr<CPDF_Stream> stream = MakeHexStream();
+  RetainPtr<CPDF_StreamAcc> acc1 = cache.GetStreamAcc(stream);
+  EXPECT_EQ(4u, acc1->GetSize());
+
+  // Only the dictionary changes, so the data keeps its generation.
+  stream->GetMutableDict()->RemoveFor("Filter");
+  RetainPtr<CPDF_StreamAcc> acc2 = cache.GetStreamAcc(stream);
+  EXPECT_NE(acc1, acc2);
+  EXPECT_EQ(9u, acc2->GetSize());
+  EXPECT_EQ(0u, cache.GetEntryCount());
+  EXPECT_EQ(0u, cache.GetCachedBytes());
+}
+
+TEST(CPDFDecodedStreamCacheTest, ChargesMemoryAccount) {
+  auto account = pdfium::MakeRetain<CFX_MemoryAccount>();
+  RetainPtr<CPDF_Stream> stream1 = MakeHexStream();
+  RetainPtr<CPDF_Stream> stream2 = MakeHexStream();
+  {
+    CPDF_DecodedStreamCache cache;
+    cache.SetMemoryAccount(account);
+    cache.GetStreamAcc(stream1);
+    EXPECT_EQ(4u, account->GetUsage(
+                      CFX_MemoryAccount::Category::kDecodedStreams));
+
+    // When the account is full, older entries make room for new ones.
+    account->SetLimit(6);
+    RetainPtr<CPDF_StreamAcc> acc = cache.GetStreamAcc(stream2);
+    EXPECT_EQ(4u, acc->GetSize());
+    EXPECT_EQ(1u, cache.GetEntryCount());
+    EXPECT_EQ(4u, account->GetTotalUsage());
+
+    // Entries that can never fit are handed out uncached.
+    account->SetLimit(3);
+    acc = cache.GetStreamAcc(stream1);
+    EXPECT_EQ(4u, acc->GetSize());
+    EXPECT_EQ(0u, cache.GetEntryCount());
+    EXPECT_EQ(0u, account->GetTotalUsage());
+
+    account->SetLimit(0);
+    cache.GetStreamAcc(stream1);
+    EXPECT_EQ(4u, account->GetTotalUsage());
+  }
+  EXPECT_EQ(0u, account->GetTotalUsage());
+}
+
+TEST(CPDFDecodedStreamCacheTest, StreamsOverTheLimitAreNotCached) {
+  auto account = pdfium::MakeRetain<CFX_MemoryAccount>();
+  account->SetLimit(3);
+  CPDF_DecodedStreamCache cache;
+  cache.SetMemoryAccount(account);
+  RetainPtr<CPDF_Stream> stream = MakeHexStream();
+  RetainPtr<CPDF_StreamAcc> acc = cache.GetStreamAcc(stream);
+  EXPECT_TRUE(acc->IsOverMaxSize());
+  EXPECT_TRUE(acc->GetSpan().empty());
+  EXPECT_EQ(0u, cache.GetEntryCount());
+
+  // The stream gets decoded once it fits.
+  account->SetLimit(0);
+  acc = cache.GetStreamAcc(stream);
+  EXPECT_FALSE(acc->IsOverMaxSize());
+  EXPECT_EQ(4u, acc->GetSize());
+  EXPECT_EQ(1u, cache.GetEntryCount());
+}
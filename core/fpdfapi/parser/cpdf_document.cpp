@@ -6,6 +6,7 @@
 
 #include "core/fpdfapi/parser/cpdf_document.h"
 
+#include <limits>
 #include <utility>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
@@ -13,6 +14,7 @@
 #include "core/fpdfapi/parser/cpdf_linearized_header.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_object_walker.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
 #include "core/fpdfapi/parser/cpdf_read_validator.h"
 #include "core/fpdfapi/parser/cpdf_reference.h"
@@ -21,6 +23,7 @@
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fxcodec/jbig2/JBig2_DocumentContext.h"
 #include "core/fxcrt/fx_codepage.h"
+#include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/scoped_set_insertion.h"
 #include "core/fxcrt/stl_util.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
@@ -31,6 +34,30 @@ namespace {
 
 const int kMaxPageLevel = 1024;
 
+// Rough per-object overhead of a parsed object, including its allocator slot
+// and the container entry that refers to it.
+constexpr size_t kParsedObjectOverhead = 64;
+
+// Estimates the memory held by `pObj` and everything it directly contains.
+// Indirect references are not followed, as their targets are charged when they
+// are parsed themselves.
+size_t EstimateParsedObjectSize(RetainPtr<const CPDF_Object> pObj) {
+  FX_SAFE_SIZE_T size = 0;
+  CPDF_ObjectWalker walker(std::move(pObj));
+  while (RetainPtr<const CPDF_Object> pSub = walker.GetNext()) {
+    size += kParsedObjectOverhead;
+    size += walker.dictionary_key().GetLength();
+    if (pSub->IsString() || pSub->IsName()) {
+      size += pSub->GetString().GetLength();
+    } else if (const CPDF_Stream* pStream = pSub->AsStream()) {
+      // File-based streams are read on demand, so only in-memory data counts.
+      if (pStream->IsMemoryBased())
+        size += pStream->GetRawSize();
+    }
+  }
+  return size.ValueOrDefault(std::numeric_limits<size_t>::max());
+}
+
 // Returns a value in the range [0, `CPDF_Document::kPageMaxNum`), or nullopt on
 // error.
 absl::optional<int> CountPages(
@@ -125,7 +152,8 @@ int FindPageIndex(const CPDF_Dictionary* pNode,
 
 CPDF_Document::CPDF_Document(std::unique_ptr<RenderDataIface> pRenderData,
                              std::unique_ptr<PageDataIface> pPageData)
-    : m_pDocRender(std::move(pRenderData)),
+    : m_pMemoryAccount(pdfium::MakeRetain<CFX_MemoryAccount>()),
+      m_pDocRender(std::move(pRenderData)),
       m_pDocPage(std::move(pPageData)),
       m_StockFontClearer(m_pDocPage.get()) {
   m_pDocRender->SetDocument(this);
@@ -138,6 +166,11 @@ CPDF_Document::~CPDF_Document() {
   // seems to already do this for us, but the C++ standards seem to
   // indicate the opposite.
   m_pExtension.reset();
+
+  for (const auto& charge : m_ParsedObjectCharges) {
+    m_pMemoryAccount->Refund(CFX_MemoryAccount::Category::kParser,
+                             charge.second);
+  }
 }
 
 // static
@@ -147,7 +180,39 @@ bool CPDF_Document::IsValidPageObject(const CPDF_Object* obj) {
 }
 
 RetainPtr<CPDF_Object> CPDF_Document::ParseIndirectObject(uint32_t objnum) {
-  return m_pParser ? m_pParser->ParseIndirectObject(objnum) : nullptr;
+  if (!m_pParser)
+    return nullptr;
+
+  auto refused_it = m_RefusedObjectSizes.find(objnum);
+  if (refused_it != m_RefusedObjectSizes.end()) {
+    if (!m_pMemoryAccount->CanCharge(refused_it->second))
+      return nullptr;
+    m_RefusedObjectSizes.erase(refused_it);
+  }
+
+  RetainPtr<CPDF_Object> pObj = m_pParser->ParseIndirectObject(objnum);
+  if (!pObj)
+    return nullptr;
+
+  // Treat objects that do not fit within the memory limit as unparsable, so
+  // callers take their existing error paths.
+  size_t size = EstimateParsedObjectSize(pObj);
+  if (!m_pMemoryAccount->TryCharge(CFX_MemoryAccount::Category::kParser,
+                                   size)) {
+    m_RefusedObjectSizes[objnum] = size;
+    return nullptr;
+  }
+  m_ParsedObjectCharges[objnum] += size;
+  return pObj;
+}
+
+void CPDF_Document::OnIndirectObjectReleased(uint32_t objnum) {
+  auto it = m_ParsedObjectCharges.find(objnum);
+  if (it == m_ParsedObjectCharges.end())
+    return;
+
+  m_pMemoryAccount->Refund(CFX_MemoryAccount::Category::kParser, it->second);
+  m_ParsedObjectCharges.erase(it);
 }
 
 bool CPDF_Document::TryInit() {
@@ -419,6 +484,11 @@ void CPDF_Document::MaybePurgeImage(uint32_t objnum) {
     m_pDocPage->MaybePurgeImage(objnum);
 }
 
+RetainPtr<CPDF_StreamAcc> CPDF_Document::GetDecodedStreamAcc(
+    RetainPtr<const CPDF_Stream> pStream) {
+  return m_pDocPage->GetDecodedStreamAcc(std::move(pStream));
+}
+
 void CPDF_Document::CreateNewDoc() {
   DCHECK(!m_pRootDict);
   DCHECK(!m_pInfoDict);
@@ -7,6 +7,7 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_DOCUMENT_H_
 #define CORE_FPDFAPI_PARSER_CPDF_DOCUMENT_H_
 
+#include <map>
 #include <memory>
 #include <set>
 #include <utility>
@@ -14,6 +15,7 @@
 
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fxcrt/cfx_memoryaccount.h"
 #include "core/fxcrt/fx_memory.h"
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
@@ -56,6 +58,8 @@ class CPDF_Document : public Observable,
     virtual void MaybePurgeFontFileStreamAcc(
         RetainPtr<CPDF_StreamAcc>&& pStreamAcc) = 0;
     virtual void MaybePurgeImage(uint32_t objnum) = 0;
+    virtual RetainPtr<CPDF_StreamAcc> GetDecodedStreamAcc(
+        RetainPtr<const CPDF_Stream> pStream) = 0;
 
     void SetDocument(CPDF_Document* pDoc) { m_pDoc = pDoc; }
 
@@ -112,6 +116,14 @@ class CPDF_Document : public Observable,
       RetainPtr<const CPDF_Stream> pFontStream);
   void MaybePurgeFontFileStreamAcc(RetainPtr<CPDF_StreamAcc>&& pStreamAcc);
   void MaybePurgeImage(uint32_t objnum);
+  RetainPtr<CPDF_StreamAcc> GetDecodedStreamAcc(
+      RetainPtr<const CPDF_Stream> pStream);
+
+  // Memory attributed to this document. Objects that may outlive the document
+  // should retain the account rather than holding on to the document.
+  CFX_MemoryAccount* GetMemoryAccount() const {
+    return m_pMemoryAccount.Get();
+  }
 
   // Returns a valid pointer, unless it is called during destruction.
   PageDataIface* GetPageData() const { return m_pDocPage.get(); }
@@ -134,6 +146,7 @@ class CPDF_Document : public Observable,
   // CPDF_Parser::ParsedObjectsHolder:
   bool TryInit() override;
   RetainPtr<CPDF_Object> ParseIndirectObject(uint32_t objnum) override;
+  void OnIndirectObjectReleased(uint32_t objnum) override;
 
   CPDF_Parser::Error LoadDoc(RetainPtr<IFX_SeekableReadStream> pFileAccess,
                              const ByteString& password);
@@ -189,6 +202,14 @@ class CPDF_Document : public Observable,
   void ResetTraversal();
   CPDF_Parser::Error HandleLoadResult(CPDF_Parser::Error error);
 
+  // Must be before anything that charges to it.
+  RetainPtr<CFX_MemoryAccount> const m_pMemoryAccount;
+  // Bytes charged to the kParser category for each parsed object, refunded
+  // when the object is released.
+  std::map<uint32_t, size_t> m_ParsedObjectCharges;
+  // Estimated sizes of objects that did not fit within the memory limit, so
+  // they are only parsed again once that much memory is available.
+  std::map<uint32_t, size_t> m_RefusedObjectSizes;
   std::unique_ptr<CPDF_Parser> m_pParser;
   RetainPtr<CPDF_Dictionary> m_pRootDict;
   RetainPtr<CPDF_Dictionary> m_pInfoDict;
@@ -104,6 +104,8 @@ bool CPDF_IndirectObjectHolder::ReplaceIndirectObjectIfHigherGeneration(
   if (old_object && pObj->GetGenNum() <= old_object->GetGenNum())
     return false;
 
+  if (obj_holder)
+    OnIndirectObjectReleased(objnum);
   pObj->SetObjNum(objnum);
   obj_holder = std::move(pObj);
   m_LastObjNum = std::max(m_LastObjNum, objnum);
@@ -116,4 +118,5 @@ void CPDF_IndirectObjectHolder::DeleteIndirectObject(uint32_t objnum) {
     return;
 
   m_IndirectObjs.erase(it);
+  OnIndirectObjectReleased(objnum);
 }
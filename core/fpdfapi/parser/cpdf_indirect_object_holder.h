@@ -75,6 +75,10 @@ class CPDF_IndirectObjectHolder {
  protected:
   virtual RetainPtr<CPDF_Object> ParseIndirectObject(uint32_t objnum);
 
+  // Called when the holder stops holding the object at `objnum`, either
+  // because it was deleted or because a newer object replaced it.
+  virtual void OnIndirectObjectReleased(uint32_t objnum) {}
+
  private:
   friend class CPDF_Reference;
 
@@ -28,6 +28,7 @@
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fxcrt/autorestorer.h"
+#include "core/fxcrt/cfx_tracelog.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_safe_types.h"
@@ -236,6 +237,7 @@ bool CPDF_Parser::ParseFileVersion() {
 CPDF_Parser::Error CPDF_Parser::StartParse(
     RetainPtr<IFX_SeekableReadStream> pFileAccess,
     const ByteString& password) {
+  FX_TRACE_EVENT("pdfium.parser", "CPDF_Parser::StartParse");
   if (!InitSyntaxParser(pdfium::MakeRetain<CPDF_ReadValidator>(
           std::move(pFileAccess), nullptr)))
     return FORMAT_ERROR;
@@ -1064,6 +1066,7 @@ std::unique_ptr<CPDF_LinearizedHeader> CPDF_Parser::ParseLinearizedHeader() {
 CPDF_Parser::Error CPDF_Parser::StartLinearizedParse(
     RetainPtr<CPDF_ReadValidator> validator,
     const ByteString& password) {
+  FX_TRACE_EVENT("pdfium.parser", "CPDF_Parser::StartLinearizedParse");
   DCHECK(!m_bHasParsed);
   DCHECK(!m_bXRefTableRebuilt);
   SetPassword(password);
@@ -75,6 +75,7 @@ void CPDF_Stream::InitStreamFromFile(RetainPtr<IFX_SeekableReadStream> pFile,
                                      RetainPtr<CPDF_Dictionary> pDict) {
   data_ = pFile;
   dict_ = std::move(pDict);
+  ++generation_;
   SetLengthInDict(pdfium::base::checked_cast<int>(pFile->GetSize()));
 }
 
@@ -125,6 +126,7 @@ void CPDF_Stream::SetData(pdfium::span<const uint8_t> pData) {
 void CPDF_Stream::TakeData(DataVector<uint8_t> data) {
   const size_t size = data.size();
   data_ = std::move(data);
+  ++generation_;
   SetLengthInDict(pdfium::base::checked_cast<int>(size));
 }
 
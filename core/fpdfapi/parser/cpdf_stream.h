@@ -69,6 +69,11 @@ class CPDF_Stream final : public CPDF_Object {
   }
   bool HasFilter() const;
 
+  // Changes whenever the stream's data is replaced, so decoded copies of the
+  // data can tell that they are stale. Edits to the dictionary, including its
+  // /Filter, do not change it.
+  uint32_t GetGeneration() const { return generation_; }
+
  private:
   friend class CPDF_Dictionary;
 
@@ -93,6 +98,7 @@ class CPDF_Stream final : public CPDF_Object {
                 DataVector<uint8_t>>
       data_;
   RetainPtr<CPDF_Dictionary> dict_;
+  uint32_t generation_ = 0;
 };
 
 inline CPDF_Stream* ToStream(CPDF_Object* obj) {
@@ -12,6 +12,7 @@
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/fpdf_parser_decode.h"
+#include "core/fxcodec/flate/flatemodule.h"
 #include "core/fxcrt/data_vector.h"
 #include "third_party/base/check_op.h"
 
@@ -22,6 +23,7 @@ CPDF_StreamAcc::~CPDF_StreamAcc() = default;
 
 void CPDF_StreamAcc::LoadAllData(bool bRawAccess,
                                  uint32_t estimated_size,
+                                 uint32_t max_size,
                                  bool bImageAcc) {
   if (bRawAccess) {
     DCHECK(!estimated_size);
@@ -35,24 +37,28 @@ void CPDF_StreamAcc::LoadAllData(bool bRawAccess,
   if (bProcessRawData)
     ProcessRawData();
   else
-    ProcessFilteredData(estimated_size, bImageAcc);
+    ProcessFilteredData(estimated_size, max_size, bImageAcc);
 }
 
 void CPDF_StreamAcc::LoadAllDataFiltered() {
-  LoadAllData(false, 0, false);
+  LoadAllData(false, 0, FlateModule::kNoMaxSize, false);
 }
 
 void CPDF_StreamAcc::LoadAllDataFilteredWithEstimatedSize(
     uint32_t estimated_size) {
-  LoadAllData(false, estimated_size, false);
+  LoadAllData(false, estimated_size, FlateModule::kNoMaxSize, false);
+}
+
+void CPDF_StreamAcc::LoadAllDataFilteredWithMaxSize(uint32_t max_size) {
+  LoadAllData(false, 0, max_size, false);
 }
 
 void CPDF_StreamAcc::LoadAllDataImageAcc(uint32_t estimated_size) {
-  LoadAllData(false, estimated_size, true);
+  LoadAllData(false, estimated_size, FlateModule::kNoMaxSize, true);
 }
 
 void CPDF_StreamAcc::LoadAllDataRaw() {
-  LoadAllData(true, 0, false);
+  LoadAllData(true, 0, FlateModule::kNoMaxSize, false);
 }
 
 RetainPtr<const CPDF_Stream> CPDF_StreamAcc::GetStream() const {
@@ -119,6 +125,7 @@ void CPDF_StreamAcc::ProcessRawData() {
 }
 
 void CPDF_StreamAcc::ProcessFilteredData(uint32_t estimated_size,
+                                         uint32_t max_size,
                                          bool bImageAcc) {
   if (m_pStream->IsUninitialized())
     return;
@@ -147,9 +154,17 @@ void CPDF_StreamAcc::ProcessFilteredData(uint32_t estimated_size,
   absl::optional<DecoderArray> decoder_array =
       GetDecoderArray(m_pStream->GetDict());
   if (!decoder_array.has_value() || decoder_array.value().empty() ||
-      !PDF_DataDecode(src_span, estimated_size, bImageAcc,
+      !PDF_DataDecode(src_span, estimated_size, max_size, bImageAcc,
                       decoder_array.value(), &pDecodedData, &dwDecodedSize,
                       &m_ImageDecoder, &m_pImageParam)) {
+    // Handing out the raw data would make callers treat still encoded data
+    // as decoded.
+    if (max_size != FlateModule::kNoMaxSize && decoder_array.has_value() &&
+        !decoder_array.value().empty()) {
+      m_bOverMaxSize = true;
+      m_Data = DataVector<uint8_t>();
+      return;
+    }
     m_Data = std::move(src_data);
     return;
   }
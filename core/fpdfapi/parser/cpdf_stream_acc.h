@@ -29,6 +29,11 @@ class CPDF_StreamAcc final : public Retainable {
 
   void LoadAllDataFiltered();
   void LoadAllDataFilteredWithEstimatedSize(uint32_t estimated_size);
+  // Leaves the accessor empty, rather than falling back to the raw data, if
+  // the decoded data would be larger than `max_size` bytes. The decoders do
+  // not tell that apart from other decoding failures, so those leave it empty
+  // as well. IsOverMaxSize() tells when either happened.
+  void LoadAllDataFilteredWithMaxSize(uint32_t max_size);
   void LoadAllDataImageAcc(uint32_t estimated_size);
   void LoadAllDataRaw();
 
@@ -41,6 +46,7 @@ class CPDF_StreamAcc final : public Retainable {
   ByteString ComputeDigest() const;
   ByteString GetImageDecoder() const { return m_ImageDecoder; }
   DataVector<uint8_t> DetachData();
+  bool IsOverMaxSize() const { return m_bOverMaxSize; }
 
   int GetLength1ForTest() const;
 
@@ -48,9 +54,14 @@ class CPDF_StreamAcc final : public Retainable {
   explicit CPDF_StreamAcc(RetainPtr<const CPDF_Stream> pStream);
   ~CPDF_StreamAcc() override;
 
-  void LoadAllData(bool bRawAccess, uint32_t estimated_size, bool bImageAcc);
+  void LoadAllData(bool bRawAccess,
+                   uint32_t estimated_size,
+                   uint32_t max_size,
+                   bool bImageAcc);
   void ProcessRawData();
-  void ProcessFilteredData(uint32_t estimated_size, bool bImageAcc);
+  void ProcessFilteredData(uint32_t estimated_size,
+                           uint32_t max_size,
+                           bool bImageAcc);
 
   // Returns the raw data from `m_pStream`, or no data on failure.
   DataVector<uint8_t> ReadRawStream() const;
@@ -64,6 +75,7 @@ class CPDF_StreamAcc final : public Retainable {
   // Needs to outlive `m_Data` when the data is not owned.
   RetainPtr<const CPDF_Stream> const m_pStream;
   absl::variant<pdfium::span<const uint8_t>, DataVector<uint8_t>> m_Data;
+  bool m_bOverMaxSize = false;
 };
 
 #endif  // CORE_FPDFAPI_PARSER_CPDF_STREAM_ACC_H_
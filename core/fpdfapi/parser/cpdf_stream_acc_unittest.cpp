@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fxcrt/fx_stream.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -33,3 +34,22 @@ TEST(StreamAccTest, DataStreamLifeTime) {
   stream.Reset();
   EXPECT_EQ(pdfium::make_span(kData), stream_acc->GetSpan());
 }
+
+TEST(StreamAccTest, LoadOverMaxSize) {
+  // Decodes to 4 bytes.
+  static constexpr uint8_t kHex[] = {'4', '1', '4', '2', '4', '3', '4', '4'};
+  auto stream = pdfium::MakeRetain<CPDF_Stream>();
+  stream->SetData(kHex);
+  stream->GetMutableDict()->SetNewFor<CPDF_Name>("Filter", "ASCIIHexDecode");
+
+  auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(stream);
+  stream_acc->LoadAllDataFilteredWithMaxSize(4);
+  EXPECT_FALSE(stream_acc->IsOverMaxSize());
+  EXPECT_EQ(4u, stream_acc->GetSize());
+
+  // The still encoded data is not handed out in place of the decoded data.
+  stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(stream);
+  stream_acc->LoadAllDataFilteredWithMaxSize(3);
+  EXPECT_TRUE(stream_acc->IsOverMaxSize());
+  EXPECT_TRUE(stream_acc->GetSpan().empty());
+}
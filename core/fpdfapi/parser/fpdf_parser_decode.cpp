@@ -344,6 +344,7 @@ uint32_t FlateOrLZWDecode(bool bLZW,
                           pdfium::span<const uint8_t> src_span,
                           const CPDF_Dictionary* pParams,
                           uint32_t estimated_size,
+                          uint32_t max_size,
                           std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
                           uint32_t* dest_size) {
   int predictor = 0;
@@ -362,7 +363,8 @@ uint32_t FlateOrLZWDecode(bool bLZW,
   }
   return FlateModule::FlateOrLZWDecode(bLZW, src_span, bEarlyChange, predictor,
                                        Colors, BitsPerComponent, Columns,
-                                       estimated_size, dest_buf, dest_size);
+                                       estimated_size, max_size, dest_buf,
+                                       dest_size);
 }
 
 absl::optional<DecoderArray> GetDecoderArray(
@@ -399,6 +401,7 @@ absl::optional<DecoderArray> GetDecoderArray(
 
 bool PDF_DataDecode(pdfium::span<const uint8_t> src_span,
                     uint32_t last_estimated_size,
+                    uint32_t max_size,
                     bool bImageAcc,
                     const DecoderArray& decoder_array,
                     std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
@@ -429,10 +432,10 @@ bool PDF_DataDecode(pdfium::span<const uint8_t> src_span,
         return true;
       }
       offset = FlateOrLZWDecode(false, last_span, pParam, estimated_size,
-                                &new_buf, &new_size);
+                                max_size, &new_buf, &new_size);
     } else if (decoder == "LZWDecode" || decoder == "LZW") {
       offset = FlateOrLZWDecode(true, last_span, pParam, estimated_size,
-                                &new_buf, &new_size);
+                                max_size, &new_buf, &new_size);
     } else if (decoder == "ASCII85Decode" || decoder == "A85") {
       offset = A85Decode(last_span, &new_buf, &new_size);
     } else if (decoder == "ASCIIHexDecode" || decoder == "AHx") {
@@ -458,7 +461,9 @@ bool PDF_DataDecode(pdfium::span<const uint8_t> src_span,
       *dest_size = last_span.size();
       return true;
     }
-    if (offset == FX_INVALID_OFFSET)
+    // Flate and LZW stop at `max_size`. The other filters only grow their
+    // input by a bounded factor, so they are checked afterwards.
+    if (offset == FX_INVALID_OFFSET || new_size > max_size)
       return false;
 
     last_span = {new_buf.get(), new_size};
@@ -604,5 +609,6 @@ uint32_t FlateDecode(pdfium::span<const uint8_t> src_span,
                      std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
                      uint32_t* dest_size) {
   return FlateModule::FlateOrLZWDecode(false, src_span, false, 0, 0, 0, 0, 0,
-                                       dest_buf, dest_size);
+                                       FlateModule::kNoMaxSize, dest_buf,
+                                       dest_size);
 }
@@ -74,6 +74,7 @@ uint32_t FlateOrLZWDecode(bool bLZW,
                           pdfium::span<const uint8_t> src_span,
                           const CPDF_Dictionary* pParams,
                           uint32_t estimated_size,
+                          uint32_t max_size,
                           std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
                           uint32_t* dest_size);
 
@@ -87,8 +88,10 @@ using DecoderArray =
 absl::optional<DecoderArray> GetDecoderArray(
     RetainPtr<const CPDF_Dictionary> pDict);
 
+// Fails if the output of any filter would be larger than `max_size` bytes.
 bool PDF_DataDecode(pdfium::span<const uint8_t> src_span,
                     uint32_t estimated_size,
+                    uint32_t max_size,
                     bool bImageAcc,
                     const DecoderArray& decoder_array,
                     std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
@@ -12,6 +12,7 @@
 #include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_reference.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
+#include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_memory_wrappers.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/test_support.h"
@@ -314,6 +315,25 @@ TEST(FPDFParserDecodeEmbedderTest, FlateDecode) {
   }
 }
 
+TEST(ParserDecodeTest, FlateOrLZWDecodeWithMaxSize) {
+  DataVector<uint8_t> input(100000, 'a');
+  DataVector<uint8_t> encoded = FlateEncode(input);
+
+  std::unique_ptr<uint8_t, FxFreeDeleter> buf;
+  uint32_t buf_size = 0;
+  EXPECT_EQ(encoded.size(),
+            FlateOrLZWDecode(false, encoded, nullptr, 0, input.size(), &buf,
+                             &buf_size));
+  ASSERT_TRUE(buf);
+  EXPECT_EQ(input.size(), buf_size);
+
+  EXPECT_EQ(FX_INVALID_OFFSET,
+            FlateOrLZWDecode(false, encoded, nullptr, 0, input.size() - 1,
+                             &buf, &buf_size));
+  EXPECT_EQ(FX_INVALID_OFFSET, FlateOrLZWDecode(false, encoded, nullptr, 0, 10,
+                                                &buf, &buf_size));
+}
+
 TEST(ParserDecodeTest, FlateEncode) {
   static const pdfium::StrFuncTestData flate_encode_cases[] = {
       STR_IN_OUT_CASE("", "\x78\x9c\x03\x00\x00\x00\x00\x01"),
@@ -0,0 +1,86 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_bitmappool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "core/fxcrt/span_util.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/base/check_op.h"
+
+CPDF_BitmapPool::CPDF_BitmapPool() = default;
+
+CPDF_BitmapPool::~CPDF_BitmapPool() = default;
+
+RetainPtr<CFX_DIBitmap> CPDF_BitmapPool::Acquire(int width,
+                                                 int height,
+                                                 FXDIB_Format format,
+                                                 bool bZero) {
+  absl::optional<CFX_DIBitmap::PitchAndSize> pitch_size =
+      CFX_DIBitmap::CalculatePitchAndSize(width, height, format, /*pitch=*/0);
+  if (!pitch_size.has_value())
+    return nullptr;
+
+  const size_t size = pitch_size.value().size;
+  Entry* pBest = nullptr;
+  for (Entry& entry : m_Entries) {
+    if (!entry.pBitmap->HasOneRef() || entry.pBitmap->GetFormat() != format ||
+        entry.capacity < size || entry.capacity / 2 > size) {
+      continue;
+    }
+    if (!pBest || entry.capacity < pBest->capacity)
+      pBest = &entry;
+  }
+  if (pBest) {
+    if (!pBest->pBitmap->Reuse(width, height, format))
+      return nullptr;
+    if (bZero)
+      fxcrt::spanclr(pBest->pBitmap->GetBuffer());
+    return pBest->pBitmap;
+  }
+
+  const bool bPooled = size <= m_ByteBudget;
+  if (bPooled)
+    ShrinkToFit(m_ByteBudget - size);
+
+  // Fresh buffers are always zeroed.
+  auto pBitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  if (!pBitmap->Create(width, height, format))
+    return nullptr;
+
+  if (bPooled && m_PooledBytes + size <= m_ByteBudget) {
+    m_PooledBytes += size;
+    m_Entries.push_back({pBitmap, size});
+  }
+  return pBitmap;
+}
+
+void CPDF_BitmapPool::SetByteBudget(size_t budget) {
+  m_ByteBudget = budget;
+  ShrinkToFit(m_ByteBudget);
+}
+
+void CPDF_BitmapPool::ShrinkToFit(size_t budget) {
+  if (m_PooledBytes <= budget)
+    return;
+
+  std::stable_sort(m_Entries.begin(), m_Entries.end(),
+                   [](const Entry& a, const Entry& b) {
+                     return a.capacity > b.capacity;
+                   });
+  std::vector<Entry> kept;
+  kept.reserve(m_Entries.size());
+  for (Entry& entry : m_Entries) {
+    if (m_PooledBytes > budget && entry.pBitmap->HasOneRef()) {
+      DCHECK_GE(m_PooledBytes, entry.capacity);
+      m_PooledBytes -= entry.capacity;
+      continue;
+    }
+    kept.push_back(std::move(entry));
+  }
+  m_Entries = std::move(kept);
+}
@@ -0,0 +1,60 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_RENDER_CPDF_BITMAPPOOL_H_
+#define CORE_FPDFAPI_RENDER_CPDF_BITMAPPOOL_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/dib/fx_dib.h"
+
+class CFX_DIBitmap;
+
+// Recycles the scratch bitmaps that rendering needs for transparency groups,
+// backdrops and device buffers, which are often as big as the whole page.
+// A bitmap goes back to the pool once the pool holds the only reference to
+// it, and its buffer then gets reused for any later request of the same
+// format that fits into it without wasting more than half of it.
+class CPDF_BitmapPool {
+ public:
+  static constexpr size_t kDefaultByteBudget = 64 * 1024 * 1024;
+
+  CPDF_BitmapPool();
+  ~CPDF_BitmapPool();
+
+  // Returns a `width` x `height` bitmap in `format`, or nullptr on failure.
+  // The contents are zero if `bZero` is set, and unspecified otherwise.
+  // Requests that do not fit into the byte budget get bitmaps that the pool
+  // does not keep.
+  RetainPtr<CFX_DIBitmap> Acquire(int width,
+                                  int height,
+                                  FXDIB_Format format,
+                                  bool bZero);
+
+  // Sets the budget and immediately drops unused bitmaps that no longer fit.
+  void SetByteBudget(size_t budget);
+  size_t GetByteBudget() const { return m_ByteBudget; }
+
+  size_t GetPooledBytes() const { return m_PooledBytes; }
+  size_t GetEntryCount() const { return m_Entries.size(); }
+
+ private:
+  struct Entry {
+    RetainPtr<CFX_DIBitmap> pBitmap;
+    size_t capacity;
+  };
+
+  // Drops unused bitmaps, largest first, until the pool holds at most
+  // `budget` bytes.
+  void ShrinkToFit(size_t budget);
+
+  std::vector<Entry> m_Entries;
+  size_t m_ByteBudget = kDefaultByteBudget;
+  size_t m_PooledBytes = 0;
+};
+
+#endif  // CORE_FPDFAPI_RENDER_CPDF_BITMAPPOOL_H_
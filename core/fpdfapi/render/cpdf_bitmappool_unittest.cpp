@@ -0,0 +1,85 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_bitmappool.h"
+
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(CPDFBitmapPoolTest, ReusesReleasedBitmaps) {
+  CPDF_BitmapPool pool;
+  RetainPtr<CFX_DIBitmap> bitmap =
+      pool.Acquire(10, 10, FXDIB_Format::kArgb, /*bZero=*/true);
+  ASSERT_TRUE(bitmap);
+  EXPECT_EQ(1u, pool.GetEntryCount());
+  EXPECT_EQ(400u, pool.GetPooledBytes());
+  const CFX_DIBitmap* first = bitmap.Get();
+
+  // Still in use, so a second request needs another bitmap.
+  RetainPtr<CFX_DIBitmap> other =
+      pool.Acquire(10, 10, FXDIB_Format::kArgb, /*bZero=*/true);
+  ASSERT_TRUE(other);
+  EXPECT_NE(first, other.Get());
+  EXPECT_EQ(2u, pool.GetEntryCount());
+
+  bitmap->Clear(0xff123456);
+  bitmap.Reset();
+  other.Reset();
+
+  // A slightly smaller request reuses the first bitmap, and clears it.
+  bitmap = pool.Acquire(8, 9, FXDIB_Format::kArgb, /*bZero=*/true);
+  ASSERT_TRUE(bitmap);
+  EXPECT_EQ(first, bitmap.Get());
+  EXPECT_EQ(8, bitmap->GetWidth());
+  EXPECT_EQ(9, bitmap->GetHeight());
+  for (uint8_t value : bitmap->GetBuffer())
+    EXPECT_EQ(0, value);
+  EXPECT_EQ(2u, pool.GetEntryCount());
+}
+
+TEST(CPDFBitmapPoolTest, MatchesFormatAndSize) {
+  CPDF_BitmapPool pool;
+  const CFX_DIBitmap* argb =
+      pool.Acquire(10, 10, FXDIB_Format::kArgb, /*bZero=*/false).Get();
+
+  // Different formats and much smaller sizes do not reuse the bitmap.
+  EXPECT_NE(argb,
+            pool.Acquire(20, 20, FXDIB_Format::k8bppMask, /*bZero=*/false)
+                .Get());
+  EXPECT_NE(argb,
+            pool.Acquire(2, 2, FXDIB_Format::kArgb, /*bZero=*/false).Get());
+  EXPECT_EQ(3u, pool.GetEntryCount());
+  EXPECT_EQ(argb,
+            pool.Acquire(10, 5, FXDIB_Format::kArgb, /*bZero=*/false).Get());
+}
+
+TEST(CPDFBitmapPoolTest, ByteBudget) {
+  CPDF_BitmapPool pool;
+  pool.SetByteBudget(800);
+
+  RetainPtr<CFX_DIBitmap> bitmap1 =
+      pool.Acquire(10, 10, FXDIB_Format::kArgb, /*bZero=*/false);
+  RetainPtr<CFX_DIBitmap> bitmap2 =
+      pool.Acquire(10, 10, FXDIB_Format::kArgb, /*bZero=*/false);
+  EXPECT_EQ(800u, pool.GetPooledBytes());
+
+  // No room for another pooled bitmap while both are in use.
+  RetainPtr<CFX_DIBitmap> bitmap3 =
+      pool.Acquire(5, 5, FXDIB_Format::kArgb, /*bZero=*/false);
+  ASSERT_TRUE(bitmap3);
+  EXPECT_EQ(2u, pool.GetEntryCount());
+
+  // Unused bitmaps make room for new ones.
+  bitmap1.Reset();
+  bitmap3 = pool.Acquire(5, 5, FXDIB_Format::kArgb, /*bZero=*/false);
+  ASSERT_TRUE(bitmap3);
+  EXPECT_EQ(2u, pool.GetEntryCount());
+  EXPECT_EQ(500u, pool.GetPooledBytes());
+
+  bitmap2.Reset();
+  bitmap3.Reset();
+  pool.SetByteBudget(0);
+  EXPECT_EQ(0u, pool.GetEntryCount());
+  EXPECT_EQ(0u, pool.GetPooledBytes());
+}
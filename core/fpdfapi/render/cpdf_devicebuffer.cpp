@@ -9,6 +9,7 @@
 #include "build/build_config.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/render/cpdf_bitmappool.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
@@ -58,7 +59,6 @@ CPDF_DeviceBuffer::CPDF_DeviceBuffer(CPDF_RenderContext* pContext,
     : m_pDevice(pDevice),
       m_pContext(pContext),
       m_pObject(pObj),
-      m_pBitmap(pdfium::MakeRetain<CFX_DIBitmap>()),
       m_Rect(rect),
       m_Matrix(CalculateMatrix(pDevice, rect, max_dpi, kScaleDeviceBuffer)) {}
 
@@ -67,8 +67,10 @@ CPDF_DeviceBuffer::~CPDF_DeviceBuffer() = default;
 bool CPDF_DeviceBuffer::Initialize() {
   FX_RECT bitmap_rect =
       m_Matrix.TransformRect(CFX_FloatRect(m_Rect)).GetOuterRect();
-  return m_pBitmap->Create(bitmap_rect.Width(), bitmap_rect.Height(),
-                           FXDIB_Format::kArgb);
+  m_pBitmap = m_pContext->GetBitmapPool()->Acquire(
+      bitmap_rect.Width(), bitmap_rect.Height(), FXDIB_Format::kArgb,
+      /*bZero=*/true);
+  return !!m_pBitmap;
 }
 
 void CPDF_DeviceBuffer::OutputToDevice() {
@@ -81,9 +83,12 @@ void CPDF_DeviceBuffer::OutputToDevice() {
     }
     return;
   }
-  auto pBuffer = pdfium::MakeRetain<CFX_DIBitmap>();
-  m_pDevice->CreateCompatibleBitmap(pBuffer, m_pBitmap->GetWidth(),
-                                    m_pBitmap->GetHeight());
+  // GetBackground() fills the whole buffer.
+  RetainPtr<CFX_DIBitmap> pBuffer = m_pContext->GetBitmapPool()->Acquire(
+      m_pBitmap->GetWidth(), m_pBitmap->GetHeight(),
+      m_pDevice->GetCompatibleBitmapFormat(), /*bZero=*/false);
+  if (!pBuffer)
+    return;
   m_pContext->GetBackground(pBuffer, m_pObject, nullptr, m_Matrix);
   pBuffer->CompositeBitmap(0, 0, pBuffer->GetWidth(), pBuffer->GetHeight(),
                            m_pBitmap, 0, 0, BlendMode::kNormal, nullptr, false);
@@ -39,7 +39,7 @@ class CPDF_DeviceBuffer {
   UnownedPtr<CFX_RenderDevice> const m_pDevice;
   UnownedPtr<CPDF_RenderContext> const m_pContext;
   UnownedPtr<const CPDF_PageObject> const m_pObject;
-  RetainPtr<CFX_DIBitmap> const m_pBitmap;
+  RetainPtr<CFX_DIBitmap> m_pBitmap;
   const FX_RECT m_Rect;
   const CFX_Matrix m_Matrix;
 };
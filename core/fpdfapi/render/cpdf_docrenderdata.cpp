@@ -67,6 +67,16 @@ RetainPtr<CPDF_TransferFunc> CPDF_DocRenderData::GetTransferFunc(
   return pFunc;
 }
 
+CPDF_RenderedBitmapCache* CPDF_DocRenderData::GetRenderedBitmapCache() {
+  // The document is not known yet when `m_RenderedBitmapCache` is
+  // constructed.
+  if (!m_RenderedBitmapCache.GetMemoryAccount() && GetDocument()) {
+    m_RenderedBitmapCache.SetMemoryAccount(
+        pdfium::WrapRetain(GetDocument()->GetMemoryAccount()));
+  }
+  return &m_RenderedBitmapCache;
+}
+
 #if BUILDFLAG(IS_WIN)
 CFX_PSFontTracker* CPDF_DocRenderData::GetPSFontTracker() {
   if (!m_PSFontTracker)
@@ -12,6 +12,7 @@
 
 #include "build/build_config.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/render/cpdf_renderedbitmapcache.h"
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
 
@@ -47,18 +48,26 @@ class CPDF_DocRenderData : public CPDF_Document::RenderDataIface {
   CFX_PSFontTracker* GetPSFontTracker();
 #endif
 
+  CPDF_RenderedBitmapCache* GetRenderedBitmapCache();
+
+  // Whether newly loaded pages start decoding their images in the background.
+  void SetPrefetchImages(bool prefetch) { m_bPrefetchImages = prefetch; }
+  bool ShouldPrefetchImages() const { return m_bPrefetchImages; }
+
  protected:
   // protected for use by test subclasses.
   RetainPtr<CPDF_TransferFunc> CreateTransferFunc(
       RetainPtr<const CPDF_Object> pObj) const;
 
  private:
+  bool m_bPrefetchImages = false;
   // TODO(tsepez): investigate this map outliving its font keys.
   std::map<CPDF_Font*, ObservedPtr<CPDF_Type3Cache>> m_Type3FaceMap;
   std::map<RetainPtr<const CPDF_Object>,
            ObservedPtr<CPDF_TransferFunc>,
            std::less<>>
       m_TransferFuncMap;
+  CPDF_RenderedBitmapCache m_RenderedBitmapCache;
 
 #if BUILDFLAG(IS_WIN)
   std::unique_ptr<CFX_PSFontTracker> m_PSFontTracker;
@@ -89,16 +89,26 @@ CPDF_ImageRenderer::CPDF_ImageRenderer(CPDF_RenderStatus* pStatus)
 CPDF_ImageRenderer::~CPDF_ImageRenderer() = default;
 
 bool CPDF_ImageRenderer::StartLoadDIBBase() {
-  if (!GetUnitRect().has_value())
+  absl::optional<FX_RECT> image_rect = GetUnitRect();
+  if (!image_rect.has_value())
     return false;
 
-  if (!m_pLoader->Start(
-          m_pImageObject, m_pRenderStatus->GetContext()->GetPageCache(),
-          m_pRenderStatus->GetFormResource(),
-          m_pRenderStatus->GetPageResource(), m_bStdCS,
-          m_pRenderStatus->GetGroupFamily(), m_pRenderStatus->GetLoadMask(),
-          {m_pRenderStatus->GetRenderDevice()->GetWidth(),
-           m_pRenderStatus->GetRenderDevice()->GetHeight()})) {
+  CFX_Size max_size_required = {
+      m_pRenderStatus->GetRenderDevice()->GetWidth(),
+      m_pRenderStatus->GetRenderDevice()->GetHeight()};
+  if (GetRenderOptions().GetOptions().bDraft) {
+    // Drafts make do with half the resolution the image covers on the device,
+    // which lets JPX decoding skip resolution levels. The page image cache
+    // decodes such images again when a later render needs more detail.
+    max_size_required = {std::max(1, image_rect.value().Width() / 2),
+                         std::max(1, image_rect.value().Height() / 2)};
+  }
+  if (!m_pLoader->Start(m_pImageObject,
+                        m_pRenderStatus->GetContext()->GetPageCache(),
+                        m_pRenderStatus->GetFormResource(),
+                        m_pRenderStatus->GetPageResource(), m_bStdCS,
+                        m_pRenderStatus->GetGroupFamily(),
+                        m_pRenderStatus->GetLoadMask(), max_size_required)) {
     return false;
   }
   m_Mode = Mode::kDefault;
@@ -10,6 +10,7 @@
 #include "core/fpdfapi/render/cpdf_progressiverenderer.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
+#include "core/fxcrt/cfx_renderprofile.h"
 #include "core/fxge/cfx_renderdevice.h"
 
 CPDF_PageRenderContext::CPDF_PageRenderContext() = default;
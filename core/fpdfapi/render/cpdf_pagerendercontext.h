@@ -7,11 +7,14 @@
 #ifndef CORE_FPDFAPI_RENDER_CPDF_PAGERENDERCONTEXT_H_
 #define CORE_FPDFAPI_RENDER_CPDF_PAGERENDERCONTEXT_H_
 
+#include <chrono>
 #include <memory>
 
 #include "core/fpdfapi/page/cpdf_page.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 class CFX_RenderDevice;
+class CFX_RenderProfile;
 class CPDF_ProgressiveRenderer;
 class CPDF_RenderContext;
 class CPDF_RenderOptions;
@@ -29,11 +32,15 @@ class CPDF_PageRenderContext final : public CPDF_Page::RenderContextIface {
   ~CPDF_PageRenderContext() override;
 
   // Specific destruction order required.
+  std::unique_ptr<CFX_RenderProfile> m_pProfile;
   std::unique_ptr<AnnotListIface> m_pAnnots;
   std::unique_ptr<CPDF_RenderOptions> m_pOptions;
   std::unique_ptr<CFX_RenderDevice> m_pDevice;
   std::unique_ptr<CPDF_RenderContext> m_pContext;
   std::unique_ptr<CPDF_ProgressiveRenderer> m_pRenderer;
+
+  // The time after which a progressive rendering gets cancelled, if any.
+  absl::optional<std::chrono::steady_clock::time_point> m_Deadline;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_PAGERENDERCONTEXT_H_
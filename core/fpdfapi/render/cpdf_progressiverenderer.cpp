@@ -13,6 +13,7 @@
 #include "core/fpdfapi/page/cpdf_pageobjectholder.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfapi/render/cpdf_renderstatus.h"
+#include "core/fxcrt/cfx_renderprofile.h"
 #include "core/fxcrt/pauseindicator_iface.h"
 #include "core/fxge/cfx_renderdevice.h"
 
@@ -39,6 +40,24 @@ void CPDF_ProgressiveRenderer::Start(PauseIndicatorIface* pPause) {
 }
 
 void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
+  if (m_Status != kToBeContinued)
+    return;
+
+  CFX_RenderProfile::ScopedCurrent profile(m_pContext->GetProfile());
+
+  // Let operations that cannot pause poll `pPause` for cancellation while
+  // rendering. The indicator only lives for the duration of this call.
+  m_pContext->SetPauseIndicator(pPause);
+  m_pDevice->SetPauseIndicator(pPause);
+  ContinueRendering(pPause);
+  m_pDevice->SetPauseIndicator(nullptr);
+  m_pContext->SetPauseIndicator(nullptr);
+
+  if (m_Status == kToBeContinued && pPause && pPause->NeedToCancelNow())
+    m_Status = kCancelled;
+}
+
+void CPDF_ProgressiveRenderer::ContinueRendering(PauseIndicatorIface* pPause) {
   while (m_Status == kToBeContinued) {
     if (!m_pCurrentLayer) {
       if (m_LayerIndex >= m_pContext->CountLayers()) {
@@ -85,8 +104,18 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
           }
           is_mask = true;
         }
-        if (m_pRenderStatus->ContinueSingleObject(
-                pCurObj, m_pCurrentLayer->GetMatrix(), pPause)) {
+        {
+          CFX_RenderProfile::ScopedObject profile_object(
+              m_pContext->GetProfile(), m_LayerIndex,
+              static_cast<size_t>(
+                  iter - m_pCurrentLayer->GetObjectHolder()->begin()));
+          if (m_pRenderStatus->ContinueSingleObject(
+                  pCurObj, m_pCurrentLayer->GetMatrix(), pPause)) {
+            return;
+          }
+        }
+        if (pPause && pPause->NeedToCancelNow()) {
+          m_LastObjectRendered = iter;
           return;
         }
         if (pCurObj->IsImage() && m_pRenderStatus->GetRenderOptions()
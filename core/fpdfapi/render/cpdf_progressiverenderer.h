@@ -30,7 +30,8 @@ class CPDF_ProgressiveRenderer {
     kReady,          // FPDF_RENDER_READY
     kToBeContinued,  // FPDF_RENDER_TOBECONTINUED
     kDone,           // FPDF_RENDER_DONE
-    kFailed          // FPDF_RENDER_FAILED
+    kFailed,         // FPDF_RENDER_FAILED
+    kCancelled       // FPDF_RENDER_CANCELLED
   };
 
   CPDF_ProgressiveRenderer(CPDF_RenderContext* pContext,
@@ -46,6 +47,8 @@ class CPDF_ProgressiveRenderer {
   // Maximum page objects to render before checking for pause.
   static constexpr int kStepLimit = 100;
 
+  void ContinueRendering(PauseIndicatorIface* pPause);
+
   Status m_Status = kReady;
   UnownedPtr<CPDF_RenderContext> const m_pContext;
   UnownedPtr<CFX_RenderDevice> const m_pDevice;
@@ -17,6 +17,7 @@
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfapi/render/cpdf_renderstatus.h"
 #include "core/fpdfapi/render/cpdf_textrenderer.h"
+#include "core/fxcrt/pauseindicator_iface.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "core/fxge/cfx_renderdevice.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
@@ -32,6 +33,14 @@ CPDF_RenderContext::CPDF_RenderContext(
 
 CPDF_RenderContext::~CPDF_RenderContext() = default;
 
+int CPDF_RenderContext::CountSoftMaskUse(const CPDF_Dictionary* pSMaskDict) {
+  return ++m_SoftMaskUses[pdfium::WrapRetain(pSMaskDict)];
+}
+
+bool CPDF_RenderContext::NeedToCancelNow() const {
+  return m_pPauseIndicator && m_pPauseIndicator->NeedToCancelNow();
+}
+
 void CPDF_RenderContext::GetBackground(RetainPtr<CFX_DIBitmap> pBuffer,
                                        const CPDF_PageObject* pObj,
                                        const CPDF_RenderOptions* pOptions,
@@ -7,14 +7,19 @@
 #ifndef CORE_FPDFAPI_RENDER_CPDF_RENDERCONTEXT_H_
 #define CORE_FPDFAPI_RENDER_CPDF_RENDERCONTEXT_H_
 
+#include <stdint.h>
+
+#include <map>
 #include <vector>
 
+#include "core/fpdfapi/render/cpdf_bitmappool.h"
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
 
 class CFX_DIBitmap;
 class CFX_Matrix;
+class CFX_RenderProfile;
 class CFX_RenderDevice;
 class CPDF_Dictionary;
 class CPDF_Document;
@@ -22,9 +27,20 @@ class CPDF_PageImageCache;
 class CPDF_PageObject;
 class CPDF_PageObjectHolder;
 class CPDF_RenderOptions;
+class PauseIndicatorIface;
 
 class CPDF_RenderContext {
  public:
+  // Tracks how well the scratch bitmaps of transparency groups fit what the
+  // groups paint.
+  struct ScratchStats {
+    // Pixels in the group, backdrop and text clip mask bitmaps.
+    uint64_t allocated_pixels = 0;
+    // Pixels of the group bitmaps that ended up not fully transparent. Only
+    // counted when the render is profiled.
+    uint64_t touched_pixels = 0;
+  };
+
   class Layer {
    public:
     Layer(CPDF_PageObjectHolder* pHolder, const CFX_Matrix& matrix);
@@ -68,12 +84,35 @@ class CPDF_RenderContext {
     return m_pPageResources;
   }
   CPDF_PageImageCache* GetPageCache() const { return m_pPageCache; }
+  CPDF_BitmapPool* GetBitmapPool() { return &m_BitmapPool; }
+  ScratchStats* GetScratchStats() { return &m_ScratchStats; }
+
+  // The pause indicator of the progressive render in progress, if any. Long
+  // operations that cannot be paused poll it for cancellation.
+  PauseIndicatorIface* GetPauseIndicator() const { return m_pPauseIndicator; }
+  void SetPauseIndicator(PauseIndicatorIface* pPause) {
+    m_pPauseIndicator = pPause;
+  }
+  bool NeedToCancelNow() const;
+
+  // The profile that progressive rendering records into, if any.
+  CFX_RenderProfile* GetProfile() const { return m_pProfile; }
+  void SetProfile(CFX_RenderProfile* pProfile) { m_pProfile = pProfile; }
+
+  // Returns how many times `pSMaskDict` has been loaded during this render,
+  // including this time.
+  int CountSoftMaskUse(const CPDF_Dictionary* pSMaskDict);
 
  private:
   UnownedPtr<CPDF_Document> const m_pDocument;
   RetainPtr<CPDF_Dictionary> const m_pPageResources;
   UnownedPtr<CPDF_PageImageCache> const m_pPageCache;
   std::vector<Layer> m_Layers;
+  std::map<RetainPtr<const CPDF_Dictionary>, int> m_SoftMaskUses;
+  CPDF_BitmapPool m_BitmapPool;
+  ScratchStats m_ScratchStats;
+  UnownedPtr<PauseIndicatorIface> m_pPauseIndicator;
+  UnownedPtr<CFX_RenderProfile> m_pProfile;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_RENDERCONTEXT_H_
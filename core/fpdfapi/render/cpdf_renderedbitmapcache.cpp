@@ -0,0 +1,137 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_renderedbitmapcache.h"
+
+#include <cmath>
+#include <tuple>
+#include <utility>
+
+#include "core/fpdfapi/page/cpdf_occontext.h"
+#include "core/fpdfapi/parser/cpdf_object.h"
+#include "core/fpdfapi/render/cpdf_renderoptions.h"
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "third_party/base/check.h"
+#include "third_party/base/numerics/safe_conversions.h"
+
+namespace {
+
+constexpr float kMatrixScale = 4096.0f;
+
+int32_t QuantizeValue(float value) {
+  return pdfium::base::saturated_cast<int32_t>(
+      std::lround(value * kMatrixScale));
+}
+
+}  // namespace
+
+CPDF_RenderedBitmapCache::Key::Key() = default;
+
+CPDF_RenderedBitmapCache::Key::Key(const Key& that) = default;
+
+CPDF_RenderedBitmapCache::Key& CPDF_RenderedBitmapCache::Key::operator=(
+    const Key& that) = default;
+
+CPDF_RenderedBitmapCache::Key::~Key() = default;
+
+bool CPDF_RenderedBitmapCache::Key::operator<(const Key& that) const {
+  return std::tie(type, object, resources, matrix, width, height, options,
+                  params) < std::tie(that.type, that.object, that.resources,
+                                     that.matrix, that.width, that.height,
+                                     that.options, that.params);
+}
+
+// static
+std::array<int32_t, 6> CPDF_RenderedBitmapCache::QuantizeMatrix(
+    const CFX_Matrix& matrix) {
+  return {QuantizeValue(matrix.a), QuantizeValue(matrix.b),
+          QuantizeValue(matrix.c), QuantizeValue(matrix.d),
+          QuantizeValue(matrix.e), QuantizeValue(matrix.f)};
+}
+
+// static
+CFX_Matrix CPDF_RenderedBitmapCache::DequantizeMatrix(
+    const std::array<int32_t, 6>& matrix) {
+  return CFX_Matrix(matrix[0] / kMatrixScale, matrix[1] / kMatrixScale,
+                    matrix[2] / kMatrixScale, matrix[3] / kMatrixScale,
+                    matrix[4] / kMatrixScale, matrix[5] / kMatrixScale);
+}
+
+// static
+CPDF_RenderedBitmapCache::Key CPDF_RenderedBitmapCache::MakeKey(
+    Type type,
+    RetainPtr<const CPDF_Object> object,
+    const CFX_Matrix& matrix,
+    int width,
+    int height,
+    const CPDF_RenderOptions& options) {
+  Key key;
+  key.type = type;
+  key.object = std::move(object);
+  key.matrix = QuantizeMatrix(matrix);
+  key.width = width;
+  key.height = height;
+  key.options = GetOptionsFlags(options);
+  if (options.ColorModeIs(CPDF_RenderOptions::kForcedColor)) {
+    const CPDF_RenderOptions::ColorScheme& scheme = options.GetColorScheme();
+    key.params = {scheme.path_fill_color, scheme.path_stroke_color,
+                  scheme.text_fill_color, scheme.text_stroke_color};
+  }
+  return key;
+}
+
+// static
+uint32_t CPDF_RenderedBitmapCache::GetOptionsFlags(
+    const CPDF_RenderOptions& options) {
+  const CPDF_RenderOptions::Options& flags = options.GetOptions();
+  uint32_t result = 0;
+  for (bool flag :
+       {flags.bClearType, flags.bNoNativeText, flags.bForceHalftone,
+        flags.bRectAA, flags.bBreakForMasks, flags.bNoTextSmooth,
+        flags.bNoPathSmooth, flags.bNoImageSmooth,
+        flags.bConvertFillToStroke, flags.bLowResSoftMasks, flags.bDraft}) {
+    result = (result << 1) | (flag ? 1 : 0);
+  }
+  for (CPDF_RenderOptions::Type mode :
+       {CPDF_RenderOptions::kGray, CPDF_RenderOptions::kAlpha,
+        CPDF_RenderOptions::kForcedColor}) {
+    result = (result << 1) | (options.ColorModeIs(mode) ? 1 : 0);
+  }
+  // Which optional content is visible depends on what the render is for,
+  // e.g. viewing or printing.
+  const CPDF_OCContext* pOCContext = options.GetOCContext();
+  result = (result << 3) | (pOCContext ? pOCContext->GetUsageType() + 1 : 0);
+  return result;
+}
+
+CPDF_RenderedBitmapCache::CPDF_RenderedBitmapCache()
+    : m_Cache(CFX_MemoryAccount::Category::kImageCaches, kDefaultByteBudget) {}
+
+CPDF_RenderedBitmapCache::~CPDF_RenderedBitmapCache() = default;
+
+RetainPtr<CFX_DIBitmap> CPDF_RenderedBitmapCache::Find(const Key& key) {
+  RetainPtr<CFX_DIBitmap>* pBitmap = m_Cache.Find(key);
+  return pBitmap ? *pBitmap : nullptr;
+}
+
+void CPDF_RenderedBitmapCache::Add(const Key& key,
+                                   RetainPtr<CFX_DIBitmap> bitmap) {
+  DCHECK(bitmap);
+  const size_t cost = bitmap->GetEstimatedImageMemoryBurden();
+  m_Cache.Add(key, std::move(bitmap), cost);
+}
+
+void CPDF_RenderedBitmapCache::SetByteBudget(size_t budget) {
+  m_Cache.SetByteBudget(budget);
+}
+
+void CPDF_RenderedBitmapCache::Clear() {
+  m_Cache.Clear();
+}
+
+void CPDF_RenderedBitmapCache::SetMemoryAccount(
+    RetainPtr<CFX_MemoryAccount> pAccount) {
+  m_Cache.SetMemoryAccount(std::move(pAccount));
+}
@@ -0,0 +1,107 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_RENDER_CPDF_RENDEREDBITMAPCACHE_H_
+#define CORE_FPDFAPI_RENDER_CPDF_RENDEREDBITMAPCACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <vector>
+
+#include "core/fxcrt/cfx_memoryaccount.h"
+#include "core/fxcrt/lru_byte_cache.h"
+#include "core/fxcrt/retain_ptr.h"
+
+class CFX_DIBitmap;
+class CFX_Matrix;
+class CPDF_Object;
+class CPDF_RenderOptions;
+
+// Document-wide cache of bitmaps rendered from resources that get painted
+// over and over with the same device transform, e.g. tiling pattern cells.
+// Once the cached bitmaps exceed the byte budget, the least recently used
+// ones are dropped. Cached bitmaps are shared and must not be modified.
+//
+// When a memory account is set, cached bytes are charged to it as image
+// cache memory, and bitmaps that would push it past its limit are not
+// cached.
+class CPDF_RenderedBitmapCache {
+ public:
+  static constexpr size_t kDefaultByteBudget = 32 * 1024 * 1024;
+
+  enum class Type : uint8_t {
+    kTilingPatternCell,
+    kForm,
+    kSoftMask,
+  };
+
+  struct Key {
+    Key();
+    Key(const Key& that);
+    Key& operator=(const Key& that);
+    ~Key();
+
+    bool operator<(const Key& that) const;
+
+    Type type = Type::kTilingPatternCell;
+    RetainPtr<const CPDF_Object> object;
+    // Fallback resources, for objects whose content may use the page's.
+    RetainPtr<const CPDF_Object> resources;
+    // See QuantizeMatrix().
+    std::array<int32_t, 6> matrix = {};
+    int width = 0;
+    int height = 0;
+    // See GetOptionsFlags().
+    uint32_t options = 0;
+    // Type-specific values that also change the rendered pixels, e.g.
+    // inherited colors.
+    std::vector<uint32_t> params;
+  };
+
+  // Fills in all the fields that every type needs. In forced color mode, the
+  // color scheme goes into `params`.
+  static Key MakeKey(Type type,
+                     RetainPtr<const CPDF_Object> object,
+                     const CFX_Matrix& matrix,
+                     int width,
+                     int height,
+                     const CPDF_RenderOptions& options);
+
+  // Rounds the matrix components to multiples of 1/4096, so transforms that
+  // differ only by floating point noise share entries.
+  static std::array<int32_t, 6> QuantizeMatrix(const CFX_Matrix& matrix);
+
+  // Returns the matrix that QuantizeMatrix() rounded `matrix` to.
+  static CFX_Matrix DequantizeMatrix(const std::array<int32_t, 6>& matrix);
+
+  // Packs the parts of `options` that can change rendered pixels.
+  static uint32_t GetOptionsFlags(const CPDF_RenderOptions& options);
+
+  CPDF_RenderedBitmapCache();
+  ~CPDF_RenderedBitmapCache();
+
+  RetainPtr<CFX_DIBitmap> Find(const Key& key);
+  void Add(const Key& key, RetainPtr<CFX_DIBitmap> bitmap);
+
+  // Sets the budget and immediately evicts entries that no longer fit.
+  void SetByteBudget(size_t budget);
+  size_t GetByteBudget() const { return m_Cache.GetByteBudget(); }
+
+  size_t GetCachedBytes() const { return m_Cache.GetCachedBytes(); }
+  size_t GetEntryCount() const { return m_Cache.GetEntryCount(); }
+
+  void Clear();
+
+  void SetMemoryAccount(RetainPtr<CFX_MemoryAccount> pAccount);
+  CFX_MemoryAccount* GetMemoryAccount() const {
+    return m_Cache.GetMemoryAccount();
+  }
+
+ private:
+  LruByteCache<Key, RetainPtr<CFX_DIBitmap>> m_Cache;
+};
+
+#endif  // CORE_FPDFAPI_RENDER_CPDF_RENDEREDBITMAPCACHE_H_
@@ -0,0 +1,195 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_renderedbitmapcache.h"
+
+#include <memory>
+#include <utility>
+
+#include "core/fpdfapi/page/cpdf_docpagedata.h"
+#include "core/fpdfapi/page/cpdf_occontext.h"
+#include "core/fpdfapi/page/cpdf_pagemodule.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/render/cpdf_docrenderdata.h"
+#include "core/fpdfapi/render/cpdf_renderoptions.h"
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Returns a 4x4 8bpp mask, which costs 16 bytes.
+RetainPtr<CFX_DIBitmap> MakeBitmap() {
+  auto bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  EXPECT_TRUE(bitmap->Create(4, 4, FXDIB_Format::k8bppMask));
+  return bitmap;
+}
+
+CPDF_RenderedBitmapCache::Key MakeKey(RetainPtr<const CPDF_Object> object) {
+  CPDF_RenderedBitmapCache::Key key;
+  key.object = std::move(object);
+  key.matrix = CPDF_RenderedBitmapCache::QuantizeMatrix(CFX_Matrix());
+  key.width = 4;
+  key.height = 4;
+  return key;
+}
+
+}  // namespace
+
+TEST(CPDFRenderedBitmapCacheTest, FindAndAdd) {
+  CPDF_RenderedBitmapCache cache;
+  CPDF_RenderedBitmapCache::Key key =
+      MakeKey(pdfium::MakeRetain<CPDF_Dictionary>());
+  EXPECT_FALSE(cache.Find(key));
+
+  RetainPtr<CFX_DIBitmap> bitmap = MakeBitmap();
+  cache.Add(key, bitmap);
+  EXPECT_EQ(bitmap, cache.Find(key));
+  EXPECT_EQ(1u, cache.GetEntryCount());
+  EXPECT_EQ(16u, cache.GetCachedBytes());
+
+  CPDF_RenderedBitmapCache::Key other_key = key;
+  other_key.width = 5;
+  EXPECT_FALSE(cache.Find(other_key));
+  other_key = key;
+  other_key.options = 1;
+  EXPECT_FALSE(cache.Find(other_key));
+  other_key = key;
+  other_key.resources = pdfium::MakeRetain<CPDF_Dictionary>();
+  EXPECT_FALSE(cache.Find(other_key));
+  other_key = key;
+  other_key.params = {1};
+  EXPECT_FALSE(cache.Find(other_key));
+}
+
+TEST(CPDFRenderedBitmapCacheTest, QuantizeMatrix) {
+  EXPECT_EQ(CPDF_RenderedBitmapCache::QuantizeMatrix(
+                CFX_Matrix(2.0f, 0, 0, 2.0f, 0, 0)),
+            CPDF_RenderedBitmapCache::QuantizeMatrix(
+                CFX_Matrix(2.00001f, 0, 0, 1.99999f, 0, 0)));
+  EXPECT_NE(CPDF_RenderedBitmapCache::QuantizeMatrix(
+                CFX_Matrix(2.0f, 0, 0, 2.0f, 0, 0)),
+            CPDF_RenderedBitmapCache::QuantizeMatrix(
+                CFX_Matrix(2.01f, 0, 0, 2.0f, 0, 0)));
+}
+
+TEST(CPDFRenderedBitmapCacheTest, DequantizeMatrix) {
+  const CFX_Matrix matrix(1.5f, 0.25f, -0.25f, 1.5f, 0.3f, 0.7f);
+  const CFX_Matrix result = CPDF_RenderedBitmapCache::DequantizeMatrix(
+      CPDF_RenderedBitmapCache::QuantizeMatrix(matrix));
+  EXPECT_FLOAT_EQ(1.5f, result.a);
+  EXPECT_FLOAT_EQ(0.25f, result.b);
+  EXPECT_FLOAT_EQ(-0.25f, result.c);
+  EXPECT_FLOAT_EQ(1.5f, result.d);
+  EXPECT_NEAR(0.3f, result.e, 1.0f / 8192);
+  EXPECT_NEAR(0.7f, result.f, 1.0f / 8192);
+}
+
+TEST(CPDFRenderedBitmapCacheTest, MakeKey) {
+  auto object = pdfium::MakeRetain<CPDF_Dictionary>();
+  CPDF_RenderOptions options;
+  CPDF_RenderedBitmapCache::Key key = CPDF_RenderedBitmapCache::MakeKey(
+      CPDF_RenderedBitmapCache::Type::kForm, object, CFX_Matrix(), 4, 5,
+      options);
+  EXPECT_EQ(CPDF_RenderedBitmapCache::Type::kForm, key.type);
+  EXPECT_EQ(object, key.object);
+  EXPECT_EQ(4, key.width);
+  EXPECT_EQ(5, key.height);
+  EXPECT_TRUE(key.params.empty());
+
+  // Forced colors change the pixels of everything drawn with them.
+  options.SetColorMode(CPDF_RenderOptions::kForcedColor);
+  options.SetColorScheme({0xff000001, 0xff000002, 0xff000003, 0xff000004});
+  key = CPDF_RenderedBitmapCache::MakeKey(
+      CPDF_RenderedBitmapCache::Type::kForm, object, CFX_Matrix(), 4, 5,
+      options);
+  EXPECT_THAT(key.params,
+              testing::ElementsAre(0xff000001, 0xff000002, 0xff000003,
+                                   0xff000004));
+}
+
+TEST(CPDFRenderedBitmapCacheTest, OptionsFlags) {
+  CPDF_RenderOptions options;
+  const uint32_t normal = CPDF_RenderedBitmapCache::GetOptionsFlags(options);
+  options.SetColorMode(CPDF_RenderOptions::kGray);
+  const uint32_t gray = CPDF_RenderedBitmapCache::GetOptionsFlags(options);
+  EXPECT_NE(normal, gray);
+  options.GetOptions().bNoPathSmooth = true;
+  EXPECT_NE(gray, CPDF_RenderedBitmapCache::GetOptionsFlags(options));
+}
+
+TEST(CPDFRenderedBitmapCacheTest, OptionsFlagsOCUsage) {
+  CPDF_PageModule::Create();
+  {
+    CPDF_Document document(std::make_unique<CPDF_DocRenderData>(),
+                           std::make_unique<CPDF_DocPageData>());
+    CPDF_RenderOptions options;
+    const uint32_t no_oc = CPDF_RenderedBitmapCache::GetOptionsFlags(options);
+    options.SetOCContext(pdfium::MakeRetain<CPDF_OCContext>(
+        &document, CPDF_OCContext::kView));
+    const uint32_t view = CPDF_RenderedBitmapCache::GetOptionsFlags(options);
+    options.SetOCContext(pdfium::MakeRetain<CPDF_OCContext>(
+        &document, CPDF_OCContext::kPrint));
+    const uint32_t print = CPDF_RenderedBitmapCache::GetOptionsFlags(options);
+    EXPECT_NE(no_oc, view);
+    EXPECT_NE(no_oc, print);
+    EXPECT_NE(view, print);
+  }
+  CPDF_PageModule::Destroy();
+}
+
+TEST(CPDFRenderedBitmapCacheTest, EvictsLeastRecentlyUsed) {
+  CPDF_RenderedBitmapCache cache;
+  cache.SetByteBudget(32);
+
+  CPDF_RenderedBitmapCache::Key key1 =
+      MakeKey(pdfium::MakeRetain<CPDF_Dictionary>());
+  CPDF_RenderedBitmapCache::Key key2 =
+      MakeKey(pdfium::MakeRetain<CPDF_Dictionary>());
+  CPDF_RenderedBitmapCache::Key key3 =
+      MakeKey(pdfium::MakeRetain<CPDF_Dictionary>());
+  cache.Add(key1, MakeBitmap());
+  cache.Add(key2, MakeBitmap());
+
+  // Touch `key1` so `key2` becomes the eviction candidate.
+  EXPECT_TRUE(cache.Find(key1));
+  cache.Add(key3, MakeBitmap());
+  EXPECT_EQ(2u, cache.GetEntryCount());
+  EXPECT_EQ(32u, cache.GetCachedBytes());
+  EXPECT_TRUE(cache.Find(key1));
+  EXPECT_FALSE(cache.Find(key2));
+  EXPECT_TRUE(cache.Find(key3));
+
+  cache.SetByteBudget(0);
+  EXPECT_EQ(0u, cache.GetEntryCount());
+  EXPECT_EQ(0u, cache.GetCachedBytes());
+}
+
+TEST(CPDFRenderedBitmapCacheTest, ChargesMemoryAccount) {
+  auto account = pdfium::MakeRetain<CFX_MemoryAccount>();
+  {
+    CPDF_RenderedBitmapCache cache;
+    cache.SetMemoryAccount(account);
+    CPDF_RenderedBitmapCache::Key key1 =
+        MakeKey(pdfium::MakeRetain<CPDF_Dictionary>());
+    cache.Add(key1, MakeBitmap());
+    EXPECT_EQ(16u,
+              account->GetUsage(CFX_MemoryAccount::Category::kImageCaches));
+
+    // Bitmaps that can never fit are not cached.
+    account->SetLimit(8);
+    CPDF_RenderedBitmapCache::Key key2 =
+        MakeKey(pdfium::MakeRetain<CPDF_Dictionary>());
+    cache.Add(key2, MakeBitmap());
+    EXPECT_EQ(0u, cache.GetEntryCount());
+    EXPECT_EQ(0u, account->GetTotalUsage());
+
+    account->SetLimit(0);
+    cache.Add(key2, MakeBitmap());
+    EXPECT_EQ(16u, account->GetTotalUsage());
+  }
+  EXPECT_EQ(0u, account->GetTotalUsage());
+}
@@ -37,6 +37,15 @@ class CPDF_RenderOptions {
     bool bNoImageSmooth = false;
     bool bLimitedImageCache = false;
     bool bConvertFillToStroke = false;
+    // Reuse the rasterized output of form XObjects drawn repeatedly with the
+    // same scale and rotation, see CPDF_RenderStatus::ProcessForm().
+    bool bCacheForms = false;
+    // Evaluate luminosity soft masks at half resolution and scale them up.
+    bool bLowResSoftMasks = false;
+    // Trade quality for speed: decode images at reduced resolution, fill
+    // shadings with a single color and draw transparency groups without
+    // their backdrops.
+    bool bDraft = false;
   };
 
   struct ColorScheme {
@@ -59,6 +68,8 @@ class CPDF_RenderOptions {
     m_ColorScheme = color_scheme;
   }
 
+  const ColorScheme& GetColorScheme() const { return m_ColorScheme; }
+
   void SetColorMode(Type mode) { m_ColorMode = mode; }
   bool ColorModeIs(Type mode) const { return m_ColorMode == mode; }
 
@@ -75,6 +86,7 @@ class CPDF_RenderOptions {
   void SetOCContext(RetainPtr<CPDF_OCContext> context) {
     m_pOCContext = context;
   }
+  const CPDF_OCContext* GetOCContext() const { return m_pOCContext.Get(); }
 
  private:
   Type m_ColorMode = kNormal;
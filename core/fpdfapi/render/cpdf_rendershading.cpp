@@ -18,28 +18,41 @@
 #include "core/fpdfapi/page/cpdf_dib.h"
 #include "core/fpdfapi/page/cpdf_function.h"
 #include "core/fpdfapi/page/cpdf_meshstream.h"
+#include "core/fpdfapi/page/cpdf_shadingpattern.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_stream_acc.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fpdfapi/render/cpdf_devicebuffer.h"
+#include "core/fpdfapi/render/cpdf_rendercontext.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
+#include "core/fpdfapi/render/cpdf_shadingkernel.h"
+#include "core/fxcrt/cfx_renderprofile.h"
+#include "core/fxcrt/fixed_uninit_data_vector.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/fx_system.h"
+#include "core/fxcrt/pauseindicator_iface.h"
 #include "core/fxcrt/span_util.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "core/fxge/cfx_fillrenderoptions.h"
 #include "core/fxge/cfx_path.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/dib/fx_dib.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
-#include "third_party/base/cxx17_backports.h"
 #include "third_party/base/span.h"
 
 namespace {
 
-constexpr int kShadingSteps = 256;
+// Free-form meshes poll for cancellation once per this many triangles.
+constexpr int kCancelCheckTriangles = 256;
+
+bool NeedToCancel(PauseIndicatorIface* pPause) {
+  return pPause && pPause->NeedToCancelNow();
+}
 
 uint32_t CountOutputsFromFunctions(
     const std::vector<std::unique_ptr<CPDF_Function>>& funcs) {
@@ -96,7 +109,8 @@ void DrawAxialShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
                       const CPDF_Dictionary* pDict,
                       const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
                       const RetainPtr<CPDF_ColorSpace>& pCS,
-                      int alpha) {
+                      int alpha,
+                      PauseIndicatorIface* pPause) {
   DCHECK_EQ(pBitmap->GetFormat(), FXDIB_Format::kArgb);
 
   const uint32_t total_results = GetValidatedOutputsCount(funcs, pCS);
@@ -122,38 +136,44 @@ void DrawAxialShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
   const bool bStartExtend = pArray && pArray->GetBooleanAt(0, false);
   const bool bEndExtend = pArray && pArray->GetBooleanAt(1, false);
 
-  int width = pBitmap->GetWidth();
-  int height = pBitmap->GetHeight();
-  float x_span = end_x - start_x;
-  float y_span = end_y - start_y;
-  float axis_len_square = (x_span * x_span) + (y_span * y_span);
-
   std::array<FX_ARGB, kShadingSteps> shading_steps =
       GetShadingSteps(t_min, t_max, funcs, pCS, alpha, total_results);
 
-  CFX_Matrix matrix = mtObject2Bitmap.GetInverse();
+  const CPDF_AxialShadingKernel kernel(
+      mtObject2Bitmap.GetInverse(), CFX_PointF(start_x, start_y),
+      CFX_PointF(end_x, end_y), bStartExtend, bEndExtend);
+  const int width = pBitmap->GetWidth();
+  const int height = pBitmap->GetHeight();
+  if (kernel.IsColumnInvariant()) {
+    // Each row is a single color, e.g. for a vertical axis.
+    for (int row = 0; row < height; ++row) {
+      int32_t index = kernel.GetIndex(0, row);
+      if (index < 0)
+        continue;
+
+      uint32_t* dib_buf =
+          reinterpret_cast<uint32_t*>(pBitmap->GetWritableScanline(row).data());
+      std::fill(dib_buf, dib_buf + width, shading_steps[index]);
+    }
+    return;
+  }
+
+  // Horizontal axes only need the indices of the first row.
+  const bool bRowInvariant = kernel.IsRowInvariant();
+  FixedUninitDataVector<int32_t> index_buffer(width);
+  pdfium::span<int32_t> indices = index_buffer.writable_span();
   for (int row = 0; row < height; row++) {
+    if (NeedToCancel(pPause))
+      return;
+
+    if (row == 0 || !bRowInvariant)
+      kernel.GetRowIndices(row, indices);
+
     uint32_t* dib_buf =
         reinterpret_cast<uint32_t*>(pBitmap->GetWritableScanline(row).data());
     for (int column = 0; column < width; column++) {
-      CFX_PointF pos = matrix.Transform(
-          CFX_PointF(static_cast<float>(column), static_cast<float>(row)));
-      float scale =
-          (((pos.x - start_x) * x_span) + ((pos.y - start_y) * y_span)) /
-          axis_len_square;
-      int index = static_cast<int32_t>(scale * (kShadingSteps - 1));
-      if (index < 0) {
-        if (!bStartExtend)
-          continue;
-
-        index = 0;
-      } else if (index >= kShadingSteps) {
-        if (!bEndExtend)
-          continue;
-
-        index = kShadingSteps - 1;
-      }
-      dib_buf[column] = shading_steps[index];
+      if (indices[column] >= 0)
+        dib_buf[column] = shading_steps[indices[column]];
     }
   }
 }
@@ -163,7 +183,8 @@ void DrawRadialShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
                        const CPDF_Dictionary* pDict,
                        const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
                        const RetainPtr<CPDF_ColorSpace>& pCS,
-                       int alpha) {
+                       int alpha,
+                       PauseIndicatorIface* pPause) {
   DCHECK_EQ(pBitmap->GetFormat(), FXDIB_Format::kArgb);
 
   const uint32_t total_results = GetValidatedOutputsCount(funcs, pCS);
@@ -194,62 +215,23 @@ void DrawRadialShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
   std::array<FX_ARGB, kShadingSteps> shading_steps =
       GetShadingSteps(t_min, t_max, funcs, pCS, alpha, total_results);
 
-  const float dx = end_x - start_x;
-  const float dy = end_y - start_y;
-  const float dr = end_r - start_r;
-  const float a = dx * dx + dy * dy - dr * dr;
-  const bool a_is_float_zero = FXSYS_IsFloatZero(a);
-
-  int width = pBitmap->GetWidth();
-  int height = pBitmap->GetHeight();
-  bool bDecreasing = dr < 0 && static_cast<int>(FXSYS_sqrt2(dx, dy)) < -dr;
-
-  CFX_Matrix matrix = mtObject2Bitmap.GetInverse();
+  const CPDF_RadialShadingKernel kernel(
+      mtObject2Bitmap.GetInverse(), CFX_PointF(start_x, start_y), start_r,
+      CFX_PointF(end_x, end_y), end_r, bStartExtend, bEndExtend);
+  const int width = pBitmap->GetWidth();
+  const int height = pBitmap->GetHeight();
+  FixedUninitDataVector<int32_t> index_buffer(width);
+  pdfium::span<int32_t> indices = index_buffer.writable_span();
   for (int row = 0; row < height; row++) {
+    if (NeedToCancel(pPause))
+      return;
+
+    kernel.GetRowIndices(row, indices);
     uint32_t* dib_buf =
         reinterpret_cast<uint32_t*>(pBitmap->GetWritableScanline(row).data());
     for (int column = 0; column < width; column++) {
-      CFX_PointF pos = matrix.Transform(
-          CFX_PointF(static_cast<float>(column), static_cast<float>(row)));
-      float pos_dx = pos.x - start_x;
-      float pos_dy = pos.y - start_y;
-      float b = -2 * (pos_dx * dx + pos_dy * dy + start_r * dr);
-      float c = pos_dx * pos_dx + pos_dy * pos_dy - start_r * start_r;
-      float s;
-      if (FXSYS_IsFloatZero(b)) {
-        s = sqrt(-c / a);
-      } else if (a_is_float_zero) {
-        s = -c / b;
-      } else {
-        float b2_4ac = (b * b) - 4 * (a * c);
-        if (b2_4ac < 0)
-          continue;
-
-        float root = sqrt(b2_4ac);
-        float s1 = (-b - root) / (2 * a);
-        float s2 = (-b + root) / (2 * a);
-        if (a <= 0)
-          std::swap(s1, s2);
-        if (bDecreasing)
-          s = (s1 >= 0 || bStartExtend) ? s1 : s2;
-        else
-          s = (s2 <= 1.0f || bEndExtend) ? s2 : s1;
-
-        if (start_r + s * dr < 0)
-          continue;
-      }
-
-      int index = static_cast<int32_t>(s * (kShadingSteps - 1));
-      if (index < 0) {
-        if (!bStartExtend)
-          continue;
-        index = 0;
-      } else if (index >= kShadingSteps) {
-        if (!bEndExtend)
-          continue;
-        index = kShadingSteps - 1;
-      }
-      dib_buf[column] = shading_steps[index];
+      if (indices[column] >= 0)
+        dib_buf[column] = shading_steps[indices[column]];
     }
   }
 }
@@ -259,7 +241,8 @@ void DrawFuncShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
                      const CPDF_Dictionary* pDict,
                      const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
                      const RetainPtr<CPDF_ColorSpace>& pCS,
-                     int alpha) {
+                     int alpha,
+                     PauseIndicatorIface* pPause) {
   DCHECK_EQ(pBitmap->GetFormat(), FXDIB_Format::kArgb);
 
   const uint32_t total_results = GetValidatedOutputsCount(funcs, pCS);
@@ -287,6 +270,9 @@ void DrawFuncShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
   DCHECK(total_results >= pCS->CountComponents());
   std::vector<float> result_array(total_results);
   for (int row = 0; row < height; ++row) {
+    if (NeedToCancel(pPause))
+      return;
+
     uint32_t* dib_buf =
         reinterpret_cast<uint32_t*>(pBitmap->GetWritableScanline(row).data());
     for (int column = 0; column < width; column++) {
@@ -315,121 +301,51 @@ void DrawFuncShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
   }
 }
 
-bool GetScanlineIntersect(int y,
-                          const CFX_PointF& first,
-                          const CFX_PointF& second,
-                          float* x) {
-  if (first.y == second.y)
-    return false;
-
-  if (first.y < second.y) {
-    if (y < first.y || y > second.y)
-      return false;
-  } else if (y < second.y || y > first.y) {
-    return false;
-  }
-  *x = first.x + ((second.x - first.x) * (y - first.y) / (second.y - first.y));
-  return true;
-}
-
-void DrawGouraud(const RetainPtr<CFX_DIBitmap>& pBitmap,
-                 int alpha,
-                 CPDF_MeshVertex triangle[3]) {
-  float min_y = triangle[0].position.y;
-  float max_y = triangle[0].position.y;
-  for (int i = 1; i < 3; i++) {
-    min_y = std::min(min_y, triangle[i].position.y);
-    max_y = std::max(max_y, triangle[i].position.y);
-  }
-  if (min_y == max_y)
-    return;
-
-  int min_yi = std::max(static_cast<int>(floorf(min_y)), 0);
-  int max_yi = static_cast<int>(ceilf(max_y));
-  if (max_yi >= pBitmap->GetHeight())
-    max_yi = pBitmap->GetHeight() - 1;
-
-  for (int y = min_yi; y <= max_yi; y++) {
-    int nIntersects = 0;
-    float inter_x[3];
-    float r[3];
-    float g[3];
-    float b[3];
-    for (int i = 0; i < 3; i++) {
-      CPDF_MeshVertex& vertex1 = triangle[i];
-      CPDF_MeshVertex& vertex2 = triangle[(i + 1) % 3];
-      CFX_PointF& position1 = vertex1.position;
-      CFX_PointF& position2 = vertex2.position;
-      bool bIntersect =
-          GetScanlineIntersect(y, position1, position2, &inter_x[nIntersects]);
-      if (!bIntersect)
-        continue;
-
-      float y_dist = (y - position1.y) / (position2.y - position1.y);
-      r[nIntersects] = vertex1.r + ((vertex2.r - vertex1.r) * y_dist);
-      g[nIntersects] = vertex1.g + ((vertex2.g - vertex1.g) * y_dist);
-      b[nIntersects] = vertex1.b + ((vertex2.b - vertex1.b) * y_dist);
-      nIntersects++;
-    }
-    if (nIntersects != 2)
-      continue;
-
-    int min_x;
-    int max_x;
-    int start_index;
-    int end_index;
-    if (inter_x[0] < inter_x[1]) {
-      min_x = static_cast<int>(floorf(inter_x[0]));
-      max_x = static_cast<int>(ceilf(inter_x[1]));
-      start_index = 0;
-      end_index = 1;
-    } else {
-      min_x = static_cast<int>(floorf(inter_x[1]));
-      max_x = static_cast<int>(ceilf(inter_x[0]));
-      start_index = 1;
-      end_index = 0;
-    }
-
-    int start_x = pdfium::clamp(min_x, 0, pBitmap->GetWidth());
-    int end_x = pdfium::clamp(max_x, 0, pBitmap->GetWidth());
-    float r_unit = (r[end_index] - r[start_index]) / (max_x - min_x);
-    float g_unit = (g[end_index] - g[start_index]) / (max_x - min_x);
-    float b_unit = (b[end_index] - b[start_index]) / (max_x - min_x);
-    float r_result = r[start_index] + (start_x - min_x) * r_unit;
-    float g_result = g[start_index] + (start_x - min_x) * g_unit;
-    float b_result = b[start_index] + (start_x - min_x) * b_unit;
-    pdfium::span<uint8_t> dib_span =
-        pBitmap->GetWritableScanline(y).subspan(start_x * 4);
-
-    for (int x = start_x; x < end_x; x++) {
-      uint8_t* dib_buf = dib_span.data();
-      r_result += r_unit;
-      g_result += g_unit;
-      b_result += b_unit;
-      FXARGB_SETDIB(dib_buf, ArgbEncode(alpha, static_cast<int>(r_result * 255),
-                                        static_cast<int>(g_result * 255),
-                                        static_cast<int>(b_result * 255)));
-      dib_span = dib_span.subspan(4);
-    }
-  }
+// Mesh shadings are often shared between pages, so use the document's decoded
+// copy of the stream when possible.
+RetainPtr<CPDF_StreamAcc> GetMeshStreamAcc(
+    CPDF_Document* pDocument,
+    const CPDF_ShadingPattern* pPattern) {
+  // The shading object can be a stream or a dictionary. We do not handle the
+  // case of dictionary at the moment.
+  RetainPtr<const CPDF_Stream> pStream = ToStream(pPattern->GetShadingObject());
+  if (!pStream)
+    return nullptr;
+
+  if (pDocument)
+    return pDocument->GetDecodedStreamAcc(std::move(pStream));
+
+  auto pAcc = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(pStream));
+  pAcc->LoadAllDataFiltered();
+  return pAcc;
 }
 
 void DrawFreeGouraudShading(
     const RetainPtr<CFX_DIBitmap>& pBitmap,
     const CFX_Matrix& mtObject2Bitmap,
-    RetainPtr<const CPDF_Stream> pShadingStream,
+    RetainPtr<CPDF_StreamAcc> pShadingAcc,
     const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
     RetainPtr<CPDF_ColorSpace> pCS,
-    int alpha) {
+    int alpha,
+    PauseIndicatorIface* pPause) {
   DCHECK_EQ(pBitmap->GetFormat(), FXDIB_Format::kArgb);
 
   CPDF_MeshStream stream(kFreeFormGouraudTriangleMeshShading, funcs,
-                         std::move(pShadingStream), std::move(pCS));
+                         std::move(pShadingAcc), std::move(pCS));
   if (!stream.Load())
     return;
 
+  CPDF_GouraudRasterizer rasterizer(pBitmap, alpha);
   CPDF_MeshVertex triangle[3];
+  int triangles_to_go = kCancelCheckTriangles;
   while (!stream.IsEOF()) {
+    if (--triangles_to_go == 0) {
+      if (NeedToCancel(pPause))
+        return;
+
+      triangles_to_go = kCancelCheckTriangles;
+    }
+
     CPDF_MeshVertex vertex;
     uint32_t flag;
     if (!stream.ReadVertex(mtObject2Bitmap, &vertex, &flag))
@@ -449,25 +365,27 @@ void DrawFreeGouraudShading(
       triangle[1] = triangle[2];
       triangle[2] = vertex;
     }
-    DrawGouraud(pBitmap, alpha, triangle);
+    rasterizer.Draw(triangle);
   }
 }
 
 void DrawLatticeGouraudShading(
     const RetainPtr<CFX_DIBitmap>& pBitmap,
     const CFX_Matrix& mtObject2Bitmap,
-    RetainPtr<const CPDF_Stream> pShadingStream,
+    RetainPtr<CPDF_StreamAcc> pShadingAcc,
     const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
     RetainPtr<CPDF_ColorSpace> pCS,
-    int alpha) {
+    int alpha,
+    PauseIndicatorIface* pPause) {
   DCHECK_EQ(pBitmap->GetFormat(), FXDIB_Format::kArgb);
 
-  int row_verts = pShadingStream->GetDict()->GetIntegerFor("VerticesPerRow");
+  int row_verts =
+      pShadingAcc->GetStream()->GetDict()->GetIntegerFor("VerticesPerRow");
   if (row_verts < 2)
     return;
 
   CPDF_MeshStream stream(kLatticeFormGouraudTriangleMeshShading, funcs,
-                         std::move(pShadingStream), std::move(pCS));
+                         std::move(pShadingAcc), std::move(pCS));
   if (!stream.Load())
     return;
 
@@ -476,8 +394,12 @@ void DrawLatticeGouraudShading(
   if (vertices[0].empty())
     return;
 
+  CPDF_GouraudRasterizer rasterizer(pBitmap, alpha);
   int last_index = 0;
   while (true) {
+    if (NeedToCancel(pPause))
+      return;
+
     vertices[1 - last_index] = stream.ReadVertexRow(mtObject2Bitmap, row_verts);
     if (vertices[1 - last_index].empty())
       return;
@@ -487,9 +409,9 @@ void DrawLatticeGouraudShading(
       triangle[0] = vertices[last_index][i];
       triangle[1] = vertices[1 - last_index][i - 1];
       triangle[2] = vertices[last_index][i - 1];
-      DrawGouraud(pBitmap, alpha, triangle);
+      rasterizer.Draw(triangle);
       triangle[2] = vertices[1 - last_index][i];
-      DrawGouraud(pBitmap, alpha, triangle);
+      rasterizer.Draw(triangle);
     }
     last_index = 1 - last_index;
   }
@@ -777,11 +699,12 @@ void DrawCoonPatchMeshes(
     ShadingType type,
     const RetainPtr<CFX_DIBitmap>& pBitmap,
     const CFX_Matrix& mtObject2Bitmap,
-    RetainPtr<const CPDF_Stream> pShadingStream,
+    RetainPtr<CPDF_StreamAcc> pShadingAcc,
     const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
     RetainPtr<CPDF_ColorSpace> pCS,
     bool bNoPathSmooth,
-    int alpha) {
+    int alpha,
+    PauseIndicatorIface* pPause) {
   DCHECK_EQ(pBitmap->GetFormat(), FXDIB_Format::kArgb);
   DCHECK(type == kCoonsPatchMeshShading ||
          type == kTensorProductPatchMeshShading);
@@ -789,8 +712,7 @@ void DrawCoonPatchMeshes(
   CFX_DefaultRenderDevice device;
   device.Attach(pBitmap);
 
-  CPDF_MeshStream stream(type, funcs, std::move(pShadingStream),
-                         std::move(pCS));
+  CPDF_MeshStream stream(type, funcs, std::move(pShadingAcc), std::move(pCS));
   if (!stream.Load())
     return;
 
@@ -808,6 +730,9 @@ void DrawCoonPatchMeshes(
   CFX_PointF coords[16];
   int point_count = type == kTensorProductPatchMeshShading ? 16 : 12;
   while (!stream.IsEOF()) {
+    if (NeedToCancel(pPause))
+      return;
+
     if (!stream.CanReadFlag())
       break;
     uint32_t flag = stream.ReadFlag();
@@ -869,6 +794,144 @@ void DrawCoonPatchMeshes(
   }
 }
 
+// Returns the single color a draft fills a shading with: the average of the
+// colors along the axis of axial and radial shadings, or the color at the
+// center of the domain of function-based shadings. Mesh shadings take their
+// colors from vertex data, so they get no draft color.
+absl::optional<FX_ARGB> GetDraftColor(
+    ShadingType type,
+    const CPDF_Dictionary* pDict,
+    const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
+    const RetainPtr<CPDF_ColorSpace>& pCS,
+    int alpha) {
+  const uint32_t total_results = GetValidatedOutputsCount(funcs, pCS);
+  if (total_results == 0)
+    return absl::nullopt;
+
+  RetainPtr<const CPDF_Array> pDomain = pDict->GetArrayFor("Domain");
+  if (type == kAxialShading || type == kRadialShading) {
+    float t_min = 0;
+    float t_max = 1.0f;
+    if (pDomain) {
+      t_min = pDomain->GetFloatAt(0);
+      t_max = pDomain->GetFloatAt(1);
+    }
+    std::array<FX_ARGB, kShadingSteps> shading_steps =
+        GetShadingSteps(t_min, t_max, funcs, pCS, alpha, total_results);
+    int r = 0;
+    int g = 0;
+    int b = 0;
+    for (FX_ARGB step : shading_steps) {
+      r += FXARGB_R(step);
+      g += FXARGB_G(step);
+      b += FXARGB_B(step);
+    }
+    return ArgbEncode(alpha, r / kShadingSteps, g / kShadingSteps,
+                      b / kShadingSteps);
+  }
+  if (type != kFunctionBasedShading)
+    return absl::nullopt;
+
+  float input[2] = {0.5f, 0.5f};
+  if (pDomain) {
+    input[0] = (pDomain->GetFloatAt(0) + pDomain->GetFloatAt(1)) / 2;
+    input[1] = (pDomain->GetFloatAt(2) + pDomain->GetFloatAt(3)) / 2;
+  }
+  std::vector<float> result_array(total_results);
+  pdfium::span<float> result_span = pdfium::make_span(result_array);
+  for (const auto& func : funcs) {
+    if (!func)
+      continue;
+    absl::optional<uint32_t> nresults = func->Call(input, result_span);
+    if (nresults.has_value())
+      result_span = result_span.subspan(nresults.value());
+  }
+  float R = 0.0f;
+  float G = 0.0f;
+  float B = 0.0f;
+  pCS->GetRGB(result_array, &R, &G, &B);
+  return ArgbEncode(alpha, FXSYS_roundf(R * 255), FXSYS_roundf(G * 255),
+                    FXSYS_roundf(B * 255));
+}
+
+// Returns whether the shading described by `pDict` paints every pixel of
+// `rect`, so that a draft can fill `rect` with a single color in its place.
+// Axial shadings cover the points that project onto their axis, or beyond an
+// extended end. Radial shadings cover the whole plane when both ends are
+// extended and one circle contains the other. Function-based shadings cover
+// their domain.
+bool ShadingCoversRect(ShadingType type,
+                       const CPDF_Dictionary* pDict,
+                       const CFX_Matrix& mtObject2Device,
+                       const FX_RECT& rect) {
+  if (rect.IsEmpty())
+    return true;
+
+  CFX_Matrix mtDevice2Object = mtObject2Device.GetInverse();
+  if (type == kFunctionBasedShading) {
+    mtDevice2Object.Concat(pDict->GetMatrixFor("Matrix").GetInverse());
+  }
+  const CFX_PointF corners[] = {
+      mtDevice2Object.Transform(CFX_PointF(rect.left, rect.top)),
+      mtDevice2Object.Transform(CFX_PointF(rect.right, rect.top)),
+      mtDevice2Object.Transform(CFX_PointF(rect.left, rect.bottom)),
+      mtDevice2Object.Transform(CFX_PointF(rect.right, rect.bottom)),
+  };
+
+  if (type == kFunctionBasedShading) {
+    CFX_FloatRect domain(0.0f, 0.0f, 1.0f, 1.0f);
+    RetainPtr<const CPDF_Array> pDomain = pDict->GetArrayFor("Domain");
+    if (pDomain) {
+      domain = CFX_FloatRect(pDomain->GetFloatAt(0), pDomain->GetFloatAt(2),
+                             pDomain->GetFloatAt(1), pDomain->GetFloatAt(3));
+    }
+    for (const CFX_PointF& corner : corners) {
+      if (corner.x < domain.left || corner.x > domain.right ||
+          corner.y < domain.bottom || corner.y > domain.top) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  RetainPtr<const CPDF_Array> pCoords = pDict->GetArrayFor("Coords");
+  if (!pCoords)
+    return false;
+
+  RetainPtr<const CPDF_Array> pExtend = pDict->GetArrayFor("Extend");
+  const bool bStartExtend = pExtend && pExtend->GetBooleanAt(0, false);
+  const bool bEndExtend = pExtend && pExtend->GetBooleanAt(1, false);
+  if (type == kAxialShading) {
+    const CFX_PointF start(pCoords->GetFloatAt(0), pCoords->GetFloatAt(1));
+    const CFX_PointF axis =
+        CFX_PointF(pCoords->GetFloatAt(2), pCoords->GetFloatAt(3)) - start;
+    const float axis_length_square = axis.x * axis.x + axis.y * axis.y;
+    if (axis_length_square <= 0)
+      return false;
+
+    // The position along the axis is linear, so the corners bound it.
+    for (const CFX_PointF& corner : corners) {
+      const CFX_PointF offset = corner - start;
+      const float t =
+          (offset.x * axis.x + offset.y * axis.y) / axis_length_square;
+      if ((!bStartExtend && t < 0) || (!bEndExtend && t > 1))
+        return false;
+    }
+    return true;
+  }
+
+  if (type != kRadialShading || !bStartExtend || !bEndExtend)
+    return false;
+
+  const CFX_PointF start(pCoords->GetFloatAt(0), pCoords->GetFloatAt(1));
+  const float start_r = pCoords->GetFloatAt(2);
+  const CFX_PointF end(pCoords->GetFloatAt(3), pCoords->GetFloatAt(4));
+  const float end_r = pCoords->GetFloatAt(5);
+  const CFX_PointF centers = end - start;
+  const float distance = sqrtf(centers.x * centers.x + centers.y * centers.y);
+  return end_r >= start_r + distance || start_r >= end_r + distance;
+}
+
 }  // namespace
 
 // static
@@ -880,6 +943,7 @@ void CPDF_RenderShading::Draw(CFX_RenderDevice* pDevice,
                               const FX_RECT& clip_rect,
                               int alpha,
                               const CPDF_RenderOptions& options) {
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kShading);
   RetainPtr<CPDF_ColorSpace> pColorSpace = pPattern->GetCS();
   if (!pColorSpace)
     return;
@@ -908,6 +972,20 @@ void CPDF_RenderShading::Draw(CFX_RenderDevice* pDevice,
         mtMatrix.TransformRect(pDict->GetRectFor("BBox")).GetOuterRect());
   }
   bool bAlphaMode = options.ColorModeIs(CPDF_RenderOptions::kAlpha);
+  // A draft only fills the clip with a single color if the shading would
+  // have painted all of it.
+  if (options.GetOptions().bDraft && !bAlphaMode &&
+      ShadingCoversRect(pPattern->GetShadingType(), pDict.Get(), mtMatrix,
+                        clip_rect_bbox)) {
+    absl::optional<FX_ARGB> draft_color =
+        GetDraftColor(pPattern->GetShadingType(), pDict.Get(),
+                      pPattern->GetFuncs(), pColorSpace, alpha);
+    if (draft_color.has_value()) {
+      pDevice->FillRect(clip_rect_bbox,
+                        options.TranslateColor(draft_color.value()));
+      return;
+    }
+  }
   if (pDevice->GetDeviceCaps(FXDC_RENDER_CAPS) & FXRC_SHADING &&
       pDevice->DrawShading(pPattern, &mtMatrix, clip_rect_bbox, alpha,
                            bAlphaMode)) {
@@ -926,54 +1004,49 @@ void CPDF_RenderShading::Draw(CFX_RenderDevice* pDevice,
   }
   const CFX_Matrix final_matrix = mtMatrix * buffer.GetMatrix();
   const auto& funcs = pPattern->GetFuncs();
+  PauseIndicatorIface* pPause = pContext->GetPauseIndicator();
   switch (pPattern->GetShadingType()) {
     case kInvalidShading:
     case kMaxShading:
       return;
     case kFunctionBasedShading:
       DrawFuncShading(pBitmap, final_matrix, pDict.Get(), funcs, pColorSpace,
-                      alpha);
+                      alpha, pPause);
       break;
     case kAxialShading:
       DrawAxialShading(pBitmap, final_matrix, pDict.Get(), funcs, pColorSpace,
-                       alpha);
+                       alpha, pPause);
       break;
     case kRadialShading:
       DrawRadialShading(pBitmap, final_matrix, pDict.Get(), funcs, pColorSpace,
-                        alpha);
+                        alpha, pPause);
       break;
     case kFreeFormGouraudTriangleMeshShading: {
-      // The shading object can be a stream or a dictionary. We do not handle
-      // the case of dictionary at the moment.
-      RetainPtr<const CPDF_Stream> pStream =
-          ToStream(pPattern->GetShadingObject());
-      if (pStream) {
-        DrawFreeGouraudShading(pBitmap, final_matrix, std::move(pStream), funcs,
-                               pColorSpace, alpha);
+      RetainPtr<CPDF_StreamAcc> pShadingAcc =
+          GetMeshStreamAcc(pContext->GetDocument(), pPattern);
+      if (pShadingAcc) {
+        DrawFreeGouraudShading(pBitmap, final_matrix, std::move(pShadingAcc),
+                               funcs, pColorSpace, alpha, pPause);
       }
       break;
     }
     case kLatticeFormGouraudTriangleMeshShading: {
-      // The shading object can be a stream or a dictionary. We do not handle
-      // the case of dictionary at the moment.
-      RetainPtr<const CPDF_Stream> pStream =
-          ToStream(pPattern->GetShadingObject());
-      if (pStream) {
-        DrawLatticeGouraudShading(pBitmap, final_matrix, std::move(pStream),
-                                  funcs, pColorSpace, alpha);
+      RetainPtr<CPDF_StreamAcc> pShadingAcc =
+          GetMeshStreamAcc(pContext->GetDocument(), pPattern);
+      if (pShadingAcc) {
+        DrawLatticeGouraudShading(pBitmap, final_matrix, std::move(pShadingAcc),
+                                  funcs, pColorSpace, alpha, pPause);
       }
       break;
     }
     case kCoonsPatchMeshShading:
     case kTensorProductPatchMeshShading: {
-      // The shading object can be a stream or a dictionary. We do not handle
-      // the case of dictionary at the moment.
-      RetainPtr<const CPDF_Stream> pStream =
-          ToStream(pPattern->GetShadingObject());
-      if (pStream) {
+      RetainPtr<CPDF_StreamAcc> pShadingAcc =
+          GetMeshStreamAcc(pContext->GetDocument(), pPattern);
+      if (pShadingAcc) {
         DrawCoonPatchMeshes(pPattern->GetShadingType(), pBitmap, final_matrix,
-                            std::move(pStream), funcs, pColorSpace,
-                            options.GetOptions().bNoPathSmooth, alpha);
+                            std::move(pShadingAcc), funcs, pColorSpace,
+                            options.GetOptions().bNoPathSmooth, alpha, pPause);
       }
       break;
     }
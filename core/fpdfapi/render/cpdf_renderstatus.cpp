@@ -9,6 +9,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <numeric>
 #include <set>
@@ -42,9 +43,11 @@
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fpdfapi/render/charposlist.h"
+#include "core/fpdfapi/render/cpdf_bitmappool.h"
 #include "core/fpdfapi/render/cpdf_docrenderdata.h"
 #include "core/fpdfapi/render/cpdf_imagerenderer.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
+#include "core/fpdfapi/render/cpdf_renderedbitmapcache.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfapi/render/cpdf_rendershading.h"
 #include "core/fpdfapi/render/cpdf_rendertiling.h"
@@ -52,6 +55,8 @@
 #include "core/fpdfapi/render/cpdf_textrenderer.h"
 #include "core/fpdfapi/render/cpdf_type3cache.h"
 #include "core/fxcrt/autorestorer.h"
+#include "core/fxcrt/cfx_renderprofile.h"
+#include "core/fxcrt/cfx_tracelog.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_2d_size.h"
 #include "core/fxcrt/fx_safe_types.h"
@@ -68,8 +73,10 @@
 #include "core/fxge/text_char_pos.h"
 #include "core/fxge/text_glyph_pos.h"
 #include "third_party/base/check.h"
+#include "third_party/base/check_op.h"
 #include "third_party/base/containers/contains.h"
 #include "third_party/base/notreached.h"
+#include "third_party/base/numerics/safe_conversions.h"
 #include "third_party/base/span.h"
 
 #if defined(_SKIA_SUPPORT_)
@@ -81,6 +88,10 @@ namespace {
 constexpr int kRenderMaxRecursionDepth = 64;
 int g_CurrentRecursionDepth = 0;
 
+// Form XObjects that would rasterize to more pixels than this are always
+// drawn directly.
+constexpr int kMaxCachedFormPixels = 1024 * 1024;
+
 CFX_FillRenderOptions GetFillOptionsForDrawPathWithBlend(
     const CPDF_RenderOptions::Options& options,
     const CPDF_PathObject* path_obj,
@@ -160,6 +171,38 @@ bool Type3CharMissingStrokeColor(const CPDF_Type3Char* pChar,
   return pChar && (!pChar->colored() || MissingStrokeColor(pColorState));
 }
 
+// Whether drawing the objects of `pForm` onto a transparent bitmap and then
+// compositing that bitmap looks the same as drawing them directly. That is not
+// the case when an object blends with the backdrop.
+bool CanRasterizeFormSeparately(const CPDF_Form* pForm) {
+  for (const auto& pObj : *pForm) {
+    if (pObj->m_GeneralState.GetBlendType() != BlendMode::kNormal)
+      return false;
+    const CPDF_FormObject* pFormObj = pObj->AsForm();
+    if (pFormObj && !CanRasterizeFormSeparately(pFormObj->form()))
+      return false;
+  }
+  return true;
+}
+
+uint32_t QuantizeFormParam(float value) {
+  return pdfium::base::saturated_cast<uint32_t>(std::lround(value * 4096));
+}
+
+// Returns how many pixels of the ARGB `bitmap` are not fully transparent.
+uint64_t CountTouchedPixels(const RetainPtr<CFX_DIBitmap>& bitmap) {
+  DCHECK_EQ(bitmap->GetFormat(), FXDIB_Format::kArgb);
+  uint64_t count = 0;
+  for (int row = 0; row < bitmap->GetHeight(); ++row) {
+    const uint8_t* alpha = bitmap->GetScanline(row).data() + 3;
+    for (int col = 0; col < bitmap->GetWidth(); ++col, alpha += 4) {
+      if (*alpha)
+        ++count;
+    }
+  }
+  return count;
+}
+
 }  // namespace
 
 CPDF_RenderStatus::CPDF_RenderStatus(CPDF_RenderContext* pContext,
@@ -172,6 +215,8 @@ void CPDF_RenderStatus::Initialize(const CPDF_RenderStatus* pParentStatus,
                                    const CPDF_GraphicStates* pInitialStates) {
   m_bPrint = m_pDevice->GetDeviceType() != DeviceType::kDisplay;
   m_pPageResource.Reset(m_pContext->GetPageResources());
+  // Lets big fills on scratch devices for groups and masks stop early too.
+  m_pDevice->SetPauseIndicator(m_pContext->GetPauseIndicator());
   if (pInitialStates && !m_pType3Char) {
     m_InitialStates.CopyStates(*pInitialStates);
     if (pParentStatus) {
@@ -213,13 +258,14 @@ void CPDF_RenderStatus::RenderObjectList(
       continue;
     }
     RenderSingleObject(pCurObj.get(), mtObj2Device);
-    if (m_bStopped)
+    if (m_bStopped || m_pContext->NeedToCancelNow())
       return;
   }
 }
 
 void CPDF_RenderStatus::RenderSingleObject(CPDF_PageObject* pObj,
                                            const CFX_Matrix& mtObj2Device) {
+  FX_TRACE_EVENT("pdfium.render", "CPDF_RenderStatus::RenderSingleObject");
   AutoRestorer<int> restorer(&g_CurrentRecursionDepth);
   if (++g_CurrentRecursionDepth > kRenderMaxRecursionDepth) {
     return;
@@ -238,6 +284,7 @@ void CPDF_RenderStatus::RenderSingleObject(CPDF_PageObject* pObj,
 bool CPDF_RenderStatus::ContinueSingleObject(CPDF_PageObject* pObj,
                                              const CFX_Matrix& mtObj2Device,
                                              PauseIndicatorIface* pPause) {
+  FX_TRACE_EVENT("pdfium.render", "CPDF_RenderStatus::ContinueSingleObject");
   if (m_pImageRenderer) {
     if (m_pImageRenderer->Continue(pPause))
       return true;
@@ -353,6 +400,9 @@ bool CPDF_RenderStatus::ProcessForm(const CPDF_FormObject* pFormObj,
     return true;
 
   CFX_Matrix matrix = pFormObj->form_matrix() * mtObj2Device;
+  if (m_Options.GetOptions().bCacheForms && DrawCachedForm(pFormObj, matrix))
+    return true;
+
   RetainPtr<const CPDF_Dictionary> pResources =
       pFormObj->form()->GetDict()->GetDictFor("Resources");
   CPDF_RenderStatus status(m_pContext, m_pDevice);
@@ -373,6 +423,7 @@ bool CPDF_RenderStatus::ProcessForm(const CPDF_FormObject* pFormObj,
 
 bool CPDF_RenderStatus::ProcessPath(CPDF_PathObject* path_obj,
                                     const CFX_Matrix& mtObj2Device) {
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kPath);
   CFX_FillRenderOptions::FillType fill_type = path_obj->filltype();
   bool stroke = path_obj->stroke();
   ProcessPathPattern(path_obj, mtObj2Device, &fill_type, &stroke);
@@ -408,6 +459,7 @@ bool CPDF_RenderStatus::ProcessPath(CPDF_PathObject* path_obj,
 RetainPtr<CPDF_TransferFunc> CPDF_RenderStatus::GetTransferFunc(
     RetainPtr<const CPDF_Object> pObj) const {
   DCHECK(pObj);
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kResourceLoad);
   auto* pDocCache = CPDF_DocRenderData::FromDocument(m_pContext->GetDocument());
   return pDocCache ? pDocCache->GetTransferFunc(std::move(pObj)) : nullptr;
 }
@@ -593,6 +645,7 @@ bool CPDF_RenderStatus::ProcessTransparency(CPDF_PageObject* pPageObj,
       !bTextClip && !bGroupTransparent) {
     return false;
   }
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kTransparency);
   if (m_bPrint) {
     bool bRet = false;
     int rendCaps = m_pDevice->GetRenderCaps();
@@ -608,33 +661,51 @@ bool CPDF_RenderStatus::ProcessTransparency(CPDF_PageObject* pPageObj,
     }
     return true;
   }
-  FX_RECT rect = pPageObj->GetTransformedBBox(mtObj2Device);
-  rect.Intersect(m_pDevice->GetClipBox());
+  // Every scratch bitmap below covers `rect` and nothing more. This matters
+  // most at print resolutions, where a page-sized buffer for a small object
+  // can take hundreds of megabytes.
+  FX_RECT rect = GetObjectClippedRect(pPageObj, mtObj2Device);
   if (rect.IsEmpty())
     return true;
 
   int width = rect.Width();
   int height = rect.Height();
-  CFX_DefaultRenderDevice bitmap_device;
+  const uint64_t pixels = static_cast<uint64_t>(width) * height;
+  CPDF_RenderContext::ScratchStats* pStats = m_pContext->GetScratchStats();
+  CPDF_BitmapPool* pPool = m_pContext->GetBitmapPool();
   RetainPtr<CFX_DIBitmap> backdrop;
-  if (!transparency.IsIsolated() &&
+  // Drafts treat all groups as isolated, which saves reading back the device.
+  if (!transparency.IsIsolated() && !m_Options.GetOptions().bDraft &&
       (m_pDevice->GetRenderCaps() & FXRC_GET_BITS)) {
-    backdrop = pdfium::MakeRetain<CFX_DIBitmap>();
-    if (!m_pDevice->CreateCompatibleBitmap(backdrop, width, height))
+    // `rect` is within the device, so GetDIBits() overwrites every pixel.
+    backdrop = pPool->Acquire(width, height,
+                              m_pDevice->GetCompatibleBitmapFormat(),
+                              /*bZero=*/false);
+    if (!backdrop)
       return true;
+    pStats->allocated_pixels += pixels;
     m_pDevice->GetDIBits(backdrop, rect.left, rect.top);
   }
-  if (!bitmap_device.Create(width, height, FXDIB_Format::kArgb, backdrop))
+  CFX_DefaultRenderDevice bitmap_device;
+  RetainPtr<CFX_DIBitmap> group_bitmap =
+      pPool->Acquire(width, height, FXDIB_Format::kArgb, /*bZero=*/true);
+  if (!group_bitmap || !bitmap_device.AttachWithBackdropAndGroupKnockout(
+                           group_bitmap, backdrop,
+                           /*bGroupKnockout=*/false)) {
     return true;
+  }
+  pStats->allocated_pixels += pixels;
 
   CFX_Matrix new_matrix = mtObj2Device;
   new_matrix.Translate(-rect.left, -rect.top);
 
   RetainPtr<CFX_DIBitmap> pTextMask;
   if (bTextClip) {
-    pTextMask = pdfium::MakeRetain<CFX_DIBitmap>();
-    if (!pTextMask->Create(width, height, FXDIB_Format::k8bppMask))
+    pTextMask =
+        pPool->Acquire(width, height, FXDIB_Format::k8bppMask, /*bZero=*/true);
+    if (!pTextMask)
       return true;
+    pStats->allocated_pixels += pixels;
 
     CFX_DefaultRenderDevice text_device;
     text_device.Attach(pTextMask);
@@ -660,6 +731,9 @@ bool CPDF_RenderStatus::ProcessTransparency(CPDF_PageObject* pPageObj,
   bitmap_render.SetFormResource(std::move(pFormResource));
   bitmap_render.Initialize(nullptr, nullptr);
   bitmap_render.ProcessObjectNoClip(pPageObj, new_matrix);
+  // Counting walks the whole group bitmap, so only do it for profiled renders.
+  if (m_pContext->GetProfile())
+    pStats->touched_pixels += CountTouchedPixels(group_bitmap);
 #if defined(_SKIA_SUPPORT_)
   if (CFX_DefaultRenderDevice::SkiaIsDefaultRenderer()) {
     // Safe because `CFX_SkiaDeviceDriver` always uses pre-multiplied alpha.
@@ -692,6 +766,114 @@ bool CPDF_RenderStatus::ProcessTransparency(CPDF_PageObject* pPageObj,
   return true;
 }
 
+bool CPDF_RenderStatus::DrawCachedForm(const CPDF_FormObject* pFormObj,
+                                       const CFX_Matrix& mtForm2Device) {
+  // Only plain display rendering composites the cached bitmap the same way
+  // the form's objects would have been drawn. Skia premultiplies bitmaps in
+  // place when compositing them, so it cannot share them.
+  if (m_bPrint || m_bLoadMask || m_pStopObj || m_pType3Char ||
+      m_curBlend != BlendMode::kNormal ||
+      CFX_DefaultRenderDevice::SkiaIsDefaultRenderer()) {
+    return false;
+  }
+
+  // Forms without their own resources use the page's, which differ between
+  // pages that share the form.
+  const CPDF_Form* pForm = pFormObj->form();
+  RetainPtr<const CPDF_Dictionary> pResources =
+      pForm->GetDict()->GetDictFor("Resources");
+  if (!pResources)
+    return false;
+
+  // Transparency groups are composited as a whole against the backdrop,
+  // which a plain cached bitmap does not reproduce.
+  if (pForm->GetTransparency().IsGroup())
+    return false;
+
+  // The objects of the form inherit the graphics state of the form object
+  // when they do not set it themselves.
+  std::vector<uint32_t> inherited_params;
+  const CPDF_ColorState& color_state = pFormObj->m_ColorState;
+  if (color_state.HasRef()) {
+    if (color_state.GetFillColor()->IsPattern() ||
+        color_state.GetStrokeColor()->IsPattern()) {
+      return false;
+    }
+    inherited_params.push_back(color_state.GetFillColorRef());
+    inherited_params.push_back(color_state.GetStrokeColorRef());
+  }
+  inherited_params.push_back(
+      QuantizeFormParam(pFormObj->m_GeneralState.GetFillAlpha()));
+  inherited_params.push_back(
+      QuantizeFormParam(pFormObj->m_GeneralState.GetStrokeAlpha()));
+  inherited_params.push_back(
+      QuantizeFormParam(pFormObj->m_GraphState.GetLineWidth()));
+
+  // Split the whole device pixels off the translation, so occurrences at
+  // different positions with the same subpixel offset share the bitmap.
+  const float origin_x = std::floor(mtForm2Device.e);
+  const float origin_y = std::floor(mtForm2Device.f);
+  if (!pdfium::base::IsValueInRangeForNumericType<int>(origin_x) ||
+      !pdfium::base::IsValueInRangeForNumericType<int>(origin_y)) {
+    return false;
+  }
+  CFX_Matrix mtForm2Bitmap = mtForm2Device;
+  mtForm2Bitmap.e -= origin_x;
+  mtForm2Bitmap.f -= origin_y;
+  mtForm2Bitmap = CPDF_RenderedBitmapCache::DequantizeMatrix(
+      CPDF_RenderedBitmapCache::QuantizeMatrix(mtForm2Bitmap));
+
+  const FX_RECT rect =
+      mtForm2Bitmap.TransformRect(pForm->CalcBoundingBox()).GetOuterRect();
+  if (rect.IsEmpty())
+    return false;
+
+  FX_SAFE_INT32 pixels = rect.Width();
+  pixels *= rect.Height();
+  if (!pixels.IsValid() || pixels.ValueOrDie() > kMaxCachedFormPixels)
+    return false;
+
+  CPDF_DocRenderData* pRenderData =
+      CPDF_DocRenderData::FromDocument(m_pContext->GetDocument());
+  if (!pRenderData)
+    return false;
+
+  CPDF_RenderedBitmapCache::Key key = CPDF_RenderedBitmapCache::MakeKey(
+      CPDF_RenderedBitmapCache::Type::kForm, pForm->GetStream(),
+      mtForm2Bitmap, rect.Width(), rect.Height(), m_Options);
+  key.params.insert(key.params.end(), inherited_params.begin(),
+                    inherited_params.end());
+
+  CPDF_RenderedBitmapCache* pCache = pRenderData->GetRenderedBitmapCache();
+  RetainPtr<CFX_DIBitmap> pBitmap = pCache->Find(key);
+  if (!pBitmap) {
+    if (!CanRasterizeFormSeparately(pForm))
+      return false;
+
+    CFX_DefaultRenderDevice bitmap_device;
+    if (!bitmap_device.Create(rect.Width(), rect.Height(), FXDIB_Format::kArgb,
+                              nullptr)) {
+      return false;
+    }
+    mtForm2Bitmap.Translate(-rect.left, -rect.top);
+    CPDF_RenderStatus status(m_pContext, &bitmap_device);
+    status.SetOptions(m_Options);
+    status.SetDropObjects(m_bDropObjects);
+    status.SetFormResource(std::move(pResources));
+    status.Initialize(this, pFormObj);
+    status.RenderObjectList(pForm, mtForm2Bitmap);
+    pBitmap = bitmap_device.GetBitmap();
+    // A cancelled rendering leaves the form partly drawn, and the cache
+    // outlives this rendering.
+    if (!m_pContext->NeedToCancelNow())
+      pCache->Add(key, pBitmap);
+  }
+  CompositeDIBitmap(pBitmap, static_cast<int>(origin_x) + rect.left,
+                    static_cast<int>(origin_y) + rect.top, 0, 255,
+                    BlendMode::kNormal, m_Transparency);
+  return true;
+}
+
 FX_RECT CPDF_RenderStatus::GetClippedBBox(const FX_RECT& rect) const {
   FX_RECT bbox = rect;
   bbox.Intersect(m_pDevice->GetClipBox());
@@ -702,23 +884,26 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderStatus::GetBackdrop(
     const CPDF_PageObject* pObj,
     const FX_RECT& bbox,
     bool bBackAlphaRequired) {
-  int width = bbox.Width();
-  int height = bbox.Height();
-  auto pBackdrop = pdfium::MakeRetain<CFX_DIBitmap>();
-  if (bBackAlphaRequired && !m_bDropObjects)
-    pBackdrop->Create(width, height, FXDIB_Format::kArgb);
-  else
-    m_pDevice->CreateCompatibleBitmap(pBackdrop, width, height);
-
-  if (pBackdrop->GetBuffer().empty())
-    return nullptr;
-
+  const FXDIB_Format format = bBackAlphaRequired && !m_bDropObjects
+                                  ? FXDIB_Format::kArgb
+                                  : m_pDevice->GetCompatibleBitmapFormat();
+  const bool bAlpha = format == FXDIB_Format::kArgb;
   bool bNeedDraw;
-  if (pBackdrop->IsAlphaFormat())
+  if (bAlpha)
     bNeedDraw = !(m_pDevice->GetRenderCaps() & FXRC_ALPHA_OUTPUT);
   else
     bNeedDraw = !(m_pDevice->GetRenderCaps() & FXRC_GET_BITS);
 
+  // Only a transparent backdrop that gets drawn into needs clearing. Opaque
+  // ones get cleared to white below, and GetDIBits() overwrites the rest.
+  RetainPtr<CFX_DIBitmap> pBackdrop = m_pContext->GetBitmapPool()->Acquire(
+      bbox.Width(), bbox.Height(), format,
+      /*bZero=*/bNeedDraw && bAlpha);
+  if (!pBackdrop)
+    return nullptr;
+  m_pContext->GetScratchStats()->allocated_pixels +=
+      static_cast<uint64_t>(bbox.Width()) * bbox.Height();
+
   if (!bNeedDraw) {
     m_pDevice->GetDIBits(pBackdrop, bbox.left, bbox.top);
     return pBackdrop;
@@ -762,6 +947,7 @@ bool CPDF_RenderStatus::ProcessText(CPDF_TextObject* textobj,
   if (textobj->GetCharCodes().empty())
     return true;
 
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kText);
   const TextRenderingMode text_render_mode = textobj->m_TextState.GetTextMode();
   if (text_render_mode == TextRenderingMode::MODE_INVISIBLE)
     return true;
@@ -1300,9 +1486,11 @@ void CPDF_RenderStatus::CompositeDIBitmap(
                                pDIBitmap, 0, 0, blend_mode, nullptr, false);
   }
 
-  auto pBackdrop1 = pdfium::MakeRetain<CFX_DIBitmap>();
-  pBackdrop1->Create(pBackdrop->GetWidth(), pBackdrop->GetHeight(),
-                     FXDIB_Format::kRgb32);
+  RetainPtr<CFX_DIBitmap> pBackdrop1 = m_pContext->GetBitmapPool()->Acquire(
+      pBackdrop->GetWidth(), pBackdrop->GetHeight(), FXDIB_Format::kRgb32,
+      /*bZero=*/false);
+  if (!pBackdrop1)
+    return;
   pBackdrop1->Clear((uint32_t)-1);
   pBackdrop1->CompositeBitmap(0, 0, pBackdrop->GetWidth(),
                               pBackdrop->GetHeight(), pBackdrop, 0, 0,
@@ -1323,15 +1511,79 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderStatus::LoadSMask(
   if (!pGroup)
     return nullptr;
 
+  CPDF_DocRenderData* pRenderData =
+      CPDF_DocRenderData::FromDocument(m_pContext->GetDocument());
+  if (!pRenderData)
+    return RenderSMask(pSMaskDict, std::move(pGroup), *pClipRect, mtMatrix);
+
+  CPDF_RenderedBitmapCache* pCache = pRenderData->GetRenderedBitmapCache();
+  auto make_key = [&](const FX_RECT& rect) {
+    CFX_Matrix matrix = mtMatrix;
+    matrix.Translate(-rect.left, -rect.top);
+    CPDF_RenderedBitmapCache::Key key = CPDF_RenderedBitmapCache::MakeKey(
+        CPDF_RenderedBitmapCache::Type::kSoftMask,
+        pdfium::WrapRetain(pSMaskDict), matrix, rect.Width(), rect.Height(),
+        m_Options);
+    if (!pGroup->GetDict()->KeyExist("Resources"))
+      key.resources = pdfium::WrapRetain(m_pContext->GetPageResources());
+    key.params.push_back(m_bDropObjects);
+    return key;
+  };
+
+  // Objects that share a soft mask usually lie within the bounding box of its
+  // group, so once a mask gets used again, compute it for all of that box.
+  FX_RECT group_rect =
+      mtMatrix.TransformRect(pGroup->GetDict()->GetRectFor("BBox"))
+          .GetOuterRect();
+  group_rect.Intersect(0, 0, m_pDevice->GetWidth(), m_pDevice->GetHeight());
+  FX_RECT covered_rect = group_rect;
+  covered_rect.Intersect(*pClipRect);
+  const int64_t group_pixels =
+      static_cast<int64_t>(group_rect.Width()) * group_rect.Height();
+  const int64_t clip_pixels =
+      static_cast<int64_t>(pClipRect->Width()) * pClipRect->Height();
+  const int use_count = m_pContext->CountSoftMaskUse(pSMaskDict);
+  if (covered_rect == *pClipRect && !group_rect.IsEmpty() &&
+      group_pixels <= static_cast<int64_t>(pCache->GetByteBudget() / 2)) {
+    const CPDF_RenderedBitmapCache::Key key = make_key(group_rect);
+    RetainPtr<CFX_DIBitmap> pMask = pCache->Find(key);
+    if (!pMask && (use_count > 1 || group_pixels <= 4 * clip_pixels)) {
+      pMask = RenderSMask(pSMaskDict, pGroup, group_rect, mtMatrix);
+      // Cancelling leaves the mask partly drawn. Use it, but do not cache it.
+      if (pMask && !m_pContext->NeedToCancelNow())
+        pCache->Add(key, pMask);
+    }
+    if (pMask) {
+      if (group_rect == *pClipRect)
+        return pMask;
+
+      FX_RECT clip_rect = *pClipRect;
+      clip_rect.Offset(-group_rect.left, -group_rect.top);
+      return pMask->ClipTo(clip_rect);
+    }
+  }
+
+  const CPDF_RenderedBitmapCache::Key key = make_key(*pClipRect);
+  RetainPtr<CFX_DIBitmap> pMask = pCache->Find(key);
+  if (!pMask) {
+    pMask = RenderSMask(pSMaskDict, std::move(pGroup), *pClipRect, mtMatrix);
+    if (pMask && !m_pContext->NeedToCancelNow())
+      pCache->Add(key, pMask);
+  }
+  return pMask;
+}
+
+RetainPtr<CFX_DIBitmap> CPDF_RenderStatus::RenderSMask(
+    const CPDF_Dictionary* pSMaskDict,
+    RetainPtr<CPDF_Stream> pGroup,
+    const FX_RECT& rect,
+    const CFX_Matrix& mtMatrix) {
   std::unique_ptr<CPDF_Function> pFunc;
   RetainPtr<const CPDF_Object> pFuncObj =
       pSMaskDict->GetDirectObjectFor(pdfium::transparency::kTR);
   if (pFuncObj && (pFuncObj->IsDictionary() || pFuncObj->IsStream()))
     pFunc = CPDF_Function::Load(std::move(pFuncObj));
 
-  CFX_Matrix matrix = mtMatrix;
-  matrix.Translate(-pClipRect->left, -pClipRect->top);
-
   CPDF_Form form(m_pContext->GetDocument(),
                  m_pContext->GetMutablePageResources(), pGroup);
   form.ParseContent();
@@ -1340,8 +1592,22 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderStatus::LoadSMask(
   bool bLuminosity =
       pSMaskDict->GetByteStringFor(pdfium::transparency::kSoftMaskSubType) !=
       pdfium::transparency::kAlpha;
-  int width = pClipRect->right - pClipRect->left;
-  int height = pClipRect->bottom - pClipRect->top;
+
+  // Luminosity masks are rendered in color and then converted, which is
+  // where most of the time goes, so those can be evaluated at half
+  // resolution.
+  int width = rect.Width();
+  int height = rect.Height();
+  const int full_width = width;
+  const int full_height = height;
+  CFX_Matrix matrix = mtMatrix;
+  matrix.Translate(-rect.left, -rect.top);
+  if (bLuminosity && m_Options.GetOptions().bLowResSoftMasks &&
+      width > 1 && height > 1) {
+    width = (width + 1) / 2;
+    height = (height + 1) / 2;
+    matrix.Scale(0.5f, 0.5f);
+  }
   FXDIB_Format format = GetFormatForLuminosity(bLuminosity);
   if (!bitmap_device.Create(width, height, format, nullptr))
     return nullptr;
@@ -1361,6 +1627,8 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderStatus::LoadSMask(
   CPDF_RenderOptions options;
   options.SetColorMode(bLuminosity ? CPDF_RenderOptions::kNormal
                                    : CPDF_RenderOptions::kAlpha);
+  options.GetOptions().bLowResSoftMasks =
+      m_Options.GetOptions().bLowResSoftMasks;
   CPDF_RenderStatus status(m_pContext, &bitmap_device);
   status.SetOptions(options);
   status.SetGroupFamily(nCSFamily);
@@ -1411,7 +1679,11 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderStatus::LoadSMask(
   } else {
     fxcrt::spancpy(dest_buf, src_buf.first(dest_pitch * height));
   }
-  return pMask;
+  if (width == full_width && height == full_height)
+    return pMask;
+
+  return pMask->StretchTo(full_width, full_height, FXDIB_ResampleOptions(),
+                          nullptr);
 }
 
 FX_ARGB CPDF_RenderStatus::GetBackColor(const CPDF_Dictionary* pSMaskDict,
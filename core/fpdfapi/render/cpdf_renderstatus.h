@@ -36,6 +36,7 @@ class CPDF_PathObject;
 class CPDF_RenderContext;
 class CPDF_ShadingObject;
 class CPDF_ShadingPattern;
+class CPDF_Stream;
 class CPDF_TilingPattern;
 class CPDF_TransferFunc;
 class CPDF_Type3Char;
@@ -165,13 +166,24 @@ class CPDF_RenderStatus {
                                bool stroke);
   bool ProcessForm(const CPDF_FormObject* pFormObj,
                    const CFX_Matrix& mtObj2Device);
+  // Composites the form's objects from a bitmap cached in the document's
+  // CPDF_RenderedBitmapCache. Returns false if the form has to be drawn
+  // directly instead.
+  bool DrawCachedForm(const CPDF_FormObject* pFormObj,
+                      const CFX_Matrix& mtForm2Device);
   FX_RECT GetClippedBBox(const FX_RECT& rect) const;
   RetainPtr<CFX_DIBitmap> GetBackdrop(const CPDF_PageObject* pObj,
                                       const FX_RECT& bbox,
                                       bool bBackAlphaRequired);
+  // Returns the soft mask for `pClipRect`, possibly from the document's
+  // CPDF_RenderedBitmapCache. Callers must not modify it.
   RetainPtr<CFX_DIBitmap> LoadSMask(CPDF_Dictionary* pSMaskDict,
                                     FX_RECT* pClipRect,
                                     const CFX_Matrix& mtMatrix);
+  RetainPtr<CFX_DIBitmap> RenderSMask(const CPDF_Dictionary* pSMaskDict,
+                                      RetainPtr<CPDF_Stream> pGroup,
+                                      const FX_RECT& rect,
+                                      const CFX_Matrix& mtMatrix);
   // Optionally write the colorspace family value into |pCSFamily|.
   FX_ARGB GetBackColor(const CPDF_Dictionary* pSMaskDict,
                        const CPDF_Dictionary* pGroupDict,
@@ -13,7 +13,10 @@
 #include "core/fpdfapi/page/cpdf_pageimagecache.h"
 #include "core/fpdfapi/page/cpdf_tilingpattern.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/render/cpdf_docrenderdata.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
+#include "core/fpdfapi/render/cpdf_renderedbitmapcache.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfapi/render/cpdf_renderstatus.h"
 #include "core/fxcrt/fx_safe_types.h"
@@ -24,6 +27,7 @@ namespace {
 RetainPtr<CFX_DIBitmap> DrawPatternBitmap(
     CPDF_Document* pDoc,
     CPDF_PageImageCache* pCache,
+    PauseIndicatorIface* pPause,
     CPDF_TilingPattern* pPattern,
     CPDF_Form* pPatternForm,
     const CFX_Matrix& mtObject2Device,
@@ -55,6 +59,7 @@ RetainPtr<CFX_DIBitmap> DrawPatternBitmap(
   options.GetOptions().bForceHalftone = true;
 
   CPDF_RenderContext context(pDoc, nullptr, pCache);
+  context.SetPauseIndicator(pPause);
   context.AppendLayer(pPatternForm, mtPattern2Bitmap);
   context.Render(&bitmap_device, nullptr, &options, nullptr);
 
@@ -65,6 +70,78 @@ RetainPtr<CFX_DIBitmap> DrawPatternBitmap(
   return pBitmap;
 }
 
+RetainPtr<CFX_DIBitmap> RenderPatternCell(CPDF_RenderContext* pContext,
+                                          CPDF_TilingPattern* pPattern,
+                                          CPDF_Form* pPatternForm,
+                                          const CFX_Matrix& mtObj2Device,
+                                          int width,
+                                          int height,
+                                          const CPDF_RenderOptions& options) {
+  RetainPtr<CFX_DIBitmap> pPatternBitmap;
+  if (width * height < 16) {
+    RetainPtr<CFX_DIBitmap> pEnlargedBitmap = DrawPatternBitmap(
+        pContext->GetDocument(), pContext->GetPageCache(),
+        pContext->GetPauseIndicator(), pPattern, pPatternForm, mtObj2Device, 8,
+        8, options.GetOptions());
+    if (!pEnlargedBitmap)
+      return nullptr;
+    pPatternBitmap = pEnlargedBitmap->StretchTo(
+        width, height, FXDIB_ResampleOptions(), nullptr);
+  } else {
+    pPatternBitmap = DrawPatternBitmap(
+        pContext->GetDocument(), pContext->GetPageCache(),
+        pContext->GetPauseIndicator(), pPattern, pPatternForm, mtObj2Device,
+        width, height, options.GetOptions());
+  }
+  if (!pPatternBitmap)
+    return nullptr;
+
+  if (options.ColorModeIs(CPDF_RenderOptions::kGray))
+    pPatternBitmap->ConvertColorScale(0, 0xffffff);
+  return pPatternBitmap;
+}
+
+// Returns the rendered cell from the document's cache when the same pattern
+// was already rendered with the same scale and rotation. The translation does
+// not matter, as DrawPatternBitmap() maps the cell onto the bitmap. Uncolored
+// cells are alpha masks that only get their color when composited, so the
+// fill color does not matter either.
+RetainPtr<CFX_DIBitmap> GetPatternBitmap(
+    CPDF_RenderContext* pContext,
+    CPDF_TilingPattern* pPattern,
+    CPDF_Form* pPatternForm,
+    const CFX_Matrix& mtObj2Device,
+    const CFX_Matrix& mtPattern2Device,
+    int width,
+    int height,
+    const CPDF_RenderOptions& options) {
+  CPDF_DocRenderData* pRenderData =
+      CPDF_DocRenderData::FromDocument(pContext->GetDocument());
+  if (!pRenderData) {
+    return RenderPatternCell(pContext, pPattern, pPatternForm, mtObj2Device,
+                             width, height, options);
+  }
+
+  const CPDF_RenderedBitmapCache::Key key = CPDF_RenderedBitmapCache::MakeKey(
+      CPDF_RenderedBitmapCache::Type::kTilingPatternCell,
+      pPatternForm->GetStream(),
+      CFX_Matrix(mtPattern2Device.a, mtPattern2Device.b, mtPattern2Device.c,
+                 mtPattern2Device.d, 0, 0),
+      width, height, options);
+
+  CPDF_RenderedBitmapCache* pCache = pRenderData->GetRenderedBitmapCache();
+  RetainPtr<CFX_DIBitmap> pCached = pCache->Find(key);
+  if (pCached)
+    return pCached;
+
+  RetainPtr<CFX_DIBitmap> pPatternBitmap = RenderPatternCell(
+      pContext, pPattern, pPatternForm, mtObj2Device, width, height, options);
+  // A cancelled rendering leaves the cell partly drawn.
+  if (pPatternBitmap && !pContext->NeedToCancelNow())
+    pCache->Add(key, pPatternBitmap);
+  return pPatternBitmap;
+}
+
 }  // namespace
 
 // static
@@ -169,24 +246,12 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderTiling::Draw(
   }
   float left_offset = cell_bbox.left - mtPattern2Device.e;
   float top_offset = cell_bbox.bottom - mtPattern2Device.f;
-  RetainPtr<CFX_DIBitmap> pPatternBitmap;
-  if (width * height < 16) {
-    RetainPtr<CFX_DIBitmap> pEnlargedBitmap = DrawPatternBitmap(
-        pContext->GetDocument(), pContext->GetPageCache(), pPattern,
-        pPatternForm, mtObj2Device, 8, 8, options.GetOptions());
-    pPatternBitmap = pEnlargedBitmap->StretchTo(
-        width, height, FXDIB_ResampleOptions(), nullptr);
-  } else {
-    pPatternBitmap = DrawPatternBitmap(
-        pContext->GetDocument(), pContext->GetPageCache(), pPattern,
-        pPatternForm, mtObj2Device, width, height, options.GetOptions());
-  }
+  RetainPtr<CFX_DIBitmap> pPatternBitmap = GetPatternBitmap(
+      pContext, pPattern, pPatternForm, mtObj2Device, mtPattern2Device, width,
+      height, options);
   if (!pPatternBitmap)
     return nullptr;
 
-  if (options.ColorModeIs(CPDF_RenderOptions::kGray))
-    pPatternBitmap->ConvertColorScale(0, 0xffffff);
-
   FX_ARGB fill_argb = pRenderStatus->GetFillArgb(pPageObj);
   int clip_width = clip_box.right - clip_box.left;
   int clip_height = clip_box.bottom - clip_box.top;
@@ -6,7 +6,10 @@
 
 #include "core/fpdfapi/render/cpdf_scaledrenderbuffer.h"
 
+#include <utility>
+
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/render/cpdf_bitmappool.h"
 #include "core/fpdfapi/render/cpdf_devicebuffer.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
@@ -51,9 +54,12 @@ bool CPDF_ScaledRenderBuffer::Initialize(CPDF_RenderContext* pContext,
     if (!pitch_size.has_value())
       return false;
 
-    if (pitch_size.value().size <= kImageSizeLimitBytes &&
-        m_pBitmapDevice->Create(width, height, dibFormat, nullptr)) {
-      break;
+    if (pitch_size.value().size <= kImageSizeLimitBytes) {
+      // GetBackground() below fills the whole bitmap.
+      RetainPtr<CFX_DIBitmap> pBitmap = pContext->GetBitmapPool()->Acquire(
+          width, height, dibFormat, /*bZero=*/false);
+      if (pBitmap && m_pBitmapDevice->Attach(std::move(pBitmap)))
+        break;
     }
     m_Matrix.Scale(0.5f, 0.5f);
   }
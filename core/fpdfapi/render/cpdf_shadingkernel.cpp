@@ -0,0 +1,592 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_shadingkernel.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "build/build_config.h"
+#include "core/fpdfapi/page/cpdf_meshstream.h"
+#include "core/fxcrt/fx_system.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "third_party/base/check_op.h"
+#include "third_party/base/cxx17_backports.h"
+#include "third_party/base/numerics/safe_conversions.h"
+
+#if defined(ARCH_CPU_X86_FAMILY) && (defined(__SSE2__) || defined(_M_X64))
+#define SHADING_SSE2
+#include <emmintrin.h>
+#elif defined(ARCH_CPU_ARM64)
+#define SHADING_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+bool g_simd_disabled_for_testing = false;
+
+// A triangle edge from vertex `first` to vertex `second`, in the triangle's
+// winding order, with the differences that every scanline needs.
+struct GouraudEdge {
+  void Init(const CPDF_MeshVertex& first, const CPDF_MeshVertex& second) {
+    x = first.position.x;
+    y = first.position.y;
+    r = first.r;
+    g = first.g;
+    b = first.b;
+    dx = second.position.x - x;
+    dy = second.position.y - y;
+    dr = second.r - r;
+    dg = second.g - g;
+    db = second.b - b;
+    bHorizontal = first.position.y == second.position.y;
+    y_end = second.position.y;
+  }
+
+  // Sets `first_row` and `last_row` to the scanlines within
+  // [`min_row`, `max_row`] that cross the edge, endpoints included. Leaves
+  // the range empty for horizontal edges, which no scanline crosses.
+  void SetRows(int min_row, int max_row) {
+    first_row = max_row + 1;
+    last_row = max_row;
+    if (bHorizontal)
+      return;
+
+    const float top = std::max(ceilf(std::min(y, y_end)),
+                               static_cast<float>(min_row));
+    const float bottom = std::min(floorf(std::max(y, y_end)),
+                                  static_cast<float>(max_row));
+    if (!(top <= bottom))
+      return;
+
+    first_row = static_cast<int>(top);
+    last_row = static_cast<int>(bottom);
+  }
+
+  float x;
+  float y;
+  float r;
+  float g;
+  float b;
+  float dx;
+  float dy;
+  float dr;
+  float dg;
+  float db;
+  float y_end;
+  int first_row;
+  int last_row;
+  bool bHorizontal;
+};
+
+// Fills row `y` of `pBitmap` between the scanline's crossings of `edge1` and
+// `edge2`. Edge positions are evaluated from the edge's first vertex on every
+// row rather than accumulated, so long edges do not drift.
+void DrawGouraudSpan(CFX_DIBitmap* pBitmap,
+                     int alpha,
+                     int y,
+                     const GouraudEdge& edge1,
+                     const GouraudEdge& edge2) {
+  const float scan_y = static_cast<float>(y);
+  const GouraudEdge* crossed[2] = {&edge1, &edge2};
+  float inter_x[2];
+  float r[2];
+  float g[2];
+  float b[2];
+  for (int i = 0; i < 2; i++) {
+    const GouraudEdge& edge = *crossed[i];
+    inter_x[i] = edge.x + (edge.dx * (scan_y - edge.y) / edge.dy);
+    float y_dist = (scan_y - edge.y) / edge.dy;
+    r[i] = edge.r + (edge.dr * y_dist);
+    g[i] = edge.g + (edge.dg * y_dist);
+    b[i] = edge.b + (edge.db * y_dist);
+  }
+
+  const int start_index = inter_x[0] < inter_x[1] ? 0 : 1;
+  const int end_index = 1 - start_index;
+  const int span_min_x = static_cast<int>(floorf(inter_x[start_index]));
+  const int span_max_x = static_cast<int>(ceilf(inter_x[end_index]));
+  const int width = pBitmap->GetWidth();
+  const int start_x = pdfium::clamp(span_min_x, 0, width);
+  const int end_x = pdfium::clamp(span_max_x, 0, width);
+  if (start_x >= end_x)
+    return;
+
+  float r_unit = (r[end_index] - r[start_index]) / (span_max_x - span_min_x);
+  float g_unit = (g[end_index] - g[start_index]) / (span_max_x - span_min_x);
+  float b_unit = (b[end_index] - b[start_index]) / (span_max_x - span_min_x);
+  float r_result = r[start_index] + (start_x - span_min_x) * r_unit;
+  float g_result = g[start_index] + (start_x - span_min_x) * g_unit;
+  float b_result = b[start_index] + (start_x - span_min_x) * b_unit;
+  uint8_t* dib_buf =
+      pBitmap->GetWritableScanline(y).subspan(start_x * 4).data();
+  for (int x = start_x; x < end_x; x++) {
+    r_result += r_unit;
+    g_result += g_unit;
+    b_result += b_unit;
+    FXARGB_SETDIB(dib_buf, ArgbEncode(alpha, static_cast<int>(r_result * 255),
+                                      static_cast<int>(g_result * 255),
+                                      static_cast<int>(b_result * 255)));
+    dib_buf += 4;
+  }
+}
+
+int32_t ClampIndex(int32_t index, bool bStartExtend, bool bEndExtend) {
+  if (index < 0)
+    return bStartExtend ? 0 : -1;
+  if (index >= kShadingSteps)
+    return bEndExtend ? kShadingSteps - 1 : -1;
+  return index;
+}
+
+#if defined(SHADING_SSE2) || defined(SHADING_NEON)
+
+constexpr int kLanes = 4;
+
+// Thin wrappers so each kernel is written once for both instruction sets.
+// Every operation rounds exactly like its scalar counterpart, and lane masks
+// are integer vectors with all bits set for true lanes.
+#if defined(SHADING_SSE2)
+using FloatVec = __m128;
+using IntVec = __m128i;
+
+FloatVec Splat(float value) {
+  return _mm_set1_ps(value);
+}
+IntVec IntSplat(int32_t value) {
+  return _mm_set1_epi32(value);
+}
+FloatVec Columns(int column) {
+  return _mm_cvtepi32_ps(
+      _mm_add_epi32(_mm_set1_epi32(column), _mm_setr_epi32(0, 1, 2, 3)));
+}
+FloatVec Add(FloatVec a, FloatVec b) {
+  return _mm_add_ps(a, b);
+}
+FloatVec Sub(FloatVec a, FloatVec b) {
+  return _mm_sub_ps(a, b);
+}
+FloatVec Mul(FloatVec a, FloatVec b) {
+  return _mm_mul_ps(a, b);
+}
+FloatVec Div(FloatVec a, FloatVec b) {
+  return _mm_div_ps(a, b);
+}
+FloatVec Sqrt(FloatVec a) {
+  return _mm_sqrt_ps(a);
+}
+FloatVec Negate(FloatVec a) {
+  return _mm_xor_ps(a, _mm_set1_ps(-0.0f));
+}
+FloatVec Abs(FloatVec a) {
+  return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+}
+IntVec Less(FloatVec a, FloatVec b) {
+  return _mm_castps_si128(_mm_cmplt_ps(a, b));
+}
+IntVec LessEqual(FloatVec a, FloatVec b) {
+  return _mm_castps_si128(_mm_cmple_ps(a, b));
+}
+IntVec GreaterEqual(FloatVec a, FloatVec b) {
+  return _mm_castps_si128(_mm_cmpge_ps(a, b));
+}
+FloatVec Select(IntVec mask, FloatVec a, FloatVec b) {
+  const __m128 float_mask = _mm_castsi128_ps(mask);
+  return _mm_or_ps(_mm_and_ps(float_mask, a), _mm_andnot_ps(float_mask, b));
+}
+IntVec Truncate(FloatVec a) {
+  return _mm_cvttps_epi32(a);
+}
+IntVec IntLess(IntVec a, IntVec b) {
+  return _mm_cmplt_epi32(a, b);
+}
+IntVec IntGreater(IntVec a, IntVec b) {
+  return _mm_cmpgt_epi32(a, b);
+}
+IntVec IntSelect(IntVec mask, IntVec a, IntVec b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+IntVec Or(IntVec a, IntVec b) {
+  return _mm_or_si128(a, b);
+}
+bool AnyLane(IntVec mask) {
+  return _mm_movemask_epi8(mask) != 0;
+}
+void Store(int32_t* dest, IntVec value) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), value);
+}
+#else
+using FloatVec = float32x4_t;
+using IntVec = int32x4_t;
+
+FloatVec Splat(float value) {
+  return vdupq_n_f32(value);
+}
+IntVec IntSplat(int32_t value) {
+  return vdupq_n_s32(value);
+}
+FloatVec Columns(int column) {
+  static constexpr int32_t kOffsets[kLanes] = {0, 1, 2, 3};
+  return vcvtq_f32_s32(vaddq_s32(vdupq_n_s32(column), vld1q_s32(kOffsets)));
+}
+FloatVec Add(FloatVec a, FloatVec b) {
+  return vaddq_f32(a, b);
+}
+FloatVec Sub(FloatVec a, FloatVec b) {
+  return vsubq_f32(a, b);
+}
+FloatVec Mul(FloatVec a, FloatVec b) {
+  return vmulq_f32(a, b);
+}
+FloatVec Div(FloatVec a, FloatVec b) {
+  return vdivq_f32(a, b);
+}
+FloatVec Sqrt(FloatVec a) {
+  return vsqrtq_f32(a);
+}
+FloatVec Negate(FloatVec a) {
+  return vnegq_f32(a);
+}
+FloatVec Abs(FloatVec a) {
+  return vabsq_f32(a);
+}
+IntVec Less(FloatVec a, FloatVec b) {
+  return vreinterpretq_s32_u32(vcltq_f32(a, b));
+}
+IntVec LessEqual(FloatVec a, FloatVec b) {
+  return vreinterpretq_s32_u32(vcleq_f32(a, b));
+}
+IntVec GreaterEqual(FloatVec a, FloatVec b) {
+  return vreinterpretq_s32_u32(vcgeq_f32(a, b));
+}
+FloatVec Select(IntVec mask, FloatVec a, FloatVec b) {
+  return vbslq_f32(vreinterpretq_u32_s32(mask), a, b);
+}
+IntVec Truncate(FloatVec a) {
+  return vcvtq_s32_f32(a);
+}
+IntVec IntLess(IntVec a, IntVec b) {
+  return vreinterpretq_s32_u32(vcltq_s32(a, b));
+}
+IntVec IntGreater(IntVec a, IntVec b) {
+  return vreinterpretq_s32_u32(vcgtq_s32(a, b));
+}
+IntVec IntSelect(IntVec mask, IntVec a, IntVec b) {
+  return vbslq_s32(vreinterpretq_u32_s32(mask), a, b);
+}
+IntVec Or(IntVec a, IntVec b) {
+  return vorrq_s32(a, b);
+}
+bool AnyLane(IntVec mask) {
+  return vmaxvq_u32(vreinterpretq_u32_s32(mask)) != 0;
+}
+void Store(int32_t* dest, IntVec value) {
+  vst1q_s32(dest, value);
+}
+#endif
+
+// Vector version of ClampIndex().
+IntVec ClampIndices(IntVec index, bool bStartExtend, bool bEndExtend) {
+  IntVec below = IntLess(index, IntSplat(0));
+  IntVec above = IntGreater(index, IntSplat(kShadingSteps - 1));
+  index = IntSelect(below, IntSplat(bStartExtend ? 0 : -1), index);
+  return IntSelect(above, IntSplat(bEndExtend ? kShadingSteps - 1 : -1),
+                   index);
+}
+
+#endif  // defined(SHADING_SSE2) || defined(SHADING_NEON)
+
+}  // namespace
+
+CPDF_AxialShadingKernel::CPDF_AxialShadingKernel(
+    const CFX_Matrix& mtBitmap2Object,
+    const CFX_PointF& start,
+    const CFX_PointF& end,
+    bool bStartExtend,
+    bool bEndExtend)
+    : m_Matrix(mtBitmap2Object),
+      m_Start(start),
+      m_XSpan(end.x - start.x),
+      m_YSpan(end.y - start.y),
+      m_AxisLenSquare((m_XSpan * m_XSpan) + (m_YSpan * m_YSpan)),
+      m_bStartExtend(bStartExtend),
+      m_bEndExtend(bEndExtend) {}
+
+int32_t CPDF_AxialShadingKernel::GetIndex(int column, int row) const {
+  CFX_PointF pos = m_Matrix.Transform(
+      CFX_PointF(static_cast<float>(column), static_cast<float>(row)));
+  float scale =
+      (((pos.x - m_Start.x) * m_XSpan) + ((pos.y - m_Start.y) * m_YSpan)) /
+      m_AxisLenSquare;
+  return ClampIndex(static_cast<int32_t>(scale * (kShadingSteps - 1)),
+                    m_bStartExtend, m_bEndExtend);
+}
+
+void CPDF_AxialShadingKernel::GetRowIndices(
+    int row,
+    pdfium::span<int32_t> indices) const {
+  const int width = pdfium::base::checked_cast<int>(indices.size());
+  int column = 0;
+#if defined(SHADING_SSE2) || defined(SHADING_NEON)
+  if (!g_simd_disabled_for_testing) {
+    // Same operations in the same order as CFX_Matrix::Transform() and
+    // GetIndex(), so every lane rounds exactly like the scalar code.
+    const FloatVec a = Splat(m_Matrix.a);
+    const FloatVec b = Splat(m_Matrix.b);
+    const FloatVec row_x = Splat(m_Matrix.c * static_cast<float>(row));
+    const FloatVec row_y = Splat(m_Matrix.d * static_cast<float>(row));
+    const FloatVec e = Splat(m_Matrix.e);
+    const FloatVec f = Splat(m_Matrix.f);
+    const FloatVec start_x = Splat(m_Start.x);
+    const FloatVec start_y = Splat(m_Start.y);
+    const FloatVec x_span = Splat(m_XSpan);
+    const FloatVec y_span = Splat(m_YSpan);
+    const FloatVec axis_len_square = Splat(m_AxisLenSquare);
+    const FloatVec max_index = Splat(kShadingSteps - 1);
+    for (; column + kLanes <= width; column += kLanes) {
+      const FloatVec x = Columns(column);
+      const FloatVec pos_x = Add(Add(Mul(a, x), row_x), e);
+      const FloatVec pos_y = Add(Add(Mul(b, x), row_y), f);
+      const FloatVec scale =
+          Div(Add(Mul(Sub(pos_x, start_x), x_span),
+                  Mul(Sub(pos_y, start_y), y_span)),
+              axis_len_square);
+      Store(&indices[column],
+            ClampIndices(Truncate(Mul(scale, max_index)), m_bStartExtend,
+                         m_bEndExtend));
+    }
+  }
+#endif
+  for (; column < width; ++column)
+    indices[column] = GetIndex(column, row);
+}
+
+bool CPDF_AxialShadingKernel::IsRowInvariant() const {
+  return (m_Matrix.c == 0 || m_XSpan == 0) && (m_Matrix.d == 0 || m_YSpan == 0);
+}
+
+bool CPDF_AxialShadingKernel::IsColumnInvariant() const {
+  return (m_Matrix.a == 0 || m_XSpan == 0) && (m_Matrix.b == 0 || m_YSpan == 0);
+}
+
+CPDF_RadialShadingKernel::CPDF_RadialShadingKernel(
+    const CFX_Matrix& mtBitmap2Object,
+    const CFX_PointF& start,
+    float start_r,
+    const CFX_PointF& end,
+    float end_r,
+    bool bStartExtend,
+    bool bEndExtend)
+    : m_Matrix(mtBitmap2Object),
+      m_Start(start),
+      m_StartR(start_r),
+      m_DX(end.x - start.x),
+      m_DY(end.y - start.y),
+      m_DR(end_r - start_r),
+      m_A(m_DX * m_DX + m_DY * m_DY - m_DR * m_DR),
+      m_bAIsFloatZero(FXSYS_IsFloatZero(m_A)),
+      m_bDecreasing(m_DR < 0 &&
+                    static_cast<int>(FXSYS_sqrt2(m_DX, m_DY)) < -m_DR),
+      m_bStartExtend(bStartExtend),
+      m_bEndExtend(bEndExtend) {}
+
+int32_t CPDF_RadialShadingKernel::GetIndex(int column, int row) const {
+  CFX_PointF pos = m_Matrix.Transform(
+      CFX_PointF(static_cast<float>(column), static_cast<float>(row)));
+  float pos_dx = pos.x - m_Start.x;
+  float pos_dy = pos.y - m_Start.y;
+  float b = -2 * (pos_dx * m_DX + pos_dy * m_DY + m_StartR * m_DR);
+  float c = pos_dx * pos_dx + pos_dy * pos_dy - m_StartR * m_StartR;
+  float s;
+  if (FXSYS_IsFloatZero(b)) {
+    s = sqrt(-c / m_A);
+  } else if (m_bAIsFloatZero) {
+    s = -c / b;
+  } else {
+    float b2_4ac = (b * b) - 4 * (m_A * c);
+    if (b2_4ac < 0)
+      return -1;
+
+    float root = sqrt(b2_4ac);
+    float s1 = (-b - root) / (2 * m_A);
+    float s2 = (-b + root) / (2 * m_A);
+    if (m_A <= 0)
+      std::swap(s1, s2);
+    if (m_bDecreasing)
+      s = (s1 >= 0 || m_bStartExtend) ? s1 : s2;
+    else
+      s = (s2 <= 1.0f || m_bEndExtend) ? s2 : s1;
+
+    if (m_StartR + s * m_DR < 0)
+      return -1;
+  }
+  return ClampIndex(static_cast<int32_t>(s * (kShadingSteps - 1)),
+                    m_bStartExtend, m_bEndExtend);
+}
+
+void CPDF_RadialShadingKernel::GetRowIndices(
+    int row,
+    pdfium::span<int32_t> indices) const {
+  const int width = pdfium::base::checked_cast<int>(indices.size());
+  int column = 0;
+#if defined(SHADING_SSE2) || defined(SHADING_NEON)
+  if (!g_simd_disabled_for_testing) {
+    const FloatVec a = Splat(m_Matrix.a);
+    const FloatVec b = Splat(m_Matrix.b);
+    const FloatVec row_x = Splat(m_Matrix.c * static_cast<float>(row));
+    const FloatVec row_y = Splat(m_Matrix.d * static_cast<float>(row));
+    const FloatVec e = Splat(m_Matrix.e);
+    const FloatVec f = Splat(m_Matrix.f);
+    const FloatVec start_x = Splat(m_Start.x);
+    const FloatVec start_y = Splat(m_Start.y);
+    const FloatVec start_r = Splat(m_StartR);
+    const FloatVec start_r_dr = Splat(m_StartR * m_DR);
+    const FloatVec start_r_square = Splat(m_StartR * m_StartR);
+    const FloatVec dx = Splat(m_DX);
+    const FloatVec dy = Splat(m_DY);
+    const FloatVec dr = Splat(m_DR);
+    const FloatVec quad_a = Splat(m_A);
+    const FloatVec two_a = Splat(2 * m_A);
+    const FloatVec zero = Splat(0.0f);
+    const FloatVec one = Splat(1.0f);
+    const FloatVec max_index = Splat(kShadingSteps - 1);
+    // Lanes where FXSYS_IsFloatZero(b) might hold take the rare scalar
+    // branch. The threshold errs on the side of the scalar code, whose
+    // comparison happens in double precision.
+    const FloatVec near_zero = Splat(0.00011f);
+    for (; column + kLanes <= width; column += kLanes) {
+      const FloatVec x = Columns(column);
+      const FloatVec pos_dx = Sub(Add(Add(Mul(a, x), row_x), e), start_x);
+      const FloatVec pos_dy = Sub(Add(Add(Mul(b, x), row_y), f), start_y);
+      const FloatVec quad_b =
+          Mul(Splat(-2.0f),
+              Add(Add(Mul(pos_dx, dx), Mul(pos_dy, dy)), start_r_dr));
+      const FloatVec quad_c =
+          Sub(Add(Mul(pos_dx, pos_dx), Mul(pos_dy, pos_dy)), start_r_square);
+      FloatVec s;
+      IntVec skip = IntSplat(0);
+      if (m_bAIsFloatZero) {
+        s = Div(Negate(quad_c), quad_b);
+      } else {
+        const FloatVec b2_4ac = Sub(Mul(quad_b, quad_b),
+                                    Mul(Splat(4.0f), Mul(quad_a, quad_c)));
+        skip = Less(b2_4ac, zero);
+        const FloatVec root = Sqrt(b2_4ac);
+        const FloatVec neg_b = Negate(quad_b);
+        FloatVec s1 = Div(Sub(neg_b, root), two_a);
+        FloatVec s2 = Div(Add(neg_b, root), two_a);
+        if (m_A <= 0)
+          std::swap(s1, s2);
+        if (m_bDecreasing) {
+          s = m_bStartExtend ? s1 : Select(GreaterEqual(s1, zero), s1, s2);
+        } else {
+          s = m_bEndExtend ? s2 : Select(LessEqual(s2, one), s2, s1);
+        }
+        skip = Or(skip, Less(Add(start_r, Mul(s, dr)), zero));
+      }
+      // Skipped lanes have all bits set, which makes them -1.
+      Store(&indices[column],
+            Or(ClampIndices(Truncate(Mul(s, max_index)), m_bStartExtend,
+                            m_bEndExtend),
+               skip));
+
+      const IntVec scalar_lanes = Less(Abs(quad_b), near_zero);
+      if (AnyLane(scalar_lanes)) {
+        int32_t lanes[kLanes];
+        Store(lanes, scalar_lanes);
+        for (int i = 0; i < kLanes; ++i) {
+          if (lanes[i])
+            indices[column + i] = GetIndex(column + i, row);
+        }
+      }
+    }
+  }
+#endif
+  for (; column < width; ++column)
+    indices[column] = GetIndex(column, row);
+}
+
+CPDF_GouraudRasterizer::CPDF_GouraudRasterizer(
+    const RetainPtr<CFX_DIBitmap>& pBitmap,
+    int alpha)
+    : m_pBitmap(pBitmap),
+      m_Width(pBitmap->GetWidth()),
+      m_Height(pBitmap->GetHeight()),
+      m_Alpha(alpha) {
+  DCHECK_EQ(m_pBitmap->GetFormat(), FXDIB_Format::kArgb);
+}
+
+CPDF_GouraudRasterizer::~CPDF_GouraudRasterizer() = default;
+
+void CPDF_GouraudRasterizer::Draw(const CPDF_MeshVertex triangle[3]) {
+  float min_x = triangle[0].position.x;
+  float max_x = triangle[0].position.x;
+  float min_y = triangle[0].position.y;
+  float max_y = triangle[0].position.y;
+  for (int i = 1; i < 3; i++) {
+    min_x = std::min(min_x, triangle[i].position.x);
+    max_x = std::max(max_x, triangle[i].position.x);
+    min_y = std::min(min_y, triangle[i].position.y);
+    max_y = std::max(max_y, triangle[i].position.y);
+  }
+  if (min_y == max_y)
+    return;
+
+  // Spans are clamped to the bitmap, so triangles entirely to its left or
+  // right cannot touch it. The margin covers rounding in the intersections.
+  const float margin = 1.0f + (max_x - min_x) / 65536;
+  if (max_x < -margin || min_x > m_Width + margin)
+    return;
+
+  int min_yi = std::max(static_cast<int>(floorf(min_y)), 0);
+  int max_yi = static_cast<int>(ceilf(max_y));
+  if (max_yi >= m_Height)
+    max_yi = m_Height - 1;
+  if (min_yi > max_yi)
+    return;
+
+  // The rows crossed by each edge split the triangle into bands in which
+  // the same edges cross every scanline. Walk the bands, filling the rows of
+  // those crossed by exactly two edges. A scanline through the middle vertex
+  // crosses all three edges, and such scanlines are left alone.
+  GouraudEdge edges[3];
+  int band_edges[8];
+  int band_edge_count = 0;
+  band_edges[band_edge_count++] = min_yi;
+  band_edges[band_edge_count++] = max_yi + 1;
+  for (int i = 0; i < 3; i++) {
+    edges[i].Init(triangle[i], triangle[(i + 1) % 3]);
+    edges[i].SetRows(min_yi, max_yi);
+    band_edges[band_edge_count++] = edges[i].first_row;
+    band_edges[band_edge_count++] = edges[i].last_row + 1;
+  }
+  std::sort(band_edges, band_edges + band_edge_count);
+
+  for (int i = 0; i + 1 < band_edge_count; i++) {
+    const int band_top = band_edges[i];
+    const int band_bottom = band_edges[i + 1];
+    if (band_top >= band_bottom)
+      continue;
+
+    const GouraudEdge* crossed[3];
+    int nIntersects = 0;
+    for (const GouraudEdge& edge : edges) {
+      if (edge.first_row <= band_top && band_top <= edge.last_row)
+        crossed[nIntersects++] = &edge;
+    }
+    if (nIntersects != 2)
+      continue;
+
+    for (int y = band_top; y < band_bottom; y++)
+      DrawGouraudSpan(m_pBitmap.Get(), m_Alpha, y, *crossed[0], *crossed[1]);
+  }
+}
+
+void CPDF_SetShadingSIMDEnabledForTesting(bool enabled) {
+  g_simd_disabled_for_testing = !enabled;
+}
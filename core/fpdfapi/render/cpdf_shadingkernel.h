@@ -0,0 +1,100 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_RENDER_CPDF_SHADINGKERNEL_H_
+#define CORE_FPDFAPI_RENDER_CPDF_SHADINGKERNEL_H_
+
+#include <stdint.h>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "third_party/base/span.h"
+
+class CFX_DIBitmap;
+class CPDF_MeshVertex;
+
+// Number of entries in the color tables of axial and radial shadings.
+constexpr int kShadingSteps = 256;
+
+// Kernels that map each pixel of a bitmap row to an entry of a shading's color
+// table. An index of -1 means the shading leaves the pixel alone. Rows are
+// processed four pixels at a time with SSE2 or NEON where available, and the
+// results match the per-pixel GetIndex() exactly.
+class CPDF_AxialShadingKernel {
+ public:
+  CPDF_AxialShadingKernel(const CFX_Matrix& mtBitmap2Object,
+                          const CFX_PointF& start,
+                          const CFX_PointF& end,
+                          bool bStartExtend,
+                          bool bEndExtend);
+
+  int32_t GetIndex(int column, int row) const;
+  void GetRowIndices(int row, pdfium::span<int32_t> indices) const;
+
+  // True if every row gets the same indices, e.g. for a horizontal axis.
+  bool IsRowInvariant() const;
+
+  // True if all pixels of a row get the same index, e.g. for a vertical axis.
+  bool IsColumnInvariant() const;
+
+ private:
+  const CFX_Matrix m_Matrix;
+  const CFX_PointF m_Start;
+  const float m_XSpan;
+  const float m_YSpan;
+  const float m_AxisLenSquare;
+  const bool m_bStartExtend;
+  const bool m_bEndExtend;
+};
+
+class CPDF_RadialShadingKernel {
+ public:
+  CPDF_RadialShadingKernel(const CFX_Matrix& mtBitmap2Object,
+                           const CFX_PointF& start,
+                           float start_r,
+                           const CFX_PointF& end,
+                           float end_r,
+                           bool bStartExtend,
+                           bool bEndExtend);
+
+  int32_t GetIndex(int column, int row) const;
+  void GetRowIndices(int row, pdfium::span<int32_t> indices) const;
+
+ private:
+  const CFX_Matrix m_Matrix;
+  const CFX_PointF m_Start;
+  const float m_StartR;
+  const float m_DX;
+  const float m_DY;
+  const float m_DR;
+  const float m_A;
+  const bool m_bAIsFloatZero;
+  const bool m_bDecreasing;
+  const bool m_bStartExtend;
+  const bool m_bEndExtend;
+};
+
+// Fills Gouraud-shaded triangles into an ARGB bitmap, for the triangle mesh
+// shadings. Each triangle's edges are set up once, and the triangle is split
+// into bands of scanlines that cross the same pair of edges. Each band is
+// walked without testing edges per scanline, with the color interpolated
+// incrementally along each span.
+class CPDF_GouraudRasterizer {
+ public:
+  CPDF_GouraudRasterizer(const RetainPtr<CFX_DIBitmap>& pBitmap, int alpha);
+  ~CPDF_GouraudRasterizer();
+
+  void Draw(const CPDF_MeshVertex triangle[3]);
+
+ private:
+  RetainPtr<CFX_DIBitmap> const m_pBitmap;
+  const int m_Width;
+  const int m_Height;
+  const int m_Alpha;
+};
+
+// Lets tests compare the vectorized row kernels against GetIndex().
+void CPDF_SetShadingSIMDEnabledForTesting(bool enabled);
+
+#endif  // CORE_FPDFAPI_RENDER_CPDF_SHADINGKERNEL_H_
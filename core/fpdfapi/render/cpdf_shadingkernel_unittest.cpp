@@ -0,0 +1,302 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_shadingkernel.h"
+
+#include <stdint.h>
+
+#include <math.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "core/fpdfapi/page/cpdf_meshstream.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/base/cxx17_backports.h"
+
+namespace {
+
+constexpr int kWidth = 37;
+constexpr int kHeight = 9;
+
+const CFX_Matrix kMatrices[] = {
+    CFX_Matrix(),
+    CFX_Matrix(0.5f, 0, 0, -0.5f, -3.25f, 40.0f),
+    CFX_Matrix(0.7f, 0.3f, -0.2f, 0.9f, 1.5f, -2.0f),
+    CFX_Matrix(0, 1.25f, -1.25f, 0, 30.0f, 0.1f),
+    CFX_Matrix(0.01f, 0, 0, 0.01f, 0, 0),
+};
+
+template <typename Kernel>
+void ExpectRowsMatchGetIndex(const Kernel& kernel) {
+  std::vector<int32_t> simd(kWidth);
+  std::vector<int32_t> portable(kWidth);
+  for (int row = 0; row < kHeight; ++row) {
+    kernel.GetRowIndices(row, simd);
+    CPDF_SetShadingSIMDEnabledForTesting(false);
+    kernel.GetRowIndices(row, portable);
+    CPDF_SetShadingSIMDEnabledForTesting(true);
+    for (int column = 0; column < kWidth; ++column) {
+      EXPECT_EQ(kernel.GetIndex(column, row), simd[column]);
+      EXPECT_EQ(kernel.GetIndex(column, row), portable[column]);
+      EXPECT_GE(simd[column], -1);
+      EXPECT_LT(simd[column], kShadingSteps);
+    }
+  }
+}
+
+// Straightforward per-scanline Gouraud fill, which CPDF_GouraudRasterizer has
+// to match bit for bit.
+void DrawReferenceGouraud(const RetainPtr<CFX_DIBitmap>& pBitmap,
+                          int alpha,
+                          const CPDF_MeshVertex triangle[3]) {
+  float min_y = triangle[0].position.y;
+  float max_y = triangle[0].position.y;
+  for (int i = 1; i < 3; i++) {
+    min_y = std::min(min_y, triangle[i].position.y);
+    max_y = std::max(max_y, triangle[i].position.y);
+  }
+  if (min_y == max_y)
+    return;
+
+  int min_yi = std::max(static_cast<int>(floorf(min_y)), 0);
+  int max_yi = std::min(static_cast<int>(ceilf(max_y)),
+                        pBitmap->GetHeight() - 1);
+  for (int y = min_yi; y <= max_yi; y++) {
+    int nIntersects = 0;
+    float inter_x[3];
+    float r[3];
+    float g[3];
+    float b[3];
+    for (int i = 0; i < 3; i++) {
+      const CPDF_MeshVertex& vertex1 = triangle[i];
+      const CPDF_MeshVertex& vertex2 = triangle[(i + 1) % 3];
+      const CFX_PointF& position1 = vertex1.position;
+      const CFX_PointF& position2 = vertex2.position;
+      if (position1.y == position2.y)
+        continue;
+      if (y < std::min(position1.y, position2.y) ||
+          y > std::max(position1.y, position2.y)) {
+        continue;
+      }
+      inter_x[nIntersects] = position1.x + ((position2.x - position1.x) *
+                                            (y - position1.y) /
+                                            (position2.y - position1.y));
+      float y_dist = (y - position1.y) / (position2.y - position1.y);
+      r[nIntersects] = vertex1.r + ((vertex2.r - vertex1.r) * y_dist);
+      g[nIntersects] = vertex1.g + ((vertex2.g - vertex1.g) * y_dist);
+      b[nIntersects] = vertex1.b + ((vertex2.b - vertex1.b) * y_dist);
+      nIntersects++;
+    }
+    if (nIntersects != 2)
+      continue;
+
+    int start_index = inter_x[0] < inter_x[1] ? 0 : 1;
+    int end_index = 1 - start_index;
+    int min_x = static_cast<int>(floorf(inter_x[start_index]));
+    int max_x = static_cast<int>(ceilf(inter_x[end_index]));
+    int start_x = pdfium::clamp(min_x, 0, pBitmap->GetWidth());
+    int end_x = pdfium::clamp(max_x, 0, pBitmap->GetWidth());
+    float r_unit = (r[end_index] - r[start_index]) / (max_x - min_x);
+    float g_unit = (g[end_index] - g[start_index]) / (max_x - min_x);
+    float b_unit = (b[end_index] - b[start_index]) / (max_x - min_x);
+    float r_result = r[start_index] + (start_x - min_x) * r_unit;
+    float g_result = g[start_index] + (start_x - min_x) * g_unit;
+    float b_result = b[start_index] + (start_x - min_x) * b_unit;
+    uint8_t* dib_buf = pBitmap->GetWritableScanline(y).data() + start_x * 4;
+    for (int x = start_x; x < end_x; x++) {
+      r_result += r_unit;
+      g_result += g_unit;
+      b_result += b_unit;
+      FXARGB_SETDIB(dib_buf, ArgbEncode(alpha, static_cast<int>(r_result * 255),
+                                        static_cast<int>(g_result * 255),
+                                        static_cast<int>(b_result * 255)));
+      dib_buf += 4;
+    }
+  }
+}
+
+CPDF_MeshVertex MakeVertex(float x, float y, float r, float g, float b) {
+  CPDF_MeshVertex vertex;
+  vertex.position = CFX_PointF(x, y);
+  vertex.r = r;
+  vertex.g = g;
+  vertex.b = b;
+  return vertex;
+}
+
+void ExpectGouraudMatchesReference(const CPDF_MeshVertex triangle[3]) {
+  constexpr int kBitmapWidth = 48;
+  constexpr int kBitmapHeight = 32;
+  auto expected = pdfium::MakeRetain<CFX_DIBitmap>();
+  ASSERT_TRUE(
+      expected->Create(kBitmapWidth, kBitmapHeight, FXDIB_Format::kArgb));
+  expected->Clear(0x12345678);
+  auto actual = pdfium::MakeRetain<CFX_DIBitmap>();
+  ASSERT_TRUE(actual->Create(kBitmapWidth, kBitmapHeight, FXDIB_Format::kArgb));
+  actual->Clear(0x12345678);
+
+  DrawReferenceGouraud(expected, 200, triangle);
+  CPDF_GouraudRasterizer rasterizer(actual, 200);
+  rasterizer.Draw(triangle);
+
+  for (int row = 0; row < kBitmapHeight; ++row) {
+    pdfium::span<const uint8_t> expected_row = expected->GetScanline(row);
+    pdfium::span<const uint8_t> actual_row = actual->GetScanline(row);
+    ASSERT_TRUE(std::equal(expected_row.begin(), expected_row.end(),
+                           actual_row.begin()))
+        << "row " << row;
+  }
+}
+
+}  // namespace
+
+TEST(CPDFShadingKernelTest, AxialIndices) {
+  // Along the axis from (0, 0) to (255, 0), each pixel maps to its column.
+  CPDF_AxialShadingKernel kernel(CFX_Matrix(), CFX_PointF(0, 0),
+                                 CFX_PointF(255, 0), /*bStartExtend=*/false,
+                                 /*bEndExtend=*/true);
+  std::vector<int32_t> indices(300);
+  kernel.GetRowIndices(5, indices);
+  for (int column = 0; column < 256; ++column)
+    EXPECT_EQ(column, indices[column]);
+  EXPECT_EQ(255, indices[299]);
+
+  // Without extension, pixels before the start stay untouched.
+  CPDF_AxialShadingKernel shifted(CFX_Matrix(1, 0, 0, 1, -10, 0),
+                                  CFX_PointF(0, 0), CFX_PointF(255, 0),
+                                  /*bStartExtend=*/false,
+                                  /*bEndExtend=*/false);
+  shifted.GetRowIndices(0, indices);
+  EXPECT_EQ(-1, indices[0]);
+  EXPECT_EQ(-1, indices[9]);
+  EXPECT_EQ(0, indices[10]);
+  EXPECT_EQ(-1, indices[266]);
+}
+
+TEST(CPDFShadingKernelTest, AxialMatchesGetIndex) {
+  const CFX_PointF kEnds[] = {{40, 0}, {0, 25}, {-13, 17}, {0.5f, 0.25f}};
+  for (const CFX_Matrix& matrix : kMatrices) {
+    for (const CFX_PointF& end : kEnds) {
+      for (int extend = 0; extend < 4; ++extend) {
+        CPDF_AxialShadingKernel kernel(matrix, CFX_PointF(3, 2), end,
+                                       extend & 1, extend & 2);
+        ExpectRowsMatchGetIndex(kernel);
+      }
+    }
+  }
+}
+
+TEST(CPDFShadingKernelTest, AxialInvariance) {
+  CPDF_AxialShadingKernel horizontal(CFX_Matrix(), CFX_PointF(0, 5),
+                                     CFX_PointF(30, 5), false, false);
+  EXPECT_TRUE(horizontal.IsRowInvariant());
+  EXPECT_FALSE(horizontal.IsColumnInvariant());
+
+  CPDF_AxialShadingKernel vertical(CFX_Matrix(), CFX_PointF(5, 0),
+                                   CFX_PointF(5, 30), false, false);
+  EXPECT_FALSE(vertical.IsRowInvariant());
+  EXPECT_TRUE(vertical.IsColumnInvariant());
+  for (int row = 0; row < kHeight; ++row) {
+    for (int column = 1; column < kWidth; ++column)
+      EXPECT_EQ(vertical.GetIndex(0, row), vertical.GetIndex(column, row));
+  }
+
+  // A quarter turn swaps the two.
+  CPDF_AxialShadingKernel rotated(CFX_Matrix(0, 1, -1, 0, 0, 0),
+                                  CFX_PointF(0, 5), CFX_PointF(30, 5), false,
+                                  false);
+  EXPECT_FALSE(rotated.IsRowInvariant());
+  EXPECT_TRUE(rotated.IsColumnInvariant());
+
+  CPDF_AxialShadingKernel diagonal(CFX_Matrix(), CFX_PointF(0, 0),
+                                   CFX_PointF(30, 30), false, false);
+  EXPECT_FALSE(diagonal.IsRowInvariant());
+  EXPECT_FALSE(diagonal.IsColumnInvariant());
+}
+
+TEST(CPDFShadingKernelTest, RadialMatchesGetIndex) {
+  struct Circles {
+    CFX_PointF start;
+    float start_r;
+    CFX_PointF end;
+    float end_r;
+  };
+  const Circles kCircles[] = {
+      {{10, 5}, 0, {10, 5}, 20},      // Concentric.
+      {{10, 5}, 30, {12, 6}, 2},      // Shrinking.
+      {{0, 0}, 5, {30, 10}, 5},       // Equal radii.
+      {{-5, 20}, 1, {25, 0}, 40},     // Cone.
+      {{8, 4}, 3, {8.0001f, 4}, 3},   // Degenerate.
+  };
+  for (const CFX_Matrix& matrix : kMatrices) {
+    for (const Circles& circles : kCircles) {
+      for (int extend = 0; extend < 4; ++extend) {
+        CPDF_RadialShadingKernel kernel(matrix, circles.start, circles.start_r,
+                                        circles.end, circles.end_r,
+                                        extend & 1, extend & 2);
+        ExpectRowsMatchGetIndex(kernel);
+      }
+    }
+  }
+}
+
+TEST(CPDFShadingKernelTest, GouraudMatchesReference) {
+  const CPDF_MeshVertex kTriangles[][3] = {
+      // Fully inside.
+      {MakeVertex(3.5f, 2.25f, 1, 0, 0), MakeVertex(40.75f, 10.5f, 0, 1, 0),
+       MakeVertex(12.1f, 29.9f, 0, 0, 1)},
+      // Vertices on integral scanlines, including the middle one.
+      {MakeVertex(5, 4, 0.2f, 0.4f, 0.6f), MakeVertex(30, 12, 1, 1, 1),
+       MakeVertex(10, 20, 0, 0.5f, 0)},
+      // Flat top and flat bottom.
+      {MakeVertex(2, 3, 0, 0, 0), MakeVertex(45, 3, 1, 0.5f, 0.25f),
+       MakeVertex(20.5f, 17.5f, 0.3f, 0.9f, 0.1f)},
+      {MakeVertex(20.5f, 3.5f, 0.3f, 0.9f, 0.1f), MakeVertex(2, 25, 0, 0, 0),
+       MakeVertex(45, 25, 1, 0.5f, 0.25f)},
+      // Partly outside every edge of the bitmap.
+      {MakeVertex(-20.25f, -10.5f, 1, 1, 0), MakeVertex(70.5f, 5.75f, 0, 1, 1),
+       MakeVertex(10.5f, 50.25f, 1, 0, 1)},
+      // Entirely outside.
+      {MakeVertex(-30, 2, 1, 1, 1), MakeVertex(-5, 9, 1, 1, 1),
+       MakeVertex(-12, 20, 1, 1, 1)},
+      {MakeVertex(60, 2, 1, 1, 1), MakeVertex(90, 9, 1, 1, 1),
+       MakeVertex(75, 20, 1, 1, 1)},
+      {MakeVertex(3, -30, 1, 1, 1), MakeVertex(9, -5, 1, 1, 1),
+       MakeVertex(20, -12, 1, 1, 1)},
+      // Thin and degenerate.
+      {MakeVertex(10.3f, 1.1f, 0, 1, 0), MakeVertex(10.4f, 30.2f, 1, 0, 0),
+       MakeVertex(10.35f, 15.6f, 0, 0, 1)},
+      {MakeVertex(5, 5, 1, 0, 0), MakeVertex(25, 5, 0, 1, 0),
+       MakeVertex(40, 5, 0, 0, 1)},
+      {MakeVertex(7, 7, 1, 0, 0), MakeVertex(7, 7, 0, 1, 0),
+       MakeVertex(7, 7, 0, 0, 1)},
+  };
+
+  for (const auto& triangle : kTriangles)
+    ExpectGouraudMatchesReference(triangle);
+}
+
+TEST(CPDFShadingKernelTest, GouraudMatchesReferenceOnQuarterPixels) {
+  // Vertices on a quarter pixel grid land on integral scanlines often, which
+  // is where the bands of scanlines crossing the same edges begin and end.
+  uint32_t seed = 1;
+  // Returns a coordinate in [-`size` / 2, 3 * `size` / 2), so triangles also
+  // cross the edges of the bitmap.
+  auto next_coordinate = [&seed](int size) {
+    seed = seed * 1103515245 + 12345;
+    const int quarters = static_cast<int>((seed >> 8) % (size * 8));
+    return static_cast<float>(quarters - size * 2) / 4;
+  };
+  for (int i = 0; i < 500; ++i) {
+    CPDF_MeshVertex triangle[3];
+    for (int j = 0; j < 3; ++j) {
+      triangle[j] = MakeVertex(next_coordinate(48), next_coordinate(32),
+                               j == 0, j == 1, j == 2);
+    }
+    ExpectGouraudMatchesReference(triangle);
+  }
+}
@@ -13,6 +13,7 @@
 
 #include "core/fpdfapi/font/cpdf_type3char.h"
 #include "core/fpdfapi/font/cpdf_type3font.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/render/cpdf_type3glyphmap.h"
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/fx_safe_types.h"
@@ -73,9 +74,19 @@ int DetectLastScan(const RetainPtr<CFX_DIBitmap>& pBitmap) {
 
 }  // namespace
 
-CPDF_Type3Cache::CPDF_Type3Cache(CPDF_Type3Font* pFont) : m_pFont(pFont) {}
-
-CPDF_Type3Cache::~CPDF_Type3Cache() = default;
+CPDF_Type3Cache::CPDF_Type3Cache(CPDF_Type3Font* pFont)
+    : m_pFont(pFont),
+      m_pMemoryAccount(
+          pFont->GetDocument()
+              ? pdfium::WrapRetain(pFont->GetDocument()->GetMemoryAccount())
+              : nullptr) {}
+
+CPDF_Type3Cache::~CPDF_Type3Cache() {
+  if (m_pMemoryAccount) {
+    m_pMemoryAccount->Refund(CFX_MemoryAccount::Category::kGlyphCaches,
+                              m_nChargedBytes);
+  }
+}
 
 const CFX_GlyphBitmap* CPDF_Type3Cache::LoadGlyph(uint32_t charcode,
                                                   const CFX_Matrix& mtMatrix) {
@@ -98,8 +109,27 @@ const CFX_GlyphBitmap* CPDF_Type3Cache::LoadGlyph(uint32_t charcode,
   if (pExisting)
     return pExisting;
 
+  const auto refused_key = std::make_pair(keygen, charcode);
+  auto refused_it = m_RefusedGlyphSizes.find(refused_key);
+  if (refused_it != m_RefusedGlyphSizes.end()) {
+    if (!m_pMemoryAccount->CanCharge(refused_it->second))
+      return nullptr;
+    m_RefusedGlyphSizes.erase(refused_it);
+  }
+
   std::unique_ptr<CFX_GlyphBitmap> pNewBitmap =
       RenderGlyph(pSizeCache, charcode, mtMatrix);
+  if (pNewBitmap && m_pMemoryAccount) {
+    const RetainPtr<CFX_DIBitmap>& pBitmap = pNewBitmap->GetBitmap();
+    size_t size = pBitmap->GetPitch() * pBitmap->GetHeight();
+    // Skip the glyph rather than exceed the document's memory limit.
+    if (!m_pMemoryAccount->TryCharge(CFX_MemoryAccount::Category::kGlyphCaches,
+                                     size)) {
+      m_RefusedGlyphSizes[refused_key] = size;
+      return nullptr;
+    }
+    m_nChargedBytes += size;
+  }
   CFX_GlyphBitmap* pGlyphBitmap = pNewBitmap.get();
   pSizeCache->SetBitmap(charcode, std::move(pNewBitmap));
   return pGlyphBitmap;
@@ -12,8 +12,10 @@
 #include <map>
 #include <memory>
 #include <tuple>
+#include <utility>
 
 #include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/cfx_memoryaccount.h"
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
 
@@ -40,7 +42,12 @@ class CPDF_Type3Cache final : public Retainable, public Observable {
                                                const CFX_Matrix& mtMatrix);
 
   RetainPtr<CPDF_Type3Font> const m_pFont;
+  RetainPtr<CFX_MemoryAccount> const m_pMemoryAccount;
+  size_t m_nChargedBytes = 0;
   std::map<SizeKey, std::unique_ptr<CPDF_Type3GlyphMap>> m_SizeMap;
+  // Sizes of glyphs that did not fit within the document's memory limit, so
+  // they are only rendered again once that much memory is available.
+  std::map<std::pair<SizeKey, uint32_t>, size_t> m_RefusedGlyphSizes;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_TYPE3CACHE_H_
@@ -4,6 +4,9 @@
 
 #include <stdint.h>
 
+#include <chrono>
+#include <string>
+#include <thread>
 #include <utility>
 
 #include "build/build_config.h"
@@ -51,6 +54,40 @@ class FPDFProgressiveRenderEmbedderTest : public EmbedderTest {
     const bool should_pause_;
   };
 
+  // Version 2 of IFSDK_PAUSE, which cancels once NeedToCancelNow() has been
+  // called `cancel_after_checks` times, and never if that is negative.
+  class FakeCancellablePause : public IFSDK_PAUSE {
+   public:
+    FakeCancellablePause(bool should_pause,
+                         int cancel_after_checks,
+                         unsigned long deadline)
+        : should_pause_(should_pause),
+          cancel_after_checks_(cancel_after_checks) {
+      IFSDK_PAUSE::version = 2;
+      IFSDK_PAUSE::user = nullptr;
+      IFSDK_PAUSE::NeedToPauseNow = Pause_NeedToPauseNow;
+      IFSDK_PAUSE::NeedToCancelNow = Pause_NeedToCancelNow;
+      IFSDK_PAUSE::deadline_ms = deadline;
+    }
+    ~FakeCancellablePause() = default;
+    static FPDF_BOOL Pause_NeedToPauseNow(IFSDK_PAUSE* param) {
+      return static_cast<FakeCancellablePause*>(param)->should_pause_;
+    }
+    static FPDF_BOOL Pause_NeedToCancelNow(IFSDK_PAUSE* param) {
+      auto* pause = static_cast<FakeCancellablePause*>(param);
+      ++pause->cancel_checks_;
+      return pause->cancel_after_checks_ >= 0 &&
+             pause->cancel_checks_ > pause->cancel_after_checks_;
+    }
+
+    int cancel_checks() const { return cancel_checks_; }
+
+   private:
+    const bool should_pause_;
+    const int cancel_after_checks_;
+    int cancel_checks_ = 0;
+  };
+
   // StartRenderPageWithFlags() with no flags.
   // The call returns true if the rendering is complete.
   bool StartRenderPage(FPDF_PAGE page, IFSDK_PAUSE* pause);
@@ -81,6 +118,9 @@ class FPDFProgressiveRenderEmbedderTest : public EmbedderTest {
   // The call returns true if the rendering is complete.
   bool ContinueRenderPage(FPDF_PAGE page, IFSDK_PAUSE* pause);
 
+  // Same as StartRenderPage(), but returns the rendering status.
+  int StartRenderPageForStatus(FPDF_PAGE page, IFSDK_PAUSE* pause);
+
   // Simplified form of FinishRenderPageWithForms() with no form handle.
   ScopedFPDFBitmap FinishRenderPage(FPDF_PAGE page);
 
@@ -182,6 +222,21 @@ bool FPDFProgressiveRenderEmbedderTest::ContinueRenderPage(FPDF_PAGE page,
   return rv != FPDF_RENDER_TOBECONTINUED;
 }
 
+int FPDFProgressiveRenderEmbedderTest::StartRenderPageForStatus(
+    FPDF_PAGE page,
+    IFSDK_PAUSE* pause) {
+  int width = static_cast<int>(FPDF_GetPageWidth(page));
+  int height = static_cast<int>(FPDF_GetPageHeight(page));
+  progressive_render_flags_ = 0;
+  progressive_render_bitmap_ =
+      ScopedFPDFBitmap(FPDFBitmap_Create(width, height, /*alpha=*/0));
+  FPDFBitmap_FillRect(progressive_render_bitmap_.get(), 0, 0, width, height,
+                      0xFFFFFFFF);
+  return FPDF_RenderPageBitmap_Start(progressive_render_bitmap_.get(), page, 0,
+                                     0, width, height, 0,
+                                     progressive_render_flags_, pause);
+}
+
 ScopedFPDFBitmap FPDFProgressiveRenderEmbedderTest::FinishRenderPage(
     FPDF_PAGE page) {
   return FinishRenderPageWithForms(page, /*handle=*/nullptr);
@@ -252,6 +307,258 @@ TEST_F(FPDFProgressiveRenderEmbedderTest, RenderWithPause) {
   UnloadPage(page);
 }
 
+TEST_F(FPDFProgressiveRenderEmbedderTest, RenderWithPauseVersion2) {
+  // Version 2 without cancellation renders the same as version 1.
+  ASSERT_TRUE(OpenDocument("annotation_stamp_with_ap.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  FakeCancellablePause pause(/*should_pause=*/true, /*cancel_after_checks=*/-1,
+                             /*deadline=*/0);
+  pause.NeedToCancelNow = nullptr;
+  bool render_done = StartRenderPage(page, &pause);
+  EXPECT_FALSE(render_done);
+
+  while (!render_done) {
+    render_done = ContinueRenderPage(page, &pause);
+  }
+  ScopedFPDFBitmap bitmap = FinishRenderPage(page);
+  CompareBitmap(bitmap.get(), 595, 842,
+                AnnotationStampWithApBaseContentChecksum());
+  UnloadPage(page);
+}
+
+TEST_F(FPDFProgressiveRenderEmbedderTest, CancelBeforeStart) {
+  ASSERT_TRUE(OpenDocument("annotation_stamp_with_ap.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  FakeCancellablePause pause(/*should_pause=*/false, /*cancel_after_checks=*/0,
+                             /*deadline=*/0);
+  EXPECT_EQ(FPDF_RENDER_CANCELLED, StartRenderPageForStatus(page, &pause));
+
+  // A cancelled rendering stays cancelled.
+  EXPECT_EQ(FPDF_RENDER_CANCELLED, FPDF_RenderPage_Continue(page, &pause));
+  FinishRenderPage(page);
+  UnloadPage(page);
+}
+
+TEST_F(FPDFProgressiveRenderEmbedderTest, CancelWhilePaused) {
+  // The rendering pauses after the first of the two shadings.
+  ASSERT_TRUE(OpenDocument("axial_shading.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  FakePause pause(true);
+  EXPECT_EQ(FPDF_RENDER_TOBECONTINUED, StartRenderPageForStatus(page, &pause));
+
+  FakeCancellablePause cancel(/*should_pause=*/true, /*cancel_after_checks=*/0,
+                              /*deadline=*/0);
+  EXPECT_EQ(FPDF_RENDER_CANCELLED, FPDF_RenderPage_Continue(page, &cancel));
+  EXPECT_EQ(FPDF_RENDER_CANCELLED, FPDF_RenderPage_Continue(page, &pause));
+  FinishRenderPage(page);
+  UnloadPage(page);
+}
+
+TEST_F(FPDFProgressiveRenderEmbedderTest, CancelAfterDeadline) {
+  ASSERT_TRUE(OpenDocument("annotation_stamp_with_ap.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  FakeCancellablePause pause(/*should_pause=*/true, /*cancel_after_checks=*/-1,
+                             /*deadline=*/1);
+  int status = StartRenderPageForStatus(page, &pause);
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  while (status == FPDF_RENDER_TOBECONTINUED)
+    status = FPDF_RenderPage_Continue(page, &pause);
+  EXPECT_EQ(FPDF_RENDER_CANCELLED, status);
+  FinishRenderPage(page);
+  UnloadPage(page);
+}
+
+TEST_F(FPDFProgressiveRenderEmbedderTest, CancelDuringShading) {
+  ASSERT_TRUE(OpenDocument("axial_shading.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  {
+    // The shading polls for cancellation as it draws, not just once.
+    FakeCancellablePause pause(/*should_pause=*/false,
+                               /*cancel_after_checks=*/-1, /*deadline=*/0);
+    EXPECT_EQ(FPDF_RENDER_DONE, StartRenderPageForStatus(page, &pause));
+    EXPECT_GT(pause.cancel_checks(), 100);
+    FinishRenderPage(page);
+  }
+  {
+    // So cancelling stops it part way through.
+    FakeCancellablePause pause(/*should_pause=*/false,
+                               /*cancel_after_checks=*/50, /*deadline=*/0);
+    EXPECT_EQ(FPDF_RENDER_CANCELLED, StartRenderPageForStatus(page, &pause));
+    EXPECT_EQ(51, pause.cancel_checks());
+    ScopedFPDFBitmap bitmap = FinishRenderPage(page);
+
+    // The shading gets drawn from the top down, so the top left corner has
+    // been drawn, and the bottom left corner still has the background color.
+    const uint32_t* pixels =
+        static_cast<const uint32_t*>(FPDFBitmap_GetBuffer(bitmap.get()));
+    const int stride = FPDFBitmap_GetStride(bitmap.get()) / 4;
+    EXPECT_NE(kWhite, pixels[0]);
+    EXPECT_EQ(kWhite, pixels[199 * stride]);
+  }
+  UnloadPage(page);
+}
+
+TEST_F(FPDFProgressiveRenderEmbedderTest, CancelDuringCachedForm) {
+  ASSERT_TRUE(OpenDocument("form_object.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  std::string expected_hash;
+  {
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+    expected_hash = HashBitmap(bitmap.get());
+  }
+  {
+    // Cancels after the first of the two text objects in the form.
+    const int width = static_cast<int>(FPDF_GetPageWidth(page));
+    const int height = static_cast<int>(FPDF_GetPageHeight(page));
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(width, height, /*alpha=*/0));
+    FPDFBitmap_FillRect(bitmap.get(), 0, 0, width, height, 0xFFFFFFFF);
+    FakeCancellablePause pause(/*should_pause=*/false,
+                               /*cancel_after_checks=*/0, /*deadline=*/0);
+    EXPECT_EQ(FPDF_RENDER_CANCELLED,
+              FPDF_RenderPageBitmap_Start(bitmap.get(), page, 0, 0, width,
+                                          height, 0, FPDF_RENDER_CACHE_FORMS,
+                                          &pause));
+    FPDF_RenderPage_Close(page);
+  }
+
+  // The partly drawn form was not cached for later renders.
+  ScopedFPDFBitmap bitmap =
+      RenderLoadedPageWithFlags(page, FPDF_RENDER_CACHE_FORMS);
+  EXPECT_EQ(expected_hash, HashBitmap(bitmap.get()));
+  UnloadPage(page);
+}
+
+TEST_F(FPDFProgressiveRenderEmbedderTest, DraftThenFullQuality) {
+  ASSERT_TRUE(OpenDocument("axial_shading.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  std::string expected_hash;
+  {
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+    expected_hash = HashBitmap(bitmap.get());
+  }
+  {
+    // The draft fills the shading with the average of its colors.
+    ScopedFPDFBitmap bitmap =
+        RenderLoadedPageWithFlags(page, FPDF_RENDER_DRAFT);
+    EXPECT_NE(expected_hash, HashBitmap(bitmap.get()));
+    const uint32_t* pixels =
+        static_cast<const uint32_t*>(FPDFBitmap_GetBuffer(bitmap.get()));
+    const int stride = FPDFBitmap_GetStride(bitmap.get()) / 4;
+    EXPECT_EQ(0xFF80007Fu, pixels[0]);
+    EXPECT_EQ(0xFF80007Fu, pixels[199 * stride + 199]);
+  }
+  {
+    // Refining the draft progressively gives the full quality output.
+    FakePause pause(true);
+    bool render_done = StartRenderPage(page, &pause);
+    EXPECT_FALSE(render_done);
+    while (!render_done)
+      render_done = ContinueRenderPage(page, &pause);
+    ScopedFPDFBitmap bitmap = FinishRenderPage(page);
+    EXPECT_EQ(expected_hash, HashBitmap(bitmap.get()));
+  }
+  UnloadPage(page);
+}
+
+TEST_F(FPDFProgressiveRenderEmbedderTest, DraftOfPartialShading) {
+  // The shading only paints the middle of the page, so the draft cannot fill
+  // the whole clip with a single color.
+  ASSERT_TRUE(OpenDocument("axial_shading_unextended.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  ScopedFPDFBitmap bitmap = RenderLoadedPageWithFlags(page, FPDF_RENDER_DRAFT);
+  const uint32_t* pixels =
+      static_cast<const uint32_t*>(FPDFBitmap_GetBuffer(bitmap.get()));
+  EXPECT_EQ(0xFFFFFFFFu, pixels[0]);
+  EXPECT_EQ(0xFFFFFFFFu, pixels[199]);
+  EXPECT_NE(0xFFFFFFFFu, pixels[100]);
+  UnloadPage(page);
+}
+
+TEST_F(FPDFProgressiveRenderEmbedderTest, ImagePrefetchMemoryUsage) {
+  ASSERT_TRUE(OpenDocument("embedded_images.pdf"));
+  ASSERT_TRUE(FPDF_SetImagePrefetch(document(), true));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+
+  // Images being prefetched are charged before the rendering reaches them.
+  FakeCancellablePause pause(/*should_pause=*/false, /*cancel_after_checks=*/0,
+                             /*deadline=*/0);
+  EXPECT_EQ(FPDF_RENDER_CANCELLED, StartRenderPageForStatus(page, &pause));
+  EXPECT_GT(FPDF_GetDocumentMemoryUsage(document(),
+                                        FPDF_MEMORY_CATEGORY_IMAGE_CACHES),
+            0u);
+  FinishRenderPage(page);
+  UnloadPage(page);
+
+  // Dropping the unused prefetched images refunds them.
+  EXPECT_EQ(0u, FPDF_GetDocumentMemoryUsage(
+                    document(), FPDF_MEMORY_CATEGORY_IMAGE_CACHES));
+}
+
+TEST_F(FPDFProgressiveRenderEmbedderTest, RenderProfile) {
+  ASSERT_TRUE(OpenDocument("axial_shading.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+
+  FPDF_RENDER_PROFILE_STATS stats;
+  int layer = -1;
+  int object_index = -1;
+  {
+    // Rendering without FPDF_RENDER_PROFILE does not record a profile.
+    FakePause pause(false);
+    EXPECT_TRUE(StartRenderPageWithFlags(page, &pause, 0));
+    EXPECT_FALSE(FPDF_RenderPage_GetPhaseProfile(
+        page, FPDF_RENDER_PHASE_SHADING, &stats));
+    EXPECT_EQ(-1, FPDF_RenderPage_CountProfiledObjects(page));
+    FinishRenderPage(page);
+  }
+
+  FakePause pause(false);
+  EXPECT_TRUE(StartRenderPageWithFlags(page, &pause, FPDF_RENDER_PROFILE));
+  EXPECT_FALSE(FPDF_RenderPage_GetPhaseProfile(page, -1, &stats));
+  EXPECT_FALSE(FPDF_RenderPage_GetPhaseProfile(
+      page, FPDF_RENDER_PHASE_TRANSPARENCY + 1, &stats));
+  EXPECT_FALSE(FPDF_RenderPage_GetPhaseProfile(
+      page, FPDF_RENDER_PHASE_SHADING, nullptr));
+
+  ASSERT_TRUE(
+      FPDF_RenderPage_GetPhaseProfile(page, FPDF_RENDER_PHASE_SHADING, &stats));
+  EXPECT_EQ(2u, stats.calls);
+  ASSERT_TRUE(
+      FPDF_RenderPage_GetPhaseProfile(page, FPDF_RENDER_PHASE_TEXT, &stats));
+  EXPECT_EQ(0u, stats.calls);
+  EXPECT_EQ(0u, stats.time_ns);
+  EXPECT_EQ(0u, stats.allocations);
+
+  // Both shadings are top-level objects of the page.
+  ASSERT_EQ(2, FPDF_RenderPage_CountProfiledObjects(page));
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_TRUE(FPDF_RenderPage_GetObjectProfile(page, i, &layer,
+                                                 &object_index, &stats));
+    EXPECT_EQ(0, layer);
+    EXPECT_EQ(i, object_index);
+    EXPECT_EQ(1u, stats.calls);
+  }
+  EXPECT_FALSE(FPDF_RenderPage_GetObjectProfile(page, 2, &layer,
+                                                &object_index, &stats));
+  EXPECT_FALSE(FPDF_RenderPage_GetObjectProfile(page, -1, &layer,
+                                                &object_index, &stats));
+
+  FinishRenderPage(page);
+  EXPECT_FALSE(
+      FPDF_RenderPage_GetPhaseProfile(page, FPDF_RENDER_PHASE_SHADING, &stats));
+  EXPECT_EQ(-1, FPDF_RenderPage_CountProfiledObjects(page));
+  UnloadPage(page);
+}
+
 TEST_F(FPDFProgressiveRenderEmbedderTest, RenderAnnotWithPause) {
   // Test rendering of the page with annotations using progressive render APIs
   // with pause in rendering.
@@ -465,3 +772,36 @@ TEST_F(FPDFProgressiveRenderEmbedderTest, RenderFormWithColorScheme) {
                                  /*color_scheme=*/nullptr, kWhite, 612, 792,
                                  content_with_form_checksum);
 }
+
+TEST_F(FPDFProgressiveRenderEmbedderTest, GetScratchPixels) {
+  ASSERT_TRUE(OpenDocument("shared_soft_mask.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+
+  unsigned long long allocated_pixels = 0;
+  unsigned long long touched_pixels = 0;
+  EXPECT_FALSE(FPDF_RenderPage_GetScratchPixels(page, &allocated_pixels,
+                                                &touched_pixels));
+
+  FakePause pause(false);
+  EXPECT_TRUE(StartRenderPage(page, &pause));
+  EXPECT_FALSE(
+      FPDF_RenderPage_GetScratchPixels(page, nullptr, &touched_pixels));
+  ASSERT_TRUE(FPDF_RenderPage_GetScratchPixels(page, &allocated_pixels,
+                                               &touched_pixels));
+  // Touched pixels are only counted for profiled renders.
+  EXPECT_GT(allocated_pixels, 0u);
+  EXPECT_EQ(0u, touched_pixels);
+  FinishRenderPage(page);
+
+  EXPECT_TRUE(StartRenderPageWithFlags(page, &pause, FPDF_RENDER_PROFILE));
+  ASSERT_TRUE(FPDF_RenderPage_GetScratchPixels(page, &allocated_pixels,
+                                               &touched_pixels));
+  EXPECT_GT(touched_pixels, 0u);
+  EXPECT_GE(allocated_pixels, touched_pixels);
+
+  FinishRenderPage(page);
+  EXPECT_FALSE(FPDF_RenderPage_GetScratchPixels(page, &allocated_pixels,
+                                                &touched_pixels));
+  UnloadPage(page);
+}
@@ -23,6 +23,7 @@
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
 #include "core/fpdftext/unicodenormalizationdata.h"
+#include "core/fxcrt/cfx_tracelog.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_bidi.h"
 #include "core/fxcrt/fx_extension.h"
@@ -290,6 +291,7 @@ CPDF_TextPage::CPDF_TextPage(const CPDF_Page* pPage, bool rtl)
 CPDF_TextPage::~CPDF_TextPage() = default;
 
 void CPDF_TextPage::Init() {
+  FX_TRACE_EVENT("pdfium.text", "CPDF_TextPage::Init");
   m_TextBuf.SetAllocStep(10240);
   ProcessObject();
 
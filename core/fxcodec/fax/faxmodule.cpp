@@ -16,6 +16,7 @@
 #include "build/build_config.h"
 #include "core/fxcodec/scanlinedecoder.h"
 #include "core/fxcrt/binary_buffer.h"
+#include "core/fxcrt/cfx_tracelog.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_2d_size.h"
 #include "core/fxcrt/fx_memory.h"
@@ -630,6 +631,7 @@ int FaxModule::FaxG4Decode(const uint8_t* src_buf,
                            int height,
                            int pitch,
                            uint8_t* dest_buf) {
+  FX_TRACE_EVENT("pdfium.codec", "FaxModule::FaxG4Decode");
   DCHECK(pitch != 0);
 
   DataVector<uint8_t> ref_buf(pitch, 0xff);
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "core/fxcodec/scanlinedecoder.h"
+#include "core/fxcrt/cfx_tracelog.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fixed_zeroed_data_vector.h"
 #include "core/fxcrt/fx_extension.h"
@@ -117,7 +118,9 @@ struct FlateDeleter {
 
 class CLZWDecoder {
  public:
-  CLZWDecoder(pdfium::span<const uint8_t> src_span, bool early_change);
+  CLZWDecoder(pdfium::span<const uint8_t> src_span,
+              bool early_change,
+              uint32_t max_size);
 
   bool Decode();
   uint32_t GetSrcSize() const { return (src_bit_pos_ + 7) / 8; }
@@ -132,6 +135,7 @@ class CLZWDecoder {
   void ExpandDestBuf(uint32_t additional_size);
 
   pdfium::span<const uint8_t> const src_span_;
+  const uint32_t max_size_;
   std::unique_ptr<uint8_t, FxFreeDeleter> dest_buf_;
   uint32_t src_bit_pos_ = 0;
   uint32_t dest_buf_size_ = 0;  // Actual allocated size.
@@ -145,8 +149,10 @@ class CLZWDecoder {
 };
 
 CLZWDecoder::CLZWDecoder(pdfium::span<const uint8_t> src_span,
-                         bool early_change)
+                         bool early_change,
+                         uint32_t max_size)
     : src_span_(src_span),
+      max_size_(max_size),
       decode_stack_(4000),
       early_change_(early_change ? 1 : 0),
       codes_(5021) {}
@@ -187,14 +193,17 @@ void CLZWDecoder::DecodeString(uint32_t code) {
 }
 
 void CLZWDecoder::ExpandDestBuf(uint32_t additional_size) {
-  FX_SAFE_UINT32 new_size = std::max(dest_buf_size_ / 2, additional_size);
-  new_size += dest_buf_size_;
-  if (!new_size.IsValid()) {
+  FX_SAFE_UINT32 required_size = dest_buf_size_;
+  required_size += additional_size;
+  if (!required_size.IsValid() || required_size.ValueOrDie() > max_size_) {
     dest_buf_.reset();
     return;
   }
 
-  dest_buf_size_ = new_size.ValueOrDie();
+  FX_SAFE_UINT32 new_size = std::max(dest_buf_size_ / 2, additional_size);
+  new_size += dest_buf_size_;
+  dest_buf_size_ =
+      std::min<uint32_t>(new_size.ValueOrDefault(max_size_), max_size_);
   dest_buf_.reset(FX_Realloc(uint8_t, dest_buf_.release(), dest_buf_size_));
 }
 
@@ -289,7 +298,8 @@ bool CLZWDecoder::Decode() {
     AddCode(old_code, last_char);
     old_code = code;
   }
-  return dest_byte_pos_ != 0;
+  // The initial buffer may be larger than `max_size_`.
+  return dest_byte_pos_ != 0 && dest_byte_pos_ <= max_size_;
 }
 
 uint8_t PathPredictor(int a, int b, int c) {
@@ -529,8 +539,10 @@ bool TIFF_Predictor(int Colors,
   return true;
 }
 
-void FlateUncompress(pdfium::span<const uint8_t> src_buf,
+// Returns false if the output would be larger than `max_size`.
+bool FlateUncompress(pdfium::span<const uint8_t> src_buf,
                      uint32_t orig_size,
+                     uint32_t max_size,
                      std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
                      uint32_t* dest_size,
                      uint32_t* offset) {
@@ -539,7 +551,7 @@ void FlateUncompress(pdfium::span<const uint8_t> src_buf,
 
   std::unique_ptr<z_stream, FlateDeleter> context(FlateInit());
   if (!context)
-    return;
+    return true;
 
   FlateInput(context.get(), src_buf);
 
@@ -548,6 +560,7 @@ void FlateUncompress(pdfium::span<const uint8_t> src_buf,
       orig_size ? orig_size
                 : pdfium::base::checked_cast<uint32_t>(src_buf.size() * 2);
   guess_size = std::min(guess_size, kMaxInitialAllocSize);
+  guess_size = std::max(std::min(guess_size, max_size), 1u);
 
   uint32_t buf_size = guess_size;
   uint32_t last_buf_size = buf_size;
@@ -567,6 +580,9 @@ void FlateUncompress(pdfium::span<const uint8_t> src_buf,
         break;
       }
       result_tmp_bufs.push_back(std::move(cur_buf));
+      // Stop before allocating past `max_size`.
+      if (FlateGetPossiblyTruncatedTotalOut(context.get()) >= max_size)
+        return false;
       cur_buf.reset(FX_Alloc(uint8_t, buf_size + 1));
       cur_buf.get()[buf_size] = '\0';
     }
@@ -577,9 +593,13 @@ void FlateUncompress(pdfium::span<const uint8_t> src_buf,
   // up to 4GB in size.
   *dest_size = FlateGetPossiblyTruncatedTotalOut(context.get());
   *offset = FlateGetPossiblyTruncatedTotalIn(context.get());
+  if (*dest_size > max_size) {
+    *dest_size = 0;
+    return false;
+  }
   if (result_tmp_bufs.size() == 1) {
     *dest_buf = std::move(result_tmp_bufs[0]);
-    return;
+    return true;
   }
 
   std::unique_ptr<uint8_t, FxFreeDeleter> result_buf(
@@ -599,6 +619,7 @@ void FlateUncompress(pdfium::span<const uint8_t> src_buf,
     remaining -= cp_size;
   }
   *dest_buf = std::move(result_buf);
+  return true;
 }
 
 enum class PredictorType : uint8_t { kNone, kFlate, kPng };
@@ -834,14 +855,17 @@ uint32_t FlateModule::FlateOrLZWDecode(
     int BitsPerComponent,
     int Columns,
     uint32_t estimated_size,
+    uint32_t max_size,
     std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
     uint32_t* dest_size) {
+  FX_TRACE_EVENT("pdfium.codec", "FlateModule::FlateOrLZWDecode");
   dest_buf->reset();
   uint32_t offset = 0;
   PredictorType predictor_type = GetPredictor(predictor);
 
   if (bLZW) {
-    auto decoder = std::make_unique<CLZWDecoder>(src_span, bEarlyChange);
+    auto decoder =
+        std::make_unique<CLZWDecoder>(src_span, bEarlyChange, max_size);
     if (!decoder->Decode())
       return FX_INVALID_OFFSET;
 
@@ -849,7 +873,10 @@ uint32_t FlateModule::FlateOrLZWDecode(
     *dest_size = decoder->GetDestSize();
     *dest_buf = decoder->TakeDestBuf();
   } else {
-    FlateUncompress(src_span, estimated_size, dest_buf, dest_size, &offset);
+    if (!FlateUncompress(src_span, estimated_size, max_size, dest_buf,
+                         dest_size, &offset)) {
+      return FX_INVALID_OFFSET;
+    }
   }
 
   bool ret = false;
@@ -32,6 +32,12 @@ class FlateModule {
       int BitsPerComponent,
       int Columns);
 
+  // Passed as `max_size` to FlateOrLZWDecode() for no limit beyond what a
+  // uint32_t can hold.
+  static constexpr uint32_t kNoMaxSize = 0xFFFFFFFF;
+
+  // Fails without allocating past `max_size` if the decoded data would be
+  // larger than `max_size` bytes.
   static uint32_t FlateOrLZWDecode(
       bool bLZW,
       pdfium::span<const uint8_t> src_span,
@@ -41,6 +47,7 @@ class FlateModule {
       int BitsPerComponent,
       int Columns,
       uint32_t estimated_size,
+      uint32_t max_size,
       std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
       uint32_t* dest_size);
 
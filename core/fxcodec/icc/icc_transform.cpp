@@ -15,7 +15,6 @@
 #include "third_party/base/cxx17_backports.h"
 #include "third_party/base/notreached.h"
 #include "third_party/base/numerics/safe_conversions.h"
-#include "third_party/base/ptr_util.h"
 
 namespace fxcodec {
 
@@ -54,7 +53,7 @@ IccTransform::~IccTransform() {
 }
 
 // static
-std::unique_ptr<IccTransform> IccTransform::CreateTransformSRGB(
+RetainPtr<IccTransform> IccTransform::CreateTransformSRGB(
     pdfium::span<const uint8_t> span) {
   ScopedCmsProfile srcProfile(cmsOpenProfileFromMem(
       span.data(), pdfium::base::checked_cast<cmsUInt32Number>(span.size())));
@@ -108,9 +107,8 @@ std::unique_ptr<IccTransform> IccTransform::CreateTransformSRGB(
   if (!hTransform)
     return nullptr;
 
-  // Private ctor.
-  return pdfium::WrapUnique(
-      new IccTransform(hTransform, nSrcComponents, bLab, bNormal));
+  return pdfium::MakeRetain<IccTransform>(hTransform, nSrcComponents, bLab,
+                                         bNormal);
 }
 
 void IccTransform::Translate(pdfium::span<const float> pSrcValues,
@@ -9,9 +9,8 @@
 
 #include <stdint.h>
 
-#include <memory>
-
 #include "core/fxcodec/fx_codec_def.h"
+#include "core/fxcrt/retain_ptr.h"
 #include "third_party/base/span.h"
 
 #if defined(USE_SYSTEM_LCMS2)
@@ -22,12 +21,12 @@
 
 namespace fxcodec {
 
-class IccTransform {
+class IccTransform final : public Retainable {
  public:
-  static std::unique_ptr<IccTransform> CreateTransformSRGB(
-      pdfium::span<const uint8_t> span);
+  CONSTRUCT_VIA_MAKE_RETAIN;
 
-  ~IccTransform();
+  static RetainPtr<IccTransform> CreateTransformSRGB(
+      pdfium::span<const uint8_t> span);
 
   void Translate(pdfium::span<const float> pSrcValues,
                  pdfium::span<float> pDestValues);
@@ -43,6 +42,7 @@ class IccTransform {
                int srcComponents,
                bool bIsLab,
                bool bNormal);
+  ~IccTransform() override;
 
   const cmsHTRANSFORM m_hTransform;
   const int m_nSrcComponents;
@@ -0,0 +1,49 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/icc/icc_transform_cache.h"
+
+#include <tuple>
+#include <utility>
+
+#include "core/fxcodec/icc/icc_transform.h"
+
+namespace fxcodec {
+
+bool IccTransformCache::Key::operator<(const Key& that) const {
+  return std::tie(size, digest) < std::tie(that.size, that.digest);
+}
+
+IccTransformCache::IccTransformCache() = default;
+
+IccTransformCache::~IccTransformCache() = default;
+
+RetainPtr<IccTransform> IccTransformCache::GetTransformSRGB(
+    const ByteString& digest,
+    pdfium::span<const uint8_t> profile) {
+  Key key = {digest, profile.size()};
+  auto it = m_Entries.find(key);
+  if (it != m_Entries.end()) {
+    it->second.last_use = ++m_UseCounter;
+    return it->second.transform;
+  }
+
+  RetainPtr<IccTransform> transform =
+      IccTransform::CreateTransformSRGB(profile);
+  if (!transform)
+    return nullptr;
+
+  if (m_Entries.size() >= kMaxEntries) {
+    auto oldest = m_Entries.begin();
+    for (auto entry = m_Entries.begin(); entry != m_Entries.end(); ++entry) {
+      if (entry->second.last_use < oldest->second.last_use)
+        oldest = entry;
+    }
+    m_Entries.erase(oldest);
+  }
+  m_Entries[std::move(key)] = {transform, ++m_UseCounter};
+  return transform;
+}
+
+}  // namespace fxcodec
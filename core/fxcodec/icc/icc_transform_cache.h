@@ -0,0 +1,61 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCODEC_ICC_ICC_TRANSFORM_CACHE_H_
+#define CORE_FXCODEC_ICC_ICC_TRANSFORM_CACHE_H_
+
+#include <stdint.h>
+
+#include <map>
+
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "third_party/base/span.h"
+
+namespace fxcodec {
+
+class IccTransform;
+
+// Shares compiled ICC transforms between all documents in the process, so that
+// a profile embedded by many documents is only turned into an lcms transform
+// once. Profiles are identified by a digest of their content, which callers
+// compute. The cache holds a reference to at most `kMaxEntries` transforms and
+// drops the least recently used one when full; transforms dropped from the
+// cache stay alive for as long as anyone else holds them.
+class IccTransformCache {
+ public:
+  static constexpr size_t kMaxEntries = 16;
+
+  IccTransformCache();
+  ~IccTransformCache();
+
+  // Returns the transform from `profile` to sRGB, or nullptr if `profile` is
+  // not usable. `digest` must identify the contents of `profile`.
+  RetainPtr<IccTransform> GetTransformSRGB(const ByteString& digest,
+                                           pdfium::span<const uint8_t> profile);
+
+  size_t GetEntryCount() const { return m_Entries.size(); }
+
+ private:
+  // All transforms convert to sRGB with the perceptual intent, so the profile
+  // contents alone determine the source component count and the transform.
+  struct Key {
+    bool operator<(const Key& that) const;
+
+    ByteString digest;
+    size_t size;
+  };
+
+  struct Entry {
+    RetainPtr<IccTransform> transform;
+    uint64_t last_use;
+  };
+
+  std::map<Key, Entry> m_Entries;
+  uint64_t m_UseCounter = 0;
+};
+
+}  // namespace fxcodec
+
+#endif  // CORE_FXCODEC_ICC_ICC_TRANSFORM_CACHE_H_
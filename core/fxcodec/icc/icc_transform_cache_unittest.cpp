@@ -0,0 +1,90 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/icc/icc_transform_cache.h"
+
+#include <vector>
+
+#include "core/fxcodec/icc/icc_transform.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace fxcodec {
+
+namespace {
+
+std::vector<uint8_t> SaveProfile(cmsHPROFILE profile) {
+  cmsUInt32Number size = 0;
+  EXPECT_TRUE(cmsSaveProfileToMem(profile, nullptr, &size));
+  std::vector<uint8_t> data(size);
+  EXPECT_TRUE(cmsSaveProfileToMem(profile, data.data(), &size));
+  cmsCloseProfile(profile);
+  return data;
+}
+
+std::vector<uint8_t> CreateSRGBProfile() {
+  return SaveProfile(cmsCreate_sRGBProfile());
+}
+
+std::vector<uint8_t> CreateGrayProfile() {
+  cmsToneCurve* curve = cmsBuildGamma(nullptr, 2.2);
+  std::vector<uint8_t> data =
+      SaveProfile(cmsCreateGrayProfile(cmsD50_xyY(), curve));
+  cmsFreeToneCurve(curve);
+  return data;
+}
+
+}  // namespace
+
+TEST(IccTransformCacheTest, SharesTransforms) {
+  IccTransformCache cache;
+  const std::vector<uint8_t> srgb = CreateSRGBProfile();
+  const std::vector<uint8_t> gray = CreateGrayProfile();
+
+  RetainPtr<IccTransform> srgb_transform =
+      cache.GetTransformSRGB("srgb", srgb);
+  ASSERT_TRUE(srgb_transform);
+  EXPECT_EQ(3, srgb_transform->components());
+  EXPECT_EQ(srgb_transform, cache.GetTransformSRGB("srgb", srgb));
+
+  RetainPtr<IccTransform> gray_transform =
+      cache.GetTransformSRGB("gray", gray);
+  ASSERT_TRUE(gray_transform);
+  EXPECT_EQ(1, gray_transform->components());
+  EXPECT_NE(srgb_transform, gray_transform);
+  EXPECT_EQ(2u, cache.GetEntryCount());
+
+  // Unusable profiles are not cached.
+  const uint8_t kBogus[] = {1, 2, 3, 4};
+  EXPECT_FALSE(cache.GetTransformSRGB("bogus", kBogus));
+  EXPECT_EQ(2u, cache.GetEntryCount());
+}
+
+TEST(IccTransformCacheTest, EvictsLeastRecentlyUsed) {
+  IccTransformCache cache;
+  const std::vector<uint8_t> srgb = CreateSRGBProfile();
+
+  RetainPtr<IccTransform> first = cache.GetTransformSRGB("0", srgb);
+  RetainPtr<IccTransform> second = cache.GetTransformSRGB("1", srgb);
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  for (size_t i = 2; i < IccTransformCache::kMaxEntries; ++i)
+    ASSERT_TRUE(cache.GetTransformSRGB(ByteString::Format("%zu", i), srgb));
+  EXPECT_EQ(IccTransformCache::kMaxEntries, cache.GetEntryCount());
+
+  // Touch the first entry, so that the second one is the oldest.
+  EXPECT_EQ(first, cache.GetTransformSRGB("0", srgb));
+  ASSERT_TRUE(cache.GetTransformSRGB("new", srgb));
+  EXPECT_EQ(IccTransformCache::kMaxEntries, cache.GetEntryCount());
+  EXPECT_EQ(first, cache.GetTransformSRGB("0", srgb));
+  EXPECT_NE(second, cache.GetTransformSRGB("1", srgb));
+
+  // Evicted transforms stay alive for their users.
+  for (size_t i = 0; i < IccTransformCache::kMaxEntries; ++i)
+    cache.GetTransformSRGB(ByteString::Format("extra%zu", i), srgb);
+  EXPECT_EQ(IccTransformCache::kMaxEntries, cache.GetEntryCount());
+  EXPECT_EQ(3, first->components());
+  EXPECT_NE(first, cache.GetTransformSRGB("0", srgb));
+}
+
+}  // namespace fxcodec
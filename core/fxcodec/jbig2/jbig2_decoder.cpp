@@ -10,6 +10,7 @@
 
 #include "core/fxcodec/jbig2/JBig2_Context.h"
 #include "core/fxcodec/jbig2/JBig2_DocumentContext.h"
+#include "core/fxcrt/cfx_tracelog.h"
 #include "core/fxcrt/span_util.h"
 
 namespace fxcodec {
@@ -51,6 +52,7 @@ FXCODEC_STATUS Jbig2Decoder::StartDecode(
     pdfium::span<uint8_t> dest_buf,
     uint32_t dest_pitch,
     PauseIndicatorIface* pPause) {
+  FX_TRACE_EVENT("pdfium.codec", "Jbig2Decoder::StartDecode");
   pJbig2Context->m_width = width;
   pJbig2Context->m_height = height;
   pJbig2Context->m_pSrcSpan = src_span;
@@ -71,6 +73,7 @@ FXCODEC_STATUS Jbig2Decoder::StartDecode(
 // static
 FXCODEC_STATUS Jbig2Decoder::ContinueDecode(Jbig2Context* pJbig2Context,
                                             PauseIndicatorIface* pPause) {
+  FX_TRACE_EVENT("pdfium.codec", "Jbig2Decoder::ContinueDecode");
   bool succeeded = pJbig2Context->m_pContext->Continue(pPause);
   return Decode(pJbig2Context, succeeded);
 }
@@ -17,6 +17,7 @@
 #include "core/fxcodec/cfx_codec_memory.h"
 #include "core/fxcodec/jpeg/jpeg_common.h"
 #include "core/fxcodec/scanlinedecoder.h"
+#include "core/fxcrt/cfx_tracelog.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxge/dib/cfx_dibbase.h"
@@ -384,6 +385,7 @@ std::unique_ptr<ScanlineDecoder> JpegModule::CreateDecoder(
     int nComps,
     bool ColorTransform) {
   DCHECK(!src_span.empty());
+  FX_TRACE_EVENT("pdfium.codec", "JpegModule::CreateDecoder");
 
   auto pDecoder = std::make_unique<JpegDecoder>();
   if (!pDecoder->Create(src_span, width, height, nComps, ColorTransform))
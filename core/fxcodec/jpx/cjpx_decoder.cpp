@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "core/fxcodec/jpx/jpx_decode_utils.h"
+#include "core/fxcrt/cfx_tracelog.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/span_util.h"
 #include "core/fxge/calculate_pitch.h"
@@ -465,6 +466,7 @@ bool CJPX_Decoder::Init(pdfium::span<const uint8_t> src_data,
 }
 
 bool CJPX_Decoder::StartDecode() {
+  FX_TRACE_EVENT("pdfium.codec", "CJPX_Decoder::StartDecode");
   if (!m_Parameters.nb_tile_to_decode) {
     if (!opj_set_decode_area(m_Codec, m_Image, m_Parameters.DA_x0,
                              m_Parameters.DA_y0, m_Parameters.DA_x1,
@@ -517,6 +519,7 @@ bool CJPX_Decoder::Decode(pdfium::span<uint8_t> dest_buf,
                           uint32_t pitch,
                           bool swap_rgb,
                           uint32_t component_count) {
+  FX_TRACE_EVENT("pdfium.codec", "CJPX_Decoder::Decode");
   CHECK_LE(component_count, m_Image->numcomps);
   uint32_t channel_count = component_count;
   if (channel_count == 3 && m_Image->numcomps == 4) {
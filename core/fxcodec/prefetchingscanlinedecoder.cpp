@@ -0,0 +1,111 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/prefetchingscanlinedecoder.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "core/fxcrt/cfx_tracelog.h"
+#include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/span_util.h"
+#include "third_party/base/check.h"
+
+namespace fxcodec {
+
+// static
+std::unique_ptr<ScanlineDecoder> PrefetchingScanlineDecoder::Create(
+    std::unique_ptr<ScanlineDecoder> pDecoder,
+    CFX_ThreadPool* pPool) {
+  DCHECK(pDecoder);
+  if (!pPool || pDecoder->GetHeight() <= 0)
+    return pDecoder;
+
+  FX_SAFE_UINT32 pitch = pDecoder->GetBPC();
+  pitch *= pDecoder->CountComps();
+  pitch *= pDecoder->GetWidth();
+  pitch += 7;
+  pitch /= 8;
+  FX_SAFE_SIZE_T size = pitch.ValueOrDefault(0);
+  size *= pDecoder->GetHeight();
+  if (!pitch.IsValid() || pitch.ValueOrDie() == 0 || !size.IsValid())
+    return pDecoder;
+
+  FixedTryAllocZeroedDataVector<uint8_t> buffer(size.ValueOrDie());
+  if (buffer.empty())
+    return pDecoder;
+
+  return std::unique_ptr<ScanlineDecoder>(new PrefetchingScanlineDecoder(
+      std::move(pDecoder), pitch.ValueOrDie(), std::move(buffer), pPool));
+}
+
+PrefetchingScanlineDecoder::PrefetchingScanlineDecoder(
+    std::unique_ptr<ScanlineDecoder> pDecoder,
+    uint32_t pitch,
+    FixedTryAllocZeroedDataVector<uint8_t> buffer,
+    CFX_ThreadPool* pPool)
+    : ScanlineDecoder(pDecoder->GetWidth(),
+                      pDecoder->GetHeight(),
+                      pDecoder->GetWidth(),
+                      pDecoder->GetHeight(),
+                      pDecoder->CountComps(),
+                      pDecoder->GetBPC(),
+                      pitch),
+      m_pDecoder(std::move(pDecoder)),
+      m_Buffer(std::move(buffer)),
+      m_TaskGroup(pPool) {
+  m_TaskGroup.Post([this] { DecodeAllLines(); });
+}
+
+PrefetchingScanlineDecoder::~PrefetchingScanlineDecoder() {
+  // `m_TaskGroup` waits for the task when it is destroyed.
+  m_bCancelled = true;
+}
+
+uint32_t PrefetchingScanlineDecoder::GetSrcOffset() {
+  WaitForDecoding();
+  return m_pDecoder->GetSrcOffset();
+}
+
+bool PrefetchingScanlineDecoder::Rewind() {
+  m_nCurrentLine = 0;
+  return true;
+}
+
+pdfium::span<uint8_t> PrefetchingScanlineDecoder::GetNextLine() {
+  WaitForDecoding();
+  if (m_nCurrentLine >= m_nDecodedLines)
+    return pdfium::span<uint8_t>();
+
+  const size_t offset = static_cast<size_t>(m_nCurrentLine++) * m_Pitch;
+  return m_Buffer.writable_span().subspan(offset, m_Pitch);
+}
+
+void PrefetchingScanlineDecoder::DecodeAllLines() {
+  FX_TRACE_EVENT("pdfium.codec", "PrefetchingScanlineDecoder::DecodeAllLines");
+  pdfium::span<uint8_t> dest = m_Buffer.writable_span();
+  for (int line = 0; line < m_OutputHeight; ++line) {
+    if (m_bCancelled)
+      break;
+
+    pdfium::span<const uint8_t> src = m_pDecoder->GetScanline(line);
+    if (src.empty())
+      break;
+
+    src = src.first(std::min<size_t>(src.size(), m_Pitch));
+    fxcrt::spancpy(dest.subspan(static_cast<size_t>(line) * m_Pitch), src);
+    m_nDecodedLines = line + 1;
+  }
+}
+
+void PrefetchingScanlineDecoder::WaitForDecoding() {
+  if (m_bDecodingDone)
+    return;
+
+  FX_TRACE_EVENT("pdfium.codec", "PrefetchingScanlineDecoder::WaitForDecoding");
+  m_TaskGroup.Wait();
+  m_bDecodingDone = true;
+}
+
+}  // namespace fxcodec
@@ -0,0 +1,68 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCODEC_PREFETCHINGSCANLINEDECODER_H_
+#define CORE_FXCODEC_PREFETCHINGSCANLINEDECODER_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "core/fxcodec/scanlinedecoder.h"
+#include "core/fxcrt/cfx_threadpool.h"
+#include "core/fxcrt/fixed_try_alloc_zeroed_data_vector.h"
+
+namespace fxcodec {
+
+// Decodes every scanline of another decoder on a thread pool as soon as it is
+// created, so the decoding overlaps with whatever the caller does before it
+// asks for the first scanline. The first GetScanline() call blocks until
+// decoding has finished. Destroying the decoder before then stops decoding
+// after the scanline in progress.
+//
+// The wrapped decoder must not depend on Retainable objects, and its source
+// data must outlive this decoder.
+class PrefetchingScanlineDecoder final : public ScanlineDecoder {
+ public:
+  // Returns `pDecoder` unchanged when the decoded image cannot be buffered.
+  static std::unique_ptr<ScanlineDecoder> Create(
+      std::unique_ptr<ScanlineDecoder> pDecoder,
+      CFX_ThreadPool* pPool);
+
+  ~PrefetchingScanlineDecoder() override;
+
+  // ScanlineDecoder:
+  uint32_t GetSrcOffset() override;
+
+ private:
+  PrefetchingScanlineDecoder(std::unique_ptr<ScanlineDecoder> pDecoder,
+                             uint32_t pitch,
+                             FixedTryAllocZeroedDataVector<uint8_t> buffer,
+                             CFX_ThreadPool* pPool);
+
+  // ScanlineDecoder:
+  bool Rewind() override;
+  pdfium::span<uint8_t> GetNextLine() override;
+
+  // Runs on the thread pool.
+  void DecodeAllLines();
+  void WaitForDecoding();
+
+  std::unique_ptr<ScanlineDecoder> const m_pDecoder;
+  FixedTryAllocZeroedDataVector<uint8_t> m_Buffer;
+  std::atomic<bool> m_bCancelled{false};
+  int m_nDecodedLines = 0;
+  int m_nCurrentLine = 0;
+  bool m_bDecodingDone = false;
+
+  // Must be last, so decoding finishes before any other member is destroyed.
+  CFX_TaskGroup m_TaskGroup;
+};
+
+}  // namespace fxcodec
+
+using fxcodec::PrefetchingScanlineDecoder;
+
+#endif  // CORE_FXCODEC_PREFETCHINGSCANLINEDECODER_H_
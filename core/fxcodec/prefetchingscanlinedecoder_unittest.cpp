@@ -0,0 +1,129 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/prefetchingscanlinedecoder.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/fxcodec/basic/basicmodule.h"
+#include "core/fxcrt/cfx_threadpool.h"
+#include "core/fxcrt/data_vector.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr int kWidth = 7;
+constexpr int kHeight = 5;
+constexpr int kComps = 3;
+
+DataVector<uint8_t> MakeImage() {
+  DataVector<uint8_t> image(kWidth * kHeight * kComps);
+  for (size_t i = 0; i < image.size(); ++i)
+    image[i] = static_cast<uint8_t>(i * 7);
+  return image;
+}
+
+// Counts the scanlines it produces.
+class CountingDecoder final : public ScanlineDecoder {
+ public:
+  explicit CountingDecoder(int* lines_decoded)
+      : ScanlineDecoder(kWidth,
+                        kHeight,
+                        kWidth,
+                        kHeight,
+                        kComps,
+                        8,
+                        kWidth * kComps),
+        m_pLinesDecoded(lines_decoded),
+        m_Line(kWidth * kComps) {}
+
+  // ScanlineDecoder:
+  uint32_t GetSrcOffset() override { return 0; }
+  bool Rewind() override { return true; }
+  pdfium::span<uint8_t> GetNextLine() override {
+    ++*m_pLinesDecoded;
+    return m_Line;
+  }
+
+ private:
+  int* const m_pLinesDecoded;
+  DataVector<uint8_t> m_Line;
+};
+
+// Holds on to posted tasks until told to run them.
+class HoldingThreadPool final : public CFX_ThreadPool {
+ public:
+  // CFX_ThreadPool:
+  size_t GetMaxConcurrency() const override { return 1; }
+  void PostTask(Task task) override { m_Tasks.push_back(std::move(task)); }
+
+  void RunTasks() {
+    for (Task& task : m_Tasks)
+      task();
+    m_Tasks.clear();
+  }
+
+ private:
+  std::vector<Task> m_Tasks;
+};
+
+}  // namespace
+
+TEST(PrefetchingScanlineDecoderTest, MatchesWrappedDecoder) {
+  const DataVector<uint8_t> image = MakeImage();
+  const DataVector<uint8_t> encoded = BasicModule::RunLengthEncode(image);
+  std::unique_ptr<CFX_ThreadPool> pool = CFX_ThreadPool::CreateDefault(2);
+
+  std::unique_ptr<ScanlineDecoder> decoder =
+      PrefetchingScanlineDecoder::Create(
+          BasicModule::CreateRunLengthDecoder(encoded, kWidth, kHeight, kComps,
+                                              8),
+          pool.get());
+  ASSERT_TRUE(decoder);
+  EXPECT_EQ(kWidth, decoder->GetWidth());
+  EXPECT_EQ(kHeight, decoder->GetHeight());
+  EXPECT_EQ(kComps, decoder->CountComps());
+  EXPECT_EQ(8, decoder->GetBPC());
+
+  // Read out of order, to exercise rewinding.
+  for (int line : {2, 0, 4, 3, 1}) {
+    pdfium::span<const uint8_t> scanline = decoder->GetScanline(line);
+    ASSERT_EQ(static_cast<size_t>(kWidth * kComps), scanline.size());
+    EXPECT_EQ(pdfium::make_span(image).subspan(line * kWidth * kComps,
+                                               kWidth * kComps),
+              scanline);
+  }
+}
+
+TEST(PrefetchingScanlineDecoderTest, NoPool) {
+  const DataVector<uint8_t> image = MakeImage();
+  const DataVector<uint8_t> encoded = BasicModule::RunLengthEncode(image);
+  std::unique_ptr<ScanlineDecoder> original =
+      BasicModule::CreateRunLengthDecoder(encoded, kWidth, kHeight, kComps, 8);
+  ScanlineDecoder* original_ptr = original.get();
+  std::unique_ptr<ScanlineDecoder> decoder =
+      PrefetchingScanlineDecoder::Create(std::move(original), nullptr);
+  EXPECT_EQ(original_ptr, decoder.get());
+}
+
+TEST(PrefetchingScanlineDecoderTest, DestroyBeforeDecoding) {
+  HoldingThreadPool pool;
+  int lines_decoded = 0;
+  std::unique_ptr<ScanlineDecoder> decoder =
+      PrefetchingScanlineDecoder::Create(
+          std::make_unique<CountingDecoder>(&lines_decoded), &pool);
+  ASSERT_TRUE(decoder);
+
+  // Destroying the decoder must not decode the image on the calling thread.
+  decoder.reset();
+  EXPECT_EQ(0, lines_decoded);
+
+  // The task the pool still holds no longer has anything to do.
+  pool.RunTasks();
+  EXPECT_EQ(0, lines_decoded);
+}
@@ -0,0 +1,48 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_memoryaccount.h"
+
+#include "third_party/base/check_op.h"
+
+CFX_MemoryAccount::CFX_MemoryAccount() = default;
+
+CFX_MemoryAccount::~CFX_MemoryAccount() = default;
+
+bool CFX_MemoryAccount::TryCharge(Category category, size_t bytes) {
+  if (!CanCharge(bytes))
+    return false;
+
+  Charge(category, bytes);
+  return true;
+}
+
+void CFX_MemoryAccount::Charge(Category category, size_t bytes) {
+  m_Usage[static_cast<size_t>(category)] += bytes;
+  m_TotalUsage += bytes;
+}
+
+void CFX_MemoryAccount::Refund(Category category, size_t bytes) {
+  size_t& usage = m_Usage[static_cast<size_t>(category)];
+  DCHECK_GE(usage, bytes);
+  DCHECK_GE(m_TotalUsage, bytes);
+  usage -= bytes;
+  m_TotalUsage -= bytes;
+}
+
+size_t CFX_MemoryAccount::GetUsage(Category category) const {
+  return m_Usage[static_cast<size_t>(category)];
+}
+
+bool CFX_MemoryAccount::CanCharge(size_t bytes) const {
+  if (!m_Limit)
+    return true;
+  return m_TotalUsage <= m_Limit && bytes <= m_Limit - m_TotalUsage;
+}
+
+size_t CFX_MemoryAccount::GetAvailable() const {
+  if (!m_Limit)
+    return SIZE_MAX;
+  return m_TotalUsage < m_Limit ? m_Limit - m_TotalUsage : 0;
+}
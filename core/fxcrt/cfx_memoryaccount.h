@@ -0,0 +1,69 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_CFX_MEMORYACCOUNT_H_
+#define CORE_FXCRT_CFX_MEMORYACCOUNT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+#include "core/fxcrt/retain_ptr.h"
+
+// Tracks the memory attributed to a single document, broken down by category,
+// and optionally enforces a hard limit on the total. Sizes are estimates
+// supplied by the code that owns the memory, not exact heap usage.
+//
+// Objects that may outlive the document (e.g. pages) hold a RetainPtr to the
+// account so their Refund() calls always have somewhere to go.
+class CFX_MemoryAccount final : public Retainable {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // Mapped to FPDF_MEMORY_CATEGORY_* values in fpdfsdk/fpdf_view.cpp.
+  enum class Category : uint8_t {
+    kParser = 0,
+    kDecodedStreams,
+    kPageObjects,
+    kImageCaches,
+    kGlyphCaches,
+    kLast = kGlyphCaches,
+  };
+
+  // Returns false, and charges nothing, if `bytes` would take the total usage
+  // past the limit.
+  bool TryCharge(Category category, size_t bytes);
+
+  // Charges `bytes` regardless of the limit. For memory that has already been
+  // allocated and cannot be given back.
+  void Charge(Category category, size_t bytes);
+
+  void Refund(Category category, size_t bytes);
+
+  size_t GetUsage(Category category) const;
+  size_t GetTotalUsage() const { return m_TotalUsage; }
+
+  // A `limit` of 0 means unlimited. Lowering the limit below the current usage
+  // does not free anything, but makes all further TryCharge() calls fail until
+  // enough memory is released.
+  void SetLimit(size_t limit) { m_Limit = limit; }
+  size_t GetLimit() const { return m_Limit; }
+
+  bool CanCharge(size_t bytes) const;
+  // Returns how many more bytes TryCharge() would accept, or SIZE_MAX when
+  // there is no limit.
+  size_t GetAvailable() const;
+  bool IsOverLimit() const { return m_Limit && m_TotalUsage > m_Limit; }
+
+ private:
+  CFX_MemoryAccount();
+  ~CFX_MemoryAccount() override;
+
+  size_t m_Limit = 0;
+  size_t m_TotalUsage = 0;
+  std::array<size_t, static_cast<size_t>(Category::kLast) + 1> m_Usage = {};
+};
+
+#endif  // CORE_FXCRT_CFX_MEMORYACCOUNT_H_
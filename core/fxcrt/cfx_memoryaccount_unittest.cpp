@@ -0,0 +1,56 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_memoryaccount.h"
+
+#include <stdint.h>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+using Category = CFX_MemoryAccount::Category;
+
+TEST(CFXMemoryAccountTest, TracksCategories) {
+  auto account = pdfium::MakeRetain<CFX_MemoryAccount>();
+  EXPECT_EQ(0u, account->GetTotalUsage());
+
+  EXPECT_TRUE(account->TryCharge(Category::kParser, 10));
+  account->Charge(Category::kImageCaches, 20);
+  EXPECT_EQ(10u, account->GetUsage(Category::kParser));
+  EXPECT_EQ(20u, account->GetUsage(Category::kImageCaches));
+  EXPECT_EQ(0u, account->GetUsage(Category::kGlyphCaches));
+  EXPECT_EQ(30u, account->GetTotalUsage());
+
+  account->Refund(Category::kImageCaches, 15);
+  EXPECT_EQ(5u, account->GetUsage(Category::kImageCaches));
+  EXPECT_EQ(15u, account->GetTotalUsage());
+}
+
+TEST(CFXMemoryAccountTest, EnforcesLimit) {
+  auto account = pdfium::MakeRetain<CFX_MemoryAccount>();
+  account->SetLimit(100);
+  EXPECT_TRUE(account->TryCharge(Category::kDecodedStreams, 60));
+  EXPECT_FALSE(account->TryCharge(Category::kPageObjects, 41));
+  EXPECT_EQ(0u, account->GetUsage(Category::kPageObjects));
+  EXPECT_TRUE(account->TryCharge(Category::kPageObjects, 40));
+  EXPECT_FALSE(account->IsOverLimit());
+  EXPECT_FALSE(account->CanCharge(1));
+
+  // Unconditional charges may exceed the limit.
+  account->Charge(Category::kParser, 10);
+  EXPECT_TRUE(account->IsOverLimit());
+  EXPECT_FALSE(account->TryCharge(Category::kParser, 0));
+
+  account->Refund(Category::kDecodedStreams, 60);
+  EXPECT_FALSE(account->IsOverLimit());
+  EXPECT_TRUE(account->CanCharge(50));
+  EXPECT_FALSE(account->CanCharge(51));
+  EXPECT_EQ(50u, account->GetAvailable());
+
+  account->SetLimit(20);
+  EXPECT_EQ(0u, account->GetAvailable());
+
+  account->SetLimit(0);
+  EXPECT_TRUE(account->CanCharge(SIZE_MAX));
+  EXPECT_EQ(SIZE_MAX, account->GetAvailable());
+}
@@ -0,0 +1,88 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_renderprofile.h"
+
+namespace {
+
+thread_local CFX_RenderProfile* g_pCurrentProfile = nullptr;
+
+}  // namespace
+
+CFX_RenderProfile::ScopedCurrent::ScopedCurrent(CFX_RenderProfile* profile)
+    : m_pPrevious(g_pCurrentProfile) {
+  g_pCurrentProfile = profile;
+}
+
+CFX_RenderProfile::ScopedCurrent::~ScopedCurrent() {
+  g_pCurrentProfile = m_pPrevious;
+}
+
+CFX_RenderProfile::ScopedPhase::ScopedPhase(Phase phase)
+    : m_pProfile(g_pCurrentProfile) {
+  if (!m_pProfile)
+    return;
+
+  m_pProfile->ChargeCurrentPhase();
+  m_PreviousPhase = m_pProfile->m_CurrentPhase;
+  m_pProfile->m_CurrentPhase = phase;
+  ++m_pProfile->m_PhaseStats[static_cast<size_t>(phase)].calls;
+}
+
+CFX_RenderProfile::ScopedPhase::~ScopedPhase() {
+  if (!m_pProfile)
+    return;
+
+  m_pProfile->ChargeCurrentPhase();
+  m_pProfile->m_CurrentPhase = m_PreviousPhase;
+}
+
+CFX_RenderProfile::ScopedObject::ScopedObject(CFX_RenderProfile* profile,
+                                              size_t layer,
+                                              size_t index)
+    : m_pProfile(profile),
+      m_Layer(layer),
+      m_Index(index),
+      m_Start(profile ? Clock::now() : Clock::time_point()),
+      m_StartAllocations(profile ? FX_GetThreadAllocationCount() : 0) {}
+
+CFX_RenderProfile::ScopedObject::~ScopedObject() {
+  if (!m_pProfile)
+    return;
+
+  std::vector<ObjectStats>& objects = m_pProfile->m_ObjectStats;
+  if (objects.empty() || objects.back().layer != m_Layer ||
+      objects.back().index != m_Index) {
+    objects.push_back({m_Layer, m_Index, Stats()});
+  }
+  Stats& stats = objects.back().stats;
+  ++stats.calls;
+  stats.time += Clock::now() - m_Start;
+  stats.allocations += FX_GetThreadAllocationCount() - m_StartAllocations;
+}
+
+CFX_RenderProfile::CFX_RenderProfile() {
+  FX_StartCountingAllocations();
+}
+
+CFX_RenderProfile::~CFX_RenderProfile() {
+  FX_StopCountingAllocations();
+}
+
+// static
+CFX_RenderProfile* CFX_RenderProfile::GetCurrent() {
+  return g_pCurrentProfile;
+}
+
+void CFX_RenderProfile::ChargeCurrentPhase() {
+  const Clock::time_point now = Clock::now();
+  const uint64_t allocations = FX_GetThreadAllocationCount();
+  if (m_CurrentPhase.has_value()) {
+    Stats& stats = m_PhaseStats[static_cast<size_t>(m_CurrentPhase.value())];
+    stats.time += now - m_PhaseStart;
+    stats.allocations += allocations - m_PhaseStartAllocations;
+  }
+  m_PhaseStart = now;
+  m_PhaseStartAllocations = allocations;
+}
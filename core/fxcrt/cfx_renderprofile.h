@@ -0,0 +1,124 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_CFX_RENDERPROFILE_H_
+#define CORE_FXCRT_CFX_RENDERPROFILE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include "core/fxcrt/fx_memory.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/base/span.h"
+
+// Attributes the time and allocations of a render to the phases of rendering
+// and to the top-level page objects. Code marks its phases with ScopedPhase,
+// which records into the profile made current on the calling thread by
+// ScopedCurrent, and does nothing when there is none. Phases nest, and each
+// phase only gets charged for the time and allocations that its nested phases
+// do not account for.
+class CFX_RenderProfile {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Mapped to FPDF_RENDER_PHASE_* values in fpdfsdk/fpdf_progressive.cpp.
+  enum class Phase : uint8_t {
+    kParse = 0,
+    kResourceLoad,
+    kImageDecode,
+    kStretch,
+    kComposite,
+    kText,
+    kPath,
+    kShading,
+    kTransparency,
+    kLast = kTransparency,
+  };
+
+  struct Stats {
+    // How many times the phase was entered, or the object was started or
+    // resumed.
+    uint64_t calls = 0;
+    Clock::duration time{0};
+    // Counted by FX_GetThreadAllocationCount(), which counts while any
+    // profile exists.
+    uint64_t allocations = 0;
+  };
+
+  struct ObjectStats {
+    size_t layer;
+    size_t index;
+    Stats stats;
+  };
+
+  class ScopedCurrent {
+   public:
+    FX_STACK_ALLOCATED();
+
+    explicit ScopedCurrent(CFX_RenderProfile* profile);
+    ~ScopedCurrent();
+
+   private:
+    CFX_RenderProfile* const m_pPrevious;
+  };
+
+  class ScopedPhase {
+   public:
+    FX_STACK_ALLOCATED();
+
+    explicit ScopedPhase(Phase phase);
+    ~ScopedPhase();
+
+   private:
+    CFX_RenderProfile* const m_pProfile;
+    absl::optional<Phase> m_PreviousPhase;
+  };
+
+  // Charges everything done while it exists to the object at `index` in
+  // `layer`, including the time spent in phases. Rendering the same object
+  // again right away, e.g. to resume it, adds to its existing stats.
+  class ScopedObject {
+   public:
+    FX_STACK_ALLOCATED();
+
+    ScopedObject(CFX_RenderProfile* profile, size_t layer, size_t index);
+    ~ScopedObject();
+
+   private:
+    CFX_RenderProfile* const m_pProfile;
+    const size_t m_Layer;
+    const size_t m_Index;
+    const Clock::time_point m_Start;
+    const uint64_t m_StartAllocations;
+  };
+
+  CFX_RenderProfile();
+  ~CFX_RenderProfile();
+
+  static CFX_RenderProfile* GetCurrent();
+
+  const Stats& GetPhaseStats(Phase phase) const {
+    return m_PhaseStats[static_cast<size_t>(phase)];
+  }
+  pdfium::span<const ObjectStats> GetObjectStats() const {
+    return m_ObjectStats;
+  }
+
+ private:
+  // Charges the current phase, if any, with everything since the last switch
+  // of phases.
+  void ChargeCurrentPhase();
+
+  absl::optional<Phase> m_CurrentPhase;
+  Clock::time_point m_PhaseStart;
+  uint64_t m_PhaseStartAllocations = 0;
+  std::array<Stats, static_cast<size_t>(Phase::kLast) + 1> m_PhaseStats;
+  std::vector<ObjectStats> m_ObjectStats;
+};
+
+#endif  // CORE_FXCRT_CFX_RENDERPROFILE_H_
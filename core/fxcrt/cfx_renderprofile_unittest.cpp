@@ -0,0 +1,111 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_renderprofile.h"
+
+#include "core/fxcrt/fx_memory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+using Phase = CFX_RenderProfile::Phase;
+
+void AllocateAndFree(int count) {
+  for (int i = 0; i < count; ++i)
+    FX_Free(FX_Alloc(uint8_t, 16));
+}
+
+}  // namespace
+
+TEST(CFXRenderProfileTest, NoCurrentProfile) {
+  EXPECT_FALSE(CFX_RenderProfile::GetCurrent());
+  CFX_RenderProfile profile;
+  {
+    // Phases outside of a ScopedCurrent go nowhere.
+    CFX_RenderProfile::ScopedPhase phase(Phase::kPath);
+  }
+  EXPECT_EQ(0u, profile.GetPhaseStats(Phase::kPath).calls);
+
+  {
+    CFX_RenderProfile::ScopedCurrent current(&profile);
+    EXPECT_EQ(&profile, CFX_RenderProfile::GetCurrent());
+    {
+      CFX_RenderProfile::ScopedCurrent nested(nullptr);
+      EXPECT_FALSE(CFX_RenderProfile::GetCurrent());
+    }
+    EXPECT_EQ(&profile, CFX_RenderProfile::GetCurrent());
+  }
+  EXPECT_FALSE(CFX_RenderProfile::GetCurrent());
+}
+
+TEST(CFXRenderProfileTest, NestedPhases) {
+  CFX_RenderProfile profile;
+  CFX_RenderProfile::ScopedCurrent current(&profile);
+  {
+    CFX_RenderProfile::ScopedPhase stretch(Phase::kStretch);
+    AllocateAndFree(2);
+    {
+      CFX_RenderProfile::ScopedPhase decode(Phase::kImageDecode);
+      AllocateAndFree(3);
+    }
+    {
+      CFX_RenderProfile::ScopedPhase decode(Phase::kImageDecode);
+      AllocateAndFree(4);
+    }
+    AllocateAndFree(1);
+  }
+
+  // The allocations of the nested phases only count for those phases.
+  const CFX_RenderProfile::Stats& stretch =
+      profile.GetPhaseStats(Phase::kStretch);
+  EXPECT_EQ(1u, stretch.calls);
+  EXPECT_EQ(3u, stretch.allocations);
+  const CFX_RenderProfile::Stats& decode =
+      profile.GetPhaseStats(Phase::kImageDecode);
+  EXPECT_EQ(2u, decode.calls);
+  EXPECT_EQ(7u, decode.allocations);
+  EXPECT_EQ(0u, profile.GetPhaseStats(Phase::kText).calls);
+}
+
+TEST(CFXRenderProfileTest, Objects) {
+  CFX_RenderProfile profile;
+  CFX_RenderProfile::ScopedCurrent current(&profile);
+  {
+    CFX_RenderProfile::ScopedObject object(&profile, 0, 0);
+    CFX_RenderProfile::ScopedPhase path(Phase::kPath);
+    AllocateAndFree(2);
+  }
+  {
+    CFX_RenderProfile::ScopedObject object(&profile, 0, 1);
+    AllocateAndFree(1);
+  }
+  {
+    // Resuming the last object adds to its stats.
+    CFX_RenderProfile::ScopedObject object(&profile, 0, 1);
+    AllocateAndFree(1);
+  }
+  {
+    CFX_RenderProfile::ScopedObject object(&profile, 1, 1);
+  }
+  {
+    // Does nothing without a profile.
+    CFX_RenderProfile::ScopedObject object(nullptr, 1, 2);
+  }
+
+  pdfium::span<const CFX_RenderProfile::ObjectStats> objects =
+      profile.GetObjectStats();
+  ASSERT_EQ(3u, objects.size());
+  EXPECT_EQ(0u, objects[0].layer);
+  EXPECT_EQ(0u, objects[0].index);
+  EXPECT_EQ(1u, objects[0].stats.calls);
+  EXPECT_EQ(2u, objects[0].stats.allocations);
+  EXPECT_EQ(0u, objects[1].layer);
+  EXPECT_EQ(1u, objects[1].index);
+  EXPECT_EQ(2u, objects[1].stats.calls);
+  EXPECT_EQ(2u, objects[1].stats.allocations);
+  EXPECT_EQ(1u, objects[2].layer);
+  EXPECT_EQ(1u, objects[2].index);
+  EXPECT_EQ(0u, objects[2].stats.allocations);
+  EXPECT_EQ(2u, profile.GetPhaseStats(Phase::kPath).allocations);
+}
@@ -0,0 +1,163 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_threadpool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "third_party/base/check.h"
+
+namespace {
+
+CFX_ThreadPool* g_pThreadPool = nullptr;
+
+class DefaultThreadPool final : public CFX_ThreadPool {
+ public:
+  explicit DefaultThreadPool(size_t num_threads) : m_nThreads(num_threads) {}
+
+  ~DefaultThreadPool() override {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_bShutdown = true;
+    }
+    m_WorkAvailable.notify_all();
+    for (std::thread& worker : m_Workers)
+      worker.join();
+  }
+
+  // CFX_ThreadPool:
+  size_t GetMaxConcurrency() const override { return m_nThreads; }
+
+  void PostTask(Task task) override {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      DCHECK(!m_bShutdown);
+      // Threads are started lazily, so embedders that never use parallel
+      // features do not pay for them.
+      if (m_Workers.empty()) {
+        m_Workers.reserve(m_nThreads);
+        for (size_t i = 0; i < m_nThreads; ++i)
+          m_Workers.emplace_back(&DefaultThreadPool::WorkerMain, this);
+      }
+      m_Tasks.push_back(std::move(task));
+    }
+    m_WorkAvailable.notify_one();
+  }
+
+ private:
+  void WorkerMain() {
+    while (true) {
+      Task task;
+      {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_WorkAvailable.wait(
+            lock, [this] { return m_bShutdown || !m_Tasks.empty(); });
+        if (m_Tasks.empty())
+          return;
+        task = std::move(m_Tasks.front());
+        m_Tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+  const size_t m_nThreads;
+  std::mutex m_Mutex;
+  std::condition_variable m_WorkAvailable;
+  std::deque<Task> m_Tasks;
+  std::vector<std::thread> m_Workers;
+  bool m_bShutdown = false;
+};
+
+}  // namespace
+
+// static
+void CFX_ThreadPool::Initialize(std::unique_ptr<CFX_ThreadPool> pPool) {
+  DCHECK(!g_pThreadPool);
+  g_pThreadPool = pPool ? pPool.release() : CreateDefault(0).release();
+}
+
+// static
+void CFX_ThreadPool::Destroy() {
+  DCHECK(g_pThreadPool);
+  delete g_pThreadPool;
+  g_pThreadPool = nullptr;
+}
+
+// static
+CFX_ThreadPool* CFX_ThreadPool::Get() {
+  return g_pThreadPool;
+}
+
+// static
+std::unique_ptr<CFX_ThreadPool> CFX_ThreadPool::CreateDefault(
+    size_t num_threads) {
+  if (!num_threads) {
+    unsigned int cores = std::thread::hardware_concurrency();
+    num_threads = std::max(cores, 2u) - 1;
+  }
+  return std::make_unique<DefaultThreadPool>(num_threads);
+}
+
+CFX_ThreadPool::~CFX_ThreadPool() = default;
+
+// Shared with posted tasks, which may outlive the group when the group's
+// Wait() ran them on the calling thread before a worker got to them.
+struct CFX_TaskGroup::State {
+  // Runs one pending task, if any. Returns false if there was none.
+  bool RunOne() {
+    CFX_ThreadPool::Task task;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (pending.empty())
+        return false;
+      task = std::move(pending.front());
+      pending.pop_front();
+    }
+    task();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      --unfinished;
+    }
+    done.notify_all();
+    return true;
+  }
+
+  std::mutex mutex;
+  std::condition_variable done;
+  std::deque<CFX_ThreadPool::Task> pending;
+  size_t unfinished = 0;
+};
+
+CFX_TaskGroup::CFX_TaskGroup(CFX_ThreadPool* pPool)
+    : m_pPool(pPool), m_pState(std::make_shared<State>()) {}
+
+CFX_TaskGroup::~CFX_TaskGroup() {
+  Wait();
+}
+
+void CFX_TaskGroup::Post(CFX_ThreadPool::Task task) {
+  {
+    std::lock_guard<std::mutex> lock(m_pState->mutex);
+    m_pState->pending.push_back(std::move(task));
+    ++m_pState->unfinished;
+  }
+  // Each posted wrapper runs whichever task is next, so the order in which
+  // workers pick up wrappers does not matter.
+  if (m_pPool)
+    m_pPool->PostTask([state = m_pState] { state->RunOne(); });
+}
+
+void CFX_TaskGroup::Wait() {
+  while (m_pState->RunOne()) {
+  }
+  std::unique_lock<std::mutex> lock(m_pState->mutex);
+  m_pState->done.wait(lock, [this] { return m_pState->unfinished == 0; });
+}
@@ -0,0 +1,66 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_CFX_THREADPOOL_H_
+#define CORE_FXCRT_CFX_THREADPOOL_H_
+
+#include <stddef.h>
+
+#include <functional>
+#include <memory>
+
+// Process-wide pool for running independent pieces of work in parallel. The
+// pool is either supplied by the embedder or a default internal one.
+//
+// Tasks run concurrently with the thread that posted them. Reference counts
+// on Retainable objects are not atomic, so tasks must only touch data that no
+// other thread uses while they run, and must not create or destroy RetainPtrs
+// to shared objects.
+class CFX_ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  // Installs `pPool` as the process-wide pool. When `pPool` is null, a default
+  // pool is installed that starts its threads on first use.
+  static void Initialize(std::unique_ptr<CFX_ThreadPool> pPool);
+  static void Destroy();
+
+  // Returns null outside of Initialize() / Destroy().
+  static CFX_ThreadPool* Get();
+
+  // Creates a pool with `num_threads` workers, or one per available core
+  // except the caller's when `num_threads` is 0.
+  static std::unique_ptr<CFX_ThreadPool> CreateDefault(size_t num_threads);
+
+  virtual ~CFX_ThreadPool();
+
+  // Number of tasks that may run at the same time, excluding the caller.
+  virtual size_t GetMaxConcurrency() const = 0;
+
+  // Runs `task` exactly once on some thread.
+  virtual void PostTask(Task task) = 0;
+};
+
+// Runs a batch of tasks on a pool and waits for them to finish. Tasks that no
+// worker has picked up by the time Wait() is called run on the waiting thread,
+// so a batch always completes, even when the pool is busy with other work or
+// is null.
+class CFX_TaskGroup {
+ public:
+  explicit CFX_TaskGroup(CFX_ThreadPool* pPool);
+  ~CFX_TaskGroup();
+
+  void Post(CFX_ThreadPool::Task task);
+
+  // Blocks until all posted tasks have run.
+  void Wait();
+
+ private:
+  struct State;
+
+  CFX_ThreadPool* const m_pPool;
+  std::shared_ptr<State> const m_pState;
+};
+
+#endif  // CORE_FXCRT_CFX_THREADPOOL_H_
@@ -0,0 +1,57 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_threadpool.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(CFXThreadPoolTest, DefaultPoolRunsTasks) {
+  std::unique_ptr<CFX_ThreadPool> pool = CFX_ThreadPool::CreateDefault(3);
+  EXPECT_EQ(3u, pool->GetMaxConcurrency());
+
+  std::atomic<int> count{0};
+  {
+    CFX_TaskGroup group(pool.get());
+    for (int i = 0; i < 100; ++i)
+      group.Post([&count] { ++count; });
+    group.Wait();
+    EXPECT_EQ(100, count.load());
+  }
+}
+
+TEST(CFXThreadPoolTest, TaskGroupWithoutPoolRunsInline) {
+  std::vector<int> order;
+  CFX_TaskGroup group(nullptr);
+  group.Post([&order] { order.push_back(1); });
+  group.Post([&order] { order.push_back(2); });
+  EXPECT_TRUE(order.empty());
+  group.Wait();
+  EXPECT_EQ((std::vector<int>{1, 2}), order);
+}
+
+TEST(CFXThreadPoolTest, DestructorWaits) {
+  std::unique_ptr<CFX_ThreadPool> pool = CFX_ThreadPool::CreateDefault(2);
+  std::atomic<int> count{0};
+  {
+    CFX_TaskGroup group(pool.get());
+    for (int i = 0; i < 10; ++i)
+      group.Post([&count] { ++count; });
+  }
+  EXPECT_EQ(10, count.load());
+}
+
+TEST(CFXThreadPoolTest, ResultsPerTask) {
+  std::unique_ptr<CFX_ThreadPool> pool = CFX_ThreadPool::CreateDefault(4);
+  std::vector<int> results(64);
+  CFX_TaskGroup group(pool.get());
+  for (size_t i = 0; i < results.size(); ++i)
+    group.Post([&results, i] { results[i] = static_cast<int>(i * i); });
+  group.Wait();
+  for (size_t i = 0; i < results.size(); ++i)
+    EXPECT_EQ(static_cast<int>(i * i), results[i]);
+}
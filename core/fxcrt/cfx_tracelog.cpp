@@ -0,0 +1,121 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_tracelog.h"
+
+#include <inttypes.h>
+
+#include <chrono>
+#include <sstream>
+
+#include "build/build_config.h"
+#include "core/fxcrt/fx_string_wrappers.h"
+#include "third_party/base/no_destructor.h"
+
+#if BUILDFLAG(IS_WIN)
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+int64_t NowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Small, stable numbers are all the trace viewers need to tell threads apart.
+uint32_t GetThreadId() {
+  static std::atomic<uint32_t> s_NextThreadId{1};
+  thread_local uint32_t t_ThreadId = s_NextThreadId.fetch_add(1);
+  return t_ThreadId;
+}
+
+uint32_t GetProcessId() {
+#if BUILDFLAG(IS_WIN)
+  return GetCurrentProcessId();
+#else
+  return static_cast<uint32_t>(getpid());
+#endif
+}
+
+// Trace files use microseconds. Keep the nanoseconds as decimals.
+ByteString FormatMicros(int64_t nanos) {
+  return ByteString::Format("%" PRId64 ".%03d", nanos / 1000,
+                            static_cast<int>(nanos % 1000));
+}
+
+}  // namespace
+
+CFX_TraceLog::ScopedEvent::ScopedEvent(const char* category, const char* name)
+    : m_Category(category),
+      m_Name(name),
+      m_StartNanos(CFX_TraceLog::Get()->IsRecording() ? NowNanos() : -1) {}
+
+CFX_TraceLog::ScopedEvent::~ScopedEvent() {
+  if (m_StartNanos < 0)
+    return;
+
+  CFX_TraceLog::Get()->AddEvent({m_Category, m_Name, m_StartNanos,
+                                 NowNanos() - m_StartNanos, GetThreadId()});
+}
+
+// static
+CFX_TraceLog* CFX_TraceLog::Get() {
+  static pdfium::base::NoDestructor<CFX_TraceLog> s_TraceLog;
+  return s_TraceLog.get();
+}
+
+CFX_TraceLog::CFX_TraceLog() = default;
+
+CFX_TraceLog::~CFX_TraceLog() = default;
+
+void CFX_TraceLog::Start() {
+  std::lock_guard<std::mutex> lock(m_Lock);
+  m_Events.clear();
+  m_bRecording.store(true, std::memory_order_relaxed);
+}
+
+void CFX_TraceLog::Stop() {
+  std::lock_guard<std::mutex> lock(m_Lock);
+  m_bRecording.store(false, std::memory_order_relaxed);
+}
+
+size_t CFX_TraceLog::GetEventCount() const {
+  std::lock_guard<std::mutex> lock(m_Lock);
+  return m_Events.size();
+}
+
+ByteString CFX_TraceLog::GetJSON() const {
+  const uint32_t pid = GetProcessId();
+  fxcrt::ostringstream buf;
+  buf << "{\"traceEvents\":[";
+  {
+    std::lock_guard<std::mutex> lock(m_Lock);
+    for (size_t i = 0; i < m_Events.size(); ++i) {
+      const Event& event = m_Events[i];
+      if (i)
+        buf << ",";
+      buf << "\n{\"name\":\"" << event.name << "\",\"cat\":\""
+          << event.category << "\",\"ph\":\"X\",\"ts\":"
+          << FormatMicros(event.start_nanos)
+          << ",\"dur\":" << FormatMicros(event.duration_nanos)
+          << ",\"pid\":" << pid << ",\"tid\":" << event.thread_id << "}";
+    }
+  }
+  buf << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return ByteString(buf);
+}
+
+void CFX_TraceLog::AddEvent(const Event& event) {
+  std::lock_guard<std::mutex> lock(m_Lock);
+  // Recording may have stopped while the event was open.
+  if (!m_bRecording.load(std::memory_order_relaxed) ||
+      m_Events.size() >= kMaxEvents) {
+    return;
+  }
+  m_Events.push_back(event);
+}
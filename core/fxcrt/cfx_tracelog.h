@@ -0,0 +1,94 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_CFX_TRACELOG_H_
+#define CORE_FXCRT_CFX_TRACELOG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/fx_memory.h"
+
+namespace pdfium {
+namespace base {
+template <typename T>
+class NoDestructor;
+}  // namespace base
+}  // namespace pdfium
+
+// Marks the enclosing scope as a trace event named `name` in `category`. Both
+// must be string literals. Compiles to nothing unless PDFium is built with
+// pdf_enable_trace_events.
+#if defined(PDF_ENABLE_TRACE_EVENTS)
+#define FX_TRACE_EVENT(category, name) \
+  CFX_TraceLog::ScopedEvent FX_TRACE_EVENT_VAR(__LINE__)(category, name)
+#define FX_TRACE_EVENT_VAR(line) FX_TRACE_EVENT_VAR2(line)
+#define FX_TRACE_EVENT_VAR2(line) fx_trace_event_##line
+#else
+#define FX_TRACE_EVENT(category, name) static_cast<void>(0)
+#endif
+
+// Process-wide recorder of trace events, which it writes out in the JSON
+// format of Chrome's trace viewer and Perfetto. Events may be recorded from
+// any thread. Timestamps come from the monotonic clock, which Chrome uses as
+// well, so traces of PDFium and of its embedder line up.
+class CFX_TraceLog {
+ public:
+  // Keeps memory bounded when recording is left on. Later events are dropped.
+  static constexpr size_t kMaxEvents = 1 << 20;
+
+  // Records a complete event spanning its lifetime, when the log is
+  // recording.
+  class ScopedEvent {
+   public:
+    FX_STACK_ALLOCATED();
+
+    ScopedEvent(const char* category, const char* name);
+    ~ScopedEvent();
+
+   private:
+    const char* const m_Category;
+    const char* const m_Name;
+    const int64_t m_StartNanos;
+  };
+
+  static CFX_TraceLog* Get();
+
+  // Discards the events of the previous recording, if any.
+  void Start();
+  void Stop();
+  bool IsRecording() const {
+    return m_bRecording.load(std::memory_order_relaxed);
+  }
+
+  size_t GetEventCount() const;
+  ByteString GetJSON() const;
+
+ private:
+  friend class pdfium::base::NoDestructor<CFX_TraceLog>;
+
+  struct Event {
+    const char* category;
+    const char* name;
+    int64_t start_nanos;
+    int64_t duration_nanos;
+    uint32_t thread_id;
+  };
+
+  CFX_TraceLog();
+  ~CFX_TraceLog();
+
+  void AddEvent(const Event& event);
+
+  std::atomic<bool> m_bRecording{false};
+  mutable std::mutex m_Lock;
+  std::vector<Event> m_Events;  // Guarded by `m_Lock`.
+};
+
+#endif  // CORE_FXCRT_CFX_TRACELOG_H_
@@ -0,0 +1,72 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_tracelog.h"
+
+#include <thread>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(CFXTraceLogTest, NotRecording) {
+  CFX_TraceLog* log = CFX_TraceLog::Get();
+  EXPECT_FALSE(log->IsRecording());
+  log->Start();
+  log->Stop();
+  { CFX_TraceLog::ScopedEvent event("test", "NotRecording"); }
+  EXPECT_EQ(0u, log->GetEventCount());
+  EXPECT_EQ("{\"traceEvents\":[\n],\"displayTimeUnit\":\"ms\"}\n",
+            log->GetJSON());
+}
+
+TEST(CFXTraceLogTest, Record) {
+  CFX_TraceLog* log = CFX_TraceLog::Get();
+  log->Start();
+  EXPECT_TRUE(log->IsRecording());
+  {
+    CFX_TraceLog::ScopedEvent outer("test", "Outer");
+    { CFX_TraceLog::ScopedEvent inner("test", "Inner"); }
+    std::thread thread(
+        [] { CFX_TraceLog::ScopedEvent event("test", "Thread"); });
+    thread.join();
+  }
+  log->Stop();
+  EXPECT_FALSE(log->IsRecording());
+  { CFX_TraceLog::ScopedEvent event("test", "Stopped"); }
+  ASSERT_EQ(3u, log->GetEventCount());
+
+  // Events are in the order they ended.
+  ByteString json = log->GetJSON();
+  EXPECT_TRUE(json.First(16) == "{\"traceEvents\":[");
+  absl::optional<size_t> inner =
+      json.Find("\"name\":\"Inner\",\"cat\":\"test\"");
+  absl::optional<size_t> thread = json.Find("\"name\":\"Thread\"");
+  absl::optional<size_t> outer = json.Find("\"name\":\"Outer\"");
+  ASSERT_TRUE(inner.has_value());
+  ASSERT_TRUE(thread.has_value());
+  ASSERT_TRUE(outer.has_value());
+  EXPECT_LT(inner.value(), thread.value());
+  EXPECT_LT(thread.value(), outer.value());
+  EXPECT_FALSE(json.Contains("Stopped"));
+  EXPECT_TRUE(json.Contains("\"ph\":\"X\""));
+
+  // Starting again discards the previous events.
+  log->Start();
+  EXPECT_EQ(0u, log->GetEventCount());
+  log->Stop();
+}
+
+TEST(CFXTraceLogTest, Macro) {
+  CFX_TraceLog* log = CFX_TraceLog::Get();
+  log->Start();
+  {
+    FX_TRACE_EVENT("test", "First");
+    FX_TRACE_EVENT("test", "Second");
+  }
+  log->Stop();
+#if defined(PDF_ENABLE_TRACE_EVENTS)
+  EXPECT_EQ(2u, log->GetEventCount());
+#else
+  EXPECT_EQ(0u, log->GetEventCount());
+#endif
+}
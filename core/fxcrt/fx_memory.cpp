@@ -8,6 +8,7 @@
 
 #include <stdlib.h>  // For abort().
 
+#include <atomic>
 #include <iterator>
 #include <limits>
 
@@ -18,6 +19,12 @@
 #include <windows.h>
 #endif
 
+namespace {
+
+thread_local uint64_t g_ThreadAllocationCount = 0;
+
+}  // namespace
+
 void* FXMEM_DefaultAlloc(size_t byte_size) {
   return pdfium::internal::Alloc(byte_size, 1);
 }
@@ -34,6 +41,20 @@ void FXMEM_DefaultFree(void* pointer) {
   FX_Free(pointer);
 }
 
+uint64_t FX_GetThreadAllocationCount() {
+  return g_ThreadAllocationCount;
+}
+
+void FX_StartCountingAllocations() {
+  pdfium::internal::g_AllocationCountingUsers.fetch_add(
+      1, std::memory_order_relaxed);
+}
+
+void FX_StopCountingAllocations() {
+  pdfium::internal::g_AllocationCountingUsers.fetch_sub(
+      1, std::memory_order_relaxed);
+}
+
 NOINLINE void FX_OutOfMemoryTerminate(size_t size) {
   // Convince the linker this should not be folded with similar functions using
   // Identical Code Folding.
@@ -55,6 +76,12 @@ NOINLINE void FX_OutOfMemoryTerminate(size_t size) {
 namespace pdfium {
 namespace internal {
 
+std::atomic<int> g_AllocationCountingUsers{0};
+
+void CountThreadAllocation() {
+  ++g_ThreadAllocationCount;
+}
+
 void* AllocOrDie(size_t num_members, size_t member_size) {
   void* result = Alloc(num_members, member_size);
   if (!result)
@@ -8,6 +8,7 @@
 #define CORE_FXCRT_FX_MEMORY_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,6 +23,8 @@ void FXMEM_DefaultFree(void* pointer);
 #ifdef __cplusplus
 }  // extern "C"
 
+#include <atomic>
+
 #include "third_party/base/compiler_specific.h"
 
 void FX_InitializeMemoryAllocators();
@@ -59,6 +62,16 @@ NOINLINE void FX_OutOfMemoryTerminate(size_t size);
 // FX_Free accepts memory from all of the above.
 void FX_Free(void* ptr);
 
+// Returns how many times the general and string partitions above have
+// allocated or reallocated memory on the calling thread, while counting is
+// enabled. For profiling.
+uint64_t FX_GetThreadAllocationCount();
+
+// Counting is enabled, on all threads, while there are more calls to
+// FX_StartCountingAllocations() than to FX_StopCountingAllocations().
+void FX_StartCountingAllocations();
+void FX_StopCountingAllocations();
+
 #ifndef V8_ENABLE_SANDBOX
 // V8 Array Buffer Partition Allocators.
 
@@ -89,6 +102,18 @@ void* ReallocOrDie(void* ptr, size_t num_members, size_t member_size);
 void* StringAlloc(size_t num_members, size_t member_size);
 void* StringAllocOrDie(size_t num_members, size_t member_size);
 
+// Nonzero while allocations are counted.
+extern std::atomic<int> g_AllocationCountingUsers;
+
+void CountThreadAllocation();
+
+// Called by the allocators above, for FX_GetThreadAllocationCount(). Only
+// checks a flag unless counting is enabled.
+inline void CountAllocation() {
+  if (g_AllocationCountingUsers.load(std::memory_order_relaxed))
+    CountThreadAllocation();
+}
+
 }  // namespace internal
 }  // namespace pdfium
 
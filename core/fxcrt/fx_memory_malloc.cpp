@@ -28,6 +28,7 @@ void* Alloc(size_t num_members, size_t member_size) {
   total *= num_members;
   if (!total.IsValid() || total.ValueOrDie() >= kMallocSizeLimit)
     return nullptr;
+  CountAllocation();
   return malloc(total.ValueOrDie());
 }
 
@@ -36,6 +37,7 @@ void* Calloc(size_t num_members, size_t member_size) {
   total *= num_members;
   if (!total.IsValid() || total.ValueOrDie() >= kMallocSizeLimit)
     return nullptr;
+  CountAllocation();
   return calloc(num_members, member_size);
 }
 
@@ -44,6 +46,7 @@ void* Realloc(void* ptr, size_t num_members, size_t member_size) {
   total *= member_size;
   if (!total.IsValid() || total.ValueOrDie() >= kMallocSizeLimit)
     return nullptr;
+  CountAllocation();
   return realloc(ptr, total.ValueOrDie());
 }
 
@@ -52,6 +55,7 @@ void* StringAlloc(size_t num_members, size_t member_size) {
   total *= num_members;
   if (!total.IsValid())
     return nullptr;
+  CountAllocation();
   return malloc(total.ValueOrDie());
 }
 
@@ -57,6 +57,7 @@ void* Alloc(size_t num_members, size_t member_size) {
   if (!total.IsValid())
     return nullptr;
 
+  CountAllocation();
   return GetGeneralPartitionAllocator().root()->AllocWithFlags(
       partition_alloc::AllocFlags::kReturnNull, total.ValueOrDie(),
       "GeneralPartition");
@@ -68,6 +69,7 @@ void* Calloc(size_t num_members, size_t member_size) {
   if (!total.IsValid())
     return nullptr;
 
+  CountAllocation();
   return GetGeneralPartitionAllocator().root()->AllocWithFlags(
       partition_alloc::AllocFlags::kReturnNull |
           partition_alloc::AllocFlags::kZeroFill,
@@ -80,6 +82,7 @@ void* Realloc(void* ptr, size_t num_members, size_t member_size) {
   if (!size.IsValid())
     return nullptr;
 
+  CountAllocation();
   return GetGeneralPartitionAllocator().root()->ReallocWithFlags(
       partition_alloc::AllocFlags::kReturnNull, ptr, size.ValueOrDie(),
       "GeneralPartition");
@@ -91,6 +94,7 @@ void* StringAlloc(size_t num_members, size_t member_size) {
   if (!total.IsValid())
     return nullptr;
 
+  CountAllocation();
   return GetStringPartitionAllocator().root()->AllocWithFlags(
       partition_alloc::AllocFlags::kReturnNull, total.ValueOrDie(),
       "StringPartition");
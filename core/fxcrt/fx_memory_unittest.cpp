@@ -103,6 +103,26 @@ TEST(fxcrt, AllocZeroesMemory) {
   FX_Free(ptr);
 }
 
+TEST(fxcrt, FXGetThreadAllocationCount) {
+  // Nothing is counted until counting starts.
+  uint64_t start = FX_GetThreadAllocationCount();
+  FX_Free(FX_Alloc(int, 1));
+  EXPECT_EQ(start, FX_GetThreadAllocationCount());
+
+  FX_StartCountingAllocations();
+  int* ptr = FX_Alloc(int, 1);
+  EXPECT_EQ(start + 1, FX_GetThreadAllocationCount());
+  ptr = FX_Realloc(int, ptr, 2);
+  EXPECT_EQ(start + 2, FX_GetThreadAllocationCount());
+  FX_Free(ptr);
+  EXPECT_EQ(start + 2, FX_GetThreadAllocationCount());
+  FX_StopCountingAllocations();
+
+  start = FX_GetThreadAllocationCount();
+  FX_Free(FX_Alloc(int, 1));
+  EXPECT_EQ(start, FX_GetThreadAllocationCount());
+}
+
 TEST(fxcrt, FXAlign) {
   static_assert(std::numeric_limits<size_t>::max() % 2 == 1,
                 "numeric limit must be odd for this test");
@@ -0,0 +1,152 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_LRU_BYTE_CACHE_H_
+#define CORE_FXCRT_LRU_BYTE_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "core/fxcrt/cfx_memoryaccount.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "third_party/base/check.h"
+#include "third_party/base/check_op.h"
+
+namespace fxcrt {
+
+// Map from `K` to `V` that holds at most a byte budget's worth of values, as
+// measured by the cost given for each value. Adding a value that does not fit
+// drops the least recently used ones first.
+//
+// When a memory account is set, cached bytes are charged to it under
+// `category`, and values that would push the account past its limit are not
+// cached. Everything cached is given back before refusing a value, since
+// cached data can always be recreated.
+template <typename K, typename V, typename Compare = std::less<K>>
+class LruByteCache {
+ public:
+  LruByteCache(CFX_MemoryAccount::Category category, size_t budget)
+      : category_(category), byte_budget_(budget) {}
+  ~LruByteCache() { Clear(); }
+
+  // Returns null if there is no value for `key`. Otherwise marks the value as
+  // the most recently used one.
+  template <typename Key>
+  V* Find(const Key& key) {
+    auto it = entries_.find(key);
+    if (it == entries_.end())
+      return nullptr;
+
+    it->second.time_count = ++time_count_;
+    return &it->second.value;
+  }
+
+  // Replaces any existing value for `key`. Returns false, and caches nothing,
+  // if `cost` does not fit within the budget or the memory account.
+  bool Add(K key, V value, size_t cost) {
+    Remove(key);
+    if (cost > byte_budget_)
+      return false;
+
+    EvictToFit(byte_budget_ - cost);
+    if (memory_account_) {
+      if (!memory_account_->CanCharge(cost))
+        EvictToFit(0);
+      if (!memory_account_->TryCharge(category_, cost))
+        return false;
+    }
+    cached_bytes_ += cost;
+    entries_.emplace(std::move(key),
+                     Entry{std::move(value), cost, ++time_count_});
+    return true;
+  }
+
+  template <typename Key>
+  void Remove(const Key& key) {
+    auto it = entries_.find(key);
+    if (it == entries_.end())
+      return;
+
+    ReleaseBytes(it->second.cost);
+    entries_.erase(it);
+  }
+
+  // Sets the budget and immediately evicts values that no longer fit.
+  void SetByteBudget(size_t budget) {
+    byte_budget_ = budget;
+    EvictToFit(byte_budget_);
+  }
+  size_t GetByteBudget() const { return byte_budget_; }
+
+  // Total cost of the cached values.
+  size_t GetCachedBytes() const { return cached_bytes_; }
+  size_t GetEntryCount() const { return entries_.size(); }
+
+  void Clear() {
+    ReleaseBytes(cached_bytes_);
+    entries_.clear();
+  }
+
+  void SetMemoryAccount(RetainPtr<CFX_MemoryAccount> account) {
+    if (memory_account_)
+      memory_account_->Refund(category_, cached_bytes_);
+    memory_account_ = std::move(account);
+    if (memory_account_)
+      memory_account_->Charge(category_, cached_bytes_);
+  }
+  CFX_MemoryAccount* GetMemoryAccount() const { return memory_account_.Get(); }
+
+ private:
+  struct Entry {
+    V value;
+    size_t cost;
+    uint64_t time_count;
+  };
+
+  void EvictToFit(size_t budget) {
+    if (cached_bytes_ <= budget)
+      return;
+
+    std::vector<std::pair<uint64_t, const K*>> by_age;
+    by_age.reserve(entries_.size());
+    for (const auto& it : entries_)
+      by_age.emplace_back(it.second.time_count, &it.first);
+    std::sort(by_age.begin(), by_age.end());
+
+    for (const auto& item : by_age) {
+      if (cached_bytes_ <= budget)
+        break;
+      auto it = entries_.find(*item.second);
+      DCHECK(it != entries_.end());
+      ReleaseBytes(it->second.cost);
+      entries_.erase(it);
+    }
+  }
+
+  void ReleaseBytes(size_t bytes) {
+    DCHECK_GE(cached_bytes_, bytes);
+    cached_bytes_ -= bytes;
+    if (memory_account_)
+      memory_account_->Refund(category_, bytes);
+  }
+
+  const CFX_MemoryAccount::Category category_;
+  std::map<K, Entry, Compare> entries_;
+  size_t byte_budget_;
+  size_t cached_bytes_ = 0;
+  uint64_t time_count_ = 0;
+  RetainPtr<CFX_MemoryAccount> memory_account_;
+};
+
+}  // namespace fxcrt
+
+using fxcrt::LruByteCache;
+
+#endif  // CORE_FXCRT_LRU_BYTE_CACHE_H_
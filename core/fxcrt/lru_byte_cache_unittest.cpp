@@ -0,0 +1,80 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/lru_byte_cache.h"
+
+#include "core/fxcrt/cfx_memoryaccount.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+using Category = CFX_MemoryAccount::Category;
+using TestCache = LruByteCache<int, int>;
+
+}  // namespace
+
+TEST(LruByteCacheTest, FindAndReplace) {
+  TestCache cache(Category::kImageCaches, 100);
+  EXPECT_FALSE(cache.Find(1));
+
+  EXPECT_TRUE(cache.Add(1, 10, 30));
+  ASSERT_TRUE(cache.Find(1));
+  EXPECT_EQ(10, *cache.Find(1));
+
+  EXPECT_TRUE(cache.Add(1, 11, 20));
+  ASSERT_TRUE(cache.Find(1));
+  EXPECT_EQ(11, *cache.Find(1));
+  EXPECT_EQ(1u, cache.GetEntryCount());
+  EXPECT_EQ(20u, cache.GetCachedBytes());
+
+  cache.Remove(1);
+  EXPECT_FALSE(cache.Find(1));
+  EXPECT_EQ(0u, cache.GetCachedBytes());
+}
+
+TEST(LruByteCacheTest, EvictsLeastRecentlyUsed) {
+  TestCache cache(Category::kImageCaches, 100);
+  EXPECT_TRUE(cache.Add(1, 1, 40));
+  EXPECT_TRUE(cache.Add(2, 2, 40));
+  EXPECT_TRUE(cache.Find(1));
+
+  EXPECT_TRUE(cache.Add(3, 3, 40));
+  EXPECT_TRUE(cache.Find(1));
+  EXPECT_FALSE(cache.Find(2));
+  EXPECT_TRUE(cache.Find(3));
+  EXPECT_EQ(80u, cache.GetCachedBytes());
+
+  // Larger than the whole budget.
+  EXPECT_FALSE(cache.Add(4, 4, 101));
+  EXPECT_EQ(2u, cache.GetEntryCount());
+
+  cache.SetByteBudget(50);
+  EXPECT_FALSE(cache.Find(1));
+  EXPECT_TRUE(cache.Find(3));
+}
+
+TEST(LruByteCacheTest, MemoryAccount) {
+  auto account = pdfium::MakeRetain<CFX_MemoryAccount>();
+  {
+    TestCache cache(Category::kDecodedStreams, 100);
+    EXPECT_TRUE(cache.Add(1, 1, 30));
+    cache.SetMemoryAccount(account);
+    EXPECT_EQ(30u, account->GetUsage(Category::kDecodedStreams));
+
+    // Everything cached is given back before refusing.
+    account->SetLimit(50);
+    EXPECT_TRUE(cache.Add(2, 2, 40));
+    EXPECT_FALSE(cache.Find(1));
+    EXPECT_EQ(40u, account->GetUsage(Category::kDecodedStreams));
+
+    account->Charge(Category::kParser, 20);
+    EXPECT_FALSE(cache.Add(3, 3, 40));
+    EXPECT_EQ(0u, cache.GetEntryCount());
+    EXPECT_EQ(0u, account->GetUsage(Category::kDecodedStreams));
+
+    EXPECT_TRUE(cache.Add(4, 4, 30));
+  }
+  // Destroying the cache refunds what it held.
+  EXPECT_EQ(0u, account->GetUsage(Category::kDecodedStreams));
+}
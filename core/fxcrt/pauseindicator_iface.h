@@ -11,6 +11,13 @@ class PauseIndicatorIface {
  public:
   virtual ~PauseIndicatorIface() = default;
   virtual bool NeedToPauseNow() = 0;
+
+  // Returns whether the operation should be given up altogether. Pausing only
+  // happens where the work can be resumed later, but this is also polled in
+  // the middle of long operations that cannot be resumed, which then stop
+  // early and leave their output incomplete. Implementations that return true
+  // here should keep doing so, and also return true from NeedToPauseNow().
+  virtual bool NeedToCancelNow() { return false; }
 };
 
 #endif  // CORE_FXCRT_PAUSEINDICATOR_IFACE_H_
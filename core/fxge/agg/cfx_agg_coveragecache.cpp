@@ -0,0 +1,131 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/agg/cfx_agg_coveragecache.h"
+
+#include <utility>
+
+#include "core/fxcrt/bytestring.h"
+#include "third_party/base/check.h"
+
+namespace pdfium {
+
+namespace {
+
+// Accounts for the list and map nodes of an entry.
+constexpr size_t kEntryOverhead = 128;
+
+// Must be a power of two.
+constexpr size_t kRecentHashCount = 4096;
+
+}  // namespace
+
+CFX_AggCoverage::CFX_AggCoverage() = default;
+
+CFX_AggCoverage::~CFX_AggCoverage() = default;
+
+void CFX_AggCoverage::AddSpan(int y,
+                              int x,
+                              pdfium::span<const uint8_t> covers) {
+  DCHECK(!covers.empty());
+  if (m_Rows.empty() || m_Rows.back().y != y) {
+    DCHECK(m_Rows.empty() || m_Rows.back().y < y);
+    m_Rows.push_back({y, m_Spans.size(), 0});
+  }
+  m_Spans.push_back({x, static_cast<int>(covers.size()), m_Covers.size()});
+  m_Covers.insert(m_Covers.end(), covers.begin(), covers.end());
+  ++m_Rows.back().span_count;
+}
+
+pdfium::span<const CFX_AggCoverage::Span> CFX_AggCoverage::GetSpans(
+    const Row& row) const {
+  return pdfium::make_span(m_Spans).subspan(row.first_span, row.span_count);
+}
+
+pdfium::span<const uint8_t> CFX_AggCoverage::GetCovers(
+    const Span& span) const {
+  return pdfium::make_span(m_Covers).subspan(span.cover_index,
+                                              static_cast<size_t>(span.len));
+}
+
+size_t CFX_AggCoverage::GetByteSize() const {
+  return sizeof(*this) + m_Rows.capacity() * sizeof(Row) +
+         m_Spans.capacity() * sizeof(Span) + m_Covers.capacity();
+}
+
+CFX_AggCoverageCache::Key::Key(std::vector<uint32_t> words)
+    : m_Words(std::move(words)),
+      m_Hash(FX_HashCode_GetA(
+          ByteStringView(pdfium::as_bytes(pdfium::make_span(m_Words))))) {}
+
+CFX_AggCoverageCache::Key::Key(Key&& that) noexcept = default;
+
+CFX_AggCoverageCache::Key::~Key() = default;
+
+bool CFX_AggCoverageCache::Key::operator<(const Key& that) const {
+  if (m_Hash != that.m_Hash)
+    return m_Hash < that.m_Hash;
+  return m_Words < that.m_Words;
+}
+
+CFX_AggCoverageCache::CFX_AggCoverageCache()
+    : m_RecentHashes(kRecentHashCount) {}
+
+CFX_AggCoverageCache::~CFX_AggCoverageCache() = default;
+
+const CFX_AggCoverage* CFX_AggCoverageCache::Find(const Key& key) {
+  auto it = m_Index.find(key);
+  if (it == m_Index.end())
+    return nullptr;
+
+  m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+  return it->second->coverage.get();
+}
+
+bool CFX_AggCoverageCache::WasRecentlyRequested(const Key& key) {
+  uint32_t& slot = m_RecentHashes[key.GetHash() & (kRecentHashCount - 1)];
+  if (slot == key.GetHash())
+    return true;
+
+  slot = key.GetHash();
+  return false;
+}
+
+const CFX_AggCoverage* CFX_AggCoverageCache::Add(
+    Key key,
+    std::unique_ptr<CFX_AggCoverage> coverage) {
+  DCHECK(coverage);
+  auto it = m_Index.find(key);
+  if (it != m_Index.end()) {
+    m_ByteSize -= it->second->byte_size;
+    m_Entries.erase(it->second);
+    m_Index.erase(it);
+  }
+
+  size_t byte_size =
+      coverage->GetByteSize() + key.GetByteSize() + kEntryOverhead;
+  it = m_Index.emplace(std::move(key), m_Entries.end()).first;
+  m_Entries.push_front({it, std::move(coverage), byte_size});
+  it->second = m_Entries.begin();
+  m_ByteSize += byte_size;
+  Trim(/*keep_newest=*/true);
+  return m_Entries.front().coverage.get();
+}
+
+void CFX_AggCoverageCache::SetByteBudget(size_t budget) {
+  m_ByteBudget = budget;
+  Trim(/*keep_newest=*/false);
+}
+
+void CFX_AggCoverageCache::Trim(bool keep_newest) {
+  const size_t min_entries = keep_newest ? 1 : 0;
+  while (m_ByteSize > m_ByteBudget && m_Entries.size() > min_entries) {
+    Entry& oldest = m_Entries.back();
+    m_ByteSize -= oldest.byte_size;
+    m_Index.erase(oldest.index);
+    m_Entries.pop_back();
+  }
+}
+
+}  // namespace pdfium
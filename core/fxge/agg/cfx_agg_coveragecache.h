@@ -0,0 +1,126 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_AGG_CFX_AGG_COVERAGECACHE_H_
+#define CORE_FXGE_AGG_CFX_AGG_COVERAGECACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "third_party/base/span.h"
+
+namespace pdfium {
+
+// The anti-aliased coverage that the AGG rasterizer produced for a path, as
+// runs of per-pixel coverage values on each row.
+class CFX_AggCoverage {
+ public:
+  struct Span {
+    int x;
+    int len;
+    size_t cover_index;
+  };
+
+  struct Row {
+    int y;
+    size_t first_span;
+    size_t span_count;
+  };
+
+  CFX_AggCoverage();
+  ~CFX_AggCoverage();
+
+  // Rows must be added from top to bottom, and spans from left to right.
+  void AddSpan(int y, int x, pdfium::span<const uint8_t> covers);
+
+  pdfium::span<const Row> GetRows() const { return m_Rows; }
+  pdfium::span<const Span> GetSpans(const Row& row) const;
+  pdfium::span<const uint8_t> GetCovers(const Span& span) const;
+
+  size_t GetByteSize() const;
+
+ private:
+  std::vector<Row> m_Rows;
+  std::vector<Span> m_Spans;
+  std::vector<uint8_t> m_Covers;
+};
+
+// Keeps the coverage of recently drawn paths, so that drawing a path again
+// only needs to composite the stored coverage instead of rasterizing the path
+// once more. Callers serialize everything that affects the rasterization into
+// the key. The cache evicts the least recently used entries once their total
+// size exceeds the byte budget.
+class CFX_AggCoverageCache {
+ public:
+  class Key {
+   public:
+    explicit Key(std::vector<uint32_t> words);
+    Key(Key&& that) noexcept;
+    ~Key();
+
+    bool operator<(const Key& that) const;
+
+    uint32_t GetHash() const { return m_Hash; }
+    size_t GetByteSize() const { return m_Words.size() * sizeof(uint32_t); }
+
+   private:
+    std::vector<uint32_t> m_Words;
+    uint32_t m_Hash;
+  };
+
+  static constexpr size_t kDefaultByteBudget = 8 * 1024 * 1024;
+
+  CFX_AggCoverageCache();
+  ~CFX_AggCoverageCache();
+
+  // Returns the coverage stored for `key`, or nullptr if there is none.
+  const CFX_AggCoverage* Find(const Key& key);
+
+  // Returns whether a recent call asked about `key`. Callers only add the
+  // coverage of paths that come up again, so that pages full of distinct
+  // paths do not churn through the cache.
+  bool WasRecentlyRequested(const Key& key);
+
+  // Stores `coverage` for `key` and returns it. The returned coverage stays
+  // valid until the next call to Add() or SetByteBudget().
+  const CFX_AggCoverage* Add(Key key,
+                             std::unique_ptr<CFX_AggCoverage> coverage);
+
+  void SetByteBudget(size_t budget);
+  size_t GetEntryCount() const { return m_Entries.size(); }
+  size_t GetByteSize() const { return m_ByteSize; }
+
+ private:
+  struct Entry;
+  using EntryList = std::list<Entry>;
+  using EntryMap = std::map<Key, EntryList::iterator>;
+
+  struct Entry {
+    EntryMap::iterator index;
+    std::unique_ptr<CFX_AggCoverage> coverage;
+    size_t byte_size;
+  };
+
+  // Evicts entries, oldest first, until the cache fits in the byte budget.
+  // Never evicts the most recently used entry if `keep_newest` is set.
+  void Trim(bool keep_newest);
+
+  // Most recently used entries come first.
+  EntryList m_Entries;
+  EntryMap m_Index;
+
+  // Hashes of recently requested keys, indexed by their low bits.
+  std::vector<uint32_t> m_RecentHashes;
+  size_t m_ByteSize = 0;
+  size_t m_ByteBudget = kDefaultByteBudget;
+};
+
+}  // namespace pdfium
+
+#endif  // CORE_FXGE_AGG_CFX_AGG_COVERAGECACHE_H_
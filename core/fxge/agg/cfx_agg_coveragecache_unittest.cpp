@@ -0,0 +1,111 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/agg/cfx_agg_coveragecache.h"
+
+#include <memory>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace pdfium {
+
+namespace {
+
+std::unique_ptr<CFX_AggCoverage> CreateCoverage(size_t width) {
+  auto coverage = std::make_unique<CFX_AggCoverage>();
+  std::vector<uint8_t> covers(width, 0xff);
+  coverage->AddSpan(0, 0, covers);
+  return coverage;
+}
+
+}  // namespace
+
+TEST(CFXAggCoverageTest, Spans) {
+  CFX_AggCoverage coverage;
+  const uint8_t covers1[] = {1, 2, 3};
+  const uint8_t covers2[] = {4};
+  const uint8_t covers3[] = {5, 6};
+  coverage.AddSpan(-2, -1, covers1);
+  coverage.AddSpan(-2, 5, covers2);
+  coverage.AddSpan(3, 0, covers3);
+
+  pdfium::span<const CFX_AggCoverage::Row> rows = coverage.GetRows();
+  ASSERT_EQ(2u, rows.size());
+  EXPECT_EQ(-2, rows[0].y);
+  EXPECT_EQ(3, rows[1].y);
+
+  pdfium::span<const CFX_AggCoverage::Span> spans = coverage.GetSpans(rows[0]);
+  ASSERT_EQ(2u, spans.size());
+  EXPECT_EQ(-1, spans[0].x);
+  EXPECT_EQ(3, spans[0].len);
+  EXPECT_EQ(3u, coverage.GetCovers(spans[0])[2]);
+  EXPECT_EQ(5, spans[1].x);
+  EXPECT_EQ(4u, coverage.GetCovers(spans[1])[0]);
+
+  spans = coverage.GetSpans(rows[1]);
+  ASSERT_EQ(1u, spans.size());
+  EXPECT_EQ(0, spans[0].x);
+  ASSERT_EQ(2u, coverage.GetCovers(spans[0]).size());
+  EXPECT_EQ(6u, coverage.GetCovers(spans[0])[1]);
+}
+
+TEST(CFXAggCoverageCacheTest, FindAndAdd) {
+  CFX_AggCoverageCache cache;
+  const CFX_AggCoverageCache::Key key1({1, 2, 3});
+  const CFX_AggCoverageCache::Key key2({1, 2, 4});
+  EXPECT_FALSE(cache.Find(key1));
+
+  // Keys only count as recently requested the second time around.
+  EXPECT_FALSE(cache.WasRecentlyRequested(key1));
+  EXPECT_TRUE(cache.WasRecentlyRequested(key1));
+
+  const CFX_AggCoverage* coverage =
+      cache.Add(CFX_AggCoverageCache::Key({1, 2, 3}), CreateCoverage(10));
+  ASSERT_TRUE(coverage);
+  EXPECT_EQ(coverage, cache.Find(key1));
+  EXPECT_FALSE(cache.Find(key2));
+  EXPECT_EQ(1u, cache.GetEntryCount());
+
+  // Adding a key again replaces its coverage.
+  coverage =
+      cache.Add(CFX_AggCoverageCache::Key({1, 2, 3}), CreateCoverage(20));
+  EXPECT_EQ(coverage, cache.Find(key1));
+  EXPECT_EQ(20, coverage->GetSpans(coverage->GetRows()[0])[0].len);
+  EXPECT_EQ(1u, cache.GetEntryCount());
+}
+
+TEST(CFXAggCoverageCacheTest, ByteBudget) {
+  CFX_AggCoverageCache cache;
+  const CFX_AggCoverageCache::Key key1({1});
+  const CFX_AggCoverageCache::Key key2({2});
+  const CFX_AggCoverageCache::Key key3({3});
+  cache.Add(CFX_AggCoverageCache::Key({1}), CreateCoverage(1000));
+  const size_t entry_size = cache.GetByteSize();
+  cache.Add(CFX_AggCoverageCache::Key({2}), CreateCoverage(1000));
+  EXPECT_EQ(2 * entry_size, cache.GetByteSize());
+
+  // Make room for just two entries, and use the first one, so that adding a
+  // third one evicts the second one.
+  cache.SetByteBudget(2 * entry_size);
+  EXPECT_EQ(2u, cache.GetEntryCount());
+  EXPECT_TRUE(cache.Find(key1));
+  cache.Add(CFX_AggCoverageCache::Key({3}), CreateCoverage(1000));
+  EXPECT_EQ(2u, cache.GetEntryCount());
+  EXPECT_TRUE(cache.Find(key1));
+  EXPECT_FALSE(cache.Find(key2));
+  EXPECT_TRUE(cache.Find(key3));
+
+  // The newest entry stays, even if it alone exceeds the budget.
+  const CFX_AggCoverage* coverage =
+      cache.Add(CFX_AggCoverageCache::Key({2}), CreateCoverage(5000));
+  EXPECT_EQ(1u, cache.GetEntryCount());
+  EXPECT_EQ(coverage, cache.Find(key2));
+
+  cache.SetByteBudget(0);
+  EXPECT_EQ(0u, cache.GetEntryCount());
+  EXPECT_EQ(0u, cache.GetByteSize());
+}
+
+}  // namespace pdfium
@@ -11,17 +11,22 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "build/build_config.h"
 #include "core/fxcrt/fx_2d_size.h"
 #include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/pauseindicator_iface.h"
+#include "core/fxge/agg/cfx_agg_coveragecache.h"
 #include "core/fxge/cfx_cliprgn.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
+#include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_graphstatedata.h"
 #include "core/fxge/cfx_path.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/dib/cfx_imagerenderer.h"
 #include "core/fxge/dib/cfx_imagestretcher.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
 #include "third_party/base/cxx17_backports.h"
@@ -51,6 +56,17 @@ namespace {
 
 const float kMaxPos = 32000.0f;
 
+// Clip paths with more rectangles than this get rasterized into a mask.
+constexpr size_t kMaxClipRects = 64;
+
+// Paths that fit into a square this large on the device get their coverage
+// cached. Drawing such a path again reuses the coverage if the rasterizer gets
+// the same vertices, up to a translation by whole pixels.
+constexpr float kMaxCachedPathSize = 256.0f;
+
+// Rows to render between polls of the pause indicator for cancellation.
+constexpr int kCancelCheckRows = 64;
+
 CFX_PointF HardClip(const CFX_PointF& pos) {
   return CFX_PointF(pdfium::clamp(pos.x, -kMaxPos, kMaxPos),
                     pdfium::clamp(pos.y, -kMaxPos, kMaxPos));
@@ -238,7 +254,8 @@ void RgbByteOrderTransferBitmap(const RetainPtr<CFX_DIBitmap>& pBitmap,
   }
 }
 
-void RasterizeStroke(agg::rasterizer_scanline_aa* rasterizer,
+template <class Rasterizer>
+void RasterizeStroke(Rasterizer* rasterizer,
                      agg::path_storage* path_data,
                      const CFX_Matrix* pObject2Device,
                      const CFX_GraphStateData* pGraphState,
@@ -340,8 +357,14 @@ class CFX_Renderer {
   void render(const Scanline& sl);
 
  private:
-  using CompositeSpanFunc = void (
-      CFX_Renderer::*)(uint8_t*, int, int, int, uint8_t*, int, int, uint8_t*);
+  using CompositeSpanFunc = void (CFX_Renderer::*)(uint8_t*,
+                                                   int,
+                                                   int,
+                                                   int,
+                                                   const uint8_t*,
+                                                   int,
+                                                   int,
+                                                   uint8_t*);
 
   void CompositeSpan(uint8_t* dest_scan,
                      uint8_t* backdrop_scan,
@@ -349,7 +372,7 @@ class CFX_Renderer {
                      bool bDestAlpha,
                      int span_left,
                      int span_len,
-                     uint8_t* cover_scan,
+                     const uint8_t* cover_scan,
                      int clip_left,
                      int clip_right,
                      uint8_t* clip_scan);
@@ -358,7 +381,7 @@ class CFX_Renderer {
                          int Bpp,
                          int span_left,
                          int span_len,
-                         uint8_t* cover_scan,
+                         const uint8_t* cover_scan,
                          int clip_left,
                          int clip_right,
                          uint8_t* clip_scan);
@@ -367,7 +390,7 @@ class CFX_Renderer {
                          int Bpp,
                          int span_left,
                          int span_len,
-                         uint8_t* cover_scan,
+                         const uint8_t* cover_scan,
                          int clip_left,
                          int clip_right,
                          uint8_t* clip_scan);
@@ -376,7 +399,7 @@ class CFX_Renderer {
                          int Bpp,
                          int span_left,
                          int span_len,
-                         uint8_t* cover_scan,
+                         const uint8_t* cover_scan,
                          int clip_left,
                          int clip_right,
                          uint8_t* clip_scan);
@@ -385,7 +408,7 @@ class CFX_Renderer {
                         int Bpp,
                         int span_left,
                         int span_len,
-                        uint8_t* cover_scan,
+                        const uint8_t* cover_scan,
                         int clip_left,
                         int clip_right,
                         uint8_t* clip_scan);
@@ -450,7 +473,7 @@ void CFX_Renderer::CompositeSpan(uint8_t* dest_scan,
                                  bool bDestAlpha,
                                  int span_left,
                                  int span_len,
-                                 uint8_t* cover_scan,
+                                 const uint8_t* cover_scan,
                                  int clip_left,
                                  int clip_right,
                                  uint8_t* clip_scan) {
@@ -592,7 +615,7 @@ void CFX_Renderer::CompositeSpan1bpp(uint8_t* dest_scan,
                                      int Bpp,
                                      int span_left,
                                      int span_len,
-                                     uint8_t* cover_scan,
+                                     const uint8_t* cover_scan,
                                      int clip_left,
                                      int clip_right,
                                      uint8_t* clip_scan) {
@@ -608,7 +631,7 @@ void CFX_Renderer::CompositeSpanGray(uint8_t* dest_scan,
                                      int Bpp,
                                      int span_left,
                                      int span_len,
-                                     uint8_t* cover_scan,
+                                     const uint8_t* cover_scan,
                                      int clip_left,
                                      int clip_right,
                                      uint8_t* clip_scan) {
@@ -632,7 +655,7 @@ void CFX_Renderer::CompositeSpanARGB(uint8_t* dest_scan,
                                      int Bpp,
                                      int span_left,
                                      int span_len,
-                                     uint8_t* cover_scan,
+                                     const uint8_t* cover_scan,
                                      int clip_left,
                                      int clip_right,
                                      uint8_t* clip_scan) {
@@ -700,7 +723,7 @@ void CFX_Renderer::CompositeSpanRGB(uint8_t* dest_scan,
                                     int Bpp,
                                     int span_left,
                                     int span_len,
-                                    uint8_t* cover_scan,
+                                    const uint8_t* cover_scan,
                                     int clip_left,
                                     int clip_right,
                                     uint8_t* clip_scan) {
@@ -954,6 +977,288 @@ agg::path_storage BuildAggPath(const CFX_Path& path,
   return agg_path;
 }
 
+// Returns the pixel that device coordinate `value` falls on when it lies on a
+// pixel boundary at the precision AGG rasterizes with, where a clip mask would
+// be fully opaque on one side and fully transparent on the other.
+absl::optional<int> GetPixelBoundary(float value) {
+  const int coord = agg::poly_coord(value);
+  if (coord % agg::poly_base_size != 0)
+    return absl::nullopt;
+  return coord / agg::poly_base_size;
+}
+
+// Returns the device rectangles of a clip path that consists of axis-aligned
+// rectangles, as long as they do not overlap and the fill rule thus does not
+// matter. Rectangles with edges between pixel boundaries would need partial
+// coverage along those edges, so only pixel-aligned ones are returned, which
+// rasterize to exactly the mask they replace.
+absl::optional<std::vector<FX_RECT>> GetClipRects(
+    const CFX_Path& path,
+    const CFX_Matrix* pObject2Device,
+    const CFX_FloatRect& device_rect) {
+  std::vector<CFX_FloatRect> rects = path.GetRects(pObject2Device);
+  if (rects.size() < 2 || rects.size() > kMaxClipRects)
+    return absl::nullopt;
+
+  for (size_t i = 0; i < rects.size(); ++i) {
+    for (size_t j = i + 1; j < rects.size(); ++j) {
+      CFX_FloatRect overlap = rects[i];
+      overlap.Intersect(rects[j]);
+      if (!overlap.IsEmpty())
+        return absl::nullopt;
+    }
+  }
+
+  std::vector<FX_RECT> result;
+  for (CFX_FloatRect& rect : rects) {
+    rect.Intersect(device_rect);
+    if (rect.IsEmpty())
+      continue;
+
+    absl::optional<int> left = GetPixelBoundary(rect.left);
+    absl::optional<int> top = GetPixelBoundary(rect.bottom);
+    absl::optional<int> right = GetPixelBoundary(rect.right);
+    absl::optional<int> bottom = GetPixelBoundary(rect.top);
+    if (!left.has_value() || !top.has_value() || !right.has_value() ||
+        !bottom.has_value()) {
+      return absl::nullopt;
+    }
+    FX_RECT pixel_rect(left.value(), top.value(), right.value(),
+                       bottom.value());
+    if (!pixel_rect.IsEmpty())
+      result.push_back(pixel_rect);
+  }
+  return result;
+}
+
+// Adds the outline that DrawPath() renders for `path` to `rasterizer`. The
+// path gets filled if `pGraphState` is null, and stroked otherwise.
+template <class Rasterizer>
+void AddPathToRasterizer(Rasterizer* rasterizer,
+                         const CFX_Path& path,
+                         const CFX_Matrix* pObject2Device,
+                         const CFX_GraphStateData* pGraphState,
+                         const CFX_FillRenderOptions& fill_options) {
+  if (!pGraphState) {
+    agg::path_storage path_data = BuildAggPath(path, pObject2Device);
+    rasterizer->add_path(path_data);
+    rasterizer->filling_rule(GetAlternateOrWindingFillType(fill_options));
+    return;
+  }
+  if (fill_options.zero_area) {
+    agg::path_storage path_data = BuildAggPath(path, pObject2Device);
+    RasterizeStroke(rasterizer, &path_data, nullptr, pGraphState, 1,
+                    fill_options.stroke_text_mode);
+    return;
+  }
+  CFX_Matrix matrix1;
+  CFX_Matrix matrix2;
+  if (pObject2Device) {
+    matrix1.a = std::max(fabs(pObject2Device->a), fabs(pObject2Device->b));
+    matrix1.d = matrix1.a;
+    matrix2 = CFX_Matrix(
+        pObject2Device->a / matrix1.a, pObject2Device->b / matrix1.a,
+        pObject2Device->c / matrix1.d, pObject2Device->d / matrix1.d, 0, 0);
+
+    matrix1 = *pObject2Device * matrix2.GetInverse();
+  }
+
+  agg::path_storage path_data = BuildAggPath(path, &matrix1);
+  RasterizeStroke(rasterizer, &path_data, &matrix2, pGraphState, matrix1.a,
+                  fill_options.stroke_text_mode);
+}
+
+// Takes the place of an agg rasterizer in AddPathToRasterizer(), and records
+// the vertices in the rasterizer's fixed-point subpixel coordinates. The
+// rasterizer's output only depends on these, its fill rule and whether it
+// antialiases, so they key the coverage cache exactly.
+class VertexRecorder {
+ public:
+  template <class VertexSource>
+  void add_path(VertexSource& vs) {
+    add_path_transformed(vs, nullptr);
+  }
+
+  template <class VertexSource>
+  void add_path_transformed(VertexSource& vs, const CFX_Matrix* pMatrix) {
+    float x;
+    float y;
+    unsigned cmd;
+    vs.rewind(0);
+    while (!agg::is_stop(cmd = vs.vertex(&x, &y))) {
+      if (pMatrix) {
+        CFX_PointF point = pMatrix->Transform(CFX_PointF(x, y));
+        x = point.x;
+        y = point.y;
+      }
+      AddVertex(x, y, cmd);
+    }
+  }
+
+  void filling_rule(agg::filling_rule_e filling_rule) {
+    m_FillingRule = filling_rule;
+  }
+
+  // Whether any vertices were recorded, all within `rect`, given in pixels.
+  bool IsWithin(const FX_RECT& rect) const {
+    return m_bHasVertices && m_MinX >= rect.left * agg::poly_base_size &&
+           m_MinY >= rect.top * agg::poly_base_size &&
+           m_MaxX <= rect.right * agg::poly_base_size &&
+           m_MaxY <= rect.bottom * agg::poly_base_size;
+  }
+
+  // Whether the vertices' bounds are at most `size` pixels wide and high.
+  bool FitsInSquare(float size) const {
+    const float max_size = size * float{agg::poly_base_size};
+    return m_MaxX - m_MinX <= max_size && m_MaxY - m_MinY <= max_size;
+  }
+
+  // The whole pixel containing the top left corner of the vertices' bounds.
+  int GetOffsetX() const { return m_MinX >> agg::poly_base_shift; }
+  int GetOffsetY() const { return m_MinY >> agg::poly_base_shift; }
+
+  // Returns the CFX_AggCoverageCache key for the vertices moved by
+  // -(`offset_x`, `offset_y`) pixels.
+  CFX_AggCoverageCache::Key GetKey(int offset_x,
+                                   int offset_y,
+                                   bool bAliased) const {
+    std::vector<uint32_t> key;
+    key.reserve(3 * m_Vertices.size() + 2);
+    key.push_back(m_FillingRule);
+    key.push_back(bAliased);
+    for (const Vertex& vertex : m_Vertices) {
+      key.push_back(static_cast<uint32_t>(vertex.cmd));
+      key.push_back(
+          static_cast<uint32_t>(vertex.x - offset_x * agg::poly_base_size));
+      key.push_back(
+          static_cast<uint32_t>(vertex.y - offset_y * agg::poly_base_size));
+    }
+    return CFX_AggCoverageCache::Key(std::move(key));
+  }
+
+  // Adds the vertices moved by -(`offset_x`, `offset_y`) pixels to
+  // `rasterizer`.
+  void Replay(agg::rasterizer_scanline_aa* rasterizer,
+              int offset_x,
+              int offset_y) const {
+    const int dx = offset_x * agg::poly_base_size;
+    const int dy = offset_y * agg::poly_base_size;
+    for (const Vertex& vertex : m_Vertices) {
+      switch (vertex.cmd) {
+        case Vertex::Command::kMove:
+          rasterizer->move_to(vertex.x - dx, vertex.y - dy);
+          break;
+        case Vertex::Command::kLine:
+          rasterizer->line_to(vertex.x - dx, vertex.y - dy);
+          break;
+        case Vertex::Command::kClose:
+          rasterizer->close_polygon();
+          break;
+      }
+    }
+    rasterizer->filling_rule(m_FillingRule);
+  }
+
+ private:
+  struct Vertex {
+    enum class Command : uint8_t { kMove, kLine, kClose };
+
+    Command cmd;
+    int x;
+    int y;
+  };
+
+  // Mirrors agg::rasterizer_scanline_aa::add_vertex().
+  void AddVertex(float x, float y, unsigned cmd) {
+    if (agg::is_close(cmd)) {
+      m_Vertices.push_back({Vertex::Command::kClose, 0, 0});
+      return;
+    }
+    Vertex::Command command;
+    if (agg::is_move_to(cmd))
+      command = Vertex::Command::kMove;
+    else if (agg::is_vertex(cmd))
+      command = Vertex::Command::kLine;
+    else
+      return;
+
+    const int poly_x = agg::poly_coord(x);
+    const int poly_y = agg::poly_coord(y);
+    m_Vertices.push_back({command, poly_x, poly_y});
+    if (!m_bHasVertices) {
+      m_bHasVertices = true;
+      m_MinX = m_MaxX = poly_x;
+      m_MinY = m_MaxY = poly_y;
+      return;
+    }
+    m_MinX = std::min(m_MinX, poly_x);
+    m_MinY = std::min(m_MinY, poly_y);
+    m_MaxX = std::max(m_MaxX, poly_x);
+    m_MaxY = std::max(m_MaxY, poly_y);
+  }
+
+  std::vector<Vertex> m_Vertices;
+  agg::filling_rule_e m_FillingRule = agg::fill_non_zero;
+  bool m_bHasVertices = false;
+  int m_MinX = 0;
+  int m_MinY = 0;
+  int m_MaxX = 0;
+  int m_MaxY = 0;
+};
+
+// Stores the scanlines of an agg rasterizer in a CFX_AggCoverage.
+class CoverageRecorder {
+ public:
+  explicit CoverageRecorder(CFX_AggCoverage* coverage)
+      : m_pCoverage(coverage) {}
+
+  // Needed for agg caller
+  void prepare(unsigned) {}
+
+  template <class Scanline>
+  void render(const Scanline& sl) {
+    typename Scanline::const_iterator span = sl.begin();
+    for (unsigned i = 0; i < sl.num_spans(); ++i, ++span) {
+      if (span->len > 0) {
+        m_pCoverage->AddSpan(
+            sl.y(), span->x,
+            pdfium::make_span(span->covers, static_cast<size_t>(span->len)));
+      }
+    }
+  }
+
+ private:
+  UnownedPtr<CFX_AggCoverage> const m_pCoverage;
+};
+
+// Presents a row of a CFX_AggCoverage to CFX_Renderer like an agg scanline.
+class CoverageScanline {
+ public:
+  struct Span {
+    int x;
+    int len;
+    const uint8_t* covers;
+  };
+  using const_iterator = const Span*;
+
+  void Reset(int y) {
+    m_Y = y;
+    m_Spans.clear();
+  }
+
+  void AddSpan(int x, pdfium::span<const uint8_t> covers) {
+    m_Spans.push_back({x, static_cast<int>(covers.size()), covers.data()});
+  }
+
+  int y() const { return m_Y; }
+  unsigned num_spans() const { return static_cast<unsigned>(m_Spans.size()); }
+  const_iterator begin() const { return m_Spans.data(); }
+
+ private:
+  int m_Y = 0;
+  std::vector<Span> m_Spans;
+};
+
 }  // namespace
 
 CFX_AggDeviceDriver::CFX_AggDeviceDriver(
@@ -1047,6 +1352,16 @@ void CFX_AggDeviceDriver::RestoreState(bool bKeepSaved) {
   }
 }
 
+void CFX_AggDeviceDriver::SetRasterizerClipBox(
+    agg::rasterizer_scanline_aa& rasterizer) {
+  // Nothing outside the current clip region can end up in the new one, so
+  // only rasterize the part of the path inside it.
+  const FX_RECT& box = m_pClipRgn->GetBox();
+  rasterizer.clip_box(static_cast<float>(box.left), static_cast<float>(box.top),
+                      static_cast<float>(box.right),
+                      static_cast<float>(box.bottom));
+}
+
 void CFX_AggDeviceDriver::SetClipMask(agg::rasterizer_scanline_aa& rasterizer) {
   FX_RECT path_rect(rasterizer.min_x(), rasterizer.min_y(),
                     rasterizer.max_x() + 1, rasterizer.max_y() + 1);
@@ -1090,12 +1405,18 @@ bool CFX_AggDeviceDriver::SetClip_PathFill(
     m_pClipRgn->IntersectRect(rect);
     return true;
   }
+  absl::optional<std::vector<FX_RECT>> rects = GetClipRects(
+      path, pObject2Device,
+      CFX_FloatRect(0, 0, static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
+                    static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT))));
+  if (rects.has_value()) {
+    m_pClipRgn->IntersectRects(rects.value());
+    return true;
+  }
   agg::path_storage path_data = BuildAggPath(path, pObject2Device);
   path_data.end_poly();
   agg::rasterizer_scanline_aa rasterizer;
-  rasterizer.clip_box(0.0f, 0.0f,
-                      static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
-                      static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
+  SetRasterizerClipBox(rasterizer);
   rasterizer.add_path(path_data);
   rasterizer.filling_rule(GetAlternateOrWindingFillType(fill_options));
   SetClipMask(rasterizer);
@@ -1112,9 +1433,7 @@ bool CFX_AggDeviceDriver::SetClip_PathStroke(
   }
   agg::path_storage path_data = BuildAggPath(path, nullptr);
   agg::rasterizer_scanline_aa rasterizer;
-  rasterizer.clip_box(0.0f, 0.0f,
-                      static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
-                      static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
+  SetRasterizerClipBox(rasterizer);
   RasterizeStroke(&rasterizer, &path_data, pObject2Device, pGraphState, 1.0f,
                   false);
   rasterizer.filling_rule(agg::fill_non_zero);
@@ -1143,8 +1462,28 @@ void CFX_AggDeviceDriver::RenderRasterizer(
   CFX_Renderer render(m_pBitmap, pt, m_pClipRgn.get(), color, bFullCover,
                       m_bRgbByteOrder);
   agg::scanline_u8 scanline;
-  agg::render_scanlines(rasterizer, scanline, render,
-                        m_FillOptions.aliased_path);
+  if (!m_pPauseIndicator) {
+    agg::render_scanlines(rasterizer, scanline, render,
+                          m_FillOptions.aliased_path);
+    return;
+  }
+
+  // Same as agg::render_scanlines(), but gives up on huge fills once the
+  // rendering gets cancelled.
+  if (!rasterizer.rewind_scanlines())
+    return;
+
+  scanline.reset(rasterizer.min_x(), rasterizer.max_x());
+  int rows_to_go = kCancelCheckRows;
+  while (rasterizer.sweep_scanline(scanline, m_FillOptions.aliased_path)) {
+    render.render(scanline);
+    if (--rows_to_go == 0) {
+      if (m_pPauseIndicator->NeedToCancelNow())
+        return;
+
+      rows_to_go = kCancelCheckRows;
+    }
+  }
 }
 
 bool CFX_AggDeviceDriver::DrawPath(const CFX_Path& path,
@@ -1162,14 +1501,15 @@ bool CFX_AggDeviceDriver::DrawPath(const CFX_Path& path,
 
   m_FillOptions = fill_options;
   if (fill_options.fill_type != CFX_FillRenderOptions::FillType::kNoFill &&
-      fill_color) {
-    agg::path_storage path_data = BuildAggPath(path, pObject2Device);
+      fill_color &&
+      !DrawCachedPath(path, pObject2Device, nullptr, fill_color,
+                      fill_options.full_cover, /*bGroupKnockout=*/false)) {
     agg::rasterizer_scanline_aa rasterizer;
     rasterizer.clip_box(0.0f, 0.0f,
                         static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
                         static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
-    rasterizer.add_path(path_data);
-    rasterizer.filling_rule(GetAlternateOrWindingFillType(fill_options));
+    AddPathToRasterizer(&rasterizer, path, pObject2Device, nullptr,
+                        fill_options);
     RenderRasterizer(rasterizer, fill_color, fill_options.full_cover,
                      /*bGroupKnockout=*/false);
   }
@@ -1177,42 +1517,130 @@ bool CFX_AggDeviceDriver::DrawPath(const CFX_Path& path,
   if (!pGraphState || !stroke_alpha)
     return true;
 
-  if (fill_options.zero_area) {
-    agg::path_storage path_data = BuildAggPath(path, pObject2Device);
-    agg::rasterizer_scanline_aa rasterizer;
-    rasterizer.clip_box(0.0f, 0.0f,
-                        static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
-                        static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
-    RasterizeStroke(&rasterizer, &path_data, nullptr, pGraphState, 1,
-                    fill_options.stroke_text_mode);
-    RenderRasterizer(rasterizer, stroke_color, fill_options.full_cover,
-                     m_bGroupKnockout);
+  if (DrawCachedPath(path, pObject2Device, pGraphState, stroke_color,
+                     fill_options.full_cover, m_bGroupKnockout)) {
     return true;
   }
-  CFX_Matrix matrix1;
-  CFX_Matrix matrix2;
-  if (pObject2Device) {
-    matrix1.a = std::max(fabs(pObject2Device->a), fabs(pObject2Device->b));
-    matrix1.d = matrix1.a;
-    matrix2 = CFX_Matrix(
-        pObject2Device->a / matrix1.a, pObject2Device->b / matrix1.a,
-        pObject2Device->c / matrix1.d, pObject2Device->d / matrix1.d, 0, 0);
-
-    matrix1 = *pObject2Device * matrix2.GetInverse();
-  }
 
-  agg::path_storage path_data = BuildAggPath(path, &matrix1);
   agg::rasterizer_scanline_aa rasterizer;
   rasterizer.clip_box(0.0f, 0.0f,
                       static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
                       static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
-  RasterizeStroke(&rasterizer, &path_data, &matrix2, pGraphState, matrix1.a,
-                  fill_options.stroke_text_mode);
+  AddPathToRasterizer(&rasterizer, path, pObject2Device, pGraphState,
+                      fill_options);
   RenderRasterizer(rasterizer, stroke_color, fill_options.full_cover,
                    m_bGroupKnockout);
   return true;
 }
 
+bool CFX_AggDeviceDriver::DrawCachedPath(const CFX_Path& path,
+                                         const CFX_Matrix* pObject2Device,
+                                         const CFX_GraphStateData* pGraphState,
+                                         uint32_t color,
+                                         bool bFullCover,
+                                         bool bGroupKnockout) {
+  if (!pObject2Device)
+    return false;
+
+  // Rule out paths too large to cache before recording their vertices.
+  CFX_Matrix linear = *pObject2Device;
+  linear.e = 0;
+  linear.f = 0;
+  CFX_FloatRect bbox = linear.TransformRect(path.GetBoundingBox());
+  if (pGraphState) {
+    float width = pGraphState->m_LineWidth;
+    if (!m_FillOptions.zero_area) {
+      width *= std::max({fabsf(linear.a), fabsf(linear.b), fabsf(linear.c),
+                         fabsf(linear.d)});
+    }
+    bbox.Inflate(width, width);
+  }
+  if (!(bbox.Width() <= kMaxCachedPathSize &&
+        bbox.Height() <= kMaxCachedPathSize)) {
+    return false;
+  }
+
+  VertexRecorder vertices;
+  AddPathToRasterizer(&vertices, path, pObject2Device, pGraphState,
+                      m_FillOptions);
+  const FX_RECT device_rect(0, 0, m_pBitmap->GetWidth(),
+                            m_pBitmap->GetHeight());
+  if (!vertices.IsWithin(device_rect) ||
+      !vertices.FitsInSquare(kMaxCachedPathSize)) {
+    return false;
+  }
+
+  // The coverage is stored relative to the whole pixels of the vertices'
+  // top left corner. Rasterizing the vertices moved by whole pixels gives the
+  // same coverage, moved by the same pixels, so a draw gives the same pixels
+  // whether or not its coverage was cached.
+  const int offset_x = vertices.GetOffsetX();
+  const int offset_y = vertices.GetOffsetY();
+  CFX_AggCoverageCache::Key key =
+      vertices.GetKey(offset_x, offset_y, m_FillOptions.aliased_path);
+  CFX_AggCoverageCache* cache = CFX_GEModule::Get()->GetAggCoverageCache();
+  const CFX_AggCoverage* coverage = cache->Find(key);
+  if (!coverage) {
+    // Draw paths directly until they come up again.
+    if (!cache->WasRecentlyRequested(key)) {
+      agg::rasterizer_scanline_aa rasterizer;
+      rasterizer.clip_box(0.0f, 0.0f, static_cast<float>(device_rect.right),
+                          static_cast<float>(device_rect.bottom));
+      vertices.Replay(&rasterizer, 0, 0);
+      RenderRasterizer(rasterizer, color, bFullCover, bGroupKnockout);
+      return true;
+    }
+
+    // The vertices are within any clip box that contains them, so clipping
+    // changes nothing but keeps the rasterizer on the same code path as the
+    // direct draw.
+    agg::rasterizer_scanline_aa rasterizer;
+    rasterizer.clip_box(0.0f, 0.0f, kMaxCachedPathSize + 1,
+                        kMaxCachedPathSize + 1);
+    vertices.Replay(&rasterizer, offset_x, offset_y);
+    auto new_coverage = std::make_unique<CFX_AggCoverage>();
+    CoverageRecorder recorder(new_coverage.get());
+    agg::scanline_u8 scanline;
+    agg::render_scanlines(rasterizer, scanline, recorder,
+                          m_FillOptions.aliased_path);
+    coverage = cache->Add(std::move(key), std::move(new_coverage));
+  }
+  RenderCoverage(*coverage, offset_x, offset_y, color, bFullCover,
+                 bGroupKnockout);
+  return true;
+}
+
+void CFX_AggDeviceDriver::RenderCoverage(const CFX_AggCoverage& coverage,
+                                         int offset_x,
+                                         int offset_y,
+                                         uint32_t color,
+                                         bool bFullCover,
+                                         bool bGroupKnockout) {
+  RetainPtr<CFX_DIBitmap> pt = bGroupKnockout ? m_pBackdropBitmap : nullptr;
+  CFX_Renderer render(m_pBitmap, pt, m_pClipRgn.get(), color, bFullCover,
+                      m_bRgbByteOrder);
+  const int width = m_pBitmap->GetWidth();
+  const int height = m_pBitmap->GetHeight();
+  CoverageScanline scanline;
+  for (const CFX_AggCoverage::Row& row : coverage.GetRows()) {
+    const int y = row.y + offset_y;
+    if (y < 0 || y >= height)
+      continue;
+
+    scanline.Reset(y);
+    for (const CFX_AggCoverage::Span& span : coverage.GetSpans(row)) {
+      const int left = std::max(span.x + offset_x, 0);
+      const int right = std::min(span.x + offset_x + span.len, width);
+      if (left < right) {
+        scanline.AddSpan(left, coverage.GetCovers(span).subspan(
+                                   left - span.x - offset_x, right - left));
+      }
+    }
+    if (scanline.num_spans())
+      render.render(scanline);
+  }
+}
+
 bool CFX_AggDeviceDriver::FillRectWithBlend(const FX_RECT& rect,
                                             uint32_t fill_color,
                                             BlendMode blend_type) {
@@ -1229,6 +1657,22 @@ bool CFX_AggDeviceDriver::FillRectWithBlend(const FX_RECT& rect,
   if (draw_rect.IsEmpty())
     return true;
 
+  if (m_pClipRgn && !m_pClipRgn->GetRects().empty()) {
+    for (const FX_RECT& clip_part : m_pClipRgn->GetRects()) {
+      FX_RECT part = draw_rect;
+      part.Intersect(clip_part);
+      if (part.IsEmpty())
+        continue;
+      if (m_bRgbByteOrder) {
+        RgbByteOrderCompositeRect(m_pBitmap, part.left, part.top, part.Width(),
+                                  part.Height(), fill_color);
+      } else {
+        m_pBitmap->CompositeRect(part.left, part.top, part.Width(),
+                                 part.Height(), fill_color);
+      }
+    }
+    return true;
+  }
   if (!m_pClipRgn || m_pClipRgn->GetType() == CFX_ClipRgn::kRectI) {
     if (m_bRgbByteOrder) {
       RgbByteOrderCompositeRect(m_pBitmap, draw_rect.left, draw_rect.top,
@@ -1366,6 +1810,10 @@ bool CFX_AggDeviceDriver::StartDIBits(
   return true;
 }
 
+void CFX_AggDeviceDriver::SetPauseIndicator(PauseIndicatorIface* pPause) {
+  m_pPauseIndicator = pPause;
+}
+
 bool CFX_AggDeviceDriver::ContinueDIBits(CFX_ImageRenderer* pHandle,
                                          PauseIndicatorIface* pPause) {
   return m_pBitmap->GetBuffer().empty() || pHandle->Continue(pPause);
@@ -12,6 +12,7 @@
 
 #include "build/build_config.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/cfx_fillrenderoptions.h"
 #include "core/fxge/renderdevicedriver_iface.h"
 
@@ -22,6 +23,8 @@ class CFX_Path;
 
 namespace pdfium {
 
+class CFX_AggCoverage;
+
 namespace agg {
 class rasterizer_scanline_aa;
 }  // namespace agg
@@ -87,6 +90,7 @@ class CFX_AggDeviceDriver final : public RenderDeviceDriverIface {
                    BlendMode blend_type) override;
   bool ContinueDIBits(CFX_ImageRenderer* handle,
                       PauseIndicatorIface* pPause) override;
+  void SetPauseIndicator(PauseIndicatorIface* pPause) override;
   bool DrawDeviceText(pdfium::span<const TextCharPos> pCharPos,
                       CFX_Font* pFont,
                       const CFX_Matrix& mtObject2Device,
@@ -103,6 +107,23 @@ class CFX_AggDeviceDriver final : public RenderDeviceDriverIface {
                         bool bFullCover,
                         bool bGroupKnockout);
 
+  // Draws small paths through CFX_AggCoverageCache, and returns false to have
+  // the caller rasterize other paths directly. Fills the path if `pGraphState`
+  // is null, and strokes it otherwise.
+  bool DrawCachedPath(const CFX_Path& path,
+                      const CFX_Matrix* pObject2Device,
+                      const CFX_GraphStateData* pGraphState,
+                      uint32_t color,
+                      bool bFullCover,
+                      bool bGroupKnockout);
+  void RenderCoverage(const CFX_AggCoverage& coverage,
+                      int offset_x,
+                      int offset_y,
+                      uint32_t color,
+                      bool bFullCover,
+                      bool bGroupKnockout);
+
+  void SetRasterizerClipBox(pdfium::agg::rasterizer_scanline_aa& rasterizer);
   void SetClipMask(pdfium::agg::rasterizer_scanline_aa& rasterizer);
 
   RetainPtr<CFX_DIBitmap> const m_pBitmap;
@@ -115,6 +136,7 @@ class CFX_AggDeviceDriver final : public RenderDeviceDriverIface {
   const bool m_bRgbByteOrder;
   const bool m_bGroupKnockout;
   RetainPtr<CFX_DIBitmap> m_pBackdropBitmap;
+  UnownedPtr<PauseIndicatorIface> m_pPauseIndicator;
 };
 
 }  // namespace pdfium
@@ -8,6 +8,7 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <utility>
 
 #include "core/fxcrt/span_util.h"
@@ -15,20 +16,137 @@
 #include "third_party/base/check_op.h"
 #include "third_party/base/notreached.h"
 
+namespace {
+
+// Appends the parts of `rect` that are not covered by `rects` yet, so that
+// `rects` stays disjoint.
+void AppendDisjointRect(std::vector<FX_RECT>* rects, FX_RECT rect) {
+  std::vector<FX_RECT> pieces = {rect};
+  for (const FX_RECT& existing : *rects) {
+    std::vector<FX_RECT> remaining;
+    for (const FX_RECT& piece : pieces) {
+      FX_RECT overlap = piece;
+      overlap.Intersect(existing);
+      if (overlap.IsEmpty()) {
+        remaining.push_back(piece);
+        continue;
+      }
+      const FX_RECT candidates[] = {
+          {piece.left, piece.top, piece.right, overlap.top},
+          {piece.left, overlap.bottom, piece.right, piece.bottom},
+          {piece.left, overlap.top, overlap.left, overlap.bottom},
+          {overlap.right, overlap.top, piece.right, overlap.bottom},
+      };
+      for (const FX_RECT& candidate : candidates) {
+        if (!candidate.IsEmpty())
+          remaining.push_back(candidate);
+      }
+    }
+    pieces = std::move(remaining);
+    if (pieces.empty())
+      return;
+  }
+  rects->insert(rects->end(), pieces.begin(), pieces.end());
+}
+
+FX_RECT GetBoundingBox(const std::vector<FX_RECT>& rects) {
+  FX_RECT box = rects.front();
+  for (const FX_RECT& rect : rects) {
+    box.left = std::min(box.left, rect.left);
+    box.top = std::min(box.top, rect.top);
+    box.right = std::max(box.right, rect.right);
+    box.bottom = std::max(box.bottom, rect.bottom);
+  }
+  return box;
+}
+
+// Returns a mask covering `box`, which is opaque inside `rects` only.
+RetainPtr<CFX_DIBitmap> CreateRectsMask(const FX_RECT& box,
+                                        const std::vector<FX_RECT>& rects) {
+  auto mask = pdfium::MakeRetain<CFX_DIBitmap>();
+  if (!mask->Create(box.Width(), box.Height(), FXDIB_Format::k8bppMask))
+    return nullptr;
+
+  mask->Clear(0);
+  for (const FX_RECT& rect : rects) {
+    for (int row = rect.top; row < rect.bottom; ++row) {
+      fxcrt::spanset(mask->GetWritableScanline(row - box.top)
+                         .subspan(rect.left - box.left, rect.Width()),
+                     0xff);
+    }
+  }
+  return mask;
+}
+
+}  // namespace
+
 CFX_ClipRgn::CFX_ClipRgn(int width, int height) : m_Box(0, 0, width, height) {}
 
 CFX_ClipRgn::CFX_ClipRgn(const CFX_ClipRgn& src) = default;
 
 CFX_ClipRgn::~CFX_ClipRgn() = default;
 
+RetainPtr<CFX_DIBitmap> CFX_ClipRgn::GetMask() const {
+  if (!m_Mask && !m_Rects.empty())
+    m_Mask = CreateRectsMask(m_Box, m_Rects);
+  return m_Mask;
+}
+
 void CFX_ClipRgn::IntersectRect(const FX_RECT& rect) {
   if (m_Type == kRectI) {
     m_Box.Intersect(rect);
     return;
   }
+  if (!m_Rects.empty()) {
+    IntersectRects({rect});
+    return;
+  }
   IntersectMaskRect(rect, m_Box, m_Mask);
 }
 
+void CFX_ClipRgn::IntersectRects(const std::vector<FX_RECT>& rects) {
+  std::vector<FX_RECT> current;
+  if (m_Type == kRectI) {
+    current.push_back(m_Box);
+  } else if (!m_Rects.empty()) {
+    current = m_Rects;
+  } else {
+    if (rects.empty()) {
+      SetRects({});
+      return;
+    }
+    const FX_RECT box = GetBoundingBox(rects);
+    RetainPtr<CFX_DIBitmap> mask = CreateRectsMask(box, rects);
+    if (mask)
+      IntersectMaskF(box.left, box.top, std::move(mask));
+    return;
+  }
+
+  std::vector<FX_RECT> result;
+  for (const FX_RECT& a : current) {
+    for (const FX_RECT& b : rects) {
+      FX_RECT overlap = a;
+      overlap.Intersect(b);
+      if (!overlap.IsEmpty())
+        AppendDisjointRect(&result, overlap);
+    }
+  }
+  SetRects(std::move(result));
+}
+
+void CFX_ClipRgn::SetRects(std::vector<FX_RECT> rects) {
+  m_Mask.Reset();
+  m_Rects.clear();
+  if (rects.size() <= 1) {
+    m_Type = kRectI;
+    m_Box = rects.empty() ? FX_RECT() : rects.front();
+    return;
+  }
+  m_Type = kMaskF;
+  m_Box = GetBoundingBox(rects);
+  m_Rects = std::move(rects);
+}
+
 void CFX_ClipRgn::IntersectMaskRect(FX_RECT rect,
                                     FX_RECT mask_rect,
                                     RetainPtr<CFX_DIBitmap> pOldMask) {
@@ -65,6 +183,10 @@ void CFX_ClipRgn::IntersectMaskF(int left,
     IntersectMaskRect(m_Box, mask_box, std::move(pMask));
     return;
   }
+  if (!m_Rects.empty()) {
+    GetMask();
+    m_Rects.clear();
+  }
 
   FX_RECT new_box = m_Box;
   new_box.Intersect(mask_box);
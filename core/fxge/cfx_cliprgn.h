@@ -7,6 +7,8 @@
 #ifndef CORE_FXGE_CFX_CLIPRGN_H_
 #define CORE_FXGE_CFX_CLIPRGN_H_
 
+#include <vector>
+
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
 
@@ -22,19 +24,29 @@ class CFX_ClipRgn {
 
   ClipType GetType() const { return m_Type; }
   const FX_RECT& GetBox() const { return m_Box; }
-  RetainPtr<CFX_DIBitmap> GetMask() const { return m_Mask; }
+
+  // A kMaskF region that is a union of rectangles only builds its mask, the
+  // size of GetBox(), when first asked for it.
+  RetainPtr<CFX_DIBitmap> GetMask() const;
+
+  // The disjoint rectangles that make up a kMaskF region, if it is still kept
+  // as a union of rectangles rather than as a mask. Empty otherwise.
+  const std::vector<FX_RECT>& GetRects() const { return m_Rects; }
 
   void IntersectRect(const FX_RECT& rect);
+  void IntersectRects(const std::vector<FX_RECT>& rects);
   void IntersectMaskF(int left, int top, RetainPtr<CFX_DIBitmap> Mask);
 
  private:
   void IntersectMaskRect(FX_RECT rect,
                          FX_RECT mask_rect,
                          RetainPtr<CFX_DIBitmap> pOldMask);
+  void SetRects(std::vector<FX_RECT> rects);
 
   ClipType m_Type = kRectI;
   FX_RECT m_Box;
-  RetainPtr<CFX_DIBitmap> m_Mask;
+  std::vector<FX_RECT> m_Rects;
+  mutable RetainPtr<CFX_DIBitmap> m_Mask;
 };
 
 #endif  // CORE_FXGE_CFX_CLIPRGN_H_
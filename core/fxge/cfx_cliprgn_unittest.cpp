@@ -0,0 +1,95 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_cliprgn.h"
+
+#include <vector>
+
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+uint8_t GetCoverage(const CFX_ClipRgn& clip, int x, int y) {
+  const FX_RECT& box = clip.GetBox();
+  if (!box.Contains(x, y))
+    return 0;
+  if (clip.GetType() == CFX_ClipRgn::kRectI)
+    return 255;
+  return clip.GetMask()->GetScanline(y - box.top)[x - box.left];
+}
+
+}  // namespace
+
+TEST(CFXClipRgnTest, IntersectRects) {
+  CFX_ClipRgn clip(100, 100);
+  clip.IntersectRects({FX_RECT(10, 10, 30, 30), FX_RECT(50, 10, 70, 30)});
+  EXPECT_EQ(CFX_ClipRgn::kMaskF, clip.GetType());
+  EXPECT_EQ(FX_RECT(10, 10, 70, 30), clip.GetBox());
+  EXPECT_EQ(2u, clip.GetRects().size());
+
+  // Cutting down to one of the rectangles makes for a rectangular region.
+  CFX_ClipRgn left_only(clip);
+  left_only.IntersectRect(FX_RECT(0, 0, 40, 100));
+  EXPECT_EQ(CFX_ClipRgn::kRectI, left_only.GetType());
+  EXPECT_EQ(FX_RECT(10, 10, 30, 30), left_only.GetBox());
+  EXPECT_FALSE(left_only.GetMask());
+
+  // Intersecting two unions of rectangles keeps a union of rectangles.
+  clip.IntersectRects({FX_RECT(20, 0, 60, 20), FX_RECT(0, 25, 100, 27)});
+  EXPECT_EQ(CFX_ClipRgn::kMaskF, clip.GetType());
+  EXPECT_EQ(FX_RECT(10, 10, 70, 27), clip.GetBox());
+  EXPECT_EQ(4u, clip.GetRects().size());
+  EXPECT_EQ(255, GetCoverage(clip, 25, 15));
+  EXPECT_EQ(0, GetCoverage(clip, 15, 15));
+  EXPECT_EQ(255, GetCoverage(clip, 15, 26));
+  EXPECT_EQ(0, GetCoverage(clip, 40, 26));
+  EXPECT_EQ(255, GetCoverage(clip, 55, 15));
+  EXPECT_EQ(0, GetCoverage(clip, 65, 15));
+
+  clip.IntersectRect(FX_RECT(80, 80, 90, 90));
+  EXPECT_EQ(CFX_ClipRgn::kRectI, clip.GetType());
+  EXPECT_TRUE(clip.GetBox().IsEmpty());
+}
+
+TEST(CFXClipRgnTest, OverlappingRects) {
+  CFX_ClipRgn clip(100, 100);
+  clip.IntersectRects({FX_RECT(10, 10, 30, 30), FX_RECT(20, 20, 40, 40)});
+  EXPECT_EQ(FX_RECT(10, 10, 40, 40), clip.GetBox());
+
+  // The rectangles get split up so that they do not overlap.
+  int area = 0;
+  for (const FX_RECT& rect : clip.GetRects())
+    area += rect.Width() * rect.Height();
+  EXPECT_EQ(700, area);
+  EXPECT_EQ(255, GetCoverage(clip, 25, 25));
+  EXPECT_EQ(0, GetCoverage(clip, 35, 15));
+}
+
+TEST(CFXClipRgnTest, RectsAndMask) {
+  auto mask = pdfium::MakeRetain<CFX_DIBitmap>();
+  ASSERT_TRUE(mask->Create(50, 50, FXDIB_Format::k8bppMask));
+  mask->Clear(0x80000000);
+
+  // A union of rectangles intersected with a mask.
+  CFX_ClipRgn clip(100, 100);
+  clip.IntersectRects({FX_RECT(0, 0, 20, 20), FX_RECT(40, 0, 60, 20)});
+  clip.IntersectMaskF(10, 10, mask);
+  EXPECT_EQ(CFX_ClipRgn::kMaskF, clip.GetType());
+  EXPECT_TRUE(clip.GetRects().empty());
+  EXPECT_EQ(FX_RECT(10, 10, 60, 20), clip.GetBox());
+  EXPECT_EQ(0x80, GetCoverage(clip, 15, 15));
+  EXPECT_EQ(0, GetCoverage(clip, 30, 15));
+  EXPECT_EQ(0x80, GetCoverage(clip, 45, 15));
+
+  // A mask intersected with a union of rectangles.
+  CFX_ClipRgn other(100, 100);
+  other.IntersectMaskF(10, 10, mask);
+  other.IntersectRects({FX_RECT(0, 0, 20, 20), FX_RECT(40, 0, 60, 20)});
+  EXPECT_EQ(clip.GetBox(), other.GetBox());
+  for (int y = 0; y < 30; ++y) {
+    for (int x = 0; x < 70; ++x)
+      EXPECT_EQ(GetCoverage(clip, x, y), GetCoverage(other, x, y));
+  }
+}
@@ -4,6 +4,8 @@
 
 #include "core/fxge/cfx_defaultrenderdevice.h"
 
+#include <algorithm>
+
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxge/cfx_fillrenderoptions.h"
@@ -13,6 +15,14 @@
 #include "core/fxge/dib/fx_dib.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+namespace {
+
+int GetAlpha(const RetainPtr<CFX_DIBitmap>& bitmap, int x, int y) {
+  return bitmap->GetScanline(y)[4 * x + 3];
+}
+
+}  // namespace
+
 TEST(CFX_DefaultRenderDeviceTest, GetClipBox_Default) {
   CFX_DefaultRenderDevice device;
   ASSERT_TRUE(device.Create(/*width=*/16, /*height=*/16, FXDIB_Format::kArgb,
@@ -40,6 +50,47 @@ TEST(CFX_DefaultRenderDeviceTest, GetClipBox_PathFill) {
   EXPECT_EQ(FX_RECT(5, 1, 13, 13), device.GetClipBox());
 }
 
+TEST(CFX_DefaultRenderDeviceTest, SetClip_PathFillRects) {
+  const CFX_FillRenderOptions fill_options(
+      CFX_FillRenderOptions::FillType::kWinding);
+
+  {
+    // Pixel-aligned rectangles clip exactly to their pixels.
+    CFX_DefaultRenderDevice device;
+    ASSERT_TRUE(device.Create(/*width=*/16, /*height=*/16, FXDIB_Format::kArgb,
+                              /*pBackdropBitmap=*/nullptr));
+    CFX_Path path;
+    path.AppendRect(2, 2, 6, 6);
+    path.AppendRect(8, 2, 12, 6);
+    EXPECT_TRUE(device.SetClip_PathFill(path, nullptr, fill_options));
+    EXPECT_EQ(FX_RECT(2, 2, 12, 6), device.GetClipBox());
+    EXPECT_TRUE(device.FillRect(FX_RECT(0, 0, 16, 16), 0xff0000ff));
+
+    RetainPtr<CFX_DIBitmap> bitmap = device.GetBitmap();
+    EXPECT_EQ(0xff, GetAlpha(bitmap, 5, 3));
+    EXPECT_EQ(0, GetAlpha(bitmap, 6, 3));
+    EXPECT_EQ(0, GetAlpha(bitmap, 7, 3));
+    EXPECT_EQ(0xff, GetAlpha(bitmap, 8, 3));
+  }
+  {
+    // Edges between pixel boundaries keep their partial coverage.
+    CFX_DefaultRenderDevice device;
+    ASSERT_TRUE(device.Create(/*width=*/16, /*height=*/16, FXDIB_Format::kArgb,
+                              /*pBackdropBitmap=*/nullptr));
+    CFX_Path path;
+    path.AppendRect(2, 2, 6.5f, 6);
+    path.AppendRect(8, 2, 12, 6);
+    EXPECT_TRUE(device.SetClip_PathFill(path, nullptr, fill_options));
+    EXPECT_TRUE(device.FillRect(FX_RECT(0, 0, 16, 16), 0xff0000ff));
+
+    RetainPtr<CFX_DIBitmap> bitmap = device.GetBitmap();
+    EXPECT_EQ(0xff, GetAlpha(bitmap, 5, 3));
+    EXPECT_GT(GetAlpha(bitmap, 6, 3), 0);
+    EXPECT_LT(GetAlpha(bitmap, 6, 3), 0xff);
+    EXPECT_EQ(0, GetAlpha(bitmap, 7, 3));
+  }
+}
+
 TEST(CFX_DefaultRenderDeviceTest, GetClipBox_PathStroke) {
   // Matrix that transposes and translates by 1 unit on each axis.
   const CFX_Matrix object_to_device(0, 1, 1, 0, 1, -1);
@@ -78,3 +129,69 @@ TEST(CFX_DefaultRenderDeviceTest, GetClipBox_Empty) {
 
   EXPECT_TRUE(device.GetClipBox().IsEmpty());
 }
+
+TEST(CFX_DefaultRenderDeviceTest, DrawPath_Repeated) {
+  CFX_Path path;
+  path.AppendPoint({0.0f, 0.0f}, CFX_Path::Point::Type::kMove);
+  path.AppendPoint({7.5f, 1.0f}, CFX_Path::Point::Type::kLine);
+  path.AppendPointAndClose({3.0f, 6.25f}, CFX_Path::Point::Type::kLine);
+  const CFX_FillRenderOptions fill_options(
+      CFX_FillRenderOptions::FillType::kWinding);
+
+  CFX_DefaultRenderDevice device;
+  ASSERT_TRUE(device.Create(/*width=*/64, /*height=*/16, FXDIB_Format::kArgb,
+                            /*pBackdropBitmap=*/nullptr));
+
+  // Drawing the same path at whole pixel offsets gives the same pixels each
+  // time, even once the path's coverage gets reused.
+  for (int i = 0; i < 4; ++i) {
+    const CFX_Matrix matrix(1, 0, 0, 1, 2.25f + 16 * i, 3.75f);
+    EXPECT_TRUE(device.DrawPath(path, &matrix, /*pGraphState=*/nullptr,
+                                /*fill_color=*/0xff0000ff,
+                                /*stroke_color=*/0, fill_options));
+  }
+
+  RetainPtr<CFX_DIBitmap> bitmap = device.GetBitmap();
+  for (int y = 0; y < 16; ++y) {
+    pdfium::span<const uint8_t> scanline = bitmap->GetScanline(y);
+    for (int x = 0; x < 16; ++x) {
+      for (int i = 1; i < 4; ++i) {
+        EXPECT_EQ(scanline[4 * x], scanline[4 * (x + 16 * i)]);
+        EXPECT_EQ(scanline[4 * x + 3], scanline[4 * (x + 16 * i) + 3]);
+      }
+    }
+  }
+}
+
+TEST(CFX_DefaultRenderDeviceTest, DrawPath_CachedAtOtherPhase) {
+  CFX_Path path;
+  path.AppendPoint({0.0f, 0.0f}, CFX_Path::Point::Type::kMove);
+  path.AppendPoint({5.5f, 2.0f}, CFX_Path::Point::Type::kLine);
+  path.AppendPointAndClose({1.0f, 7.25f}, CFX_Path::Point::Type::kLine);
+  const CFX_FillRenderOptions fill_options(
+      CFX_FillRenderOptions::FillType::kWinding);
+
+  auto render = [&](float x) {
+    CFX_DefaultRenderDevice device;
+    EXPECT_TRUE(device.Create(/*width=*/16, /*height=*/16, FXDIB_Format::kArgb,
+                              /*pBackdropBitmap=*/nullptr));
+    const CFX_Matrix matrix(1, 0, 0, 1, x, 3.75f);
+    EXPECT_TRUE(device.DrawPath(path, &matrix, /*pGraphState=*/nullptr,
+                                /*fill_color=*/0xff0000ff,
+                                /*stroke_color=*/0, fill_options));
+    return device.GetBitmap();
+  };
+
+  // Coverage cached for a nearby subpixel phase does not change the pixels.
+  RetainPtr<CFX_DIBitmap> expected = render(2.3f);
+  render(2.25f);
+  render(2.25f);
+  RetainPtr<CFX_DIBitmap> actual = render(2.3f);
+  for (int y = 0; y < 16; ++y) {
+    pdfium::span<const uint8_t> expected_row = expected->GetScanline(y);
+    pdfium::span<const uint8_t> actual_row = actual->GetScanline(y);
+    EXPECT_TRUE(std::equal(expected_row.begin(), expected_row.end(),
+                           actual_row.begin()))
+        << "row " << y;
+  }
+}
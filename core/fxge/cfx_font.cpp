@@ -14,6 +14,7 @@
 #include <utility>
 
 #include "build/build_config.h"
+#include "core/fxcrt/cfx_tracelog.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_codepage.h"
 #include "core/fxcrt/fx_stream.h"
@@ -343,6 +344,7 @@ int CFX_Font::GetSubstFontItalicAngle() const {
 #ifdef PDF_ENABLE_XFA
 bool CFX_Font::LoadFile(RetainPtr<IFX_SeekableReadStream> pFile,
                         int nFaceIndex) {
+  FX_TRACE_EVENT("pdfium.font", "CFX_Font::LoadFile");
   m_bEmbedded = false;
   m_ObjectTag = 0;
 
@@ -398,6 +400,7 @@ void CFX_Font::LoadSubst(const ByteString& face_name,
                          int italic_angle,
                          FX_CodePage code_page,
                          bool bVertical) {
+  FX_TRACE_EVENT("pdfium.font", "CFX_Font::LoadSubst");
   m_bEmbedded = false;
   m_bVertical = bVertical;
   m_ObjectTag = 0;
@@ -446,6 +449,7 @@ int CFX_Font::GetGlyphWidthImpl(uint32_t glyph_index,
 bool CFX_Font::LoadEmbedded(pdfium::span<const uint8_t> src_span,
                             bool force_vertical,
                             uint64_t object_tag) {
+  FX_TRACE_EVENT("pdfium.font", "CFX_Font::LoadEmbedded");
   m_bVertical = force_vertical;
   m_ObjectTag = object_tag;
   m_FontDataAllocation = DataVector<uint8_t>(src_span.begin(), src_span.end());
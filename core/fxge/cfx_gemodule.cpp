@@ -6,6 +6,7 @@
 
 #include "core/fxge/cfx_gemodule.h"
 
+#include "core/fxge/agg/cfx_agg_coveragecache.h"
 #include "core/fxge/cfx_folderfontinfo.h"
 #include "core/fxge/cfx_fontcache.h"
 #include "core/fxge/cfx_fontmgr.h"
@@ -21,6 +22,7 @@ CFX_GEModule::CFX_GEModule(const char** pUserFontPaths)
     : m_pPlatform(PlatformIface::Create()),
       m_pFontMgr(std::make_unique<CFX_FontMgr>()),
       m_pFontCache(std::make_unique<CFX_FontCache>()),
+      m_pAggCoverageCache(std::make_unique<pdfium::CFX_AggCoverageCache>()),
       m_pUserFontPaths(pUserFontPaths) {}
 
 CFX_GEModule::~CFX_GEModule() = default;
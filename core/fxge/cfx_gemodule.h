@@ -21,6 +21,10 @@ class CFX_FontCache;
 class CFX_FontMgr;
 class SystemFontInfoIface;
 
+namespace pdfium {
+class CFX_AggCoverageCache;
+}  // namespace pdfium
+
 class CFX_GEModule {
  public:
   class PlatformIface {
@@ -43,6 +47,9 @@ class CFX_GEModule {
   CFX_FontCache* GetFontCache() const { return m_pFontCache.get(); }
   CFX_FontMgr* GetFontMgr() const { return m_pFontMgr.get(); }
   PlatformIface* GetPlatform() const { return m_pPlatform.get(); }
+  pdfium::CFX_AggCoverageCache* GetAggCoverageCache() const {
+    return m_pAggCoverageCache.get();
+  }
   const char** GetUserFontPaths() const { return m_pUserFontPaths; }
 
  private:
@@ -52,6 +59,7 @@ class CFX_GEModule {
   std::unique_ptr<PlatformIface> const m_pPlatform;
   std::unique_ptr<CFX_FontMgr> const m_pFontMgr;
   std::unique_ptr<CFX_FontCache> const m_pFontCache;
+  std::unique_ptr<pdfium::CFX_AggCoverageCache> const m_pAggCoverageCache;
   const char** const m_pUserFontPaths;
 };
 
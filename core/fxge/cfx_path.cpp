@@ -101,6 +101,42 @@ std::vector<CFX_Path::Point> GetNormalizedPoints(
   return normalized;
 }
 
+absl::optional<CFX_FloatRect> GetRectFromPoints(
+    const std::vector<CFX_Path::Point>& points,
+    const CFX_Matrix* matrix) {
+  bool do_normalize = PathPointsNeedNormalization(points);
+  std::vector<CFX_Path::Point> normalized;
+  if (do_normalize)
+    normalized = GetNormalizedPoints(points);
+  const std::vector<CFX_Path::Point>& path_points =
+      do_normalize ? normalized : points;
+
+  if (!matrix) {
+    if (!IsRectImpl(path_points))
+      return absl::nullopt;
+
+    return CreateRectFromPoints(path_points[0].m_Point, path_points[2].m_Point);
+  }
+
+  if (!IsRectPreTransform(path_points))
+    return absl::nullopt;
+
+  CFX_PointF rect_points[5];
+  for (size_t i = 0; i < path_points.size(); ++i) {
+    rect_points[i] = matrix->Transform(path_points[i].m_Point);
+
+    if (i == 0)
+      continue;
+    if (XYBothNotEqual(rect_points[i], rect_points[i - 1]))
+      return absl::nullopt;
+  }
+
+  if (XYBothNotEqual(rect_points[0], rect_points[3]))
+    return absl::nullopt;
+
+  return CreateRectFromPoints(rect_points[0], rect_points[2]);
+}
+
 void UpdateLineEndPoints(CFX_FloatRect* rect,
                          const CFX_PointF& start_pos,
                          const CFX_PointF& end_pos,
@@ -403,36 +439,27 @@ bool CFX_Path::IsRect() const {
 
 absl::optional<CFX_FloatRect> CFX_Path::GetRect(
     const CFX_Matrix* matrix) const {
-  bool do_normalize = PathPointsNeedNormalization(m_Points);
-  std::vector<Point> normalized;
-  if (do_normalize)
-    normalized = GetNormalizedPoints(m_Points);
-  const std::vector<Point>& path_points = do_normalize ? normalized : m_Points;
-
-  if (!matrix) {
-    if (!IsRectImpl(path_points))
-      return absl::nullopt;
-
-    return CreateRectFromPoints(path_points[0].m_Point, path_points[2].m_Point);
-  }
-
-  if (!IsRectPreTransform(path_points))
-    return absl::nullopt;
-
-  CFX_PointF points[5];
-  for (size_t i = 0; i < path_points.size(); ++i) {
-    points[i] = matrix->Transform(path_points[i].m_Point);
+  return GetRectFromPoints(m_Points, matrix);
+}
 
-    if (i == 0)
-      continue;
-    if (XYBothNotEqual(points[i], points[i - 1]))
-      return absl::nullopt;
+std::vector<CFX_FloatRect> CFX_Path::GetRects(const CFX_Matrix* matrix) const {
+  std::vector<CFX_FloatRect> rects;
+  std::vector<Point> figure;
+  for (size_t i = 0; i <= m_Points.size(); ++i) {
+    if (i == m_Points.size() || m_Points[i].m_Type == Point::Type::kMove) {
+      if (!figure.empty()) {
+        absl::optional<CFX_FloatRect> rect = GetRectFromPoints(figure, matrix);
+        if (!rect.has_value())
+          return {};
+        rects.push_back(rect.value());
+        figure.clear();
+      }
+      if (i == m_Points.size())
+        break;
+    }
+    figure.push_back(m_Points[i]);
   }
-
-  if (XYBothNotEqual(points[0], points[3]))
-    return absl::nullopt;
-
-  return CreateRectFromPoints(points[0], points[2]);
+  return rects;
 }
 
 CFX_RetainablePath::CFX_RetainablePath() = default;
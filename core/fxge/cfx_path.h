@@ -58,6 +58,10 @@ class CFX_Path {
   bool IsRect() const;
   absl::optional<CFX_FloatRect> GetRect(const CFX_Matrix* matrix) const;
 
+  // Returns one rectangle per figure if every figure of the path is an
+  // axis-aligned rectangle after applying `matrix`, or nothing otherwise.
+  std::vector<CFX_FloatRect> GetRects(const CFX_Matrix* matrix) const;
+
   void Append(const CFX_Path& src, const CFX_Matrix* matrix);
   void AppendFloatRect(const CFX_FloatRect& rect);
   void AppendRect(float left, float bottom, float right, float top);
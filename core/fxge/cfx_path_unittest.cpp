@@ -348,6 +348,35 @@ TEST(CFX_Path, EmptyRect) {
   EXPECT_EQ(CFX_FloatRect(0, 0, 0, 1), path.GetBoundingBox());
 }
 
+TEST(CFX_Path, GetRects) {
+  CFX_Path path;
+  path.AppendRect(/*left=*/1, /*bottom=*/2, /*right=*/3, /*top=*/5);
+  path.AppendRect(/*left=*/4, /*bottom=*/2, /*right=*/6, /*top=*/5);
+  EXPECT_FALSE(path.GetRect(nullptr).has_value());
+
+  std::vector<CFX_FloatRect> rects = path.GetRects(nullptr);
+  ASSERT_EQ(2u, rects.size());
+  EXPECT_EQ(CFX_FloatRect(1, 2, 3, 5), rects[0]);
+  EXPECT_EQ(CFX_FloatRect(4, 2, 6, 5), rects[1]);
+
+  const CFX_Matrix kScaleMatrix(1, 0, 0, 2, 60, 70);
+  rects = path.GetRects(&kScaleMatrix);
+  ASSERT_EQ(2u, rects.size());
+  EXPECT_EQ(CFX_FloatRect(61, 74, 63, 80), rects[0]);
+  EXPECT_EQ(CFX_FloatRect(64, 74, 66, 80), rects[1]);
+
+  // Rotated rectangles are not axis-aligned.
+  const CFX_Matrix kRotateMatrix(0.8f, 0.6f, -0.6f, 0.8f, 0, 0);
+  EXPECT_TRUE(path.GetRects(&kRotateMatrix).empty());
+
+  // A single figure that is not a rectangle rules out the whole path.
+  path.AppendPoint({0, 0}, CFX_Path::Point::Type::kMove);
+  path.AppendPoint({1, 0}, CFX_Path::Point::Type::kLine);
+  path.AppendPoint({0, 1}, CFX_Path::Point::Type::kLine);
+  path.ClosePath();
+  EXPECT_TRUE(path.GetRects(nullptr).empty());
+}
+
 TEST(CFX_Path, Append) {
   CFX_Path path;
   path.AppendPoint({5, 6}, CFX_Path::Point::Type::kMove);
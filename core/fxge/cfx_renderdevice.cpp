@@ -545,8 +545,11 @@ bool CFX_RenderDevice::CreateCompatibleBitmap(
     const RetainPtr<CFX_DIBitmap>& pDIB,
     int width,
     int height) const {
-  return pDIB->Create(width, height,
-                      GetCreateCompatibleBitmapFormat(m_RenderCaps));
+  return pDIB->Create(width, height, GetCompatibleBitmapFormat());
+}
+
+FXDIB_Format CFX_RenderDevice::GetCompatibleBitmapFormat() const {
+  return GetCreateCompatibleBitmapFormat(m_RenderCaps);
 }
 
 void CFX_RenderDevice::SetBaseClip(const FX_RECT& rect) {
@@ -992,6 +995,10 @@ bool CFX_RenderDevice::ContinueDIBits(CFX_ImageRenderer* handle,
   return m_pDeviceDriver->ContinueDIBits(handle, pPause);
 }
 
+void CFX_RenderDevice::SetPauseIndicator(PauseIndicatorIface* pPause) {
+  m_pDeviceDriver->SetPauseIndicator(pPause);
+}
+
 #if defined(_SKIA_SUPPORT_)
 bool CFX_RenderDevice::SetBitsWithMask(const RetainPtr<CFX_DIBBase>& pBitmap,
                                        const RetainPtr<CFX_DIBBase>& pMask,
@@ -67,6 +67,8 @@ class CFX_RenderDevice {
   bool CreateCompatibleBitmap(const RetainPtr<CFX_DIBitmap>& pDIB,
                               int width,
                               int height) const;
+  // Returns the format that CreateCompatibleBitmap() uses.
+  FXDIB_Format GetCompatibleBitmapFormat() const;
   const FX_RECT& GetClipBox() const { return m_ClipBox; }
   void SetBaseClip(const FX_RECT& rect);
   bool SetClip_PathFill(const CFX_Path& path,
@@ -152,6 +154,7 @@ class CFX_RenderDevice {
                             std::unique_ptr<CFX_ImageRenderer>* handle,
                             BlendMode blend_mode);
   bool ContinueDIBits(CFX_ImageRenderer* handle, PauseIndicatorIface* pPause);
+  void SetPauseIndicator(PauseIndicatorIface* pPause);
 
   bool DrawNormalText(pdfium::span<const TextCharPos> pCharPos,
                       CFX_Font* pFont,
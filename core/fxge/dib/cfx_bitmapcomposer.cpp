@@ -8,6 +8,7 @@
 
 #include <string.h>
 
+#include "core/fxcrt/cfx_renderprofile.h"
 #include "core/fxcrt/fx_2d_size.h"
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/fx_safe_types.h"
@@ -15,6 +16,55 @@
 #include "core/fxge/cfx_cliprgn.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "third_party/base/check_op.h"
+#include "third_party/base/notreached.h"
+
+namespace {
+
+// Number of source lines that vertical composition transposes at once. Each
+// destination row then receives a run of this many pixels, instead of a
+// single one per source line.
+constexpr int kVerticalBlockLines = 16;
+
+// Copies the pixels at `src_offset` of `line_count` lines that are `line_size`
+// bytes apart in `block`, in reverse order if `reverse` is set.
+template <int Bpp>
+void GatherPixels(const uint8_t* block,
+                  size_t line_size,
+                  size_t src_offset,
+                  int line_count,
+                  bool reverse,
+                  uint8_t* dest) {
+  const uint8_t* src = block + src_offset;
+  for (int i = 0; i < line_count; ++i) {
+    const int line = reverse ? line_count - i - 1 : i;
+    memcpy(dest + i * Bpp, src + line * line_size, Bpp);
+  }
+}
+
+void GatherPixels(int Bpp,
+                  const uint8_t* block,
+                  size_t line_size,
+                  size_t src_offset,
+                  int line_count,
+                  bool reverse,
+                  uint8_t* dest) {
+  switch (Bpp) {
+    case 1:
+      GatherPixels<1>(block, line_size, src_offset, line_count, reverse, dest);
+      break;
+    case 3:
+      GatherPixels<3>(block, line_size, src_offset, line_count, reverse, dest);
+      break;
+    case 4:
+      GatherPixels<4>(block, line_size, src_offset, line_count, reverse, dest);
+      break;
+    default:
+      NOTREACHED();
+      break;
+  }
+}
+
+}  // namespace
 
 CFX_BitmapComposer::CFX_BitmapComposer() = default;
 
@@ -42,6 +92,8 @@ void CFX_BitmapComposer::Compose(const RetainPtr<CFX_DIBitmap>& pDest,
   if (pClipRgn && pClipRgn->GetType() != CFX_ClipRgn::kRectI)
     m_pClipMask = pClipRgn->GetMask();
   m_bVertical = bVertical;
+  m_BlockFirstLineV = 0;
+  m_BlockLineCountV = 0;
   m_bFlipX = bFlipX;
   m_bFlipY = bFlipY;
   m_bRgbByteOrder = bRgbByteOrder;
@@ -62,13 +114,14 @@ bool CFX_BitmapComposer::SetInfo(int width,
     return false;
   }
   if (m_bVertical) {
-    m_pScanlineV.resize(m_pBitmap->GetBPP() / 8 * width + 4);
-    m_pClipScanV.resize(m_pBitmap->GetHeight());
-  }
-  if (m_BitmapAlpha < 255) {
-    m_pAddClipScan.resize(m_bVertical ? m_pBitmap->GetHeight()
-                                      : m_pBitmap->GetWidth());
+    m_SrcBppV = GetBppFromFormat(src_format) / 8;
+    m_SrcLineCountV = height;
+    m_LineSizeV = Fx2DSizeOrDie(width, m_SrcBppV);
+    m_BlockV.resize(Fx2DSizeOrDie(m_LineSizeV, kVerticalBlockLines));
+    m_pScanlineV.resize(m_SrcBppV * kVerticalBlockLines);
   }
+  if (m_BitmapAlpha < 255)
+    m_pAddClipScan.resize(m_pBitmap->GetWidth());
   return true;
 }
 
@@ -100,6 +153,7 @@ void CFX_BitmapComposer::DoCompose(pdfium::span<uint8_t> dest_scan,
 
 void CFX_BitmapComposer::ComposeScanline(int line,
                                          pdfium::span<const uint8_t> scanline) {
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kComposite);
   if (m_bVertical) {
     ComposeScanlineV(line, scanline);
     return;
@@ -128,52 +182,46 @@ void CFX_BitmapComposer::ComposeScanline(int line,
 void CFX_BitmapComposer::ComposeScanlineV(
     int line,
     pdfium::span<const uint8_t> scanline) {
-  int Bpp = m_pBitmap->GetBPP() / 8;
-  int dest_pitch = m_pBitmap->GetPitch();
-  int dest_x = m_DestLeft + (m_bFlipX ? (m_DestWidth - line - 1) : line);
-  pdfium::span<uint8_t> dest_span = m_pBitmap->GetBuffer();
-  if (!dest_span.empty()) {
-    const size_t dest_x_offset = Fx2DSizeOrDie(dest_x, Bpp);
-    const size_t dest_y_offset = Fx2DSizeOrDie(m_DestTop, dest_pitch);
-    dest_span = dest_span.subspan(dest_y_offset).subspan(dest_x_offset);
-    if (m_bFlipY) {
-      const size_t dest_flip_offset =
-          Fx2DSizeOrDie(dest_pitch, m_DestHeight - 1);
-      dest_span = dest_span.subspan(dest_flip_offset);
-    }
+  if (m_BlockLineCountV > 0 &&
+      line != m_BlockFirstLineV + m_BlockLineCountV) {
+    FlushScanlinesV();
   }
-  uint8_t* dest_buf = dest_span.data();
-  const int y_step = m_bFlipY ? -dest_pitch : dest_pitch;
-  uint8_t* src_scan = m_pScanlineV.data();
-  uint8_t* dest_scan = dest_buf;
+  if (m_BlockLineCountV == 0)
+    m_BlockFirstLineV = line;
+
+  fxcrt::spancpy(
+      pdfium::make_span(m_BlockV).subspan(m_BlockLineCountV * m_LineSizeV),
+      scanline.first(m_LineSizeV));
+  ++m_BlockLineCountV;
+  if (m_BlockLineCountV == kVerticalBlockLines || line == m_SrcLineCountV - 1)
+    FlushScanlinesV();
+}
+
+void CFX_BitmapComposer::FlushScanlinesV() {
+  const int line_count = m_BlockLineCountV;
+  m_BlockLineCountV = 0;
+
+  // Source lines become destination columns, running right to left when
+  // flipped, so the buffered lines cover a run of adjacent columns.
+  const int first_line = m_BlockFirstLineV;
+  const int dest_x =
+      m_DestLeft + (m_bFlipX ? m_DestWidth - first_line - line_count
+                             : first_line);
+  const int Bpp = m_pBitmap->GetBPP() / 8;
+  const size_t dest_x_offset = Fx2DSizeOrDie(dest_x, Bpp);
   for (int i = 0; i < m_DestHeight; ++i) {
-    for (int j = 0; j < Bpp; ++j)
-      *src_scan++ = dest_scan[j];
-    dest_scan += y_step;
-  }
-  pdfium::span<uint8_t> clip_scan;
-  if (m_pClipMask) {
-    clip_scan = m_pClipScanV;
-    int clip_pitch = m_pClipMask->GetPitch();
-    const uint8_t* src_clip =
-        m_pClipMask->GetScanline(m_DestTop - m_pClipRgn->GetBox().top)
-            .subspan(dest_x - m_pClipRgn->GetBox().left)
-            .data();
-    if (m_bFlipY) {
-      src_clip += Fx2DSizeOrDie(clip_pitch, m_DestHeight - 1);
-      clip_pitch = -clip_pitch;
-    }
-    for (int i = 0; i < m_DestHeight; ++i) {
-      clip_scan[i] = *src_clip;
-      src_clip += clip_pitch;
+    // Gather pixel `i` of each buffered line, in destination order.
+    GatherPixels(m_SrcBppV, m_BlockV.data(), m_LineSizeV,
+                 Fx2DSizeOrDie(i, m_SrcBppV), line_count, m_bFlipX,
+                 m_pScanlineV.data());
+    const int dest_y = m_DestTop + (m_bFlipY ? m_DestHeight - i - 1 : i);
+    pdfium::span<const uint8_t> clip_scan;
+    if (m_pClipMask) {
+      clip_scan =
+          m_pClipMask->GetScanline(dest_y - m_pClipRgn->GetBox().top)
+              .subspan(dest_x - m_pClipRgn->GetBox().left);
     }
-  }
-  DoCompose(m_pScanlineV, scanline, m_DestHeight, clip_scan);
-  src_scan = m_pScanlineV.data();
-  dest_scan = dest_buf;
-  for (int i = 0; i < m_DestHeight; ++i) {
-    for (int j = 0; j < Bpp; ++j)
-      dest_scan[j] = *src_scan++;
-    dest_scan += y_step;
+    DoCompose(m_pBitmap->GetWritableScanline(dest_y).subspan(dest_x_offset),
+              m_pScanlineV, line_count, clip_scan);
   }
 }
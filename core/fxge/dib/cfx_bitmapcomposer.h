@@ -49,6 +49,7 @@ class CFX_BitmapComposer final : public ScanlineComposerIface {
                  int dest_width,
                  pdfium::span<const uint8_t> clip_scan);
   void ComposeScanlineV(int line, pdfium::span<const uint8_t> scanline);
+  void FlushScanlinesV();
 
   RetainPtr<CFX_DIBitmap> m_pBitmap;
   UnownedPtr<const CFX_ClipRgn> m_pClipRgn;
@@ -66,8 +67,13 @@ class CFX_BitmapComposer final : public ScanlineComposerIface {
   bool m_bFlipY;
   bool m_bRgbByteOrder = false;
   BlendMode m_BlendMode = BlendMode::kNormal;
+  int m_SrcBppV = 0;
+  int m_SrcLineCountV = 0;
+  size_t m_LineSizeV = 0;
+  int m_BlockFirstLineV = 0;
+  int m_BlockLineCountV = 0;
+  DataVector<uint8_t> m_BlockV;
   DataVector<uint8_t> m_pScanlineV;
-  DataVector<uint8_t> m_pClipScanV;
   DataVector<uint8_t> m_pAddClipScan;
 };
 
@@ -6,12 +6,22 @@
 
 #include "core/fxge/dib/cfx_cmyk_to_srgb.h"
 
+#include <string.h>
+
 #include <algorithm>
+#include <array>
 #include <tuple>
 
+#include "build/build_config.h"
 #include "core/fxcrt/fx_system.h"
+#include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
 
+#if defined(ARCH_CPU_X86_FAMILY) && (defined(__SSE2__) || defined(_M_X64))
+#define CMYK_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace fxge {
 
 namespace {
@@ -1660,6 +1670,154 @@ constexpr uint8_t kCMYK[81 * 81][3] = {
     {0, 0, 0},
 };
 
+// Where one channel value lands in `kCMYK`, as computed by
+// AdobeCMYK_to_sRGB1(): the offset of the nearest grid point along the
+// channel's axis, the offset from there to the neighbor used for
+// interpolation, and the interpolation weight.
+struct AxisStep {
+  int offset;
+  int neighbor;
+  int rate;
+};
+
+using AxisTable = std::array<AxisStep, 256>;
+
+constexpr AxisTable BuildAxisTable(int stride) {
+  AxisTable table = {};
+  for (int value = 0; value < 256; ++value) {
+    const int fix = value << 8;
+    const int index = (fix + 4096) >> 13;
+    int index1 = fix >> 13;
+    if (index1 == index)
+      index1 = index1 == 8 ? index1 - 1 : index1 + 1;
+    table[value].offset = index * stride;
+    table[value].neighbor = (index1 - index) * stride;
+    table[value].rate = (fix - (index << 13)) * (index - index1);
+  }
+  return table;
+}
+
+constexpr AxisTable kAxisC = BuildAxisTable(9 * 9 * 9);
+constexpr AxisTable kAxisM = BuildAxisTable(9 * 9);
+constexpr AxisTable kAxisY = BuildAxisTable(9);
+constexpr AxisTable kAxisK = BuildAxisTable(1);
+
+bool IsSamePixel(const uint8_t* a, const uint8_t* b) {
+  return memcmp(a, b, 4) == 0;
+}
+
+// Same as AdobeCMYK_to_sRGB1(), with the per-channel setup looked up.
+void ConvertPixel(const uint8_t* src, uint8_t* dest_bgr) {
+  const AxisStep& c = kAxisC[src[0]];
+  const AxisStep& m = kAxisM[src[1]];
+  const AxisStep& y = kAxisY[src[2]];
+  const AxisStep& k = kAxisK[src[3]];
+  const int pos = c.offset + m.offset + y.offset + k.offset;
+  const uint8_t* base = kCMYK[pos];
+  const uint8_t* c1 = kCMYK[pos + c.neighbor];
+  const uint8_t* m1 = kCMYK[pos + m.neighbor];
+  const uint8_t* y1 = kCMYK[pos + y.neighbor];
+  const uint8_t* k1 = kCMYK[pos + k.neighbor];
+  for (int channel = 0; channel < 3; ++channel) {
+    const int value = base[channel];
+    int fix = value << 8;
+    fix += (value - c1[channel]) * c.rate / 32;
+    fix += (value - m1[channel]) * m.rate / 32;
+    fix += (value - y1[channel]) * y.rate / 32;
+    fix += (value - k1[channel]) * k.rate / 32;
+    dest_bgr[2 - channel] = std::max(fix, 0) >> 8;
+  }
+}
+
+#if defined(CMYK_SSE2)
+// `kCMYK` with entries padded to 32 bits, in B, G, R order.
+constexpr std::array<uint32_t, 81 * 81> BuildBGRXTable() {
+  std::array<uint32_t, 81 * 81> table = {};
+  for (size_t i = 0; i < table.size(); ++i) {
+    table[i] = kCMYK[i][2] | (kCMYK[i][1] << 8) | (kCMYK[i][0] << 16);
+  }
+  return table;
+}
+
+constexpr std::array<uint32_t, 81 * 81> kCMYKBGRX = BuildBGRXTable();
+
+// Widens the entries at `pos0` and `pos1` to 16-bit lanes, one pixel per
+// 64-bit half.
+__m128i LoadEntryPair(int pos0, int pos1) {
+  __m128i entries = _mm_unpacklo_epi32(_mm_cvtsi32_si128(kCMYKBGRX[pos0]),
+                                       _mm_cvtsi32_si128(kCMYKBGRX[pos1]));
+  return _mm_unpacklo_epi8(entries, _mm_setzero_si128());
+}
+
+// Broadcasts `rate0` to the 16-bit lanes of the first pixel and `rate1` to
+// those of the second one.
+__m128i LoadRatePair(int rate0, int rate1) {
+  return _mm_unpacklo_epi64(
+      _mm_shufflelo_epi16(_mm_cvtsi32_si128(rate0), 0),
+      _mm_shufflelo_epi16(_mm_cvtsi32_si128(rate1), 0));
+}
+
+// Signed division by 32 that truncates like C++ does.
+__m128i DivideBy32(__m128i value) {
+  __m128i bias = _mm_srli_epi32(_mm_srai_epi32(value, 31), 27);
+  return _mm_srai_epi32(_mm_add_epi32(value, bias), 5);
+}
+
+// Adds (`base` - `neighbor`) * `rate` / 32 to the 32-bit sums of both pixels.
+void AddAxisTerm(__m128i base,
+                 __m128i neighbor,
+                 __m128i rate,
+                 __m128i* sum0,
+                 __m128i* sum1) {
+  __m128i diff = _mm_sub_epi16(base, neighbor);
+  __m128i lo = _mm_mullo_epi16(diff, rate);
+  __m128i hi = _mm_mulhi_epi16(diff, rate);
+  *sum0 = _mm_add_epi32(*sum0, DivideBy32(_mm_unpacklo_epi16(lo, hi)));
+  *sum1 = _mm_add_epi32(*sum1, DivideBy32(_mm_unpackhi_epi16(lo, hi)));
+}
+
+// Converts two pixels at once, with the same results as ConvertPixel().
+void ConvertPixelPairSSE2(const uint8_t* src, uint8_t* dest_bgr) {
+  const AxisStep& c0 = kAxisC[src[0]];
+  const AxisStep& m0 = kAxisM[src[1]];
+  const AxisStep& y0 = kAxisY[src[2]];
+  const AxisStep& k0 = kAxisK[src[3]];
+  const AxisStep& c1 = kAxisC[src[4]];
+  const AxisStep& m1 = kAxisM[src[5]];
+  const AxisStep& y1 = kAxisY[src[6]];
+  const AxisStep& k1 = kAxisK[src[7]];
+  const int pos0 = c0.offset + m0.offset + y0.offset + k0.offset;
+  const int pos1 = c1.offset + m1.offset + y1.offset + k1.offset;
+
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i base = LoadEntryPair(pos0, pos1);
+  __m128i sum0 = _mm_slli_epi32(_mm_unpacklo_epi16(base, zero), 8);
+  __m128i sum1 = _mm_slli_epi32(_mm_unpackhi_epi16(base, zero), 8);
+  AddAxisTerm(base, LoadEntryPair(pos0 + c0.neighbor, pos1 + c1.neighbor),
+              LoadRatePair(c0.rate, c1.rate), &sum0, &sum1);
+  AddAxisTerm(base, LoadEntryPair(pos0 + m0.neighbor, pos1 + m1.neighbor),
+              LoadRatePair(m0.rate, m1.rate), &sum0, &sum1);
+  AddAxisTerm(base, LoadEntryPair(pos0 + y0.neighbor, pos1 + y1.neighbor),
+              LoadRatePair(y0.rate, y1.rate), &sum0, &sum1);
+  AddAxisTerm(base, LoadEntryPair(pos0 + k0.neighbor, pos1 + k1.neighbor),
+              LoadRatePair(k0.rate, k1.rate), &sum0, &sum1);
+
+  // Clamp negative sums to 0, and keep the low byte of the rest, like the
+  // conversion to uint8_t in ConvertPixel() does.
+  const __m128i byte_mask = _mm_set1_epi32(0xff);
+  sum0 = _mm_andnot_si128(_mm_srai_epi32(sum0, 31), sum0);
+  sum1 = _mm_andnot_si128(_mm_srai_epi32(sum1, 31), sum1);
+  sum0 = _mm_and_si128(_mm_srli_epi32(sum0, 8), byte_mask);
+  sum1 = _mm_and_si128(_mm_srli_epi32(sum1, 8), byte_mask);
+  __m128i packed = _mm_packs_epi32(sum0, sum1);
+  packed = _mm_packus_epi16(packed, packed);
+  uint32_t bgr0 = _mm_cvtsi128_si32(packed);
+  uint32_t bgr1 = _mm_cvtsi128_si32(_mm_srli_si128(packed, 4));
+  memcpy(dest_bgr, &bgr0, 3);
+  memcpy(dest_bgr + 3, &bgr1, 3);
+}
+#endif  // defined(CMYK_SSE2)
+
 }  // namespace
 
 std::tuple<uint8_t, uint8_t, uint8_t> AdobeCMYK_to_sRGB1(uint8_t c,
@@ -1755,4 +1913,34 @@ std::tuple<float, float, float> AdobeCMYK_to_sRGB(float c,
   return std::make_tuple(r * (1.0f / 255), g * (1.0f / 255), b * (1.0f / 255));
 }
 
+void AdobeCMYK_to_sRGB1_Scanline(pdfium::span<uint8_t> dest_bgr,
+                                 pdfium::span<const uint8_t> src_cmyk) {
+  const size_t pixels = src_cmyk.size() / 4;
+  CHECK_GE(dest_bgr.size(), pixels * 3);
+  const uint8_t* src = src_cmyk.data();
+  uint8_t* dest = dest_bgr.data();
+  size_t i = 0;
+#if defined(CMYK_SSE2)
+  for (; i + 2 <= pixels; i += 2) {
+    // Flat areas repeat the same color, so reuse the previous pixel's result.
+    if (i > 0 && IsSamePixel(src, src - 4) && IsSamePixel(src + 4, src)) {
+      memcpy(dest, dest - 3, 3);
+      memcpy(dest + 3, dest - 3, 3);
+    } else {
+      ConvertPixelPairSSE2(src, dest);
+    }
+    src += 8;
+    dest += 6;
+  }
+#endif
+  for (; i < pixels; ++i) {
+    if (i > 0 && IsSamePixel(src, src - 4))
+      memcpy(dest, dest - 3, 3);
+    else
+      ConvertPixel(src, dest);
+    src += 4;
+    dest += 3;
+  }
+}
+
 }  // namespace fxge
@@ -11,6 +11,8 @@
 
 #include <tuple>
 
+#include "third_party/base/span.h"
+
 namespace fxge {
 
 std::tuple<float, float, float> AdobeCMYK_to_sRGB(float c,
@@ -22,9 +24,15 @@ std::tuple<uint8_t, uint8_t, uint8_t> AdobeCMYK_to_sRGB1(uint8_t c,
                                                          uint8_t y,
                                                          uint8_t k);
 
+// Converts every CMYK pixel of `src_cmyk` like AdobeCMYK_to_sRGB1() does, and
+// writes the results to `dest_bgr` in B, G, R order.
+void AdobeCMYK_to_sRGB1_Scanline(pdfium::span<uint8_t> dest_bgr,
+                                 pdfium::span<const uint8_t> src_cmyk);
+
 }  // namespace fxge
 
 using fxge::AdobeCMYK_to_sRGB;
 using fxge::AdobeCMYK_to_sRGB1;
+using fxge::AdobeCMYK_to_sRGB1_Scanline;
 
 #endif  // CORE_FXGE_DIB_CFX_CMYK_TO_SRGB_H_
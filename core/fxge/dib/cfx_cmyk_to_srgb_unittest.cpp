@@ -4,6 +4,9 @@
 
 #include "core/fxge/dib/cfx_cmyk_to_srgb.h"
 
+#include <iterator>
+#include <vector>
+
 #include "testing/gtest/include/gtest/gtest.h"
 
 union Float_t {
@@ -30,3 +33,37 @@ TEST(fxge, CMYK_Rounding) {
   // Check various other 'special' numbers.
   std::tie(R, G, B) = AdobeCMYK_to_sRGB(0.0f, 0.25f, 0.5f, 1.0f);
 }
+
+TEST(fxge, CMYK_Scanline) {
+  // Cover every value of each channel, some repeated pixels, an odd pixel
+  // count, and trailing bytes that do not make up a whole pixel.
+  std::vector<uint8_t> src;
+  for (int i = 0; i < 256 * 17; ++i) {
+    const int value = i % 256;
+    const int step = i / 256 * 15;
+    const uint8_t pixel[] = {
+        static_cast<uint8_t>(value),
+        static_cast<uint8_t>((value * 7 + step) % 256),
+        static_cast<uint8_t>((255 - value + step) % 256),
+        static_cast<uint8_t>(i % 3 == 0 ? step : (value + step) % 256)};
+    src.insert(src.end(), std::begin(pixel), std::end(pixel));
+    if (i % 5 == 0)
+      src.insert(src.end(), std::begin(pixel), std::end(pixel));
+  }
+  src.insert(src.end(), {0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255});
+  ASSERT_EQ(3u, src.size() % 4);
+
+  const size_t pixels = src.size() / 4;
+  std::vector<uint8_t> dest(pixels * 3);
+  AdobeCMYK_to_sRGB1_Scanline(dest, src);
+  for (size_t i = 0; i < pixels; ++i) {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    std::tie(r, g, b) = AdobeCMYK_to_sRGB1(src[i * 4], src[i * 4 + 1],
+                                           src[i * 4 + 2], src[i * 4 + 3]);
+    EXPECT_EQ(b, dest[i * 3]) << i;
+    EXPECT_EQ(g, dest[i * 3 + 1]) << i;
+    EXPECT_EQ(r, dest[i * 3 + 2]) << i;
+  }
+}
@@ -31,6 +31,23 @@
 
 namespace {
 
+// Number of source rows that SwapXY() transposes at once, so that each
+// destination row receives a run of adjacent pixels instead of a single one.
+constexpr int kSwapBlockRows = 16;
+
+// Copies column `col` of the rows in `src_rows` to the `Bpp`-byte pixels at
+// `dest`, one per row.
+template <int Bpp>
+void TransposeColumn(pdfium::span<const uint8_t* const> src_rows,
+                     int col,
+                     uint8_t* dest) {
+  const size_t src_offset = static_cast<size_t>(col) * Bpp;
+  for (const uint8_t* src_row : src_rows) {
+    memcpy(dest, src_row + src_offset, Bpp);
+    dest += Bpp;
+  }
+}
+
 void ColorDecode(uint32_t pal_v, uint8_t* r, uint8_t* g, uint8_t* b) {
   *r = static_cast<uint8_t>((pal_v & 0xf00) >> 4);
   *g = static_cast<uint8_t>(pal_v & 0x0f0);
@@ -1004,41 +1021,34 @@ RetainPtr<CFX_DIBitmap> CFX_DIBBase::SwapXY(bool bXFlip, bool bYFlip) const {
       }
     }
   } else {
-    int nBytes = GetBPP() / 8;
-    int dest_step = bYFlip ? -dest_pitch : dest_pitch;
-    if (nBytes == 3)
-      dest_step -= 2;
+    const int nBytes = GetBPP() / 8;
+    const int dest_step = bYFlip ? -dest_pitch : dest_pitch;
     if (bYFlip)
       dest_span = dest_span.subspan(dest_last_row_offset);
-    for (int row = row_start; row < row_end; ++row) {
-      int dest_col = (bXFlip ? dest_clip.right - (row - row_start) - 1 : row) -
-                     dest_clip.left;
-      size_t dest_offset = Fx2DSizeOrDie(dest_col, nBytes);
-      uint8_t* dest_scan = dest_span.subspan(dest_offset).data();
-      if (nBytes == 4) {
-        const uint32_t* src_scan =
-            reinterpret_cast<const uint32_t*>(GetScanline(row).data()) +
-            col_start;
-        for (int col = col_start; col < col_end; ++col) {
-          uint32_t* dest_scan32 = reinterpret_cast<uint32_t*>(dest_scan);
-          *dest_scan32 = *src_scan++;
-          dest_scan += dest_step;
-        }
-      } else {
-        const uint8_t* src_scan =
-            GetScanline(row).subspan(col_start * nBytes).data();
-        if (nBytes == 1) {
-          for (int col = col_start; col < col_end; ++col) {
-            *dest_scan = *src_scan++;
-            dest_scan += dest_step;
-          }
-        } else {
-          for (int col = col_start; col < col_end; ++col) {
-            memcpy(dest_scan, src_scan, 3);
-            dest_scan += 2 + dest_step;
-            src_scan += 3;
-          }
-        }
+    const uint8_t* src_rows[kSwapBlockRows];
+    for (int block_start = row_start; block_start < row_end;
+         block_start += kSwapBlockRows) {
+      // Source rows land in adjacent destination columns, from right to left
+      // when flipped. Order the block from left to right.
+      const int block_size = std::min(kSwapBlockRows, row_end - block_start);
+      for (int i = 0; i < block_size; ++i) {
+        const int row = block_start + (bXFlip ? block_size - i - 1 : i);
+        src_rows[i] = GetScanline(row).data();
+      }
+      const int left_row = bXFlip ? block_start + block_size - 1 : block_start;
+      const int dest_col =
+          (bXFlip ? dest_clip.right - (left_row - row_start) - 1 : left_row) -
+          dest_clip.left;
+      pdfium::span<const uint8_t* const> rows(src_rows, block_size);
+      uint8_t* dest_scan = dest_span.subspan(dest_col * nBytes).data();
+      for (int col = col_start; col < col_end; ++col) {
+        if (nBytes == 4)
+          TransposeColumn<4>(rows, col, dest_scan);
+        else if (nBytes == 3)
+          TransposeColumn<3>(rows, col, dest_scan);
+        else
+          TransposeColumn<1>(rows, col, dest_scan);
+        dest_scan += dest_step;
       }
     }
   }
@@ -161,3 +161,44 @@ TEST(CFX_DIBBaseTest, GetOverlapRectBadInputs) {
   for (const Input& input : kOutOfBoundInputs)
     RunOverlapRectTest(bitmap.Get(), input, /*expected_output=*/nullptr);
 }
+
+TEST(CFX_DIBBaseTest, SwapXY) {
+  // Larger than the blocks SwapXY() works on, and not a multiple of them.
+  constexpr int kWidth = 37;
+  constexpr int kHeight = 21;
+  const FXDIB_Format kFormats[] = {FXDIB_Format::k8bppRgb, FXDIB_Format::kRgb,
+                                   FXDIB_Format::kRgb32};
+  for (FXDIB_Format format : kFormats) {
+    auto bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+    ASSERT_TRUE(bitmap->Create(kWidth, kHeight, format));
+    const int bpp = bitmap->GetBPP() / 8;
+    for (int row = 0; row < kHeight; ++row) {
+      pdfium::span<uint8_t> scanline = bitmap->GetWritableScanline(row);
+      for (int col = 0; col < kWidth; ++col) {
+        for (int i = 0; i < bpp; ++i)
+          scanline[col * bpp + i] = row * 11 + col * 3 + i;
+      }
+    }
+
+    for (bool flip_x : {false, true}) {
+      for (bool flip_y : {false, true}) {
+        RetainPtr<CFX_DIBitmap> swapped = bitmap->SwapXY(flip_x, flip_y);
+        ASSERT_TRUE(swapped);
+        ASSERT_EQ(kHeight, swapped->GetWidth());
+        ASSERT_EQ(kWidth, swapped->GetHeight());
+        for (int row = 0; row < kHeight; ++row) {
+          const int dest_col = flip_x ? kHeight - row - 1 : row;
+          for (int col = 0; col < kWidth; ++col) {
+            const int dest_row = flip_y ? kWidth - col - 1 : col;
+            pdfium::span<const uint8_t> dest_scan =
+                swapped->GetScanline(dest_row);
+            for (int i = 0; i < bpp; ++i) {
+              EXPECT_EQ(static_cast<uint8_t>(row * 11 + col * 3 + i),
+                        dest_scan[dest_col * bpp + i]);
+            }
+          }
+        }
+      }
+    }
+  }
+}
@@ -14,6 +14,7 @@
 #include <utility>
 
 #include "build/build_config.h"
+#include "core/fxcrt/cfx_renderprofile.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/fx_safe_types.h"
@@ -39,6 +40,7 @@ bool CFX_DIBitmap::Create(int width,
                           uint8_t* pBuffer,
                           uint32_t pitch) {
   m_pBuffer = nullptr;
+  m_nBufferSize = 0;
   m_Format = format;
   m_Width = 0;
   m_Height = 0;
@@ -61,6 +63,8 @@ bool CFX_DIBitmap::Create(int width,
         FX_TryAlloc(uint8_t, safe_buffer_size.ValueOrDie()));
     if (!m_pBuffer)
       return false;
+
+    m_nBufferSize = safe_buffer_size.ValueOrDie();
   }
   m_Width = width;
   m_Height = height;
@@ -68,6 +72,29 @@ bool CFX_DIBitmap::Create(int width,
   return true;
 }
 
+bool CFX_DIBitmap::Reuse(int width, int height, FXDIB_Format format) {
+  absl::optional<PitchAndSize> pitch_size =
+      CalculatePitchAndSize(width, height, format, /*pitch=*/0);
+  if (!pitch_size.has_value())
+    return false;
+
+  FX_SAFE_SIZE_T safe_buffer_size = pitch_size.value().size;
+  safe_buffer_size += 4;
+  if (!safe_buffer_size.IsValid() ||
+      safe_buffer_size.ValueOrDie() > m_nBufferSize) {
+    return Create(width, height, format);
+  }
+
+  m_Format = format;
+  m_Width = width;
+  m_Height = height;
+  m_Pitch = pitch_size.value().pitch;
+#if defined(_SKIA_SUPPORT_)
+  m_nFormat = Format::kCleared;
+#endif
+  return true;
+}
+
 bool CFX_DIBitmap::Copy(const RetainPtr<CFX_DIBBase>& pSrc) {
   if (m_pBuffer)
     return false;
@@ -112,8 +139,10 @@ size_t CFX_DIBitmap::GetEstimatedImageMemoryBurden() const {
 
 void CFX_DIBitmap::TakeOver(RetainPtr<CFX_DIBitmap>&& pSrcBitmap) {
   m_pBuffer = std::move(pSrcBitmap->m_pBuffer);
+  m_nBufferSize = pSrcBitmap->m_nBufferSize;
   m_palette = std::move(pSrcBitmap->m_palette);
   pSrcBitmap->m_pBuffer = nullptr;
+  pSrcBitmap->m_nBufferSize = 0;
   m_Format = pSrcBitmap->m_Format;
   m_Width = pSrcBitmap->m_Width;
   m_Height = pSrcBitmap->m_Height;
@@ -698,6 +727,7 @@ bool CFX_DIBitmap::CompositeBitmap(int dest_left,
                                    BlendMode blend_type,
                                    const CFX_ClipRgn* pClipRgn,
                                    bool bRgbByteOrder) {
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kComposite);
   if (pSrcBitmap->IsMaskFormat()) {
     // Should have called CompositeMask().
     NOTREACHED();
@@ -765,6 +795,7 @@ bool CFX_DIBitmap::CompositeMask(int dest_left,
                                  BlendMode blend_type,
                                  const CFX_ClipRgn* pClipRgn,
                                  bool bRgbByteOrder) {
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kComposite);
   if (!pMask->IsMaskFormat()) {
     // Should have called CompositeBitmap().
     NOTREACHED();
@@ -1038,6 +1069,7 @@ bool CFX_DIBitmap::ConvertFormat(FXDIB_Format dest_format) {
 
   m_palette = std::move(pal_8bpp);
   m_pBuffer = std::move(dest_buf);
+  m_nBufferSize = dest_buf_size;
   m_Format = dest_format;
   m_Pitch = dest_pitch;
   return true;
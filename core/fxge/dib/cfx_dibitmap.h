@@ -30,6 +30,11 @@ class CFX_DIBitmap final : public CFX_DIBBase {
               uint8_t* pBuffer,
               uint32_t pitch);
 
+  // Like Create(), but keeps the current buffer if this bitmap owns it and it
+  // is big enough. In that case, the contents are left as they were, so
+  // callers must clear the bitmap themselves when they need it cleared.
+  bool Reuse(int width, int height, FXDIB_Format format);
+
   bool Copy(const RetainPtr<CFX_DIBBase>& pSrc);
 
   // CFX_DIBBase
@@ -167,6 +172,8 @@ class CFX_DIBitmap final : public CFX_DIBBase {
                                   int src_top);
 
   MaybeOwned<uint8_t, FxFreeDeleter> m_pBuffer;
+  // Size of `m_pBuffer` if this bitmap owns it, 0 otherwise.
+  size_t m_nBufferSize = 0;
 #if defined(_SKIA_SUPPORT_)
   Format m_nFormat = Format::kCleared;
 #endif
@@ -26,6 +26,37 @@ TEST(CFX_DIBitmap, Create) {
   EXPECT_TRUE(pBitmap->Create(400, 300, FXDIB_Format::k1bppRgb));
 }
 
+TEST(CFX_DIBitmap, Reuse) {
+  auto pBitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  ASSERT_TRUE(pBitmap->Create(100, 100, FXDIB_Format::kArgb));
+  const uint8_t* buffer = pBitmap->GetBuffer().data();
+
+  // Smaller bitmaps fit into the existing buffer.
+  ASSERT_TRUE(pBitmap->Reuse(50, 20, FXDIB_Format::k8bppMask));
+  EXPECT_EQ(buffer, pBitmap->GetBuffer().data());
+  EXPECT_EQ(50, pBitmap->GetWidth());
+  EXPECT_EQ(20, pBitmap->GetHeight());
+  EXPECT_EQ(52u, pBitmap->GetPitch());
+  EXPECT_EQ(FXDIB_Format::k8bppMask, pBitmap->GetFormat());
+
+  // The original size still fits after shrinking.
+  ASSERT_TRUE(pBitmap->Reuse(100, 100, FXDIB_Format::kArgb));
+  EXPECT_EQ(buffer, pBitmap->GetBuffer().data());
+
+  // Bigger ones need a new buffer.
+  ASSERT_TRUE(pBitmap->Reuse(101, 100, FXDIB_Format::kArgb));
+  EXPECT_EQ(101, pBitmap->GetWidth());
+  EXPECT_EQ(40400u, pBitmap->GetBuffer().size());
+
+  EXPECT_FALSE(pBitmap->Reuse(100, 100, FXDIB_Format::kInvalid));
+
+  // Bitmaps over external buffers always get a new buffer.
+  uint8_t external[16] = {};
+  ASSERT_TRUE(pBitmap->Create(2, 2, FXDIB_Format::kArgb, external, 8));
+  ASSERT_TRUE(pBitmap->Reuse(1, 1, FXDIB_Format::kArgb));
+  EXPECT_NE(external, pBitmap->GetBuffer().data());
+}
+
 TEST(CFX_DIBitmap, CalculatePitchAndSizeGood) {
   // Simple case with no provided pitch.
   absl::optional<CFX_DIBitmap::PitchAndSize> result =
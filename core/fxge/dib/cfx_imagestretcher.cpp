@@ -6,6 +6,7 @@
 
 #include "core/fxge/dib/cfx_imagestretcher.h"
 
+#include "core/fxcrt/cfx_renderprofile.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxge/dib/cfx_dibbase.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
@@ -91,6 +92,7 @@ CFX_ImageStretcher::CFX_ImageStretcher(
 CFX_ImageStretcher::~CFX_ImageStretcher() = default;
 
 bool CFX_ImageStretcher::Start() {
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kStretch);
   if (m_DestWidth == 0 || m_DestHeight == 0)
     return false;
 
@@ -110,6 +112,7 @@ bool CFX_ImageStretcher::Start() {
 }
 
 bool CFX_ImageStretcher::Continue(PauseIndicatorIface* pPause) {
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kStretch);
   return ContinueStretch(pPause);
 }
 
@@ -12,14 +12,21 @@
 #include <memory>
 #include <utility>
 
+#include "build/build_config.h"
+#include "core/fxcrt/cfx_renderprofile.h"
 #include "core/fxcrt/fx_system.h"
+#include "core/fxcrt/pauseindicator_iface.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/dib/cfx_imagestretcher.h"
 #include "core/fxge/dib/fx_dib.h"
 #include "third_party/base/check.h"
-#include "third_party/base/compiler_specific.h"
+#include "third_party/base/check_op.h"
 #include "third_party/base/notreached.h"
-#include "third_party/base/numerics/safe_conversions.h"
+
+#if defined(ARCH_CPU_X86_FAMILY) && (defined(__SSE2__) || defined(_M_X64))
+#define TRANSFORMER_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace {
 
@@ -45,6 +52,83 @@ uint8_t BilinearInterpolate(const uint8_t* buf,
   return (r_pos_0 * (255 - data.res_y) + r_pos_1 * data.res_y) >> 8;
 }
 
+#if defined(TRANSFORMER_SSE2)
+// Loads the two horizontally adjacent pixels at `pos` into the low 64 bits,
+// with each pixel padded to 32 bits.
+__m128i LoadAdjacentPixels(const uint8_t* pos, int bpp) {
+  if (bpp == 4)
+    return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pos));
+
+  return _mm_setr_epi32(pos[0] | (pos[1] << 8) | (pos[2] << 16),
+                        pos[3] | (pos[4] << 8) | (pos[5] << 16), 0, 0);
+}
+
+// Broadcasts `weight0` to the 16-bit lanes of the low half, and `weight1` to
+// those of the high half.
+__m128i LoadWeights(int weight0, int weight1) {
+  return _mm_unpacklo_epi64(_mm_set1_epi16(weight0), _mm_set1_epi16(weight1));
+}
+#endif  // defined(TRANSFORMER_SSE2)
+
+// Interpolates the first 3 or 4 channels of two pixels, depending on `bpp`,
+// with the same results as BilinearInterpolate(). Writes 4 bytes of `channels`
+// per pixel. Both pixels must have their right and bottom neighbors inside the
+// image.
+void BilinearInterpolatePixelPair(
+    const uint8_t* buf,
+    const CFX_ImageTransformer::BilinearData& data0,
+    const CFX_ImageTransformer::BilinearData& data1,
+    int bpp,
+    uint8_t* channels) {
+  DCHECK(bpp == 3 || bpp == 4);
+#if defined(TRANSFORMER_SSE2)
+  DCHECK_EQ(data0.src_col_l + 1, data0.src_col_r);
+  DCHECK_EQ(data1.src_col_l + 1, data1.src_col_r);
+  const uint8_t* pos0 = buf + data0.row_offset_l + data0.src_col_l * bpp;
+  const uint8_t* pos1 = buf + data1.row_offset_l + data1.src_col_l * bpp;
+  const uint8_t* pos2 = buf + data0.row_offset_r + data0.src_col_l * bpp;
+  const uint8_t* pos3 = buf + data1.row_offset_r + data1.src_col_l * bpp;
+
+  // Gather the left and the right neighbors of both pixels in separate
+  // registers, with 16-bit lanes.
+  const __m128i zero = _mm_setzero_si128();
+  __m128i up = _mm_unpacklo_epi32(LoadAdjacentPixels(pos0, bpp),
+                                  LoadAdjacentPixels(pos1, bpp));
+  __m128i down = _mm_unpacklo_epi32(LoadAdjacentPixels(pos2, bpp),
+                                    LoadAdjacentPixels(pos3, bpp));
+  __m128i up_l = _mm_unpacklo_epi8(up, zero);
+  __m128i up_r = _mm_unpackhi_epi8(up, zero);
+  __m128i down_l = _mm_unpacklo_epi8(down, zero);
+  __m128i down_r = _mm_unpackhi_epi8(down, zero);
+
+  // The weighted sums never exceed 255 * 255, so they fit in unsigned 16-bit
+  // lanes.
+  const __m128i max = _mm_set1_epi16(255);
+  const __m128i res_x = LoadWeights(data0.res_x, data1.res_x);
+  const __m128i i_res_x = _mm_sub_epi16(max, res_x);
+  __m128i row_u = _mm_srli_epi16(
+      _mm_add_epi16(_mm_mullo_epi16(up_l, i_res_x),
+                    _mm_mullo_epi16(up_r, res_x)),
+      8);
+  __m128i row_d = _mm_srli_epi16(
+      _mm_add_epi16(_mm_mullo_epi16(down_l, i_res_x),
+                    _mm_mullo_epi16(down_r, res_x)),
+      8);
+  const __m128i res_y = LoadWeights(data0.res_y, data1.res_y);
+  __m128i result = _mm_srli_epi16(
+      _mm_add_epi16(_mm_mullo_epi16(row_u, _mm_sub_epi16(max, res_y)),
+                    _mm_mullo_epi16(row_d, res_y)),
+      8);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(channels),
+                   _mm_packus_epi16(result, result));
+#else
+  for (int i = 0; i < bpp; ++i) {
+    channels[i] = BilinearInterpolate(buf, data0, bpp, i);
+    channels[i + 4] = BilinearInterpolate(buf, data1, bpp, i);
+  }
+#endif
+}
+
 class CFX_BilinearMatrix {
  public:
   explicit CFX_BilinearMatrix(const CFX_Matrix& src)
@@ -55,24 +139,20 @@ class CFX_BilinearMatrix {
         e(FXSYS_roundf(src.e * kBase)),
         f(FXSYS_roundf(src.f * kBase)) {}
 
-  void Transform(int x, int y, int* x1, int* y1, int* res_x, int* res_y) const {
-    CFX_PointF val = TransformInternal(CFX_PointF(x, y));
-    *x1 = pdfium::base::saturated_cast<int>(val.x / kBase);
-    *y1 = pdfium::base::saturated_cast<int>(val.y / kBase);
-    *res_x = static_cast<int>(val.x) % kBase;
-    *res_y = static_cast<int>(val.y) % kBase;
-    if (*res_x < 0 && *res_x > -kBase)
-      *res_x = kBase + *res_x;
-    if (*res_y < 0 && *res_y > -kBase)
-      *res_y = kBase + *res_y;
+  // Returns the fixed-point position, in 1/kBase pixels and offset by half a
+  // pixel, that column 0 of `row` maps to. Each following column is
+  // GetColumnStep() further along.
+  void GetRowStart(int row, int64_t* x, int64_t* y) const {
+    *x = int64_t{c} * row + e + kBase / 2;
+    *y = int64_t{d} * row + f + kBase / 2;
   }
 
- private:
-  CFX_PointF TransformInternal(CFX_PointF pt) const {
-    return CFX_PointF(a * pt.x + c * pt.y + e + kBase / 2,
-                      b * pt.x + d * pt.y + f + kBase / 2);
+  void GetColumnStep(int* x, int* y) const {
+    *x = a;
+    *y = b;
   }
 
+ private:
   const int a;
   const int b;
   const int c;
@@ -81,9 +161,39 @@ class CFX_BilinearMatrix {
   const int f;
 };
 
-bool InStretchBounds(const FX_RECT& clip_rect, int col, int row) {
-  return col >= 0 && col <= clip_rect.Width() && row >= 0 &&
-         row <= clip_rect.Height();
+// Splits the fixed-point position `pos` into a pixel index and the weight of
+// the next pixel. Returns false if the index falls outside of [0, `size`].
+// Like truncating division, positions just below 0 map to pixel 0.
+bool SplitFixedPosition(int64_t pos, int size, int* index, int* res) {
+  if (pos <= -kBase || pos >= int64_t{size + 1} * kBase)
+    return false;
+
+  *index = pos < 0 ? 0 : static_cast<int>(pos / kBase);
+  *res = static_cast<int>(pos & (kBase - 1));
+  return true;
+}
+
+// Returns whether the fixed-point position `pos` and the next pixel after it
+// both fall inside [0, `size`), so that no clamping is needed.
+bool IsInterior(int64_t pos, int size) {
+  return pos >= 0 && pos < int64_t{size - 1} * kBase;
+}
+
+// Same as SplitFixedPosition() and AdjustCoords() for positions where
+// IsInterior() holds in both directions.
+CFX_ImageTransformer::BilinearData GetInteriorData(int64_t pos_x,
+                                                   int64_t pos_y,
+                                                   uint32_t pitch) {
+  CFX_ImageTransformer::BilinearData d;
+  d.res_x = static_cast<int>(pos_x & (kBase - 1));
+  d.res_y = static_cast<int>(pos_y & (kBase - 1));
+  d.src_col_l = static_cast<int>(pos_x / kBase);
+  d.src_row_l = static_cast<int>(pos_y / kBase);
+  d.src_col_r = d.src_col_l + 1;
+  d.src_row_r = d.src_row_l + 1;
+  d.row_offset_l = d.src_row_l * pitch;
+  d.row_offset_r = d.src_row_r * pitch;
+  return d;
 }
 
 void AdjustCoords(const FX_RECT& clip_rect, int* col, int* row) {
@@ -95,26 +205,50 @@ void AdjustCoords(const FX_RECT& clip_rect, int* col, int* row) {
     src_row--;
 }
 
-// Let the compiler deduce the type for |func|, which cheaper than specifying it
-// with std::function.
-template <typename F>
+// Let the compiler deduce the types for |func| and |pair_func|, which cheaper
+// than specifying them with std::function. Walks each destination row with
+// incremental fixed-point source positions, and hands pairs of pixels away
+// from the image edges to |pair_func|.
+template <typename F, typename G>
 void DoBilinearLoop(const CFX_ImageTransformer::CalcData& calc_data,
                     const FX_RECT& result_rect,
                     const FX_RECT& clip_rect,
                     int increment,
-                    const F& func) {
+                    const F& func,
+                    const G& pair_func) {
   CFX_BilinearMatrix matrix_fix(calc_data.matrix);
+  const int width = clip_rect.Width();
+  const int height = clip_rect.Height();
+  int step_x;
+  int step_y;
+  matrix_fix.GetColumnStep(&step_x, &step_y);
   for (int row = 0; row < result_rect.Height(); row++) {
     uint8_t* dest = calc_data.bitmap->GetWritableScanline(row).data();
-    for (int col = 0; col < result_rect.Width(); col++) {
+    int64_t pos_x;
+    int64_t pos_y;
+    matrix_fix.GetRowStart(row, &pos_x, &pos_y);
+    int col = 0;
+    while (col < result_rect.Width()) {
+      const int64_t next_x = pos_x + step_x;
+      const int64_t next_y = pos_y + step_y;
+      if (col + 1 < result_rect.Width() && IsInterior(pos_x, width) &&
+          IsInterior(pos_y, height) && IsInterior(next_x, width) &&
+          IsInterior(next_y, height)) {
+        CFX_ImageTransformer::BilinearData d0 =
+            GetInteriorData(pos_x, pos_y, calc_data.pitch);
+        CFX_ImageTransformer::BilinearData d1 =
+            GetInteriorData(next_x, next_y, calc_data.pitch);
+        pair_func(d0, d1, dest);
+        dest += 2 * increment;
+        col += 2;
+        pos_x = next_x + step_x;
+        pos_y = next_y + step_y;
+        continue;
+      }
+
       CFX_ImageTransformer::BilinearData d;
-      d.res_x = 0;
-      d.res_y = 0;
-      d.src_col_l = 0;
-      d.src_row_l = 0;
-      matrix_fix.Transform(col, row, &d.src_col_l, &d.src_row_l, &d.res_x,
-                           &d.res_y);
-      if (LIKELY(InStretchBounds(clip_rect, d.src_col_l, d.src_row_l))) {
+      if (SplitFixedPosition(pos_x, width, &d.src_col_l, &d.res_x) &&
+          SplitFixedPosition(pos_y, height, &d.src_row_l, &d.res_y)) {
         AdjustCoords(clip_rect, &d.src_col_l, &d.src_row_l);
         d.src_col_r = d.src_col_l + 1;
         d.src_row_r = d.src_row_l + 1;
@@ -124,10 +258,30 @@ void DoBilinearLoop(const CFX_ImageTransformer::CalcData& calc_data,
         func(d, dest);
       }
       dest += increment;
+      col++;
+      pos_x = next_x;
+      pos_y = next_y;
     }
   }
 }
 
+template <typename F>
+void DoBilinearLoop(const CFX_ImageTransformer::CalcData& calc_data,
+                    const FX_RECT& result_rect,
+                    const FX_RECT& clip_rect,
+                    int increment,
+                    const F& func) {
+  auto pair_func = [&func, increment](
+                       const CFX_ImageTransformer::BilinearData& data0,
+                       const CFX_ImageTransformer::BilinearData& data1,
+                       uint8_t* dest) {
+    func(data0, dest);
+    func(data1, dest + increment);
+  };
+  DoBilinearLoop(calc_data, result_rect, clip_rect, increment, func,
+                 pair_func);
+}
+
 }  // namespace
 
 CFX_ImageTransformer::CFX_ImageTransformer(
@@ -212,6 +366,12 @@ bool CFX_ImageTransformer::Continue(PauseIndicatorIface* pPause) {
   if (m_Stretcher->Continue(pPause))
     return true;
 
+  // Do not spend a second pass on what a cancelled stretch left behind.
+  if (pPause && pPause->NeedToCancelNow()) {
+    m_Storer.Replace(nullptr);
+    return false;
+  }
+
   switch (m_type) {
     case kNormal:
       break;
@@ -229,6 +389,7 @@ bool CFX_ImageTransformer::Continue(PauseIndicatorIface* pPause) {
 }
 
 void CFX_ImageTransformer::ContinueRotate(PauseIndicatorIface* pPause) {
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kStretch);
   if (m_Storer.GetBitmap()) {
     m_Storer.Replace(
         m_Storer.GetBitmap()->SwapXY(m_matrix.c > 0, m_matrix.b < 0));
@@ -236,6 +397,7 @@ void CFX_ImageTransformer::ContinueRotate(PauseIndicatorIface* pPause) {
 }
 
 void CFX_ImageTransformer::ContinueOther(PauseIndicatorIface* pPause) {
+  CFX_RenderProfile::ScopedPhase phase(CFX_RenderProfile::Phase::kStretch);
   if (!m_Storer.GetBitmap())
     return;
 
@@ -310,7 +472,18 @@ void CFX_ImageTransformer::CalcColor(const CalcData& calc_data,
       uint8_t r = BilinearInterpolate(calc_data.buf, data, Bpp, 2);
       *reinterpret_cast<uint32_t*>(dest) = ArgbEncode(kOpaqueAlpha, r, g, b);
     };
-    DoBilinearLoop(calc_data, m_result, m_StretchClip, destBpp, func);
+    auto pair_func = [&calc_data, Bpp, destBpp](const BilinearData& data0,
+                                                const BilinearData& data1,
+                                                uint8_t* dest) {
+      uint8_t bgr[8];
+      BilinearInterpolatePixelPair(calc_data.buf, data0, data1, Bpp, bgr);
+      *reinterpret_cast<uint32_t*>(dest) =
+          ArgbEncode(kOpaqueAlpha, bgr[2], bgr[1], bgr[0]);
+      *reinterpret_cast<uint32_t*>(dest + destBpp) =
+          ArgbEncode(kOpaqueAlpha, bgr[6], bgr[5], bgr[4]);
+    };
+    DoBilinearLoop(calc_data, m_result, m_StretchClip, destBpp, func,
+                   pair_func);
     return;
   }
 
@@ -322,7 +495,18 @@ void CFX_ImageTransformer::CalcColor(const CalcData& calc_data,
       uint8_t alpha = BilinearInterpolate(calc_data.buf, data, Bpp, 3);
       *reinterpret_cast<uint32_t*>(dest) = ArgbEncode(alpha, r, g, b);
     };
-    DoBilinearLoop(calc_data, m_result, m_StretchClip, destBpp, func);
+    auto pair_func = [&calc_data, Bpp, destBpp](const BilinearData& data0,
+                                                const BilinearData& data1,
+                                                uint8_t* dest) {
+      uint8_t bgra[8];
+      BilinearInterpolatePixelPair(calc_data.buf, data0, data1, Bpp, bgra);
+      *reinterpret_cast<uint32_t*>(dest) =
+          ArgbEncode(bgra[3], bgra[2], bgra[1], bgra[0]);
+      *reinterpret_cast<uint32_t*>(dest + destBpp) =
+          ArgbEncode(bgra[7], bgra[6], bgra[5], bgra[4]);
+    };
+    DoBilinearLoop(calc_data, m_result, m_StretchClip, destBpp, func,
+                   pair_func);
     return;
   }
 
@@ -23,6 +23,13 @@
 #include "third_party/base/check.h"
 #include "third_party/base/cxx17_backports.h"
 
+namespace {
+
+// Rows to stretch between polls of the pause indicator.
+constexpr int kStrechPauseRows = 10;
+
+}  // namespace
+
 static_assert(
     std::is_trivially_destructible<CStretchEngine::PixelWeight>::value,
     "PixelWeight storage may be re-used without invoking its destructor");
@@ -267,7 +274,7 @@ bool CStretchEngine::Continue(PauseIndicatorIface* pPause) {
       return true;
 
     m_State = State::kVertical;
-    StretchVert();
+    StretchVert(pPause);
   }
   return false;
 }
@@ -303,7 +310,6 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
     return true;
 
   int Bpp = m_DestBpp / 8;
-  static const int kStrechPauseRows = 10;
   int rows_to_go = kStrechPauseRows;
   for (; m_CurRow < m_SrcClip.bottom; ++m_CurRow) {
     if (rows_to_go == 0) {
@@ -421,7 +427,7 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
   return false;
 }
 
-void CStretchEngine::StretchVert() {
+void CStretchEngine::StretchVert(PauseIndicatorIface* pPause) {
   if (m_DestHeight == 0)
     return;
 
@@ -433,7 +439,16 @@ void CStretchEngine::StretchVert() {
   }
 
   const int DestBpp = m_DestBpp / 8;
+  int rows_to_go = kStrechPauseRows;
   for (int row = m_DestClip.top; row < m_DestClip.bottom; ++row) {
+    // The vertical pass cannot pause, but it can still stop early.
+    if (--rows_to_go == 0) {
+      if (pPause && pPause->NeedToCancelNow())
+        return;
+
+      rows_to_go = kStrechPauseRows;
+    }
+
     unsigned char* dest_scan = m_DestScanline.data();
     PixelWeight* pWeights = table.GetPixelWeight(row);
     switch (m_TransMethod) {
@@ -119,7 +119,7 @@ class CStretchEngine {
   bool Continue(PauseIndicatorIface* pPause);
   bool StartStretchHorz();
   bool ContinueStretchHorz(PauseIndicatorIface* pPause);
-  void StretchVert();
+  void StretchVert(PauseIndicatorIface* pPause);
 
   const FXDIB_ResampleOptions& GetResampleOptionsForTest() const {
     return m_ResampleOptions;
@@ -49,6 +49,8 @@ bool RenderDeviceDriverIface::ContinueDIBits(CFX_ImageRenderer* handle,
   return false;
 }
 
+void RenderDeviceDriverIface::SetPauseIndicator(PauseIndicatorIface* pPause) {}
+
 bool RenderDeviceDriverIface::DrawDeviceText(
     pdfium::span<const TextCharPos> pCharPos,
     CFX_Font* pFont,
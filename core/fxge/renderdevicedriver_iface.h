@@ -96,6 +96,10 @@ class RenderDeviceDriverIface {
                            BlendMode blend_type) = 0;
   virtual bool ContinueDIBits(CFX_ImageRenderer* handle,
                               PauseIndicatorIface* pPause);
+
+  // Drivers may poll `pPause` for cancellation in the middle of long drawing
+  // operations. Passing nullptr stops the polling.
+  virtual void SetPauseIndicator(PauseIndicatorIface* pPause);
   virtual bool DrawDeviceText(pdfium::span<const TextCharPos> pCharPos,
                               CFX_Font* pFont,
                               const CFX_Matrix& mtObject2Device,
@@ -6,11 +6,37 @@
 
 #include "fpdfsdk/cpdfsdk_pauseadapter.h"
 
-CPDFSDK_PauseAdapter::CPDFSDK_PauseAdapter(IFSDK_PAUSE* IPause)
-    : m_IPause(IPause) {}
+CPDFSDK_PauseAdapter::CPDFSDK_PauseAdapter(IFSDK_PAUSE* IPause,
+                                           absl::optional<Deadline> deadline)
+    : m_IPause(IPause), m_Deadline(deadline) {}
 
 CPDFSDK_PauseAdapter::~CPDFSDK_PauseAdapter() = default;
 
+// static
+absl::optional<CPDFSDK_PauseAdapter::Deadline>
+CPDFSDK_PauseAdapter::GetDeadline(const IFSDK_PAUSE* IPause) {
+  if (IPause->version < 2 || !IPause->deadline_ms)
+    return absl::nullopt;
+
+  return std::chrono::steady_clock::now() +
+         std::chrono::milliseconds(IPause->deadline_ms);
+}
+
 bool CPDFSDK_PauseAdapter::NeedToPauseNow() {
-  return m_IPause->NeedToPauseNow && m_IPause->NeedToPauseNow(m_IPause);
+  return NeedToCancelNow() ||
+         (m_IPause->NeedToPauseNow && m_IPause->NeedToPauseNow(m_IPause));
+}
+
+bool CPDFSDK_PauseAdapter::NeedToCancelNow() {
+  if (m_bCancelled)
+    return true;
+
+  if (m_Deadline.has_value() &&
+      std::chrono::steady_clock::now() >= m_Deadline.value()) {
+    m_bCancelled = true;
+  } else if (m_IPause->version >= 2 && m_IPause->NeedToCancelNow &&
+             m_IPause->NeedToCancelNow(m_IPause)) {
+    m_bCancelled = true;
+  }
+  return m_bCancelled;
 }
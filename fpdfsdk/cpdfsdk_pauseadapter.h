@@ -7,19 +7,32 @@
 #ifndef FPDFSDK_CPDFSDK_PAUSEADAPTER_H_
 #define FPDFSDK_CPDFSDK_PAUSEADAPTER_H_
 
+#include <chrono>
+
 #include "core/fxcrt/pauseindicator_iface.h"
 #include "core/fxcrt/unowned_ptr.h"
 #include "public/fpdf_progressive.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 class CPDFSDK_PauseAdapter final : public PauseIndicatorIface {
  public:
-  explicit CPDFSDK_PauseAdapter(IFSDK_PAUSE* IPause);
+  using Deadline = std::chrono::steady_clock::time_point;
+
+  // Cancels once `deadline` has passed, if there is one, in addition to when
+  // `IPause` asks for it.
+  CPDFSDK_PauseAdapter(IFSDK_PAUSE* IPause, absl::optional<Deadline> deadline);
   ~CPDFSDK_PauseAdapter() override;
 
+  // Returns the deadline set by `IPause`, counted from now.
+  static absl::optional<Deadline> GetDeadline(const IFSDK_PAUSE* IPause);
+
   bool NeedToPauseNow() override;
+  bool NeedToCancelNow() override;
 
  private:
   UnownedPtr<IFSDK_PAUSE> const m_IPause;
+  const absl::optional<Deadline> m_Deadline;
+  bool m_bCancelled = false;
 };
 
 #endif  // FPDFSDK_CPDFSDK_PAUSEADAPTER_H_
@@ -10,10 +10,14 @@
 #include <utility>
 
 #include "core/fpdfapi/page/cpdf_pageimagecache.h"
+#include "core/fpdfapi/render/cpdf_docrenderdata.h"
 #include "core/fpdfapi/render/cpdf_pagerendercontext.h"
 #include "core/fpdfapi/render/cpdf_progressiverenderer.h"
+#include "core/fpdfapi/render/cpdf_rendercontext.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfdoc/cpdf_annotlist.h"
+#include "core/fxcrt/cfx_renderprofile.h"
+#include "core/fxcrt/cfx_threadpool.h"
 #include "core/fxge/cfx_renderdevice.h"
 #include "fpdfsdk/cpdfsdk_helpers.h"
 #include "fpdfsdk/cpdfsdk_pauseadapter.h"
@@ -39,6 +43,15 @@ void RenderPageImpl(CPDF_PageRenderContext* pContext,
   options.bNoTextSmooth = !!(flags & FPDF_RENDER_NO_SMOOTHTEXT);
   options.bNoImageSmooth = !!(flags & FPDF_RENDER_NO_SMOOTHIMAGE);
   options.bNoPathSmooth = !!(flags & FPDF_RENDER_NO_SMOOTHPATH);
+  options.bCacheForms = !!(flags & FPDF_RENDER_CACHE_FORMS);
+  options.bLowResSoftMasks = !!(flags & FPDF_RENDER_LOWRES_SOFTMASKS);
+  options.bDraft = !!(flags & FPDF_RENDER_DRAFT);
+  if (options.bDraft) {
+    options.bNoTextSmooth = true;
+    options.bNoImageSmooth = true;
+    options.bNoPathSmooth = true;
+    options.bLowResSoftMasks = true;
+  }
 
   // Grayscale output
   if (flags & FPDF_GRAYSCALE)
@@ -61,9 +74,24 @@ void RenderPageImpl(CPDF_PageRenderContext* pContext,
   pContext->m_pContext = std::make_unique<CPDF_RenderContext>(
       pPage->GetDocument(), pPage->GetMutablePageResources(),
       pPage->GetPageImageCache());
+  if (flags & FPDF_RENDER_PROFILE) {
+    pContext->m_pProfile = std::make_unique<CFX_RenderProfile>();
+    pContext->m_pContext->SetProfile(pContext->m_pProfile.get());
+  }
 
   pContext->m_pContext->AppendLayer(pPage, matrix);
 
+  // Non-draft renders ask for images at the device size, so prefetched images
+  // can be decoded for that size up front. Drafts size each image by where it
+  // lands on the page, so they decode on demand.
+  if (!options.bDraft && pPage->GetPageImageCache() &&
+      CPDF_DocRenderData::FromDocument(pPage->GetDocument())
+          ->ShouldPrefetchImages()) {
+    pPage->GetPageImageCache()->PrefetchImages(
+        CFX_ThreadPool::Get(), {pContext->m_pDevice->GetWidth(),
+                                pContext->m_pDevice->GetHeight()});
+  }
+
   if (flags & FPDF_ANNOT) {
     auto pOwnedList = std::make_unique<CPDF_AnnotList>(pPage);
     CPDF_AnnotList* pList = pOwnedList.get();
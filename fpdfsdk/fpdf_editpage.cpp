@@ -600,6 +600,12 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPage_GenerateContent(FPDF_PAGE page) {
 
   CPDF_PageContentGenerator CG(pPage);
   CG.GenerateContent();
+
+  // Rasterized form XObjects may no longer match their edited contents.
+  CPDF_DocRenderData* pRenderData =
+      CPDF_DocRenderData::FromDocument(pPage->GetDocument());
+  if (pRenderData)
+    pRenderData->GetRenderedBitmapCache()->Clear();
   return true;
 }
 
@@ -6,17 +6,22 @@
 
 #include "public/fpdf_progressive.h"
 
+#include <chrono>
 #include <memory>
 #include <utility>
 
 #include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/render/cpdf_pagerendercontext.h"
 #include "core/fpdfapi/render/cpdf_progressiverenderer.h"
+#include "core/fpdfapi/render/cpdf_rendercontext.h"
+#include "core/fxcrt/cfx_renderprofile.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "fpdfsdk/cpdfsdk_helpers.h"
 #include "fpdfsdk/cpdfsdk_pauseadapter.h"
 #include "fpdfsdk/cpdfsdk_renderpage.h"
 #include "public/fpdfview.h"
+#include "third_party/base/numerics/safe_conversions.h"
+#include "third_party/base/span.h"
 
 // These checks are here because core/ and public/ cannot depend on each other.
 static_assert(CPDF_ProgressiveRenderer::kReady == FPDF_RENDER_READY,
@@ -28,6 +33,35 @@ static_assert(CPDF_ProgressiveRenderer::kDone == FPDF_RENDER_DONE,
               "CPDF_ProgressiveRenderer::kDone value mismatch");
 static_assert(CPDF_ProgressiveRenderer::kFailed == FPDF_RENDER_FAILED,
               "CPDF_ProgressiveRenderer::kFailed value mismatch");
+static_assert(CPDF_ProgressiveRenderer::kCancelled == FPDF_RENDER_CANCELLED,
+              "CPDF_ProgressiveRenderer::kCancelled value mismatch");
+static_assert(static_cast<int>(CFX_RenderProfile::Phase::kParse) ==
+                  FPDF_RENDER_PHASE_PARSE,
+              "CFX_RenderProfile::Phase::kParse value mismatch");
+static_assert(static_cast<int>(CFX_RenderProfile::Phase::kResourceLoad) ==
+                  FPDF_RENDER_PHASE_RESOURCE_LOAD,
+              "CFX_RenderProfile::Phase::kResourceLoad value mismatch");
+static_assert(static_cast<int>(CFX_RenderProfile::Phase::kImageDecode) ==
+                  FPDF_RENDER_PHASE_IMAGE_DECODE,
+              "CFX_RenderProfile::Phase::kImageDecode value mismatch");
+static_assert(static_cast<int>(CFX_RenderProfile::Phase::kStretch) ==
+                  FPDF_RENDER_PHASE_STRETCH,
+              "CFX_RenderProfile::Phase::kStretch value mismatch");
+static_assert(static_cast<int>(CFX_RenderProfile::Phase::kComposite) ==
+                  FPDF_RENDER_PHASE_COMPOSITE,
+              "CFX_RenderProfile::Phase::kComposite value mismatch");
+static_assert(static_cast<int>(CFX_RenderProfile::Phase::kText) ==
+                  FPDF_RENDER_PHASE_TEXT,
+              "CFX_RenderProfile::Phase::kText value mismatch");
+static_assert(static_cast<int>(CFX_RenderProfile::Phase::kPath) ==
+                  FPDF_RENDER_PHASE_PATH,
+              "CFX_RenderProfile::Phase::kPath value mismatch");
+static_assert(static_cast<int>(CFX_RenderProfile::Phase::kShading) ==
+                  FPDF_RENDER_PHASE_SHADING,
+              "CFX_RenderProfile::Phase::kShading value mismatch");
+static_assert(static_cast<int>(CFX_RenderProfile::Phase::kTransparency) ==
+                  FPDF_RENDER_PHASE_TRANSPARENCY,
+              "CFX_RenderProfile::Phase::kTransparency value mismatch");
 
 namespace {
 
@@ -35,6 +69,28 @@ int ToFPDFStatus(CPDF_ProgressiveRenderer::Status status) {
   return static_cast<int>(status);
 }
 
+bool IsValidPause(const IFSDK_PAUSE* pause) {
+  return pause && (pause->version == 1 || pause->version == 2);
+}
+
+const CFX_RenderProfile* GetRenderProfile(FPDF_PAGE page) {
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!pPage)
+    return nullptr;
+
+  auto* pContext =
+      static_cast<CPDF_PageRenderContext*>(pPage->GetRenderContext());
+  return pContext ? pContext->m_pProfile.get() : nullptr;
+}
+
+void ToFPDFProfileStats(const CFX_RenderProfile::Stats& stats,
+                        FPDF_RENDER_PROFILE_STATS* out) {
+  out->calls = stats.calls;
+  out->time_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(stats.time).count();
+  out->allocations = stats.allocations;
+}
+
 }  // namespace
 
 FPDF_EXPORT int FPDF_CALLCONV
@@ -48,7 +104,7 @@ FPDF_RenderPageBitmapWithColorScheme_Start(FPDF_BITMAP bitmap,
                                            int flags,
                                            const FPDF_COLORSCHEME* color_scheme,
                                            IFSDK_PAUSE* pause) {
-  if (!bitmap || !pause || pause->version != 1)
+  if (!bitmap || !IsValidPause(pause))
     return FPDF_RENDER_FAILED;
 
   CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
@@ -65,7 +121,8 @@ FPDF_RenderPageBitmapWithColorScheme_Start(FPDF_BITMAP bitmap,
   pContext->m_pDevice = std::move(pOwnedDevice);
   pDevice->AttachWithRgbByteOrder(pBitmap, !!(flags & FPDF_REVERSE_BYTE_ORDER));
 
-  CPDFSDK_PauseAdapter pause_adapter(pause);
+  pContext->m_Deadline = CPDFSDK_PauseAdapter::GetDeadline(pause);
+  CPDFSDK_PauseAdapter pause_adapter(pause, pContext->m_Deadline);
   CPDFSDK_RenderPageWithContext(pContext, pPage, start_x, start_y, size_x,
                                 size_y, rotate, flags, color_scheme,
                                 /*need_to_restore=*/false, &pause_adapter);
@@ -98,7 +155,7 @@ FPDF_EXPORT int FPDF_CALLCONV FPDF_RenderPageBitmap_Start(FPDF_BITMAP bitmap,
 
 FPDF_EXPORT int FPDF_CALLCONV FPDF_RenderPage_Continue(FPDF_PAGE page,
                                                        IFSDK_PAUSE* pause) {
-  if (!pause || pause->version != 1)
+  if (!IsValidPause(pause))
     return FPDF_RENDER_FAILED;
 
   CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
@@ -110,7 +167,7 @@ FPDF_EXPORT int FPDF_CALLCONV FPDF_RenderPage_Continue(FPDF_PAGE page,
   if (!pContext || !pContext->m_pRenderer)
     return FPDF_RENDER_FAILED;
 
-  CPDFSDK_PauseAdapter pause_adapter(pause);
+  CPDFSDK_PauseAdapter pause_adapter(pause, pContext->m_Deadline);
   pContext->m_pRenderer->Continue(&pause_adapter);
 
 #if defined(_SKIA_SUPPORT_)
@@ -126,3 +183,79 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPage_Close(FPDF_PAGE page) {
   if (pPage)
     pPage->ClearRenderContext();
 }
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderPage_GetScratchPixels(FPDF_PAGE page,
+                                 unsigned long long* allocated_pixels,
+                                 unsigned long long* touched_pixels) {
+  if (!allocated_pixels || !touched_pixels)
+    return false;
+
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!pPage)
+    return false;
+
+  auto* pContext =
+      static_cast<CPDF_PageRenderContext*>(pPage->GetRenderContext());
+  if (!pContext || !pContext->m_pContext)
+    return false;
+
+  const CPDF_RenderContext::ScratchStats* pStats =
+      pContext->m_pContext->GetScratchStats();
+  *allocated_pixels = pStats->allocated_pixels;
+  *touched_pixels = pStats->touched_pixels;
+  return true;
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderPage_GetPhaseProfile(FPDF_PAGE page,
+                                int phase,
+                                FPDF_RENDER_PROFILE_STATS* stats) {
+  if (!stats || phase < 0 ||
+      phase > static_cast<int>(CFX_RenderProfile::Phase::kLast)) {
+    return false;
+  }
+
+  const CFX_RenderProfile* pProfile = GetRenderProfile(page);
+  if (!pProfile)
+    return false;
+
+  ToFPDFProfileStats(
+      pProfile->GetPhaseStats(static_cast<CFX_RenderProfile::Phase>(phase)),
+      stats);
+  return true;
+}
+
+FPDF_EXPORT int FPDF_CALLCONV
+FPDF_RenderPage_CountProfiledObjects(FPDF_PAGE page) {
+  const CFX_RenderProfile* pProfile = GetRenderProfile(page);
+  if (!pProfile)
+    return -1;
+
+  return pdfium::base::checked_cast<int>(pProfile->GetObjectStats().size());
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderPage_GetObjectProfile(FPDF_PAGE page,
+                                 int index,
+                                 int* layer,
+                                 int* object_index,
+                                 FPDF_RENDER_PROFILE_STATS* stats) {
+  if (!layer || !object_index || !stats || index < 0)
+    return false;
+
+  const CFX_RenderProfile* pProfile = GetRenderProfile(page);
+  if (!pProfile)
+    return false;
+
+  pdfium::span<const CFX_RenderProfile::ObjectStats> objects =
+      pProfile->GetObjectStats();
+  if (static_cast<size_t>(index) >= objects.size())
+    return false;
+
+  const CFX_RenderProfile::ObjectStats& object = objects[index];
+  *layer = pdfium::base::checked_cast<int>(object.layer);
+  *object_index = pdfium::base::checked_cast<int>(object.index);
+  ToFPDFProfileStats(object.stats, stats);
+  return true;
+}
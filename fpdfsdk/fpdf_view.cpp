@@ -6,6 +6,7 @@
 
 #include "public/fpdfview.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -17,6 +18,7 @@
 #include "core/fpdfapi/page/cpdf_pageimagecache.h"
 #include "core/fpdfapi/page/cpdf_pagemodule.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_decodedstreamcache.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
@@ -30,7 +32,10 @@
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfdoc/cpdf_nametree.h"
 #include "core/fpdfdoc/cpdf_viewerpreferences.h"
+#include "core/fxcrt/cfx_memoryaccount.h"
 #include "core/fxcrt/cfx_read_only_span_stream.h"
+#include "core/fxcrt/cfx_threadpool.h"
+#include "core/fxcrt/cfx_tracelog.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/fx_stream.h"
 #include "core/fxcrt/fx_system.h"
@@ -116,6 +121,47 @@ namespace {
 
 bool g_bLibraryInitialized = false;
 
+class EmbedderThreadPool final : public CFX_ThreadPool {
+ public:
+  explicit EmbedderThreadPool(FPDF_THREAD_POOL* pool) : pool_(pool) {}
+  ~EmbedderThreadPool() override = default;
+
+  // CFX_ThreadPool:
+  size_t GetMaxConcurrency() const override {
+    return std::max(pool_->GetMaxConcurrency(pool_), 0);
+  }
+
+  void PostTask(Task task) override {
+    pool_->PostTask(pool_, &RunTask, new Task(std::move(task)));
+  }
+
+ private:
+  static void RunTask(void* task_data) {
+    std::unique_ptr<Task> task(static_cast<Task*>(task_data));
+    (*task)();
+  }
+
+  UnownedPtr<FPDF_THREAD_POOL> const pool_;
+};
+
+absl::optional<CFX_MemoryAccount::Category> MemoryCategoryFromPublic(
+    int category) {
+  switch (category) {
+    case FPDF_MEMORY_CATEGORY_PARSER:
+      return CFX_MemoryAccount::Category::kParser;
+    case FPDF_MEMORY_CATEGORY_DECODED_STREAMS:
+      return CFX_MemoryAccount::Category::kDecodedStreams;
+    case FPDF_MEMORY_CATEGORY_PAGE_OBJECTS:
+      return CFX_MemoryAccount::Category::kPageObjects;
+    case FPDF_MEMORY_CATEGORY_IMAGE_CACHES:
+      return CFX_MemoryAccount::Category::kImageCaches;
+    case FPDF_MEMORY_CATEGORY_GLYPH_CACHES:
+      return CFX_MemoryAccount::Category::kGlyphCaches;
+    default:
+      return absl::nullopt;
+  }
+}
+
 void UseRendererType(FPDF_RENDERER_TYPE public_type) {
   // Internal definition of renderer types must stay updated with respect to
   // the public definition, such that all public definitions can be mapped to
@@ -225,6 +271,15 @@ FPDF_InitLibraryWithConfig(const FPDF_LIBRARY_CONFIG* config) {
   CFX_GEModule::Create(config ? config->m_pUserFontPaths : nullptr);
   CPDF_PageModule::Create();
 
+  std::unique_ptr<CFX_ThreadPool> thread_pool;
+  // Pools with an unknown interface version are ignored, and the default pool
+  // is used instead.
+  if (config && config->version >= 5 && config->m_pThreadPool &&
+      config->m_pThreadPool->version == 1) {
+    thread_pool = std::make_unique<EmbedderThreadPool>(config->m_pThreadPool);
+  }
+  CFX_ThreadPool::Initialize(std::move(thread_pool));
+
 #ifdef PDF_ENABLE_XFA
   CPDFXFA_ModuleInit();
 #endif  // PDF_ENABLE_XFA
@@ -248,6 +303,7 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_DestroyLibrary() {
   CPDFXFA_ModuleDestroy();
 #endif  // PDF_ENABLE_XFA
 
+  CFX_ThreadPool::Destroy();
   CPDF_PageModule::Destroy();
   CFX_GEModule::Destroy();
   IJS_Runtime::Destroy();
@@ -272,6 +328,22 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_SetPrintMode(int mode) {
 }
 #endif  // BUILDFLAG(IS_WIN)
 
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_StartTracing() {
+#if defined(PDF_ENABLE_TRACE_EVENTS)
+  CFX_TraceLog::Get()->Start();
+  return true;
+#else
+  return false;
+#endif
+}
+
+FPDF_EXPORT unsigned long FPDF_CALLCONV FPDF_StopTracing(void* buffer,
+                                                        unsigned long buflen) {
+  CFX_TraceLog* log = CFX_TraceLog::Get();
+  log->Stop();
+  return NulTerminateMaybeCopyAndReturnLength(log->GetJSON(), buffer, buflen);
+}
+
 FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
 FPDF_LoadDocument(FPDF_STRING file_path, FPDF_BYTESTRING password) {
   // NOTE: the creation of the file needs to be by the embedder on the
@@ -1307,3 +1379,68 @@ FPDF_GetTrailerEnds(FPDF_DOCUMENT document,
 
   return trailer_ends_len;
 }
+
+FPDF_EXPORT unsigned long FPDF_CALLCONV
+FPDF_GetDecodedStreamCacheSize(FPDF_DOCUMENT document) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return 0;
+
+  CPDF_DocPageData* pPageData = CPDF_DocPageData::FromDocument(pDoc);
+  return pdfium::base::saturated_cast<unsigned long>(
+      pPageData->GetDecodedStreamCache()->GetCachedBytes());
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetDecodedStreamCacheLimit(FPDF_DOCUMENT document,
+                                unsigned long max_bytes) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return false;
+
+  CPDF_DocPageData::FromDocument(pDoc)->GetDecodedStreamCache()->SetByteBudget(
+      pdfium::base::saturated_cast<size_t>(max_bytes));
+  return true;
+}
+
+FPDF_EXPORT unsigned long FPDF_CALLCONV
+FPDF_GetDocumentMemoryUsage(FPDF_DOCUMENT document, int category) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return 0;
+
+  CFX_MemoryAccount* pAccount = pDoc->GetMemoryAccount();
+  if (category == FPDF_MEMORY_CATEGORY_TOTAL) {
+    return pdfium::base::saturated_cast<unsigned long>(
+        pAccount->GetTotalUsage());
+  }
+
+  absl::optional<CFX_MemoryAccount::Category> internal_category =
+      MemoryCategoryFromPublic(category);
+  if (!internal_category.has_value())
+    return 0;
+
+  return pdfium::base::saturated_cast<unsigned long>(
+      pAccount->GetUsage(internal_category.value()));
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetDocumentMemoryLimit(FPDF_DOCUMENT document, unsigned long limit) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return false;
+
+  pDoc->GetMemoryAccount()->SetLimit(
+      pdfium::base::saturated_cast<size_t>(limit));
+  return true;
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetImagePrefetch(FPDF_DOCUMENT document, FPDF_BOOL enable) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return false;
+
+  CPDF_DocRenderData::FromDocument(pDoc)->SetPrefetchImages(!!enable);
+  return true;
+}
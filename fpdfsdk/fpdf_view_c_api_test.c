@@ -341,6 +341,10 @@ int CheckPDFiumCApi() {
     CHK(FPDF_RenderPageBitmap_Start);
     CHK(FPDF_RenderPage_Close);
     CHK(FPDF_RenderPage_Continue);
+    CHK(FPDF_RenderPage_CountProfiledObjects);
+    CHK(FPDF_RenderPage_GetObjectProfile);
+    CHK(FPDF_RenderPage_GetPhaseProfile);
+    CHK(FPDF_RenderPage_GetScratchPixels);
 
     // fpdf_save.h
     CHK(FPDF_SaveAsCopy);
@@ -483,7 +487,9 @@ int CheckPDFiumCApi() {
 #ifdef PDF_ENABLE_V8
     CHK(FPDF_GetArrayBufferAllocatorSharedInstance);
 #endif
+    CHK(FPDF_GetDecodedStreamCacheSize);
     CHK(FPDF_GetDocPermissions);
+    CHK(FPDF_GetDocumentMemoryUsage);
     CHK(FPDF_GetFileVersion);
     CHK(FPDF_GetLastError);
     CHK(FPDF_GetNamedDest);
@@ -520,10 +526,15 @@ int CheckPDFiumCApi() {
 #if defined(_SKIA_SUPPORT_)
     CHK(FPDF_RenderPageSkp);
 #endif
+    CHK(FPDF_SetDecodedStreamCacheLimit);
+    CHK(FPDF_SetDocumentMemoryLimit);
+    CHK(FPDF_SetImagePrefetch);
 #if defined(_WIN32)
     CHK(FPDF_SetPrintMode);
 #endif
     CHK(FPDF_SetSandBoxPolicy);
+    CHK(FPDF_StartTracing);
+    CHK(FPDF_StopTracing);
     CHK(FPDF_VIEWERREF_GetDuplex);
     CHK(FPDF_VIEWERREF_GetName);
     CHK(FPDF_VIEWERREF_GetNumCopies);
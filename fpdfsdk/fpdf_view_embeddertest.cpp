@@ -16,6 +16,7 @@
 #include "fpdfsdk/cpdfsdk_helpers.h"
 #include "fpdfsdk/fpdf_view_c_api_test.h"
 #include "public/cpp/fpdf_scopers.h"
+#include "public/fpdf_edit.h"
 #include "public/fpdfview.h"
 #include "testing/embedder_test.h"
 #include "testing/embedder_test_constants.h"
@@ -109,6 +110,32 @@ class MockDownloadHints final : public FX_DOWNLOADHINTS {
   ~MockDownloadHints() = default;
 };
 
+// Runs tasks synchronously and counts them.
+class CountingThreadPool final : public FPDF_THREAD_POOL {
+ public:
+  static int SGetMaxConcurrency(FPDF_THREAD_POOL* pThis) { return 1; }
+
+  static void SPostTask(FPDF_THREAD_POOL* pThis,
+                        void (*task)(void* task_data),
+                        void* task_data) {
+    ++static_cast<CountingThreadPool*>(pThis)->task_count_;
+    task(task_data);
+  }
+
+  explicit CountingThreadPool(int pool_version) {
+    FPDF_THREAD_POOL::version = pool_version;
+    FPDF_THREAD_POOL::GetMaxConcurrency = SGetMaxConcurrency;
+    FPDF_THREAD_POOL::PostTask = SPostTask;
+  }
+
+  ~CountingThreadPool() = default;
+
+  int task_count() const { return task_count_; }
+
+ private:
+  int task_count_ = 0;
+};
+
 #if defined(_SKIA_SUPPORT_)
 ScopedFPDFBitmap SkImageToPdfiumBitmap(const SkImage& image) {
   ScopedFPDFBitmap bitmap(
@@ -1415,6 +1442,226 @@ TEST_F(FPDFViewEmbedderTest, DocumentHasInvalidCrossReferenceTable) {
   EXPECT_FALSE(FPDF_DocumentHasValidCrossReferenceTable(document()));
 }
 
+TEST_F(FPDFViewEmbedderTest, DecodedStreamCache) {
+  EXPECT_EQ(0u, FPDF_GetDecodedStreamCacheSize(nullptr));
+  EXPECT_FALSE(FPDF_SetDecodedStreamCacheLimit(nullptr, 0));
+
+  // The stamp appearance is a compressed form XObject.
+  ASSERT_TRUE(OpenDocument("annotation_stamp_with_ap.pdf"));
+  EXPECT_EQ(0u, FPDF_GetDecodedStreamCacheSize(document()));
+
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  RenderLoadedPageWithFlags(page, FPDF_ANNOT);
+  unsigned long cache_size = FPDF_GetDecodedStreamCacheSize(document());
+  EXPECT_GT(cache_size, 0u);
+
+  // Rendering again reuses the cached data.
+  RenderLoadedPageWithFlags(page, FPDF_ANNOT);
+  EXPECT_EQ(cache_size, FPDF_GetDecodedStreamCacheSize(document()));
+
+  EXPECT_TRUE(FPDF_SetDecodedStreamCacheLimit(document(), 0));
+  EXPECT_EQ(0u, FPDF_GetDecodedStreamCacheSize(document()));
+  RenderLoadedPageWithFlags(page, FPDF_ANNOT);
+  EXPECT_EQ(0u, FPDF_GetDecodedStreamCacheSize(document()));
+  UnloadPage(page);
+}
+
+TEST_F(FPDFViewEmbedderTest, DocumentMemoryLimit) {
+  EXPECT_EQ(0u,
+            FPDF_GetDocumentMemoryUsage(nullptr, FPDF_MEMORY_CATEGORY_TOTAL));
+  EXPECT_FALSE(FPDF_SetDocumentMemoryLimit(nullptr, 0));
+
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  EXPECT_GT(
+      FPDF_GetDocumentMemoryUsage(document(), FPDF_MEMORY_CATEGORY_PARSER), 0u);
+  EXPECT_EQ(0u, FPDF_GetDocumentMemoryUsage(document(), -1));
+  EXPECT_EQ(0u, FPDF_GetDocumentMemoryUsage(document(), 6));
+
+  {
+    FPDF_PAGE page = LoadPage(0);
+    ASSERT_TRUE(page);
+    EXPECT_GT(FPDF_GetDocumentMemoryUsage(document(),
+                                          FPDF_MEMORY_CATEGORY_PAGE_OBJECTS),
+              0u);
+    unsigned long sum = 0;
+    for (int category = FPDF_MEMORY_CATEGORY_PARSER;
+         category <= FPDF_MEMORY_CATEGORY_GLYPH_CACHES; ++category) {
+      sum += FPDF_GetDocumentMemoryUsage(document(), category);
+    }
+    EXPECT_EQ(sum, FPDF_GetDocumentMemoryUsage(document(),
+                                               FPDF_MEMORY_CATEGORY_TOTAL));
+    UnloadPage(page);
+  }
+  EXPECT_EQ(0u, FPDF_GetDocumentMemoryUsage(document(),
+                                            FPDF_MEMORY_CATEGORY_PAGE_OBJECTS));
+
+  // Over the limit, the page still loads, but its content is not parsed.
+  EXPECT_TRUE(FPDF_SetDocumentMemoryLimit(document(), 1));
+  {
+    FPDF_PAGE page = LoadPage(0);
+    ASSERT_TRUE(page);
+    EXPECT_EQ(0u, FPDF_GetDocumentMemoryUsage(
+                      document(), FPDF_MEMORY_CATEGORY_PAGE_OBJECTS));
+    UnloadPage(page);
+  }
+
+  EXPECT_TRUE(FPDF_SetDocumentMemoryLimit(document(), 0));
+  {
+    FPDF_PAGE page = LoadPage(0);
+    ASSERT_TRUE(page);
+    EXPECT_GT(FPDF_GetDocumentMemoryUsage(document(),
+                                          FPDF_MEMORY_CATEGORY_PAGE_OBJECTS),
+              0u);
+    UnloadPage(page);
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, ImagePrefetch) {
+  EXPECT_FALSE(FPDF_SetImagePrefetch(nullptr, true));
+
+  ASSERT_TRUE(OpenDocument("embedded_images.pdf"));
+  std::string expected_hash;
+  {
+    FPDF_PAGE page = LoadPage(0);
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+    expected_hash = HashBitmap(bitmap.get());
+    UnloadPage(page);
+  }
+
+  // Prefetched images render the same as images decoded on demand.
+  EXPECT_TRUE(FPDF_SetImagePrefetch(document(), true));
+  {
+    FPDF_PAGE page = LoadPage(0);
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+    EXPECT_EQ(expected_hash, HashBitmap(bitmap.get()));
+    UnloadPage(page);
+  }
+  EXPECT_TRUE(FPDF_SetImagePrefetch(document(), false));
+}
+
+TEST_F(FPDFViewEmbedderTest, EmbedderThreadPool) {
+  EmbedderTestEnvironment::GetInstance()->TearDown();
+
+  CountingThreadPool pool(/*pool_version=*/1);
+  CountingThreadPool unsupported_pool(/*pool_version=*/2);
+  for (CountingThreadPool* config_pool : {&pool, &unsupported_pool}) {
+    FPDF_LIBRARY_CONFIG config = {};
+    config.version = 5;
+    config.m_RendererType = FPDF_RENDERERTYPE_AGG;
+    config.m_pThreadPool = config_pool;
+    FPDF_InitLibraryWithConfig(&config);
+
+    ASSERT_TRUE(OpenDocument("embedded_images.pdf"));
+    EXPECT_TRUE(FPDF_SetImagePrefetch(document(), true));
+    FPDF_PAGE page = LoadPage(0);
+    ASSERT_TRUE(page);
+    RenderLoadedPage(page);
+    UnloadPage(page);
+    CloseDocument();
+    FPDF_DestroyLibrary();
+  }
+
+  // Prefetching ran on the embedder's pool, limited to the one image the
+  // pool can decode at a time, and a pool with an unknown version was not
+  // used.
+  EXPECT_EQ(1, pool.task_count());
+  EXPECT_EQ(0, unsupported_pool.task_count());
+
+  // Puts the test environment back the way it was.
+  EmbedderTestEnvironment::GetInstance()->SetUp();
+}
+
+TEST_F(FPDFViewEmbedderTest, Tracing) {
+#if defined(PDF_ENABLE_TRACE_EVENTS)
+  ASSERT_TRUE(FPDF_StartTracing());
+#else
+  EXPECT_FALSE(FPDF_StartTracing());
+#endif
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+  UnloadPage(page);
+
+  unsigned long length = FPDF_StopTracing(nullptr, 0);
+  ASSERT_GT(length, 0u);
+  std::vector<char> buffer(length);
+  EXPECT_EQ(length, FPDF_StopTracing(buffer.data(), length));
+  EXPECT_EQ('\0', buffer.back());
+  std::string json(buffer.data());
+  EXPECT_EQ(0u, json.find("{\"traceEvents\":["));
+#if defined(PDF_ENABLE_TRACE_EVENTS)
+  EXPECT_NE(std::string::npos, json.find("CPDF_Parser::StartParse"));
+  EXPECT_NE(std::string::npos, json.find("CPDF_ContentParser::Parse"));
+  EXPECT_NE(std::string::npos,
+            json.find("CPDF_RenderStatus::ContinueSingleObject"));
+  EXPECT_NE(std::string::npos, json.find("CFX_Font::Load"));
+#else
+  EXPECT_EQ(std::string::npos, json.find("\"name\""));
+#endif
+}
+
+TEST_F(FPDFViewEmbedderTest, RenderCachedForms) {
+  ASSERT_TRUE(OpenDocument("form_object.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  std::string expected_hash;
+  {
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+    expected_hash = HashBitmap(bitmap.get());
+  }
+
+  // The first render rasterizes the form, the second one reuses it.
+  for (int i = 0; i < 2; ++i) {
+    ScopedFPDFBitmap bitmap =
+        RenderLoadedPageWithFlags(page, FPDF_RENDER_CACHE_FORMS);
+    EXPECT_EQ(expected_hash, HashBitmap(bitmap.get()));
+  }
+
+  // Regenerating the content drops the cached form.
+  EXPECT_TRUE(FPDFPage_GenerateContent(page));
+  {
+    ScopedFPDFBitmap bitmap =
+        RenderLoadedPageWithFlags(page, FPDF_RENDER_CACHE_FORMS);
+    EXPECT_EQ(expected_hash, HashBitmap(bitmap.get()));
+  }
+  UnloadPage(page);
+}
+
+TEST_F(FPDFViewEmbedderTest, RenderSharedSoftMask) {
+  ASSERT_TRUE(OpenDocument("shared_soft_mask.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  std::string expected_hash;
+  {
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+    expected_hash = HashBitmap(bitmap.get());
+  }
+  {
+    // All four rectangles now get the cached soft mask.
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+    EXPECT_EQ(expected_hash, HashBitmap(bitmap.get()));
+  }
+
+  // Half resolution soft masks blur the mask edges.
+  std::string lowres_hash;
+  {
+    ScopedFPDFBitmap bitmap =
+        RenderLoadedPageWithFlags(page, FPDF_RENDER_LOWRES_SOFTMASKS);
+    lowres_hash = HashBitmap(bitmap.get());
+    EXPECT_NE(expected_hash, lowres_hash);
+  }
+  {
+    ScopedFPDFBitmap bitmap =
+        RenderLoadedPageWithFlags(page, FPDF_RENDER_LOWRES_SOFTMASKS);
+    EXPECT_EQ(lowres_hash, HashBitmap(bitmap.get()));
+  }
+  UnloadPage(page);
+}
+
 // Related to https://crbug.com/pdfium/1197
 TEST_F(FPDFViewEmbedderTest, LoadDocumentWithEmptyXRefConsistently) {
   ASSERT_TRUE(OpenDocument("empty_xref.pdf"));
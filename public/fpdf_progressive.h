@@ -16,6 +16,20 @@
 #define FPDF_RENDER_TOBECONTINUED 1
 #define FPDF_RENDER_DONE 2
 #define FPDF_RENDER_FAILED 3
+// Experimental API.
+// Rendering gave up early, as requested through IFSDK_PAUSE version 2.
+#define FPDF_RENDER_CANCELLED 4
+
+// Render phases reported by FPDF_RenderPage_GetPhaseProfile().
+#define FPDF_RENDER_PHASE_PARSE 0
+#define FPDF_RENDER_PHASE_RESOURCE_LOAD 1
+#define FPDF_RENDER_PHASE_IMAGE_DECODE 2
+#define FPDF_RENDER_PHASE_STRETCH 3
+#define FPDF_RENDER_PHASE_COMPOSITE 4
+#define FPDF_RENDER_PHASE_TEXT 5
+#define FPDF_RENDER_PHASE_PATH 6
+#define FPDF_RENDER_PHASE_SHADING 7
+#define FPDF_RENDER_PHASE_TRANSPARENCY 8
 
 #ifdef __cplusplus
 extern "C" {
@@ -24,7 +38,7 @@ extern "C" {
 // IFPDF_RENDERINFO interface.
 typedef struct _IFSDK_PAUSE {
   /*
-   * Version number of the interface. Currently must be 1.
+   * Version number of the interface. Currently must be 1 or 2.
    */
   int version;
 
@@ -44,6 +58,40 @@ typedef struct _IFSDK_PAUSE {
 
   // A user defined data pointer, used by user's application. Can be NULL.
   void* user;
+
+  /*
+   * Method: NeedToCancelNow
+   *           Experimental API.
+   *           Check if we need to give up a progressive process altogether.
+   *           Unlike NeedToPauseNow(), this is also called in the middle of
+   *           long-running operations that cannot be paused, like decoding
+   *           and scaling large images, drawing shadings and filling large
+   *           paths. It may be called often, so it should be cheap, e.g.
+   *           read a flag that another thread sets. Once it returns
+   *           non-zero, it should keep doing so. The rendering then stops as
+   *           soon as possible, leaves the bitmap partially rendered, and
+   *           reports FPDF_RENDER_CANCELLED.
+   * Interface Version:
+   *           2
+   * Implementation Required:
+   *           no
+   * Parameters:
+   *           pThis       -   Pointer to the interface structure itself
+   * Return Value:
+   *           Non-zero for cancel now, 0 for continue.
+   */
+  FPDF_BOOL (*NeedToCancelNow)(struct _IFSDK_PAUSE* pThis);
+
+  /*
+   * Experimental API.
+   * Interface Version 2 and later. Wall-clock time limit of the whole
+   * rendering in milliseconds, counted from the call to
+   * FPDF_RenderPageBitmap_Start() or
+   * FPDF_RenderPageBitmapWithColorScheme_Start(), which are the only
+   * functions that read it. Once the time limit passes, the rendering is
+   * cancelled as if NeedToCancelNow() returned non-zero. 0 for no limit.
+   */
+  unsigned long deadline_ms;
 } IFSDK_PAUSE;
 
 // Experimental API.
@@ -152,6 +200,101 @@ FPDF_EXPORT int FPDF_CALLCONV FPDF_RenderPage_Continue(FPDF_PAGE page,
 //          None.
 FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPage_Close(FPDF_PAGE page);
 
+// Experimental API.
+// Function: FPDF_RenderPage_GetScratchPixels
+//          Get how many pixels of scratch bitmaps the rendering of |page| has
+//          allocated so far for transparency groups, and how many of those
+//          the groups actually painted.
+// Parameters:
+//          page             -  Handle to the page, as returned by
+//                              FPDF_LoadPage().
+//          allocated_pixels -  Receives the number of pixels in the bitmaps
+//                              allocated for transparency groups, their
+//                              backdrops and their text clip masks.
+//          touched_pixels   -  Receives the number of pixels in the group
+//                              bitmaps that are not fully transparent. This
+//                              is only counted if FPDF_RENDER_PROFILE was
+//                              passed to FPDF_RenderPageBitmap_Start(), and
+//                              is 0 otherwise.
+// Return value:
+//          True on success. False if an out parameter is NULL, or if |page|
+//          is not being rendered, i.e. if FPDF_RenderPageBitmap_Start() was
+//          not called or FPDF_RenderPage_Close() already was.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderPage_GetScratchPixels(FPDF_PAGE page,
+                                 unsigned long long* allocated_pixels,
+                                 unsigned long long* touched_pixels);
+
+// Experimental API.
+// What a render phase or a page object took during a profiled rendering.
+typedef struct FPDF_RENDER_PROFILE_STATS_ {
+  // For phases, how many times the phase was entered. For page objects, how
+  // many times rendering the object was started or resumed.
+  unsigned long long calls;
+  // Wall clock time, in nanoseconds.
+  unsigned long long time_ns;
+  // Allocations made through PDFium's own allocators on the rendering thread.
+  unsigned long long allocations;
+} FPDF_RENDER_PROFILE_STATS;
+
+// Experimental API.
+// Function: FPDF_RenderPage_GetPhaseProfile
+//          Get what the rendering of |page| has spent in a phase so far. This
+//          requires FPDF_RENDER_PROFILE in the flags that started the
+//          rendering. Phases nest, e.g. images get decoded while they get
+//          stretched, and each phase only gets what its nested phases do not
+//          account for.
+// Parameters:
+//          page        -   Handle to the page, as returned by FPDF_LoadPage().
+//          phase       -   One of the FPDF_RENDER_PHASE_* values.
+//          stats       -   Receives the stats of the phase.
+// Return value:
+//          True on success. False if |phase| is unknown, if |stats| is NULL,
+//          or if |page| is not being rendered with FPDF_RENDER_PROFILE.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderPage_GetPhaseProfile(FPDF_PAGE page,
+                                int phase,
+                                FPDF_RENDER_PROFILE_STATS* stats);
+
+// Experimental API.
+// Function: FPDF_RenderPage_CountProfiledObjects
+//          Get how many top-level page objects the rendering of |page| has
+//          rendered so far with FPDF_RENDER_PROFILE.
+// Parameters:
+//          page        -   Handle to the page, as returned by FPDF_LoadPage().
+// Return value:
+//          The number of objects, or -1 if |page| is not being rendered with
+//          FPDF_RENDER_PROFILE.
+FPDF_EXPORT int FPDF_CALLCONV
+FPDF_RenderPage_CountProfiledObjects(FPDF_PAGE page);
+
+// Experimental API.
+// Function: FPDF_RenderPage_GetObjectProfile
+//          Get what rendering a top-level page object took, including all
+//          of its phases.
+// Parameters:
+//          page         -  Handle to the page, as returned by FPDF_LoadPage().
+//          index        -  Index of the profiled object, from 0 to
+//                          FPDF_RenderPage_CountProfiledObjects() - 1, in the
+//                          order the objects were rendered.
+//          layer        -  Receives 0 for objects of the page contents. With
+//                          FPDF_ANNOT, the appearance of each annotation gets
+//                          rendered as a following layer.
+//          object_index -  Receives the index of the object within its
+//                          layer. For layer 0, this is the index to pass to
+//                          FPDFPage_GetObject().
+//          stats        -  Receives the stats of the object.
+// Return value:
+//          True on success. False if |index| is out of range, if an out
+//          parameter is NULL, or if |page| is not being rendered with
+//          FPDF_RENDER_PROFILE.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderPage_GetObjectProfile(FPDF_PAGE page,
+                                 int index,
+                                 int* layer,
+                                 int* object_index,
+                                 FPDF_RENDER_PROFILE_STATS* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -243,6 +243,37 @@ typedef enum {
   FPDF_RENDERERTYPE_SKIA = 1,
 } FPDF_RENDERER_TYPE;
 
+// Experimental API.
+// Interface for running PDFium's parallel work on an embedder's threads.
+typedef struct _FPDF_THREAD_POOL {
+  // Version number of the interface. Must be 1.
+  int version;
+
+  // Reports how many tasks the pool can run at the same time, not counting
+  // the thread that posts them. PDFium uses this to decide how to split work.
+  //
+  // Interface Version: 1
+  // Implementation Required: Yes
+  //
+  //   pThis - pointer to the interface structure.
+  //
+  // Returns the number of tasks that may run concurrently.
+  int (*GetMaxConcurrency)(struct _FPDF_THREAD_POOL* pThis);
+
+  // Schedules a task. The pool must call |task| with |task_data| exactly
+  // once, on any thread, and may do so before PostTask() returns.
+  //
+  // Interface Version: 1
+  // Implementation Required: Yes
+  //
+  //   pThis     - pointer to the interface structure.
+  //   task      - the function to run.
+  //   task_data - the argument to pass to |task|.
+  void (*PostTask)(struct _FPDF_THREAD_POOL* pThis,
+                   void (*task)(void* task_data),
+                   void* task_data);
+} FPDF_THREAD_POOL;
+
 // Process-wide options for initializing the library.
 typedef struct FPDF_LIBRARY_CONFIG_ {
   // Version number of the interface. Currently must be 2.
@@ -281,6 +312,14 @@ typedef struct FPDF_LIBRARY_CONFIG_ {
   // fail with an immediate crash.
   FPDF_RENDERER_TYPE m_RendererType;
 
+  // Version 5 - Experimental.
+
+  // Pool to run PDFium's parallel work on, or NULL to let PDFium start its
+  // own threads when it first needs them. The pool must stay valid until
+  // FPDF_DestroyLibrary() returns. A pool whose |version| is not supported is
+  // ignored, as if NULL had been passed.
+  FPDF_THREAD_POOL* m_pThreadPool;
+
 } FPDF_LIBRARY_CONFIG;
 
 // Function: FPDF_InitLibraryWithConfig
@@ -351,6 +390,37 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_SetSandBoxPolicy(FPDF_DWORD policy,
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_SetPrintMode(int mode);
 #endif  // defined(_WIN32)
 
+// Experimental API.
+// Function: FPDF_StartTracing
+//          Start recording trace events, such as page parsing, rendering of
+//          page objects and image decoding. The events of any previous
+//          recording are discarded.
+// Return value:
+//          True if PDFium was built with trace events, i.e. with the
+//          pdf_enable_trace_events build flag. Otherwise, no events get
+//          recorded and false is returned.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_StartTracing();
+
+// Experimental API.
+// Function: FPDF_StopTracing
+//          Stop recording trace events and get the recorded events, as JSON in
+//          the trace event format of Chrome's trace viewer and Perfetto.
+// Parameters:
+//          buffer  -   A buffer for the NUL-terminated JSON. May be NULL.
+//          buflen  -   The length of |buffer|, in bytes.
+// Return value:
+//          The number of bytes in the JSON, including the NUL terminator.
+// Comments:
+//          If |buflen| is less than the returned length, or |buffer| is NULL,
+//          |buffer| will not be modified. The events stay available until the
+//          next FPDF_StartTracing() call, so calling this function again gets
+//          the same JSON.
+//
+//          Timestamps are in microseconds of the same monotonic clock that
+//          Chrome uses, so the trace can be merged with the embedder's.
+FPDF_EXPORT unsigned long FPDF_CALLCONV FPDF_StopTracing(void* buffer,
+                                                        unsigned long buflen);
+
 // Function: FPDF_LoadDocument
 //          Open and load a PDF document.
 // Parameters:
@@ -639,6 +709,97 @@ FPDF_GetTrailerEnds(FPDF_DOCUMENT document,
                     unsigned int* buffer,
                     unsigned long length);
 
+// Experimental API.
+// Function: FPDF_GetDecodedStreamCacheSize
+//          Get the amount of decoded stream data the document keeps cached
+//          for resources shared between pages, such as form XObjects, soft
+//          masks, ICC profiles and mesh shadings.
+// Parameters:
+//          document    -   Handle to a document. Returned by FPDF_LoadDocument.
+// Return value:
+//          The size of the cached data in bytes, or 0 on error.
+FPDF_EXPORT unsigned long FPDF_CALLCONV
+FPDF_GetDecodedStreamCacheSize(FPDF_DOCUMENT document);
+
+// Experimental API.
+// Function: FPDF_SetDecodedStreamCacheLimit
+//          Set the maximum amount of decoded stream data the document keeps
+//          cached. Least recently used data is released first.
+// Parameters:
+//          document    -   Handle to a document. Returned by FPDF_LoadDocument.
+//          max_bytes   -   The cache budget in bytes. 0 disables the cache.
+// Return value:
+//          True on success.
+// Comments:
+//          Data still used by loaded pages is released once those pages no
+//          longer need it.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetDecodedStreamCacheLimit(FPDF_DOCUMENT document,
+                                unsigned long max_bytes);
+
+// Memory categories for FPDF_GetDocumentMemoryUsage().
+#define FPDF_MEMORY_CATEGORY_TOTAL 0
+#define FPDF_MEMORY_CATEGORY_PARSER 1
+#define FPDF_MEMORY_CATEGORY_DECODED_STREAMS 2
+#define FPDF_MEMORY_CATEGORY_PAGE_OBJECTS 3
+#define FPDF_MEMORY_CATEGORY_IMAGE_CACHES 4
+#define FPDF_MEMORY_CATEGORY_GLYPH_CACHES 5
+
+// Experimental API.
+// Function: FPDF_GetDocumentMemoryUsage
+//          Get an estimate of the memory attributed to a document.
+// Parameters:
+//          document    -   Handle to a document. Returned by FPDF_LoadDocument.
+//          category    -   One of the FPDF_MEMORY_CATEGORY_* values.
+// Return value:
+//          The estimated number of bytes used for |category|, or 0 on error.
+// Comments:
+//          Parsed objects, decoded stream data, page objects of loaded pages,
+//          cached images and Type 3 glyph bitmaps are attributed to the
+//          document. Font glyph caches shared between documents are not.
+FPDF_EXPORT unsigned long FPDF_CALLCONV
+FPDF_GetDocumentMemoryUsage(FPDF_DOCUMENT document, int category);
+
+// Experimental API.
+// Function: FPDF_SetDocumentMemoryLimit
+//          Set a hard limit on the memory attributed to a document, as
+//          reported by FPDF_GetDocumentMemoryUsage() for
+//          FPDF_MEMORY_CATEGORY_TOTAL.
+// Parameters:
+//          document    -   Handle to a document. Returned by FPDF_LoadDocument.
+//          limit       -   The limit in bytes. 0 removes the limit.
+// Return value:
+//          True on success.
+// Comments:
+//          Once the limit is reached, cached data is released first. After
+//          that, objects that do not fit fail to load, content streams that
+//          would not fit are not decoded, page content parsing stops early,
+//          and cached images and glyphs that do not fit are skipped. Other
+//          allocations, such as font data and image decoder buffers, are not
+//          bounded by the limit, so it does not cap the process's memory use.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetDocumentMemoryLimit(FPDF_DOCUMENT document, unsigned long limit);
+
+// Experimental API.
+// Function: FPDF_SetImagePrefetch
+//          Set whether rendering a page starts decoding its images in the
+//          background up front, so the renderer does not have to decode them
+//          one after another.
+// Parameters:
+//          document    -   Handle to a document. Returned by FPDF_LoadDocument.
+//          enable      -   Whether to prefetch images. Off by default.
+// Return value:
+//          True on success.
+// Comments:
+//          Decoding runs on the thread pool given in FPDF_LIBRARY_CONFIG, or
+//          on PDFium's own threads if there is none. Only images drawn
+//          directly by the page content are prefetched, and JPEG 2000 and
+//          JBIG2 images are not. At most as many images as the pool's
+//          GetMaxConcurrency() are prefetched per page, in page order. Renders
+//          with FPDF_RENDER_DRAFT do not prefetch.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetImagePrefetch(FPDF_DOCUMENT document, FPDF_BOOL enable);
+
 // Function: FPDF_GetDocPermission
 //          Get file permission flags of the document.
 // Parameters:
@@ -808,6 +969,26 @@ FPDF_EXPORT int FPDF_CALLCONV FPDF_GetPageSizeByIndex(FPDF_DOCUMENT document,
 // FPDF_COLORSCHEME is passed in, since with a single fill color for paths the
 // boundaries of adjacent fill paths are less visible.
 #define FPDF_CONVERT_FILL_TO_STROKE 0x20
+// Experimental. Set to reuse the rasterized output of form XObjects that are
+// drawn repeatedly with the same scale and rotation, e.g. stamps and logos,
+// instead of drawing their contents each time. The output is cached per
+// document. Call FPDFPage_GenerateContent() after editing the contents of a
+// form XObject to drop stale output.
+#define FPDF_RENDER_CACHE_FORMS 0x8000
+// Experimental. Set to evaluate luminosity soft masks at half resolution and
+// scale them up, which makes soft mask edges blurrier but renders faster.
+#define FPDF_RENDER_LOWRES_SOFTMASKS 0x10000
+// Experimental. Set to render a quick draft of the page: no anti-aliasing,
+// images decoded at reduced resolution where the format allows it, shadings
+// that cover their whole clip filled with a single color, and transparency
+// groups drawn without their backdrops. To show a heavy page quickly, render a
+// draft first, then render the page again without this flag, e.g. with
+// FPDF_RenderPageBitmap_Start(), into a separate bitmap and swap it in once it
+// is done.
+#define FPDF_RENDER_DRAFT 0x20000
+// Experimental. Set to record where the time and allocations of a progressive
+// render go. See FPDF_RenderPage_GetPhaseProfile() in fpdf_progressive.h.
+#define FPDF_RENDER_PROFILE 0x40000
 
 // Struct for color scheme.
 // Each should be a 32-bit value specifying the color, in 8888 ARGB format.
@@ -7,6 +7,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <iterator>
 #include <map>
@@ -47,6 +49,7 @@
 #include <errhandlingapi.h>
 #include <io.h>
 #else
+#include <sys/resource.h>
 #include <unistd.h>
 #endif  // _WIN32
 
@@ -120,6 +123,8 @@ struct Options {
 
   bool show_config = false;
   bool show_metadata = false;
+  bool show_scratch_stats = false;
+  bool show_render_profile = false;
   bool send_events = false;
   bool use_load_mem_document = false;
   bool render_oneshot = false;
@@ -134,6 +139,9 @@ struct Options {
   bool no_smoothtext = false;
   bool no_smoothimage = false;
   bool no_smoothpath = false;
+  bool cache_forms = false;
+  bool lowres_softmasks = false;
+  bool draft = false;
   bool reverse_byte_order = false;
   bool save_attachments = false;
   bool save_images = false;
@@ -164,6 +172,8 @@ struct Options {
   std::string exe_path;
   std::string bin_directory;
   std::string font_directory;
+  std::string trace_filename;
+  std::string throughput_filename;
   int first_page = 0;  // First 0-based page number to renderer.
   int last_page = 0;   // Last 0-based page number to renderer.
   time_t time = -1;
@@ -191,6 +201,14 @@ int PageRenderFlagsFromOptions(const Options& options) {
     flags |= FPDF_RENDER_NO_SMOOTHIMAGE;
   if (options.no_smoothpath)
     flags |= FPDF_RENDER_NO_SMOOTHPATH;
+  if (options.cache_forms)
+    flags |= FPDF_RENDER_CACHE_FORMS;
+  if (options.lowres_softmasks)
+    flags |= FPDF_RENDER_LOWRES_SOFTMASKS;
+  if (options.draft)
+    flags |= FPDF_RENDER_DRAFT;
+  if (options.show_scratch_stats || options.show_render_profile)
+    flags |= FPDF_RENDER_PROFILE;
   if (options.reverse_byte_order)
     flags |= FPDF_REVERSE_BYTE_ORDER;
   return flags;
@@ -250,6 +268,115 @@ void OutputMD5Hash(const char* file_name, pdfium::span<const uint8_t> output) {
   printf("MD5:%s:%s\n", file_name, hash.c_str());
 }
 
+// Wall time spent on one file, split by phase, for --throughput.
+struct FileTimings {
+  double total_ms = 0;
+  double load_ms = 0;
+  double parse_ms = 0;
+  double render_ms = 0;
+  double text_ms = 0;
+  std::vector<double> page_ms;
+};
+
+// Adds the wall time of its lifetime to `*total_ms`.
+class ScopedPhaseTimer {
+ public:
+  explicit ScopedPhaseTimer(double* total_ms)
+      : total_ms_(total_ms), start_(std::chrono::steady_clock::now()) {}
+  ~ScopedPhaseTimer() {
+    *total_ms_ += std::chrono::duration<double, std::milli>(
+                      std::chrono::steady_clock::now() - start_)
+                      .count();
+  }
+
+ private:
+  double* const total_ms_;
+  const std::chrono::steady_clock::time_point start_;
+};
+
+// Returns the nearest-rank `percent` percentile of `sorted`.
+double GetPercentile(const std::vector<double>& sorted, size_t percent) {
+  if (sorted.empty())
+    return 0;
+  size_t rank = (sorted.size() * percent + 99) / 100;
+  return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+// Returns the peak resident set size of this process so far, in KiB.
+absl::optional<long> GetPeakRssKb() {
+#ifdef _WIN32
+  return absl::nullopt;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return absl::nullopt;
+#ifdef __APPLE__
+  // macOS reports bytes instead of KiB.
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif  // __APPLE__
+#endif  // _WIN32
+}
+
+std::string EscapeJsonString(const std::string& str) {
+  std::string escaped;
+  for (char ch : str) {
+    if (ch == '"' || ch == '\\') {
+      escaped += '\\';
+      escaped += ch;
+    } else if (static_cast<unsigned char>(ch) < 0x20) {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04x", ch);
+      escaped += buf;
+    } else {
+      escaped += ch;
+    }
+  }
+  return escaped;
+}
+
+// Appends `timings` to `filename` as one line of JSON. The peak RSS is the
+// high-water mark of the process, so it only belongs to `name` when each file
+// runs in its own process.
+void WriteThroughputStats(const std::string& filename,
+                          const std::string& name,
+                          const FileTimings& timings) {
+  FILE* fp = fopen(filename.c_str(), "ab");
+  if (!fp) {
+    fprintf(stderr, "Failed to open %s for output\n", filename.c_str());
+    return;
+  }
+
+  std::vector<double> sorted_page_ms = timings.page_ms;
+  std::sort(sorted_page_ms.begin(), sorted_page_ms.end());
+  const size_t pages = sorted_page_ms.size();
+  const double pages_per_sec =
+      timings.total_ms > 0 ? pages * 1000.0 / timings.total_ms : 0;
+
+  fprintf(fp, "{\"file\": \"%s\", \"pages\": %zu, \"total_ms\": %.3f",
+          EscapeJsonString(name).c_str(), pages, timings.total_ms);
+  fprintf(fp, ", \"pages_per_sec\": %.3f", pages_per_sec);
+  fprintf(fp, ", \"p50_ms\": %.3f, \"p95_ms\": %.3f, \"p99_ms\": %.3f",
+          GetPercentile(sorted_page_ms, 50), GetPercentile(sorted_page_ms, 95),
+          GetPercentile(sorted_page_ms, 99));
+  absl::optional<long> peak_rss_kb = GetPeakRssKb();
+  if (peak_rss_kb.has_value())
+    fprintf(fp, ", \"peak_rss_kb\": %ld", peak_rss_kb.value());
+  else
+    fprintf(fp, ", \"peak_rss_kb\": null");
+  fprintf(fp,
+          ", \"load_ms\": %.3f, \"parse_ms\": %.3f, \"render_ms\": %.3f"
+          ", \"text_ms\": %.3f",
+          timings.load_ms, timings.parse_ms, timings.render_ms,
+          timings.text_ms);
+  fprintf(fp, ", \"page_ms\": [");
+  for (size_t i = 0; i < timings.page_ms.size(); ++i)
+    fprintf(fp, "%s%.3f", i ? ", " : "", timings.page_ms[i]);
+  fprintf(fp, "]}\n");
+  fclose(fp);
+}
+
 #ifdef PDF_ENABLE_V8
 
 struct V8IsolateDeleter {
@@ -462,6 +589,16 @@ bool ParseCommandLine(const std::vector<std::string>& args,
       options->no_smoothimage = true;
     } else if (cur_arg == "--no-smoothpath") {
       options->no_smoothpath = true;
+    } else if (cur_arg == "--cache-forms") {
+      options->cache_forms = true;
+    } else if (cur_arg == "--lowres-softmasks") {
+      options->lowres_softmasks = true;
+    } else if (cur_arg == "--draft") {
+      options->draft = true;
+    } else if (cur_arg == "--show-scratch-stats") {
+      options->show_scratch_stats = true;
+    } else if (cur_arg == "--show-render-profile") {
+      options->show_render_profile = true;
     } else if (cur_arg == "--reverse-byte-order") {
       options->reverse_byte_order = true;
     } else if (cur_arg == "--save-attachments") {
@@ -635,6 +772,18 @@ bool ParseCommandLine(const std::vector<std::string>& args,
         return false;
       }
       options->password = value;
+    } else if (ParseSwitchKeyValue(cur_arg, "--trace=", &value)) {
+      if (!options->trace_filename.empty()) {
+        fprintf(stderr, "Duplicate --trace argument\n");
+        return false;
+      }
+      options->trace_filename = value;
+    } else if (ParseSwitchKeyValue(cur_arg, "--throughput=", &value)) {
+      if (!options->throughput_filename.empty()) {
+        fprintf(stderr, "Duplicate --throughput argument\n");
+        return false;
+      }
+      options->throughput_filename = value;
     } else if (ParseSwitchKeyValue(cur_arg, "--scale=", &value)) {
       if (!options->scale_factor_as_string.empty()) {
         fprintf(stderr, "Duplicate --scale argument\n");
@@ -916,14 +1065,18 @@ class ProgressiveBitmapPageRenderer : public BitmapPageRenderer {
                                 int flags,
                                 const std::function<void()>& idler,
                                 BitmapWriter writer,
-                                const FPDF_COLORSCHEME* color_scheme)
+                                const FPDF_COLORSCHEME* color_scheme,
+                                bool show_scratch_stats,
+                                bool show_render_profile)
       : BitmapPageRenderer(page,
                            /*width=*/width,
                            /*height=*/height,
                            /*flags=*/flags,
                            idler,
                            writer),
-        color_scheme_(color_scheme) {
+        color_scheme_(color_scheme),
+        show_scratch_stats_(show_scratch_stats),
+        show_render_profile_(show_render_profile) {
     pause_.version = 1;
     pause_.NeedToPauseNow = &NeedToPauseNow;
   }
@@ -951,12 +1104,71 @@ class ProgressiveBitmapPageRenderer : public BitmapPageRenderer {
 
   void Finish(FPDF_FORMHANDLE form) override {
     BitmapPageRenderer::Finish(form);
+    unsigned long long allocated_pixels;
+    unsigned long long touched_pixels;
+    if (show_scratch_stats_ &&
+        FPDF_RenderPage_GetScratchPixels(page(), &allocated_pixels,
+                                         &touched_pixels)) {
+      printf("Scratch pixels: %llu allocated, %llu touched\n",
+             allocated_pixels, touched_pixels);
+    }
+    if (show_render_profile_)
+      PrintRenderProfile();
     FPDF_RenderPage_Close(page());
     Idle();
   }
 
  private:
   const FPDF_COLORSCHEME* color_scheme_;
+  void PrintRenderProfile() {
+    // Indexed by FPDF_RENDER_PHASE_* values.
+    static constexpr const char* kPhaseNames[] = {
+        "parse", "resource load", "image decode", "stretch", "composite",
+        "text", "path", "shading", "transparency"};
+    printf("Render profile:\n");
+    for (size_t phase = 0; phase < std::size(kPhaseNames); ++phase) {
+      FPDF_RENDER_PROFILE_STATS stats;
+      if (!FPDF_RenderPage_GetPhaseProfile(page(), static_cast<int>(phase),
+                                           &stats)) {
+        return;
+      }
+
+      printf("  %s: %llu calls, %.3f ms, %llu allocations\n",
+             kPhaseNames[phase], stats.calls, stats.time_ns / 1e6,
+             stats.allocations);
+    }
+
+    // List the slowest objects, which are the ones worth looking into.
+    constexpr size_t kMaxObjects = 10;
+    struct ObjectProfile {
+      int layer;
+      int index;
+      FPDF_RENDER_PROFILE_STATS stats;
+    };
+    std::vector<ObjectProfile> objects;
+    const int object_count = FPDF_RenderPage_CountProfiledObjects(page());
+    for (int i = 0; i < object_count; ++i) {
+      ObjectProfile object;
+      if (FPDF_RenderPage_GetObjectProfile(page(), i, &object.layer,
+                                           &object.index, &object.stats)) {
+        objects.push_back(object);
+      }
+    }
+    std::sort(objects.begin(), objects.end(),
+              [](const ObjectProfile& a, const ObjectProfile& b) {
+                return a.stats.time_ns > b.stats.time_ns;
+              });
+    if (objects.size() > kMaxObjects)
+      objects.resize(kMaxObjects);
+    for (const ObjectProfile& object : objects) {
+      printf("  layer %d object %d: %llu calls, %.3f ms, %llu allocations\n",
+             object.layer, object.index, object.stats.calls,
+             object.stats.time_ns / 1e6, object.stats.allocations);
+    }
+  }
+
+  const bool show_scratch_stats_;
+  const bool show_render_profile_;
   IFSDK_PAUSE pause_;
   bool to_be_continued_ = false;
 };
@@ -1028,8 +1240,13 @@ bool ProcessPage(const std::string& name,
                  const int page_index,
                  const Options& options,
                  const std::string& events,
-                 const std::function<void()>& idler) {
-  FPDF_PAGE page = GetPageForIndex(form_fill_info, doc, page_index);
+                 const std::function<void()>& idler,
+                 FileTimings* timings) {
+  FPDF_PAGE page;
+  {
+    ScopedPhaseTimer parse_timer(&timings->parse_ms);
+    page = GetPageForIndex(form_fill_info, doc, page_index);
+  }
   if (!page)
     return false;
   if (options.send_events)
@@ -1053,7 +1270,11 @@ bool ProcessPage(const std::string& name,
     return true;
   }
 
-  ScopedFPDFTextPage text_page(FPDFText_LoadPage(page));
+  ScopedFPDFTextPage text_page;
+  {
+    ScopedPhaseTimer text_timer(&timings->text_ms);
+    text_page.reset(FPDFText_LoadPage(page));
+  }
   double scale = 1.0;
   if (!options.scale_factor_as_string.empty())
     std::stringstream(options.scale_factor_as_string) >> scale;
@@ -1109,15 +1330,22 @@ bool ProcessPage(const std::string& name,
 
       renderer = std::make_unique<ProgressiveBitmapPageRenderer>(
           page, /*width=*/width, /*height=*/height, /*flags=*/flags, idler,
-          writer, options.forced_color ? &color_scheme : nullptr);
+          writer, options.forced_color ? &color_scheme : nullptr,
+          options.show_scratch_stats, options.show_render_profile);
     }
   }
 
-  if (renderer->Start()) {
-    while (renderer->Continue())
-      continue;
-    renderer->Finish(form);
-
+  bool started;
+  {
+    ScopedPhaseTimer render_timer(&timings->render_ms);
+    started = renderer->Start();
+    if (started) {
+      while (renderer->Continue())
+        continue;
+      renderer->Finish(form);
+    }
+  }
+  if (started) {
     switch (options.output_format) {
 #ifdef _WIN32
       case OutputFormat::kEmf:
@@ -1160,7 +1388,12 @@ void ProcessPdf(const std::string& name,
                 size_t len,
                 const Options& options,
                 const std::string& events,
-                const std::function<void()>& idler) {
+                const std::function<void()>& idler,
+                FileTimings* timings) {
+  // Loading ends once the document open actions have run.
+  absl::optional<ScopedPhaseTimer> load_timer;
+  load_timer.emplace(&timings->load_ms);
+
   TestLoader loader({buf, len});
 
   FPDF_FILEACCESS file_access = {};
@@ -1279,6 +1512,7 @@ void ProcessPdf(const std::string& name,
   FPDF_SetFormFieldHighlightAlpha(form.get(), 100);
   FORM_DoDocumentJSAction(form.get());
   FORM_DoDocumentOpenAction(form.get());
+  load_timer.reset();
 
 #if _WIN32
   if (options.output_format == OutputFormat::kPs2)
@@ -1306,12 +1540,18 @@ void ProcessPdf(const std::string& name,
         return;
       }
     }
-    if (ProcessPage(name, doc.get(), form.get(), &form_callbacks, i, options,
-                    events, idler)) {
+    bool processed;
+    double page_ms = 0;
+    {
+      ScopedPhaseTimer page_timer(&page_ms);
+      processed = ProcessPage(name, doc.get(), form.get(), &form_callbacks, i,
+                              options, events, idler, timings);
+    }
+    timings->page_ms.push_back(page_ms);
+    if (processed)
       ++processed_pages;
-    } else {
+    else
       ++bad_pages;
-    }
     idler();
   }
 
@@ -1371,6 +1611,14 @@ constexpr char kUsageString[] =
     "  --no-smoothtext        - render disabling text anti-aliasing\n"
     "  --no-smoothimage       - render disabling image anti-alisasing\n"
     "  --no-smoothpath        - render disabling path anti-aliasing\n"
+    "  --cache-forms          - render reusing rasterized form XObjects\n"
+    "  --lowres-softmasks     - render luminosity soft masks at half "
+    "resolution\n"
+    "  --draft                - render a quick, lower quality draft\n"
+    "  --show-scratch-stats   - print the scratch pixels used by progressive "
+    "renders\n"
+    "  --show-render-profile  - print where the time and allocations of "
+    "progressive renders go\n"
     "  --reverse-byte-order   - render to BGRA, if supported by the output "
     "format\n"
     "  --save-attachments     - write embedded attachments "
@@ -1408,6 +1656,10 @@ constexpr char kUsageString[] =
     "  --scale=<number>       - scale output size by number (e.g. 0.5)\n"
     "  --password=<secret>    - password to decrypt the PDF with\n"
     "  --pages=<number>(-<number>) - only render the given 0-based page(s)\n"
+    "  --trace=<path>         - write trace events of all files as Chrome "
+    "trace JSON\n"
+    "  --throughput=<path>    - append the page latencies and phase times of "
+    "each file as a JSON line\n"
 #ifdef _WIN32
     "  --bmp   - write page images <pdf-name>.<page-number>.bmp\n"
     "  --emf   - write page meta files <pdf-name>.<page-number>.emf\n"
@@ -1429,6 +1681,22 @@ constexpr char kUsageString[] =
     "  --time=<number> - Seconds since the epoch to set system time.\n"
     "";
 
+void WriteTrace(const std::string& filename) {
+  unsigned long length = FPDF_StopTracing(nullptr, 0);
+  std::vector<char> json(length);
+  FPDF_StopTracing(json.data(), length);
+
+  FILE* fp = fopen(filename.c_str(), "wb");
+  if (!fp) {
+    fprintf(stderr, "Failed to open %s for output\n", filename.c_str());
+    return;
+  }
+  // Leave out the NUL terminator.
+  fwrite(json.data(), 1, length - 1, fp);
+  fclose(fp);
+  fprintf(stderr, "Wrote trace to %s\n", filename.c_str());
+}
+
 void SetUpErrorHandling() {
 #ifdef _WIN32
   // Suppress various Windows error reporting mechanisms that can pop up dialog
@@ -1539,6 +1807,11 @@ int main(int argc, const char* argv[]) {
 
   FSDK_SetUnSpObjProcessHandler(&unsupported_info);
 
+  if (!options.trace_filename.empty() && !FPDF_StartTracing()) {
+    fprintf(stderr,
+            "--trace needs PDFium built with pdf_enable_trace_events = true\n");
+  }
+
   if (options.time > -1) {
     // This must be a static var to avoid explicit capture, so the lambda can be
     // converted to a function ptr.
@@ -1548,9 +1821,16 @@ int main(int argc, const char* argv[]) {
   }
 
   for (const std::string& filename : files) {
+    FileTimings timings;
+    absl::optional<ScopedPhaseTimer> total_timer;
+    total_timer.emplace(&timings.total_ms);
+
     size_t file_length = 0;
-    std::unique_ptr<char, pdfium::FreeDeleter> file_contents =
-        GetFileContents(filename.c_str(), &file_length);
+    std::unique_ptr<char, pdfium::FreeDeleter> file_contents;
+    {
+      ScopedPhaseTimer load_timer(&timings.load_ms);
+      file_contents = GetFileContents(filename.c_str(), &file_length);
+    }
     if (!file_contents)
       continue;
     fprintf(stderr, "Processing PDF file %s.\n", filename.c_str());
@@ -1581,14 +1861,21 @@ int main(int argc, const char* argv[]) {
     }
 
     ProcessPdf(filename, file_contents.get(), file_length, options, events,
-               idler);
+               idler, &timings);
 
 #ifdef ENABLE_CALLGRIND
     if (options.callgrind_delimiters)
       CALLGRIND_STOP_INSTRUMENTATION;
 #endif  // ENABLE_CALLGRIND
+
+    total_timer.reset();
+    if (!options.throughput_filename.empty())
+      WriteThroughputStats(options.throughput_filename, filename, timings);
   }
 
+  if (!options.trace_filename.empty())
+    WriteTrace(options.trace_filename);
+
   FPDF_DestroyLibrary();
 
 #ifdef PDF_ENABLE_V8
@@ -0,0 +1,598 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "testing/benchmarks/benchmark_inputs.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <iterator>
+
+#include "core/fxcodec/jpeg/jpeg_common.h"
+#include "testing/utils/file_util.h"
+#include "testing/utils/path_service.h"
+
+#if defined(USE_SYSTEM_LIBOPENJPEG2)
+#include <openjpeg.h>
+#else
+#include "third_party/libopenjpeg/openjpeg.h"
+#endif
+
+namespace {
+
+// Deterministic pseudo-random numbers, so every build sees the same input.
+class Lcg {
+ public:
+  uint32_t Next(uint32_t range) {
+    m_State = m_State * 1103515245u + 12345u;
+    return (m_State >> 16) % range;
+  }
+
+ private:
+  uint32_t m_State = 1;
+};
+
+void FillRect(BilevelImage* image, int left, int top, int right, int bottom) {
+  for (int y = top; y < bottom; ++y) {
+    for (int x = left; x < right; ++x)
+      image->SetPixel(x, y);
+  }
+}
+
+// An OpenJPEG output stream that appends to a vector.
+struct JpxOutput {
+  static OPJ_SIZE_T Write(void* buffer, OPJ_SIZE_T size, void* user_data) {
+    JpxOutput* output = static_cast<JpxOutput*>(user_data);
+    if (output->pos + size > output->data.size())
+      output->data.resize(output->pos + size);
+    memcpy(&output->data[output->pos], buffer, size);
+    output->pos += size;
+    return size;
+  }
+
+  static OPJ_OFF_T Skip(OPJ_OFF_T size, void* user_data) {
+    JpxOutput* output = static_cast<JpxOutput*>(user_data);
+    output->pos += static_cast<size_t>(size);
+    return size;
+  }
+
+  static OPJ_BOOL Seek(OPJ_OFF_T pos, void* user_data) {
+    static_cast<JpxOutput*>(user_data)->pos = static_cast<size_t>(pos);
+    return OPJ_TRUE;
+  }
+
+  std::vector<uint8_t> data;
+  size_t pos = 0;
+};
+
+class BitWriter {
+ public:
+  void Write(uint32_t code, int length) {
+    for (int i = length - 1; i >= 0; --i) {
+      if (m_BitPos % 8 == 0)
+        m_Bytes.push_back(0);
+      if (code & (1u << i))
+        m_Bytes.back() |= 0x80 >> (m_BitPos % 8);
+      ++m_BitPos;
+    }
+  }
+
+  std::vector<uint8_t> Take() { return std::move(m_Bytes); }
+
+ private:
+  std::vector<uint8_t> m_Bytes;
+  size_t m_BitPos = 0;
+};
+
+// Returns the first changing element after `start` whose color is `color`,
+// as in ITU-T T.4 section 4.2.1.3.1. Pixels left of the row are white.
+int NextChangingElement(const BilevelImage& image,
+                        int y,
+                        int start,
+                        bool color) {
+  for (int x = std::max(start + 1, 0); x < image.width; ++x) {
+    const bool previous = x > 0 && image.GetPixel(x - 1, y);
+    if (image.GetPixel(x, y) == color && previous != color)
+      return x;
+  }
+  return image.width;
+}
+
+// The probability estimation table of ITU-T T.88 table E.1, which
+// CJBig2_ArithDecoder mirrors.
+struct QeEntry {
+  uint16_t qe;
+  uint8_t nmps;
+  uint8_t nlps;
+  bool switch_mps;
+};
+
+constexpr QeEntry kQeTable[] = {
+    {0x5601, 1, 1, true},    {0x3401, 2, 6, false},   {0x1801, 3, 9, false},
+    {0x0AC1, 4, 12, false},  {0x0521, 5, 29, false},  {0x0221, 38, 33, false},
+    {0x5601, 7, 6, true},    {0x5401, 8, 14, false},  {0x4801, 9, 14, false},
+    {0x3801, 10, 14, false}, {0x3001, 11, 17, false}, {0x2401, 12, 18, false},
+    {0x1C01, 13, 20, false}, {0x1601, 29, 21, false}, {0x5601, 15, 14, true},
+    {0x5401, 16, 14, false}, {0x5101, 17, 15, false}, {0x4801, 18, 16, false},
+    {0x3801, 19, 17, false}, {0x3401, 20, 18, false}, {0x3001, 21, 19, false},
+    {0x2801, 22, 19, false}, {0x2401, 23, 20, false}, {0x2201, 24, 21, false},
+    {0x1C01, 25, 22, false}, {0x1801, 26, 23, false}, {0x1601, 27, 24, false},
+    {0x1401, 28, 25, false}, {0x1201, 29, 26, false}, {0x1101, 30, 27, false},
+    {0x0AC1, 31, 28, false}, {0x09C1, 32, 29, false}, {0x08A1, 33, 30, false},
+    {0x0521, 34, 31, false}, {0x0441, 35, 32, false}, {0x02A1, 36, 33, false},
+    {0x0221, 37, 34, false}, {0x0141, 38, 35, false}, {0x0111, 39, 36, false},
+    {0x0085, 40, 37, false}, {0x0049, 41, 38, false}, {0x0025, 42, 39, false},
+    {0x0015, 43, 40, false}, {0x0009, 44, 41, false}, {0x0005, 45, 42, false},
+    {0x0001, 45, 43, false}, {0x5601, 46, 46, false}};
+
+// The MQ arithmetic encoder of ITU-T T.88 annex E.2.
+class ArithEncoder {
+ public:
+  struct Context {
+    uint8_t index = 0;
+    bool mps = false;
+  };
+
+  // Starts with the byte before the data, which a carry may reach, as in
+  // INITENC. Finish() drops it.
+  ArithEncoder() { m_Output.push_back(0); }
+
+  void Encode(Context* cx, bool bit) {
+    const QeEntry& qe = kQeTable[cx->index];
+    m_A -= qe.qe;
+    if (bit == cx->mps) {
+      if (m_A & 0x8000) {
+        m_C += qe.qe;
+        return;
+      }
+      if (m_A < qe.qe)
+        m_A = qe.qe;
+      else
+        m_C += qe.qe;
+      cx->index = qe.nmps;
+    } else {
+      if (m_A < qe.qe)
+        m_C += qe.qe;
+      else
+        m_A = qe.qe;
+      if (qe.switch_mps)
+        cx->mps = !cx->mps;
+      cx->index = qe.nlps;
+    }
+    Renormalize();
+  }
+
+  // Returns the data including the 0xFFAC end marker.
+  std::vector<uint8_t> Finish() {
+    const uint32_t temp = m_C + m_A;
+    m_C |= 0xffff;
+    if (m_C >= temp)
+      m_C -= 0x8000;
+    m_C <<= m_CT;
+    ByteOut();
+    m_C <<= m_CT;
+    ByteOut();
+    if (m_Output.back() != 0xff)
+      m_Output.push_back(0xff);
+    m_Output.push_back(0xac);
+    m_Output.erase(m_Output.begin());
+    return std::move(m_Output);
+  }
+
+ private:
+  void Renormalize() {
+    do {
+      m_A <<= 1;
+      m_C <<= 1;
+      if (--m_CT == 0)
+        ByteOut();
+    } while ((m_A & 0x8000) == 0);
+  }
+
+  void ByteOut() {
+    if (m_Output.back() != 0xff && m_C >= 0x8000000) {
+      ++m_Output.back();
+      if (m_Output.back() == 0xff)
+        m_C &= 0x7ffffff;
+    }
+    if (m_Output.back() == 0xff) {
+      m_Output.push_back(static_cast<uint8_t>(m_C >> 20));
+      m_C &= 0xfffff;
+      m_CT = 7;
+    } else {
+      m_Output.push_back(static_cast<uint8_t>(m_C >> 19));
+      m_C &= 0x7ffff;
+      m_CT = 8;
+    }
+  }
+
+  uint32_t m_A = 0x8000;
+  uint32_t m_C = 0;
+  int m_CT = 12;
+  std::vector<uint8_t> m_Output;
+};
+
+void AppendUint32(std::vector<uint8_t>* data, uint32_t value) {
+  for (int shift = 24; shift >= 0; shift -= 8)
+    data->push_back(static_cast<uint8_t>(value >> shift));
+}
+
+void AppendSegmentHeader(std::vector<uint8_t>* data,
+                         uint32_t number,
+                         uint8_t type,
+                         uint32_t data_length) {
+  AppendUint32(data, number);
+  data->push_back(type);
+  data->push_back(0);  // No referred-to segments.
+  data->push_back(1);  // Page association.
+  AppendUint32(data, data_length);
+}
+
+// Template 0 context of T.88 section 6.2.5.3 with the nominal AT pixels.
+uint32_t GetTemplate0Context(const BilevelImage& image, int x, int y) {
+  auto pixel = [&image](int px, int py) -> uint32_t {
+    return px >= 0 && px < image.width && py >= 0 && image.GetPixel(px, py);
+  };
+  uint32_t context = 0;
+  context |= pixel(x - 1, y);
+  context |= pixel(x - 2, y) << 1;
+  context |= pixel(x - 3, y) << 2;
+  context |= pixel(x - 4, y) << 3;
+  context |= pixel(x + 3, y - 1) << 4;
+  context |= pixel(x + 2, y - 1) << 5;
+  context |= pixel(x + 1, y - 1) << 6;
+  context |= pixel(x, y - 1) << 7;
+  context |= pixel(x - 1, y - 1) << 8;
+  context |= pixel(x - 2, y - 1) << 9;
+  context |= pixel(x - 3, y - 1) << 10;
+  context |= pixel(x + 2, y - 2) << 11;
+  context |= pixel(x + 1, y - 2) << 12;
+  context |= pixel(x, y - 2) << 13;
+  context |= pixel(x - 1, y - 2) << 14;
+  context |= pixel(x - 2, y - 2) << 15;
+  return context;
+}
+
+void AppendObject(std::string* data, int number, const std::string& body) {
+  *data += std::to_string(number);
+  *data += " 0 obj\n";
+  *data += body;
+  *data += "\nendobj\n";
+}
+
+}  // namespace
+
+std::vector<uint8_t> LoadTestFile(const std::string& name) {
+  std::string path;
+  if (!PathService::GetTestFilePath(name, &path))
+    return {};
+
+  size_t size = 0;
+  std::unique_ptr<char, pdfium::FreeDeleter> contents =
+      GetFileContents(path.c_str(), &size);
+  if (!contents)
+    return {};
+
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(contents.get());
+  return std::vector<uint8_t>(bytes, bytes + size);
+}
+
+std::vector<uint8_t> MakePhotoLikeImage(int width, int height) {
+  std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 3);
+  Lcg random;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      // A sky-like gradient over a darker, hilly foreground.
+      const int horizon = height / 2 + (x * 7 / 5 + y) % 97 - 48;
+      const bool ground = y > horizon;
+      const int shade = ground ? 40 + (x ^ y) % 64 : 255 - y * 128 / height;
+      const int noise = static_cast<int>(random.Next(16)) - 8;
+      uint8_t* pixel = &pixels[(static_cast<size_t>(y) * width + x) * 3];
+      pixel[0] = static_cast<uint8_t>(std::clamp(shade / 2 + noise, 0, 255));
+      pixel[1] = static_cast<uint8_t>(
+          std::clamp((ground ? shade + 30 : shade * 3 / 4) + noise, 0, 255));
+      pixel[2] = static_cast<uint8_t>(
+          std::clamp((ground ? shade / 3 : shade) + noise, 0, 255));
+    }
+  }
+  return pixels;
+}
+
+std::vector<uint8_t> EncodeJpeg(int width, int height) {
+  std::vector<uint8_t> pixels = MakePhotoLikeImage(width, height);
+  jpeg_compress_struct cinfo = {};
+  jpeg_error_mgr error_manager = {};
+  cinfo.err = jpeg_std_error(&error_manager);
+  jpeg_create_compress(&cinfo);
+
+  unsigned char* output = nullptr;
+  unsigned long output_size = 0;
+  jpeg_mem_dest(&cinfo, &output, &output_size);
+  cinfo.image_width = width;
+  cinfo.image_height = height;
+  cinfo.input_components = 3;
+  cinfo.in_color_space = JCS_RGB;
+  jpeg_set_defaults(&cinfo);
+  jpeg_set_quality(&cinfo, 85, /*force_baseline=*/TRUE);
+  jpeg_start_compress(&cinfo, /*write_all_tables=*/TRUE);
+  while (cinfo.next_scanline < cinfo.image_height) {
+    JSAMPROW row = &pixels[cinfo.next_scanline * width * 3];
+    jpeg_write_scanlines(&cinfo, &row, 1);
+  }
+  jpeg_finish_compress(&cinfo);
+  jpeg_destroy_compress(&cinfo);
+
+  std::vector<uint8_t> data(output, output + output_size);
+  free(output);
+  return data;
+}
+
+std::vector<uint8_t> EncodeJpx(int width, int height) {
+  static constexpr int kComponents = 3;
+  const std::vector<uint8_t> pixels = MakePhotoLikeImage(width, height);
+  opj_image_cmptparm_t component_params[kComponents] = {};
+  for (opj_image_cmptparm_t& params : component_params) {
+    params.dx = 1;
+    params.dy = 1;
+    params.w = width;
+    params.h = height;
+    params.prec = 8;
+  }
+  opj_image_t* image =
+      opj_image_create(kComponents, component_params, OPJ_CLRSPC_SRGB);
+  if (!image)
+    return {};
+
+  image->x1 = width;
+  image->y1 = height;
+  for (int c = 0; c < kComponents; ++c) {
+    for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i)
+      image->comps[c].data[i] = pixels[i * kComponents + c];
+  }
+
+  // Lossy at 20:1 with the 9/7 wavelet, as scanned pages usually are.
+  opj_cparameters_t params;
+  opj_set_default_encoder_parameters(&params);
+  params.tcp_numlayers = 1;
+  params.tcp_rates[0] = 20;
+  params.cp_disto_alloc = 1;
+  params.irreversible = 1;
+
+  JpxOutput output;
+  opj_codec_t* codec = opj_create_compress(OPJ_CODEC_J2K);
+  opj_stream_t* stream =
+      opj_stream_create(OPJ_J2K_STREAM_CHUNK_SIZE, /*p_is_input=*/OPJ_FALSE);
+  opj_stream_set_user_data(stream, &output, nullptr);
+  opj_stream_set_write_function(stream, JpxOutput::Write);
+  opj_stream_set_skip_function(stream, JpxOutput::Skip);
+  opj_stream_set_seek_function(stream, JpxOutput::Seek);
+  const bool encoded = opj_setup_encoder(codec, &params, image) &&
+                       opj_start_compress(codec, image, stream) &&
+                       opj_encode(codec, stream) &&
+                       opj_end_compress(codec, stream);
+  opj_stream_destroy(stream);
+  opj_destroy_codec(codec);
+  opj_image_destroy(image);
+  return encoded ? std::move(output.data) : std::vector<uint8_t>();
+}
+
+BilevelImage::BilevelImage(int width, int height)
+    : width(width),
+      height(height),
+      pitch((width + 7) / 8),
+      bits(static_cast<size_t>(pitch) * height) {}
+
+BilevelImage::~BilevelImage() = default;
+
+bool BilevelImage::GetPixel(int x, int y) const {
+  return bits[y * pitch + x / 8] & (0x80 >> (x % 8));
+}
+
+void BilevelImage::SetPixel(int x, int y) {
+  bits[y * pitch + x / 8] |= 0x80 >> (x % 8);
+}
+
+BilevelImage MakeStripedImage(int width, int height) {
+  BilevelImage image(width, height);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      if (x + y >= width - 1 && (x + y) % 16 < 8)
+        image.SetPixel(x, y);
+    }
+  }
+  return image;
+}
+
+BilevelImage MakeTextLikeImage(int width, int height) {
+  static constexpr int kMargin = 16;
+  static constexpr int kLineHeight = 24;
+  static constexpr int kXHeight = 8;
+  static constexpr int kAscent = 12;
+
+  BilevelImage image(width, height);
+  Lcg random;
+  for (int top = kMargin; top + kAscent <= height - kMargin;
+       top += kLineHeight) {
+    const int baseline = top + kAscent;
+    int x = kMargin;
+    while (x < width - kMargin) {
+      const int letters = 1 + random.Next(9);
+      for (int i = 0; i < letters && x < width - kMargin; ++i) {
+        const int glyph_width = 4 + random.Next(4);
+        const int glyph_top = random.Next(3) ? baseline - kXHeight : top;
+        const int right = std::min(x + glyph_width, width - kMargin);
+        // An outline with a stem, which gives the codec some structure.
+        FillRect(&image, x, glyph_top, right, glyph_top + 2);
+        FillRect(&image, x, baseline - 2, right, baseline);
+        FillRect(&image, x, glyph_top, std::min(x + 2, right), baseline);
+        x += glyph_width + 1;
+      }
+      x += 4 + random.Next(4);
+    }
+  }
+  return image;
+}
+
+std::vector<uint8_t> EncodeFaxG4(const BilevelImage& image) {
+  BitWriter writer;
+  for (int y = 0; y < image.height; ++y) {
+    int a0 = -1;
+    bool a0_color = false;
+    while (true) {
+      const int a1 = NextChangingElement(image, y, a0, !a0_color);
+      int b1 = y ? NextChangingElement(image, y - 1, a0, !a0_color)
+                 : image.width;
+      int b2 = y && b1 < image.width
+                   ? NextChangingElement(image, y - 1, b1, a0_color)
+                   : image.width;
+      if (b2 < a1) {
+        writer.Write(0x1, 4);  // Pass mode.
+        a0 = b2;
+        continue;
+      }
+
+      static constexpr struct {
+        uint32_t code;
+        int length;
+      } kVerticalCodes[] = {{0x2, 7}, {0x2, 6}, {0x2, 3}, {0x1, 1},
+                            {0x3, 3}, {0x3, 6}, {0x3, 7}};
+      const int delta = a1 - b1;
+      if (delta < -3 || delta > 3)
+        return {};  // Needs horizontal mode, which this does not support.
+
+      writer.Write(kVerticalCodes[delta + 3].code,
+                   kVerticalCodes[delta + 3].length);
+      if (a1 >= image.width)
+        break;
+
+      a0 = a1;
+      a0_color = !a0_color;
+    }
+  }
+  return writer.Take();
+}
+
+std::vector<uint8_t> EncodeJbig2GenericRegion(const BilevelImage& image) {
+  ArithEncoder encoder;
+  std::vector<ArithEncoder::Context> contexts(1 << 16);
+  for (int y = 0; y < image.height; ++y) {
+    for (int x = 0; x < image.width; ++x) {
+      encoder.Encode(&contexts[GetTemplate0Context(image, x, y)],
+                     image.GetPixel(x, y));
+    }
+  }
+  const std::vector<uint8_t> coded = encoder.Finish();
+
+  static constexpr uint8_t kPageInformation = 48;
+  static constexpr uint8_t kImmediateLosslessGenericRegion = 39;
+  static constexpr uint8_t kEndOfPage = 49;
+  static constexpr uint8_t kNominalAtPixels[] = {0x03, 0xff, 0xfd, 0xff,
+                                                 0x02, 0xfe, 0xfe, 0xfe};
+
+  std::vector<uint8_t> data;
+  AppendSegmentHeader(&data, 0, kPageInformation, 19);
+  AppendUint32(&data, image.width);
+  AppendUint32(&data, image.height);
+  AppendUint32(&data, 0);  // Resolution.
+  AppendUint32(&data, 0);
+  data.push_back(0);  // Flags.
+  data.push_back(0);  // Striping.
+  data.push_back(0);
+
+  const uint32_t region_length = static_cast<uint32_t>(
+      17 + 1 + std::size(kNominalAtPixels) + coded.size());
+  AppendSegmentHeader(&data, 1, kImmediateLosslessGenericRegion,
+                      region_length);
+  AppendUint32(&data, image.width);
+  AppendUint32(&data, image.height);
+  AppendUint32(&data, 0);  // Position.
+  AppendUint32(&data, 0);
+  data.push_back(0);  // External combination operator.
+  data.push_back(0);  // Arithmetic coding with template 0.
+  data.insert(data.end(), std::begin(kNominalAtPixels),
+              std::end(kNominalAtPixels));
+  data.insert(data.end(), coded.begin(), coded.end());
+
+  AppendSegmentHeader(&data, 2, kEndOfPage, 0);
+  return data;
+}
+
+std::vector<uint8_t> MakeSyntheticObjects(int count,
+                                          std::vector<uint32_t>* offsets) {
+  std::string data = "%PDF-1.7\n";
+  offsets->clear();
+  for (int i = 1; i <= count; ++i) {
+    offsets->push_back(static_cast<uint32_t>(data.size()));
+    const std::string n = std::to_string(i);
+    switch (i % 4) {
+      case 0:
+        AppendObject(&data, i,
+                     "<</Type /Annot /Subtype /Link /Rect [" + n + " 72 " + n +
+                         ".5 144.25] /Border [0 0 1] /A <</S /URI /URI "
+                         "(http://example.com/\\(" +
+                         n + "\\))>> /F 4 /P 3 0 R>>");
+        break;
+      case 1:
+        AppendObject(&data, i,
+                     "[" + n + " -" + n + ".125 (Hello, world) <48656C6C6F>" +
+                         " /N" + n + " true false null 7 0 R [1 2 [3 4]]]");
+        break;
+      case 2:
+        AppendObject(&data, i,
+                     "<</Type /Page /Parent 1 0 R /MediaBox [0 0 612 792] "
+                     "/Resources <</Font <</F1 5 0 R /F2 6 0 R>> /XObject "
+                     "<</Im1 8 0 R>>>> /Contents " +
+                         n + " 0 R /Rotate 0>>");
+        break;
+      case 3: {
+        const std::string content =
+            "BT /F1 12 Tf 72 712 Td (Hello, world " + n + ") Tj ET";
+        AppendObject(&data, i,
+                     "<</Length " + std::to_string(content.size()) +
+                         ">>\nstream\n" + content + "\nendstream");
+        break;
+      }
+    }
+  }
+  return std::vector<uint8_t>(data.begin(), data.end());
+}
+
+std::vector<uint8_t> MakeTextDocument(int lines) {
+  std::string content = "BT /F1 9 Tf 11 TL 36 756 Td\n";
+  for (int i = 0; i < lines; ++i) {
+    content += "(Line " + std::to_string(i) +
+               ": The quick brown fox jumps over the lazy dog, "
+               "then runs 1,234.5 miles.) '\n";
+  }
+  content += "ET";
+
+  const std::string objects[] = {
+      "<</Type /Catalog /Pages 2 0 R>>",
+      "<</Type /Pages /Kids [3 0 R] /Count 1>>",
+      "<</Type /Page /Parent 2 0 R /MediaBox [0 0 612 792] "
+      "/Resources <</Font <</F1 4 0 R>>>> /Contents 5 0 R>>",
+      "<</Type /Font /Subtype /Type1 /BaseFont /Helvetica>>",
+      "<</Length " + std::to_string(content.size()) + ">>\nstream\n" +
+          content + "\nendstream",
+  };
+
+  std::string data = "%PDF-1.7\n";
+  std::vector<size_t> offsets;
+  for (const std::string& object : objects) {
+    offsets.push_back(data.size());
+    AppendObject(&data, static_cast<int>(offsets.size()), object);
+  }
+  const size_t xref_offset = data.size();
+  data += "xref\n0 " + std::to_string(offsets.size() + 1) +
+          "\n0000000000 65535 f \n";
+  for (size_t offset : offsets) {
+    std::string entry = std::to_string(offset);
+    data += std::string(10 - entry.size(), '0') + entry + " 00000 n \n";
+  }
+  data += "trailer\n<</Size " + std::to_string(offsets.size() + 1) +
+          " /Root 1 0 R>>\nstartxref\n" + std::to_string(xref_offset) +
+          "\n%%EOF\n";
+  return std::vector<uint8_t>(data.begin(), data.end());
+}
@@ -0,0 +1,69 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TESTING_BENCHMARKS_BENCHMARK_INPUTS_H_
+#define TESTING_BENCHMARKS_BENCHMARK_INPUTS_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+// Inputs shared by the benchmarks. Files come from testing/resources. The
+// synthetic inputs are deterministic, so runs on different builds compare.
+
+// Returns an empty vector when `name` does not exist in testing/resources.
+std::vector<uint8_t> LoadTestFile(const std::string& name);
+
+// Returns `width` x `height` RGB pixels with smooth gradients, edges and
+// noise, so lossy codecs see something like a photograph.
+std::vector<uint8_t> MakePhotoLikeImage(int width, int height);
+
+// Encodes MakePhotoLikeImage() as a baseline JPEG.
+std::vector<uint8_t> EncodeJpeg(int width, int height);
+
+// Encodes MakePhotoLikeImage() as a lossy JPEG 2000 codestream.
+std::vector<uint8_t> EncodeJpx(int width, int height);
+
+// A 1 bpp image, packed MSB first. Set bits are black.
+struct BilevelImage {
+  BilevelImage(int width, int height);
+  ~BilevelImage();
+
+  bool GetPixel(int x, int y) const;
+  void SetPixel(int x, int y);
+
+  const int width;
+  const int height;
+  const int pitch;
+  std::vector<uint8_t> bits;
+};
+
+// Diagonal stripes that scroll in from the right edge. Each row is the row
+// above moved left by one pixel.
+BilevelImage MakeStripedImage(int width, int height);
+
+// Rows of word-sized blocks, which look like scanned text to the codecs.
+BilevelImage MakeTextLikeImage(int width, int height);
+
+// Encodes `image` as CCITT Group 4 data. Only supports images where each row
+// can be coded from the row above with vertical and pass modes, such as
+// MakeStripedImage(). Returns an empty vector otherwise.
+std::vector<uint8_t> EncodeFaxG4(const BilevelImage& image);
+
+// Encodes `image` as an embedded JBIG2 stream with a page information segment
+// and an immediate lossless generic region, arithmetic coded with template 0.
+std::vector<uint8_t> EncodeJbig2GenericRegion(const BilevelImage& image);
+
+// Returns `count` indirect objects in the PDF syntax, a mix of dictionaries,
+// arrays, strings, numbers and small streams. Fills `offsets` with the start
+// of each object.
+std::vector<uint8_t> MakeSyntheticObjects(int count,
+                                          std::vector<uint32_t>* offsets);
+
+// Returns a one page PDF with `lines` lines of text in the standard Helvetica
+// font, which text extraction and saving both have to walk.
+std::vector<uint8_t> MakeTextDocument(int lines);
+
+#endif  // TESTING_BENCHMARKS_BENCHMARK_INPUTS_H_
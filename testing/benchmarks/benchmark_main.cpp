@@ -0,0 +1,23 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "public/fpdfview.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+// Runs the benchmarks of the core subsystems. Takes the usual Google Benchmark
+// flags, e.g. --benchmark_filter=Flate to run a subset, and
+// --benchmark_format=json to compare runs with the tools that come with it.
+int main(int argc, char** argv) {
+  // Sets up the modules that codecs, fonts and the page parser need.
+  FPDF_InitLibrary();
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  FPDF_DestroyLibrary();
+  return 0;
+}
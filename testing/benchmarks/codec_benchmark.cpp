@@ -0,0 +1,223 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/fxcodec/fax/faxmodule.h"
+#include "core/fxcodec/flate/flatemodule.h"
+#include "core/fxcodec/fx_codec_def.h"
+#include "core/fxcodec/jbig2/JBig2_DocumentContext.h"
+#include "core/fxcodec/jbig2/jbig2_decoder.h"
+#include "core/fxcodec/jpeg/jpegmodule.h"
+#include "core/fxcodec/jpx/cjpx_decoder.h"
+#include "core/fxcodec/scanlinedecoder.h"
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/fx_memory_wrappers.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "testing/benchmarks/benchmark_inputs.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/base/span.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace {
+
+// A letter size page at 200 dpi, like the output of a fax or a scanner.
+constexpr int kPageWidth = 1728;
+constexpr int kPageHeight = 2200;
+
+// Returns a content stream with text and path operators.
+std::vector<uint8_t> MakeContentStream() {
+  std::string content;
+  for (int i = 0; i < 10000; ++i) {
+    const std::string n = std::to_string(i % 700);
+    content += "BT /F1 12 Tf 72 " + n + " Td (Line " + n + " of text) Tj ET\n";
+    content += "q 0.5 g 72 " + n + " 468 0.75 re f Q\n";
+  }
+  return std::vector<uint8_t>(content.begin(), content.end());
+}
+
+// Returns an RGB gradient with the PNG Up predictor applied to each row, as
+// image streams with /DecodeParms << /Predictor 12 >> have.
+std::vector<uint8_t> MakePredictedImage(int width, int height) {
+  const int row_size = width * 3;
+  std::vector<uint8_t> previous(row_size);
+  std::vector<uint8_t> row(row_size);
+  std::vector<uint8_t> data;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      row[x * 3] = static_cast<uint8_t>(x + y);
+      row[x * 3 + 1] = static_cast<uint8_t>(x * y / 64);
+      row[x * 3 + 2] = static_cast<uint8_t>((x ^ y) & 0xf0);
+    }
+    data.push_back(2);  // PNG Up filter.
+    for (int i = 0; i < row_size; ++i)
+      data.push_back(static_cast<uint8_t>(row[i] - previous[i]));
+    std::swap(row, previous);
+  }
+  return data;
+}
+
+void FlateDecode(benchmark::State& state,
+                 const std::vector<uint8_t>& raw,
+                 int predictor,
+                 int colors,
+                 int columns) {
+  const DataVector<uint8_t> encoded = FlateModule::Encode(raw);
+  for (auto _ : state) {
+    std::unique_ptr<uint8_t, FxFreeDeleter> dest_buf;
+    uint32_t dest_size = 0;
+    FlateModule::FlateOrLZWDecode(
+        /*bLZW=*/false, encoded, /*bEarlyChange=*/false, predictor, colors,
+        /*BitsPerComponent=*/8, columns, /*estimated_size=*/0,
+        FlateModule::kNoMaxSize, &dest_buf, &dest_size);
+    benchmark::DoNotOptimize(dest_buf.get());
+  }
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+
+void BM_FlateDecodeContent(benchmark::State& state) {
+  FlateDecode(state, MakeContentStream(), /*predictor=*/0, /*colors=*/1,
+              /*columns=*/1);
+}
+BENCHMARK(BM_FlateDecodeContent);
+
+void BM_FlateDecodePredictedImage(benchmark::State& state) {
+  static constexpr int kWidth = 1024;
+  FlateDecode(state, MakePredictedImage(kWidth, 1024), /*predictor=*/12,
+              /*colors=*/3, kWidth);
+}
+BENCHMARK(BM_FlateDecodePredictedImage);
+
+// A null `name` selects a synthetic photograph, since the JPEG and JPEG 2000
+// files in testing/resources are all thumbnails.
+void BM_DctDecode(benchmark::State& state, const char* name) {
+  const std::vector<uint8_t> data =
+      name ? LoadTestFile(name) : EncodeJpeg(1600, 1200);
+  absl::optional<JpegModule::ImageInfo> info;
+  if (!data.empty())
+    info = JpegModule::LoadInfo(data);
+  if (!info.has_value()) {
+    state.SkipWithError("cannot read image");
+    return;
+  }
+
+  for (auto _ : state) {
+    std::unique_ptr<ScanlineDecoder> decoder = JpegModule::CreateDecoder(
+        data, info->width, info->height, info->num_components,
+        info->color_transform);
+    for (uint32_t row = 0; row < info->height; ++row)
+      benchmark::DoNotOptimize(decoder->GetScanline(row).data());
+  }
+  state.SetItemsProcessed(state.iterations() * info->width * info->height);
+}
+BENCHMARK_CAPTURE(BM_DctDecode, MonaLisa, "mona_lisa.jpg");
+BENCHMARK_CAPTURE(BM_DctDecode, Synthetic, nullptr);
+
+void BM_JpxDecode(benchmark::State& state, const char* name) {
+  const std::vector<uint8_t> data =
+      name ? LoadTestFile(name) : EncodeJpx(1024, 1024);
+  if (data.empty()) {
+    state.SkipWithError("cannot read image");
+    return;
+  }
+
+  uint32_t pixels = 0;
+  for (auto _ : state) {
+    std::unique_ptr<CJPX_Decoder> decoder =
+        CJPX_Decoder::Create(data, CJPX_Decoder::kNormalColorSpace,
+                             /*resolution_levels_to_skip=*/0);
+    if (!decoder || !decoder->StartDecode()) {
+      state.SkipWithError("cannot decode");
+      return;
+    }
+
+    const CJPX_Decoder::JpxImageInfo info = decoder->GetInfo();
+    const FXDIB_Format format =
+        info.channels == 1 ? FXDIB_Format::k8bppRgb : FXDIB_Format::kRgb;
+    auto bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+    if (info.channels > 3 || !bitmap->Create(info.width, info.height, format)) {
+      state.SkipWithError("unexpected image");
+      return;
+    }
+    decoder->Decode(bitmap->GetBuffer(), bitmap->GetPitch(),
+                    /*swap_rgb=*/false, GetCompsFromFormat(format));
+    benchmark::DoNotOptimize(bitmap->GetBuffer().data());
+    pixels = info.width * info.height;
+  }
+  state.SetItemsProcessed(state.iterations() * pixels);
+}
+BENCHMARK_CAPTURE(BM_JpxDecode, Rgb, "RGB.jp2");
+BENCHMARK_CAPTURE(BM_JpxDecode, Gray, "gray.jp2");
+BENCHMARK_CAPTURE(BM_JpxDecode, Synthetic, nullptr);
+
+void BM_FaxG4Decode(benchmark::State& state) {
+  const BilevelImage image = MakeStripedImage(kPageWidth, kPageHeight);
+  const std::vector<uint8_t> data = EncodeFaxG4(image);
+  auto create_decoder = [&data]() {
+    return FaxModule::CreateDecoder(
+        data, kPageWidth, kPageHeight, /*K=*/-1, /*EndOfLine=*/false,
+        /*EncodedByteAlign=*/false, /*BlackIs1=*/true, kPageWidth,
+        kPageHeight);
+  };
+
+  // Make sure the synthetic data is right before timing it.
+  std::unique_ptr<ScanlineDecoder> decoder = create_decoder();
+  for (int row = 0; row < kPageHeight; ++row) {
+    pdfium::span<const uint8_t> scanline = decoder->GetScanline(row);
+    if (scanline.size() < static_cast<size_t>(image.pitch) ||
+        memcmp(scanline.data(), &image.bits[row * image.pitch],
+               image.pitch) != 0) {
+      state.SkipWithError("synthetic G4 data does not round-trip");
+      return;
+    }
+  }
+
+  for (auto _ : state) {
+    decoder = create_decoder();
+    for (int row = 0; row < kPageHeight; ++row)
+      benchmark::DoNotOptimize(decoder->GetScanline(row).data());
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+  state.SetItemsProcessed(state.iterations() * kPageWidth * kPageHeight);
+}
+BENCHMARK(BM_FaxG4Decode);
+
+void BM_Jbig2GenericRegionDecode(benchmark::State& state) {
+  const BilevelImage image = MakeTextLikeImage(kPageWidth, kPageHeight);
+  const std::vector<uint8_t> data = EncodeJbig2GenericRegion(image);
+  std::vector<uint8_t> dest(image.bits.size());
+  auto decode = [&data, &dest, &image]() {
+    JBig2_DocumentContext document_context;
+    Jbig2Context context;
+    return Jbig2Decoder::StartDecode(
+        &context, &document_context, kPageWidth, kPageHeight, data,
+        /*src_key=*/1, /*global_span=*/{}, /*global_key=*/0, dest,
+        image.pitch, /*pPause=*/nullptr);
+  };
+
+  // Make sure the synthetic data is right before timing it. The decoder
+  // outputs set bits for white.
+  bool round_trips = decode() == FXCODEC_STATUS::kDecodeFinished;
+  for (size_t i = 0; round_trips && i < dest.size(); ++i)
+    round_trips = dest[i] == static_cast<uint8_t>(~image.bits[i]);
+  if (!round_trips) {
+    state.SkipWithError("synthetic JBIG2 data does not round-trip");
+    return;
+  }
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(decode());
+  state.SetBytesProcessed(state.iterations() * data.size());
+  state.SetItemsProcessed(state.iterations() * kPageWidth * kPageHeight);
+}
+BENCHMARK(BM_Jbig2GenericRegionDecode);
+
+}  // namespace
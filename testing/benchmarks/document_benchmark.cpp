@@ -0,0 +1,106 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fpdfapi/edit/cpdf_creator.h"
+#include "core/fpdfapi/page/cpdf_page.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdftext/cpdf_textpage.h"
+#include "core/fxcrt/fx_stream.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "fpdfsdk/cpdfsdk_helpers.h"
+#include "public/cpp/fpdf_scopers.h"
+#include "public/fpdfview.h"
+#include "testing/benchmarks/benchmark_inputs.h"
+#include "third_party/base/span.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace {
+
+// The synthetic text page fills a letter size page.
+constexpr int kTextDocumentLines = 64;
+
+// Counts the bytes of a saved document instead of keeping them.
+class CountingWriteStream final : public IFX_RetainableWriteStream {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // IFX_WriteStream:
+  bool WriteBlock(pdfium::span<const uint8_t> data) override {
+    m_Size += data.size();
+    return true;
+  }
+
+  size_t size() const { return m_Size; }
+
+ private:
+  CountingWriteStream() = default;
+  ~CountingWriteStream() override = default;
+
+  size_t m_Size = 0;
+};
+
+// A null `name` selects the synthetic text document.
+std::vector<uint8_t> LoadDocumentData(const char* name) {
+  return name ? LoadTestFile(name) : MakeTextDocument(kTextDocumentLines);
+}
+
+// Extracts the text of the first page, parsed once up front, so the timing
+// covers CPDF_TextPage and not the content stream parser.
+void BM_TextPageExtract(benchmark::State& state, const char* name) {
+  const std::vector<uint8_t> data = LoadDocumentData(name);
+  ScopedFPDFDocument document(
+      FPDF_LoadMemDocument64(data.data(), data.size(), nullptr));
+  ScopedFPDFPage page(document ? FPDF_LoadPage(document.get(), 0) : nullptr);
+  if (!page) {
+    state.SkipWithError("cannot load page");
+    return;
+  }
+
+  const CPDF_Page* pdf_page = CPDFPageFromFPDFPage(page.get());
+  int chars = 0;
+  for (auto _ : state) {
+    CPDF_TextPage text_page(pdf_page, /*rtl=*/false);
+    chars = text_page.CountChars();
+    benchmark::DoNotOptimize(chars);
+  }
+  state.SetItemsProcessed(state.iterations() * chars);
+}
+BENCHMARK_CAPTURE(BM_TextPageExtract, LatinExtended, "latin_extended.pdf");
+BENCHMARK_CAPTURE(BM_TextPageExtract, Synthetic, nullptr);
+
+void BM_CreatorSave(benchmark::State& state, const char* name) {
+  const std::vector<uint8_t> data = LoadDocumentData(name);
+  ScopedFPDFDocument document(
+      FPDF_LoadMemDocument64(data.data(), data.size(), nullptr));
+  if (!document) {
+    state.SkipWithError("cannot load document");
+    return;
+  }
+
+  CPDF_Document* pdf_document = CPDFDocumentFromFPDFDocument(document.get());
+  size_t saved_size = 0;
+  for (auto _ : state) {
+    auto stream = pdfium::MakeRetain<CountingWriteStream>();
+    {
+      // The creator flushes its buffer when it goes away.
+      CPDF_Creator creator(pdf_document, stream);
+      if (!creator.Create(/*flags=*/0)) {
+        state.SkipWithError("cannot save");
+        return;
+      }
+    }
+    saved_size = stream->size();
+  }
+  state.SetBytesProcessed(state.iterations() * saved_size);
+}
+BENCHMARK_CAPTURE(BM_CreatorSave, AnnotationStamp,
+                  "annotation_stamp_with_ap.pdf");
+BENCHMARK_CAPTURE(BM_CreatorSave, ManyRectangles, "many_rectangles.pdf");
+BENCHMARK_CAPTURE(BM_CreatorSave, Synthetic, nullptr);
+
+}  // namespace
@@ -0,0 +1,308 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <math.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/cfx_defaultrenderdevice.h"
+#include "core/fxge/cfx_fillrenderoptions.h"
+#include "core/fxge/cfx_font.h"
+#include "core/fxge/cfx_fontmgr.h"
+#include "core/fxge/cfx_graphstatedata.h"
+#include "core/fxge/cfx_path.h"
+#include "core/fxge/cfx_textrenderoptions.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/cfx_scanlinecompositor.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "core/fxge/freetype/fx_freetype.h"
+#include "third_party/base/span.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace {
+
+constexpr int kLineWidth = 2048;
+constexpr int kLineCount = 64;
+
+// Returns `count` rows of ARGB pixels with varying color and alpha, so the
+// compositors do not take their opaque or transparent shortcuts everywhere.
+std::vector<uint8_t> MakeArgbLines(int width, int count, int seed) {
+  std::vector<uint8_t> data(width * count * 4);
+  for (int y = 0; y < count; ++y) {
+    for (int x = 0; x < width; ++x) {
+      uint8_t* pixel = &data[(y * width + x) * 4];
+      pixel[0] = static_cast<uint8_t>(x * 3 + seed);
+      pixel[1] = static_cast<uint8_t>(y * 5 + x);
+      pixel[2] = static_cast<uint8_t>(x ^ (y + seed));
+      pixel[3] = static_cast<uint8_t>((x + y) * 7);
+    }
+  }
+  return data;
+}
+
+RetainPtr<CFX_DIBitmap> MakeRgbBitmap(int width, int height) {
+  auto bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  if (!bitmap->Create(width, height, FXDIB_Format::kRgb))
+    return nullptr;
+
+  for (int y = 0; y < height; ++y) {
+    pdfium::span<uint8_t> scanline = bitmap->GetWritableScanline(y);
+    for (int x = 0; x < width; ++x) {
+      scanline[x * 3] = static_cast<uint8_t>(x + y);
+      scanline[x * 3 + 1] = static_cast<uint8_t>(x * 2);
+      scanline[x * 3 + 2] = static_cast<uint8_t>((x ^ y) & 0xf0);
+    }
+  }
+  return bitmap;
+}
+
+// A star of curved spikes, which covers most of a `size` device and crosses
+// itself, so fill rules and the scanline rasterizer both matter.
+CFX_Path MakeStarPath(float size) {
+  static constexpr int kSpikes = 48;
+  static constexpr float kPi = 3.14159265f;
+  const float center = size / 2;
+  CFX_Path path;
+  for (int i = 0; i <= kSpikes; ++i) {
+    const float angle = 2 * kPi * i / kSpikes;
+    const float next = 2 * kPi * (i + 0.5f) / kSpikes;
+    const CFX_PointF tip(center + center * 0.95f * cosf(angle),
+                         center + center * 0.95f * sinf(angle));
+    if (i == 0) {
+      path.AppendPoint(tip, CFX_Path::Point::Type::kMove);
+      continue;
+    }
+    // Loops back across the center, so spikes overlap each other.
+    path.AppendPoint(CFX_PointF(center + center * 0.2f * cosf(next + kPi),
+                                center + center * 0.2f * sinf(next + kPi)),
+                     CFX_Path::Point::Type::kBezier);
+    path.AppendPoint(CFX_PointF(center + center * 0.6f * cosf(next),
+                                center + center * 0.6f * sinf(next)),
+                     CFX_Path::Point::Type::kBezier);
+    path.AppendPoint(tip, CFX_Path::Point::Type::kBezier);
+  }
+  path.ClosePath();
+  return path;
+}
+
+void BM_CompositeArgbLine(benchmark::State& state) {
+  const BlendMode blend_mode = static_cast<BlendMode>(state.range(0));
+  const std::vector<uint8_t> src = MakeArgbLines(kLineWidth, kLineCount, 0);
+  std::vector<uint8_t> dest = MakeArgbLines(kLineWidth, kLineCount, 99);
+  CFX_ScanlineCompositor compositor;
+  if (!compositor.Init(FXDIB_Format::kArgb, FXDIB_Format::kArgb, {},
+                       /*mask_color=*/0, blend_mode, /*bClip=*/false,
+                       /*bRgbByteOrder=*/false)) {
+    state.SkipWithError("cannot composite");
+    return;
+  }
+
+  const size_t pitch = kLineWidth * 4;
+  for (auto _ : state) {
+    for (int y = 0; y < kLineCount; ++y) {
+      compositor.CompositeRgbBitmapLine(
+          pdfium::make_span(dest).subspan(y * pitch, pitch),
+          pdfium::make_span(src).subspan(y * pitch, pitch), kLineWidth, {});
+    }
+    benchmark::DoNotOptimize(dest.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kLineWidth * kLineCount);
+}
+BENCHMARK(BM_CompositeArgbLine)
+    ->Arg(static_cast<int>(BlendMode::kNormal))
+    ->Arg(static_cast<int>(BlendMode::kMultiply))
+    ->Arg(static_cast<int>(BlendMode::kScreen))
+    ->Arg(static_cast<int>(BlendMode::kOverlay))
+    ->Arg(static_cast<int>(BlendMode::kSoftLight))
+    ->Arg(static_cast<int>(BlendMode::kHue))
+    ->Arg(static_cast<int>(BlendMode::kLuminosity));
+
+// Composites onto an opaque RGB page buffer, as page rendering does.
+void BM_CompositeArgbOntoRgbLine(benchmark::State& state) {
+  const std::vector<uint8_t> src = MakeArgbLines(kLineWidth, kLineCount, 0);
+  std::vector<uint8_t> dest(kLineWidth * kLineCount * 3, 0xff);
+  CFX_ScanlineCompositor compositor;
+  if (!compositor.Init(FXDIB_Format::kRgb, FXDIB_Format::kArgb, {},
+                       /*mask_color=*/0, BlendMode::kNormal, /*bClip=*/false,
+                       /*bRgbByteOrder=*/false)) {
+    state.SkipWithError("cannot composite");
+    return;
+  }
+
+  const size_t src_pitch = kLineWidth * 4;
+  const size_t dest_pitch = kLineWidth * 3;
+  for (auto _ : state) {
+    for (int y = 0; y < kLineCount; ++y) {
+      compositor.CompositeRgbBitmapLine(
+          pdfium::make_span(dest).subspan(y * dest_pitch, dest_pitch),
+          pdfium::make_span(src).subspan(y * src_pitch, src_pitch),
+          kLineWidth, {});
+    }
+    benchmark::DoNotOptimize(dest.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kLineWidth * kLineCount);
+}
+BENCHMARK(BM_CompositeArgbOntoRgbLine);
+
+// Fills a color through an 8 bpp mask, as glyphs and anti-aliased paths do.
+void BM_CompositeByteMaskLine(benchmark::State& state) {
+  std::vector<uint8_t> mask(kLineWidth * kLineCount);
+  for (size_t i = 0; i < mask.size(); ++i)
+    mask[i] = static_cast<uint8_t>(i * 13);
+  std::vector<uint8_t> dest = MakeArgbLines(kLineWidth, kLineCount, 99);
+  CFX_ScanlineCompositor compositor;
+  if (!compositor.Init(FXDIB_Format::kArgb, FXDIB_Format::k8bppMask, {},
+                       /*mask_color=*/0xff336699, BlendMode::kNormal,
+                       /*bClip=*/false, /*bRgbByteOrder=*/false)) {
+    state.SkipWithError("cannot composite");
+    return;
+  }
+
+  const size_t pitch = kLineWidth * 4;
+  for (auto _ : state) {
+    for (int y = 0; y < kLineCount; ++y) {
+      compositor.CompositeByteMaskLine(
+          pdfium::make_span(dest).subspan(y * pitch, pitch),
+          pdfium::make_span(mask).subspan(y * kLineWidth, kLineWidth),
+          kLineWidth, {});
+    }
+    benchmark::DoNotOptimize(dest.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kLineWidth * kLineCount);
+}
+BENCHMARK(BM_CompositeByteMaskLine);
+
+// Arguments are the destination size and whether to interpolate bilinearly.
+void BM_StretchRgb(benchmark::State& state) {
+  const int dest_size = static_cast<int>(state.range(0));
+  RetainPtr<CFX_DIBitmap> source = MakeRgbBitmap(1024, 1024);
+  FXDIB_ResampleOptions options;
+  options.bInterpolateBilinear = state.range(1);
+  for (auto _ : state) {
+    RetainPtr<CFX_DIBitmap> result =
+        source->StretchTo(dest_size, dest_size, options, nullptr);
+    if (!result) {
+      state.SkipWithError("cannot stretch");
+      return;
+    }
+    benchmark::DoNotOptimize(result.Get());
+  }
+  state.SetItemsProcessed(state.iterations() * dest_size * dest_size);
+}
+BENCHMARK(BM_StretchRgb)
+    ->Args({256, 0})
+    ->Args({256, 1})
+    ->Args({1500, 0})
+    ->Args({1500, 1})
+    ->Args({3000, 0});
+
+void BM_AggFillPath(benchmark::State& state) {
+  static constexpr int kSize = 1024;
+  CFX_DefaultRenderDevice device;
+  if (!device.Create(kSize, kSize, FXDIB_Format::kArgb, nullptr)) {
+    state.SkipWithError("cannot create device");
+    return;
+  }
+
+  // Too big for the coverage cache of small paths, so every fill rasterizes.
+  const CFX_Path path = MakeStarPath(kSize);
+  const CFX_FillRenderOptions options =
+      state.range(0) ? CFX_FillRenderOptions::WindingOptions()
+                     : CFX_FillRenderOptions::EvenOddOptions();
+  for (auto _ : state) {
+    device.DrawPath(path, nullptr, nullptr, 0xff3366cc, 0, options);
+    benchmark::DoNotOptimize(device.GetBitmap().Get());
+  }
+}
+BENCHMARK(BM_AggFillPath)->Arg(0)->Arg(1);
+
+void BM_AggStrokePath(benchmark::State& state) {
+  static constexpr int kSize = 1024;
+  CFX_DefaultRenderDevice device;
+  if (!device.Create(kSize, kSize, FXDIB_Format::kArgb, nullptr)) {
+    state.SkipWithError("cannot create device");
+    return;
+  }
+
+  const CFX_Path path = MakeStarPath(kSize);
+  CFX_GraphStateData graph_state;
+  graph_state.m_LineWidth = 3.0f;
+  for (auto _ : state) {
+    device.DrawPath(path, nullptr, &graph_state, 0, 0xff3366cc,
+                    CFX_FillRenderOptions());
+    benchmark::DoNotOptimize(device.GetBitmap().Get());
+  }
+}
+BENCHMARK(BM_AggStrokePath);
+
+// Loads the built-in serif font, which PDFium substitutes for Times.
+std::unique_ptr<CFX_Font> LoadSerifFont() {
+  static constexpr size_t kFoxitSerifIndex = 8;
+  auto font = std::make_unique<CFX_Font>();
+  if (!font->LoadEmbedded(CFX_FontMgr::GetStandardFont(kFoxitSerifIndex),
+                          /*force_vertical=*/false, /*object_tag=*/0)) {
+    return nullptr;
+  }
+  return font;
+}
+
+uint32_t GetGlyphCount(const CFX_Font& font) {
+  static constexpr uint32_t kMaxGlyphs = 200;
+  return std::min(static_cast<uint32_t>(font.GetFaceRec()->num_glyphs),
+                  kMaxGlyphs);
+}
+
+void LoadGlyphs(const CFX_Font& font, uint32_t count) {
+  // 12 point text at 150 dpi, in device space.
+  const CFX_Matrix matrix(25, 0, 0, -25, 0, 0);
+  CFX_TextRenderOptions options;
+  for (uint32_t glyph = 0; glyph < count; ++glyph) {
+    benchmark::DoNotOptimize(font.LoadGlyphBitmap(
+        glyph, /*bFontStyle=*/false, matrix, /*dest_width=*/0,
+        FT_RENDER_MODE_NORMAL, &options));
+  }
+}
+
+// Renders glyphs that are not in CFX_GlyphCache yet.
+void BM_GlyphRasterize(benchmark::State& state) {
+  uint32_t count = 0;
+  for (auto _ : state) {
+    // A new font comes with a new glyph cache.
+    state.PauseTiming();
+    std::unique_ptr<CFX_Font> font = LoadSerifFont();
+    if (!font) {
+      state.SkipWithError("cannot load font");
+      return;
+    }
+    count = GetGlyphCount(*font);
+    state.ResumeTiming();
+
+    LoadGlyphs(*font, count);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_GlyphRasterize);
+
+// Looks up glyphs that CFX_GlyphCache already has.
+void BM_GlyphCacheHit(benchmark::State& state) {
+  std::unique_ptr<CFX_Font> font = LoadSerifFont();
+  if (!font) {
+    state.SkipWithError("cannot load font");
+    return;
+  }
+
+  const uint32_t count = GetGlyphCount(*font);
+  LoadGlyphs(*font, count);
+  for (auto _ : state)
+    LoadGlyphs(*font, count);
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_GlyphCacheHit);
+
+}  // namespace
@@ -0,0 +1,83 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <ctype.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fpdfapi/parser/cpdf_indirect_object_holder.h"
+#include "core/fpdfapi/parser/cpdf_object.h"
+#include "core/fpdfapi/parser/cpdf_syntax_parser.h"
+#include "core/fxcrt/cfx_read_only_span_stream.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "testing/benchmarks/benchmark_inputs.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace {
+
+// Returns the offsets of the "N G obj" lines in `data`, without trusting the
+// cross-reference table.
+std::vector<uint32_t> FindObjectOffsets(const std::vector<uint8_t>& data) {
+  std::vector<uint32_t> offsets;
+  for (size_t i = 0; i < data.size(); ++i) {
+    if (i > 0 && data[i - 1] != '\n' && data[i - 1] != '\r')
+      continue;
+
+    size_t pos = i;
+    int numbers = 0;
+    while (numbers < 2) {
+      const size_t start = pos;
+      while (pos < data.size() && isdigit(data[pos]))
+        ++pos;
+      if (pos == start || pos == data.size() || data[pos] != ' ')
+        break;
+      ++pos;
+      ++numbers;
+    }
+    if (numbers == 2 && data.size() - pos >= 3 && data[pos] == 'o' &&
+        data[pos + 1] == 'b' && data[pos + 2] == 'j') {
+      offsets.push_back(static_cast<uint32_t>(i));
+    }
+  }
+  return offsets;
+}
+
+void ParseObjects(benchmark::State& state,
+                  const std::vector<uint8_t>& data,
+                  const std::vector<uint32_t>& offsets) {
+  if (offsets.empty()) {
+    state.SkipWithError("no objects");
+    return;
+  }
+
+  CPDF_IndirectObjectHolder holder;
+  CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(data));
+  for (auto _ : state) {
+    for (uint32_t offset : offsets) {
+      parser.SetPos(offset);
+      RetainPtr<CPDF_Object> object = parser.GetIndirectObject(
+          &holder, CPDF_SyntaxParser::ParseType::kLoose);
+      benchmark::DoNotOptimize(object.Get());
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+  state.SetItemsProcessed(state.iterations() * offsets.size());
+}
+
+void BM_SyntaxParserSynthetic(benchmark::State& state) {
+  std::vector<uint32_t> offsets;
+  const std::vector<uint8_t> data = MakeSyntheticObjects(1000, &offsets);
+  ParseObjects(state, data, offsets);
+}
+BENCHMARK(BM_SyntaxParserSynthetic);
+
+void BM_SyntaxParserDocument(benchmark::State& state) {
+  const std::vector<uint8_t> data =
+      LoadTestFile("annotation_stamp_with_ap.pdf");
+  ParseObjects(state, data, FindObjectOffsets(data));
+}
+BENCHMARK(BM_SyntaxParserDocument);
+
+}  // namespace
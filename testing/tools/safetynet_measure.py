@@ -5,22 +5,50 @@
 """Measures performance for rendering a single test case with pdfium.
 
 The output is a number that is a metric which depends on the profiler specified.
+
+The throughput profiler instead measures a whole corpus of test cases with
+several worker processes, and prints the corpus throughput, the tail latency of
+pages, the peak RSS and the time spent in each phase.
 """
 
 import argparse
+import json
+import multiprocessing
 import os
 import re
 import subprocess
 import sys
+import tempfile
+import time
 
 from common import PrintErr
 
 CALLGRIND_PROFILER = 'callgrind'
 PERFSTAT_PROFILER = 'perfstat'
 NONE_PROFILER = 'none'
+THROUGHPUT_PROFILER = 'throughput'
 
 PDFIUM_TEST = 'pdfium_test'
 
+# Phases reported by `pdfium_test --throughput`.
+PHASES = ('load_ms', 'parse_ms', 'render_ms', 'text_ms')
+
+# Metrics compared between two builds by the throughput profiler.
+THROUGHPUT_METRICS = ('pages_per_sec', 'p50_ms', 'p95_ms', 'p99_ms',
+                      'peak_rss_kb') + PHASES
+
+
+def RunThroughputCaseParallel(this, pdfium_test_path, pdf_path):
+  return this.RunThroughputCase(pdfium_test_path, pdf_path)
+
+
+def GetPercentile(sorted_values, percent):
+  """Returns the nearest-rank percentile, like pdfium_test does."""
+  if not sorted_values:
+    return 0
+  rank = (len(sorted_values) * percent + 99) // 100
+  return sorted_values[max(rank, 1) - 1]
+
 
 class PerformanceRun:
   """A single measurement of a test case."""
@@ -28,18 +56,25 @@ class PerformanceRun:
   def __init__(self, args):
     self.args = args
     self.pdfium_test_path = os.path.join(self.args.build_dir, PDFIUM_TEST)
+    self.pdfium_test_path_before = None
+    if self.args.build_dir_before:
+      self.pdfium_test_path_before = os.path.join(self.args.build_dir_before,
+                                                  PDFIUM_TEST)
 
   def _CheckTools(self):
     """Returns whether the tool file paths are sane."""
-    if not os.path.exists(self.pdfium_test_path):
-      PrintErr(
-          "FAILURE: Can't find test executable '%s'" % self.pdfium_test_path)
-      PrintErr('Use --build-dir to specify its location.')
-      return False
-    if not os.access(self.pdfium_test_path, os.X_OK):
-      PrintErr("FAILURE: Test executable '%s' lacks execution permissions" %
-               self.pdfium_test_path)
-      return False
+    paths = [self.pdfium_test_path]
+    if self.pdfium_test_path_before:
+      paths.append(self.pdfium_test_path_before)
+    for path in paths:
+      if not os.path.exists(path):
+        PrintErr("FAILURE: Can't find test executable '%s'" % path)
+        PrintErr('Use --build-dir to specify its location.')
+        return False
+      if not os.access(path, os.X_OK):
+        PrintErr(
+            "FAILURE: Test executable '%s' lacks execution permissions" % path)
+        return False
     return True
 
   def Run(self):
@@ -51,6 +86,9 @@ class PerformanceRun:
     if not self._CheckTools():
       return 1
 
+    if self.args.profiler == THROUGHPUT_PROFILER:
+      return self._RunThroughput()
+
     if self.args.profiler == CALLGRIND_PROFILER:
       time = self._RunCallgrind()
     elif self.args.profiler == PERFSTAT_PROFILER:
@@ -82,7 +120,8 @@ class PerformanceRun:
         'valgrind', '--tool=callgrind',
         '--instr-atstart=%s' % instrument_at_start,
         '--callgrind-out-file=%s' % output_path
-    ] + self._BuildTestHarnessCommand())
+    ] + self._BuildTestHarnessCommand(self.pdfium_test_path,
+                                      self.args.pdf_path))
     output = subprocess.check_output(
         valgrind_cmd, stderr=subprocess.STDOUT).decode('utf-8')
 
@@ -99,7 +138,8 @@ class PerformanceRun:
     # --no-big-num: do not add thousands separators
     # -einstructions: print only instruction count
     cmd_to_run = (['perf', 'stat', '--no-big-num', '-einstructions'] +
-                  self._BuildTestHarnessCommand())
+                  self._BuildTestHarnessCommand(self.pdfium_test_path,
+                                                self.args.pdf_path))
     output = subprocess.check_output(
         cmd_to_run, stderr=subprocess.STDOUT).decode('utf-8')
 
@@ -114,15 +154,143 @@ class PerformanceRun:
       int with the result of the measurement, in instructions or time. In this
       case, always return 1 since no profiler is being used.
     """
-    cmd_to_run = self._BuildTestHarnessCommand()
+    cmd_to_run = self._BuildTestHarnessCommand(self.pdfium_test_path,
+                                               self.args.pdf_path)
     subprocess.check_output(cmd_to_run, stderr=subprocess.STDOUT)
 
     # Return 1 for every run.
     return 1
 
-  def _BuildTestHarnessCommand(self):
+  def _RunThroughput(self):
+    """Measures a corpus of test cases with several worker processes.
+
+    Returns:
+      Exit code for the script.
+    """
+    test_cases = self._FindTestCases()
+    if not test_cases:
+      PrintErr("FAILURE: No test cases in '%s'" % self.args.pdf_path)
+      return 1
+
+    after = self._MeasureCorpus(self.pdfium_test_path, test_cases)
+    if self.pdfium_test_path_before:
+      before = self._MeasureCorpus(self.pdfium_test_path_before, test_cases)
+      output = {'before': before, 'after': after}
+      self._PrintComparison(before['summary'], after['summary'])
+    else:
+      output = after
+      print(json.dumps(after['summary'], indent=2))
+
+    if self.args.output_path:
+      with open(self.args.output_path, 'w') as output_file:
+        json.dump(output, output_file, indent=2)
+    return 0
+
+  def _FindTestCases(self):
+    """Returns the test cases in `pdf_path`, which may be a directory."""
+    if os.path.isfile(self.args.pdf_path):
+      return [self.args.pdf_path]
+
+    test_cases = []
+    for file_dir, _, filename_list in os.walk(self.args.pdf_path):
+      for filename in filename_list:
+        if filename.endswith('.pdf'):
+          test_cases.append(os.path.join(file_dir, filename))
+    return sorted(test_cases)
+
+  def _MeasureCorpus(self, pdfium_test_path, test_cases):
+    """Runs each test case in its own process, so each gets its own peak RSS.
+
+    Returns:
+      dict with the stats of each file and a summary of the corpus.
+    """
+    start = time.monotonic()
+    with multiprocessing.Pool(self.args.workers) as pool:
+      results = [
+          pool.apply_async(RunThroughputCaseParallel,
+                           (self, pdfium_test_path, test_case))
+          for test_case in test_cases
+      ]
+      files = [result.get() for result in results]
+    wall_s = time.monotonic() - start
+
+    failed_files = [
+        test_case for test_case, stats in zip(test_cases, files) if not stats
+    ]
+    for test_case in failed_files:
+      PrintErr("FAILURE: Can't measure '%s'" % test_case)
+    files = [stats for stats in files if stats]
+    return {
+        'summary': self._SummarizeCorpus(files, wall_s, len(failed_files)),
+        'files': files,
+    }
+
+  def RunThroughputCase(self, pdfium_test_path, pdf_path):
+    """Runs `pdf_path` with `pdfium_test --throughput`.
+
+    Returns:
+      dict with the stats of the file, or None on failure.
+    """
+    fd, stats_path = tempfile.mkstemp(suffix='.jsonl')
+    os.close(fd)
+    try:
+      cmd = self._BuildTestHarnessCommand(
+          pdfium_test_path, pdf_path, throughput_path=stats_path)
+      returncode = subprocess.call(
+          cmd, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+      if returncode:
+        return None
+      with open(stats_path) as stats_file:
+        line = stats_file.readline()
+      return json.loads(line) if line else None
+    finally:
+      os.remove(stats_path)
+
+  def _SummarizeCorpus(self, files, wall_s, failed_files):
+    """Combines the stats of each file into the stats of the corpus."""
+    page_ms = sorted(ms for stats in files for ms in stats['page_ms'])
+    pages = len(page_ms)
+    peak_rss_kb = [
+        stats['peak_rss_kb']
+        for stats in files
+        if stats['peak_rss_kb'] is not None
+    ]
+    summary = {
+        'files': len(files),
+        'failed_files': failed_files,
+        'workers': self.args.workers,
+        'pages': pages,
+        'wall_s': round(wall_s, 3),
+        'pages_per_sec': round(pages / wall_s, 3) if wall_s else 0,
+        'p50_ms': GetPercentile(page_ms, 50),
+        'p95_ms': GetPercentile(page_ms, 95),
+        'p99_ms': GetPercentile(page_ms, 99),
+        'peak_rss_kb': max(peak_rss_kb) if peak_rss_kb else None,
+    }
+    for phase in PHASES:
+      summary[phase] = round(sum(stats[phase] for stats in files), 3)
+    return summary
+
+  def _PrintComparison(self, before, after):
+    """Prints the change of each throughput metric between two builds."""
+    print('%-14s %14s %14s %9s' % ('metric', 'before', 'after', 'change'))
+    for metric in THROUGHPUT_METRICS:
+      value_before = before[metric]
+      value_after = after[metric]
+      if value_before is None or value_after is None:
+        continue
+      change = 'n/a'
+      if value_before:
+        change = '%+.1f%%' % (
+            (value_after - value_before) * 100.0 / value_before)
+      print('%-14s %14s %14s %9s' % (metric, value_before, value_after, change))
+
+  def _BuildTestHarnessCommand(self,
+                               pdfium_test_path,
+                               pdf_path,
+                               throughput_path=None):
     """Builds command to run the test harness."""
-    cmd = [self.pdfium_test_path, '--send-events']
+    cmd = [pdfium_test_path, '--send-events']
 
     if self.args.interesting_section:
       cmd.append('--callgrind-delim')
@@ -130,8 +298,10 @@ class PerformanceRun:
       cmd.append('--png')
     if self.args.pages:
       cmd.append('--pages=%s' % self.args.pages)
+    if throughput_path:
+      cmd.append('--throughput=%s' % throughput_path)
 
-    cmd.append(self.args.pdf_path)
+    cmd.append(pdf_path)
     return cmd
 
   def _ExtractIrCount(self, regex, output):
@@ -148,7 +318,9 @@ class PerformanceRun:
 def main():
   parser = argparse.ArgumentParser()
   parser.add_argument(
-      'pdf_path', help='test case to measure load and rendering time')
+      'pdf_path',
+      help='test case to measure load and rendering time. The '
+      'throughput profiler also takes a directory of test cases.')
   parser.add_argument(
       '--build-dir',
       default=os.path.join('out', 'Release'),
@@ -158,7 +330,7 @@ def main():
       '--profiler',
       default=CALLGRIND_PROFILER,
       help='which profiler to use. Supports callgrind, '
-      'perfstat, and none.')
+      'perfstat, throughput, and none.')
   parser.add_argument(
       '--interesting-section',
       action='store_true',
@@ -183,12 +355,25 @@ def main():
       '(inclusive).')
   parser.add_argument(
       '--output-path', help='where to write the profile data output file')
+  parser.add_argument(
+      '--workers',
+      type=int,
+      default=multiprocessing.cpu_count(),
+      help='number of test cases to run at once. Throughput only.')
+  parser.add_argument(
+      '--build-dir-before',
+      help='relative path to the build directory of a second '
+      '%s to compare against. Throughput only.' % PDFIUM_TEST)
   args = parser.parse_args()
 
   if args.interesting_section and args.profiler != CALLGRIND_PROFILER:
     PrintErr('--interesting-section requires profiler to be callgrind.')
     return 1
 
+  if args.build_dir_before and args.profiler != THROUGHPUT_PROFILER:
+    PrintErr('--build-dir-before requires profiler to be throughput.')
+    return 1
+
   run = PerformanceRun(args)
   return run.Run()
 
@@ -1071,8 +1071,8 @@ CXFA_XMLLocale* GetLocaleFromBuffer(cppgc::Heap* heap,
 
   std::unique_ptr<uint8_t, FxFreeDeleter> output;
   uint32_t dwSize;
-  FlateModule::FlateOrLZWDecode(false, src_span, true, 0, 0, 0, 0, 0, &output,
-                                &dwSize);
+  FlateModule::FlateOrLZWDecode(false, src_span, true, 0, 0, 0, 0, 0,
+                                FlateModule::kNoMaxSize, &output, &dwSize);
   if (!output)
     return nullptr;
 